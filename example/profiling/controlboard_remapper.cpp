@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+#include <yarp/dev/ControlBoardInterfaces.h>
+#include <yarp/dev/PolyDriver.h>
+#include <yarp/dev/PolyDriverList.h>
+#include <yarp/dev/Wrapper.h>
+
+using namespace yarp::os;
+using namespace yarp::dev;
+
+// ControlBoardRemapper multi joint methods benchmark.
+// Remaps 4 fakeMotionControl parts (50 joints in total, interleaved) and
+// compares the multi joint methods of the remapper, that call each part
+// once, with a loop of single joint calls on the same remapper.
+// The test is done on the local remapper and on the remote remapper,
+// connected to the parts through controlboardwrapper2.
+
+// Parameters:
+// --iterations: number of calls per measurement (default 1000)
+// --remote_iterations: number of calls per remote measurement (default 20)
+
+static const int nrOfParts = 4;
+static const int jointsInPart[nrOfParts] = { 12, 13, 12, 13 };
+
+static std::string axisName(int part, int joint)
+{
+    return "part" + std::to_string(part) + "_joint" + std::to_string(joint);
+}
+
+template <typename F>
+static double timeit(int iterations, F f)
+{
+    double t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        f();
+    }
+    return (SystemClock::nowSystem() - t0) / iterations;
+}
+
+static void bench(const char* what, PolyDriver& remapper, int iterations)
+{
+    IEncodersTimed* enc = nullptr;
+    IPidControl* pid = nullptr;
+    remapper.view(enc);
+    remapper.view(pid);
+    if (!enc || !pid) {
+        printf("%s: missing interfaces\n", what);
+        return;
+    }
+
+    int axes = 0;
+    enc->getAxes(&axes);
+    std::vector<double> values(axes), stamps(axes);
+    std::vector<Pid> pids(axes);
+    PidControlTypeEnum type = VOCAB_PIDTYPE_POSITION;
+
+    printf("%s, %d axes (time per call over all the axes)\n", what, axes);
+
+    double loop = timeit(iterations, [&]() {
+        for (int j = 0; j < axes; j++) {
+            enc->getEncoderTimed(j, &values[j], &stamps[j]);
+        }
+    });
+    double multi = timeit(iterations, [&]() { enc->getEncodersTimed(values.data(), stamps.data()); });
+    printf("  getEncodersTimed   single joint %9.3f us | multi joint %9.3f us\n", loop * 1e6, multi * 1e6);
+
+    loop = timeit(iterations, [&]() {
+        for (int j = 0; j < axes; j++) {
+            pid->getPid(type, j, &pids[j]);
+        }
+    });
+    multi = timeit(iterations, [&]() { pid->getPids(type, pids.data()); });
+    printf("  getPids            single joint %9.3f us | multi joint %9.3f us\n", loop * 1e6, multi * 1e6);
+
+    loop = timeit(iterations, [&]() {
+        for (int j = 0; j < axes; j++) {
+            pid->getPidError(type, j, &values[j]);
+        }
+    });
+    multi = timeit(iterations, [&]() { pid->getPidErrors(type, values.data()); });
+    printf("  getPidErrors       single joint %9.3f us | multi joint %9.3f us\n", loop * 1e6, multi * 1e6);
+
+    loop = timeit(iterations, [&]() {
+        for (int j = 0; j < axes; j++) {
+            pid->setPidReference(type, j, values[j]);
+        }
+    });
+    multi = timeit(iterations, [&]() { pid->setPidReferences(type, values.data()); });
+    printf("  setPidReferences   single joint %9.3f us | multi joint %9.3f us\n", loop * 1e6, multi * 1e6);
+}
+
+int main(int argc, char* argv[])
+{
+    Network yarp;
+    Network::setLocalMode(true);
+
+    Property p;
+    p.fromCommand(argc, argv);
+    int iterations = p.check("iterations", Value(1000)).asInt32();
+    int remoteIterations = p.check("remote_iterations", Value(20)).asInt32();
+
+    PolyDriver parts[nrOfParts];
+    PolyDriver wrappers[nrOfParts];
+    PolyDriverList partList;
+    Bottle remoteControlBoards;
+    Bottle& remoteList = remoteControlBoards.addList();
+
+    for (int i = 0; i < nrOfParts; i++) {
+        std::string config = "device fakeMotionControl\n[GENERAL]\nJoints " + std::to_string(jointsInPart[i]) + "\nAxisName";
+        for (int j = 0; j < jointsInPart[i]; j++) {
+            config += " \"" + axisName(i, j) + "\"";
+        }
+        Property pp;
+        pp.fromConfig(config.c_str());
+        if (!parts[i].open(pp)) {
+            printf("Unable to open fakeMotionControl part %d\n", i);
+            return 1;
+        }
+        std::string partName = "part" + std::to_string(i);
+        partList.push(&parts[i], partName.c_str());
+
+        Property pw;
+        pw.put("device", "controlboardwrapper2");
+        pw.put("name", "/benchRemapper/" + partName);
+        pw.put("period", 10);
+        pw.put("joints", jointsInPart[i]);
+        Bottle networks;
+        networks.addList().addString(partName);
+        pw.put("networks", networks.get(0));
+        Bottle net;
+        Bottle& netList = net.addList();
+        netList.addInt32(0);
+        netList.addInt32(jointsInPart[i] - 1);
+        netList.addInt32(0);
+        netList.addInt32(jointsInPart[i] - 1);
+        pw.put(partName, net.get(0));
+
+        IMultipleWrapper* iwrap = nullptr;
+        PolyDriverList single;
+        single.push(&parts[i], partName.c_str());
+        if (!wrappers[i].open(pw) || !wrappers[i].view(iwrap) || !iwrap->attachAll(single)) {
+            printf("Unable to wrap part %d\n", i);
+            return 1;
+        }
+        remoteList.addString("/benchRemapper/" + partName);
+    }
+
+    // Interleave the joints of the parts, as a whole body remapper does
+    Bottle axesNames;
+    Bottle& axesList = axesNames.addList();
+    for (int j = 0; j < 13; j++) {
+        for (int i = 0; i < nrOfParts; i++) {
+            if (j < jointsInPart[i]) {
+                axesList.addString(axisName(i, j));
+            }
+        }
+    }
+
+    PolyDriver remapper;
+    Property pr;
+    pr.put("device", "controlboardremapper");
+    pr.put("axesNames", axesNames.get(0));
+    IMultipleWrapper* imultwrap = nullptr;
+    if (!remapper.open(pr) || !remapper.view(imultwrap) || !imultwrap->attachAll(partList)) {
+        printf("Unable to open the controlboardremapper\n");
+        return 1;
+    }
+    bench("controlboardremapper", remapper, iterations);
+
+    PolyDriver remoteRemapper;
+    Property prr;
+    prr.put("device", "remotecontrolboardremapper");
+    prr.put("axesNames", axesNames.get(0));
+    prr.put("remoteControlBoards", remoteControlBoards.get(0));
+    prr.put("localPortPrefix", "/benchRemapper/remote");
+    if (!remoteRemapper.open(prr)) {
+        printf("Unable to open the remotecontrolboardremapper\n");
+        return 1;
+    }
+    bench("remotecontrolboardremapper", remoteRemapper, remoteIterations);
+
+    remoteRemapper.close();
+    imultwrap->detachAll();
+    remapper.close();
+    for (int i = 0; i < nrOfParts; i++) {
+        wrappers[i].close();
+        parts[i].close();
+    }
+    return 0;
+}
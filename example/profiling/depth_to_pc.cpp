@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+#include <yarp/sig/PointCloudUtils.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+// Depth to point cloud conversion benchmark.
+// Compares a naive per-pixel loop with yarp::sig::utils::depthToPC at
+// 640x480 and 1280x720, reusing the same output cloud across iterations.
+
+// Parameters:
+// --iterations: number of conversions per measurement (default 200)
+// --threads: number of threads used by depthToPC (default 4)
+
+static void naiveDepthToPC(const ImageOf<PixelFloat>& depth,
+                           const IntrinsicParams& intrinsic,
+                           PointCloud<DataXYZ>& cloud)
+{
+    cloud.resize(depth.width(), depth.height());
+    for (size_t v = 0; v < depth.height(); v++) {
+        for (size_t u = 0; u < depth.width(); u++) {
+            DataXYZ& p = cloud(u, v);
+            p.z = depth.pixel(u, v);
+            p.x = static_cast<float>((u - intrinsic.principalPointX) * p.z / intrinsic.focalLengthX);
+            p.y = static_cast<float>((v - intrinsic.principalPointY) * p.z / intrinsic.focalLengthY);
+        }
+    }
+}
+
+static void bench(size_t width, size_t height, int iterations, size_t threads)
+{
+    ImageOf<PixelFloat> depth;
+    depth.resize(width, height);
+    for (size_t v = 0; v < height; v++) {
+        for (size_t u = 0; u < width; u++) {
+            depth.pixel(u, v) = 0.5f + 0.001f * ((u + v) % 1000);
+        }
+    }
+
+    IntrinsicParams intrinsic;
+    intrinsic.focalLengthX = 0.8 * width;
+    intrinsic.focalLengthY = 0.8 * width;
+    intrinsic.principalPointX = width / 2.0;
+    intrinsic.principalPointY = height / 2.0;
+
+    PointCloud<DataXYZ> cloud;
+
+    double t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        naiveDepthToPC(depth, intrinsic, cloud);
+    }
+    double naive = (SystemClock::nowSystem() - t0) / iterations;
+
+    t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        utils::depthToPC(depth, intrinsic, cloud);
+    }
+    double single = (SystemClock::nowSystem() - t0) / iterations;
+
+    t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        utils::depthToPC(depth, intrinsic, cloud, utils::PCL_ROI(), 1, 1, threads);
+    }
+    double multi = (SystemClock::nowSystem() - t0) / iterations;
+
+    t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        utils::depthToPC(depth, intrinsic, cloud, utils::PCL_ROI(), 2, 2);
+    }
+    double decimated = (SystemClock::nowSystem() - t0) / iterations;
+
+    printf("%4zux%-4zu naive %8.3f ms | depthToPC %8.3f ms | %zu threads %8.3f ms | step 2 %8.3f ms\n",
+           width, height, naive * 1000, single * 1000, threads, multi * 1000, decimated * 1000);
+}
+
+int main(int argc, char* argv[])
+{
+    Property p;
+    p.fromCommand(argc, argv);
+
+    int iterations = p.check("iterations", Value(200)).asInt32();
+    size_t threads = static_cast<size_t>(p.check("threads", Value(4)).asInt32());
+
+    bench(640, 480, iterations, threads);
+    bench(1280, 720, iterations, threads);
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+
+using namespace yarp::os;
+
+// Datagram carriers throughput benchmark.
+// Sends large frames (a Bottle containing a single blob) on the loopback
+// interface, through tcp and udp connections, and reports the received
+// throughput and the number of frames lost.
+
+// Parameters:
+// --size: frame size in bytes (default 1048576)
+// --frames: number of frames sent for each carrier (default 200)
+// --period: delay between frames in seconds (default 0.005)
+// --carriers: list of carriers to test (default (tcp udp))
+
+class Receiver : public TypedReaderCallback<Bottle>
+{
+    std::mutex mutex;
+    size_t frames;
+    size_t bytes;
+    size_t corrupted;
+    double first;
+    double last;
+
+public:
+    Receiver() { reset(); }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames = 0;
+        bytes = 0;
+        corrupted = 0;
+        first = 0;
+        last = 0;
+    }
+
+    void onRead(Bottle& b) override
+    {
+        double now = SystemClock::nowSystem();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (b.size() != 2 || !b.get(1).isBlob()) {
+            corrupted++;
+            return;
+        }
+        if (frames == 0) {
+            first = now;
+        }
+        last = now;
+        frames++;
+        bytes += b.get(1).asBlobLength();
+    }
+
+    void report(const std::string& carrier, size_t sent, double sendTime)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        double elapsed = (frames > 1) ? (last - first) * frames / (frames - 1) : sendTime;
+        printf("%-6s sent %4zu | received %4zu (lost %5.1f%%, corrupted %zu) | %8.1f MB/s\n",
+               carrier.c_str(), sent, frames,
+               100.0 * (sent - frames) / sent, corrupted,
+               elapsed > 0 ? bytes / elapsed / 1e6 : 0.0);
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    Network yarp;
+    Network::setLocalMode(true);
+
+    Property p;
+    p.fromCommand(argc, argv);
+    int size = p.check("size", Value(1048576)).asInt32();
+    int frames = p.check("frames", Value(200)).asInt32();
+    double period = p.check("period", Value(0.005)).asFloat64();
+    Bottle carriers;
+    carriers.fromString("tcp udp");
+    if (p.check("carriers")) {
+        carriers = *p.find("carriers").asList();
+    }
+
+    std::vector<char> payload(size);
+    for (int i = 0; i < size; i++) {
+        payload[i] = static_cast<char>(i * 7);
+    }
+
+    for (size_t c = 0; c < carriers.size(); c++) {
+        std::string carrier = carriers.get(c).asString();
+
+        Receiver receiver;
+        BufferedPort<Bottle> in;
+        in.setStrict();
+        in.useCallback(receiver);
+        Port out;
+        if (!in.open("/dgram_throughput/in") || !out.open("/dgram_throughput/out")) {
+            printf("Unable to open the ports\n");
+            return 1;
+        }
+        if (!Network::connect(out.getName(), in.getName(), carrier)) {
+            printf("Unable to connect with %s\n", carrier.c_str());
+            return 1;
+        }
+
+        Bottle msg;
+        msg.addInt32(0);
+        msg.add(Value(payload.data(), size));
+
+        double t0 = SystemClock::nowSystem();
+        for (int i = 0; i < frames; i++) {
+            msg.get(0) = Value(i);
+            out.write(msg);
+            SystemClock::delaySystem(period);
+        }
+        double sendTime = SystemClock::nowSystem() - t0;
+
+        // let the last frames arrive
+        SystemClock::delaySystem(0.5);
+        receiver.report(carrier, frames, sendTime);
+
+        out.close();
+        in.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+#include <yarp/sig/Image.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+
+// Image scaling benchmark.
+// Scales a color image to half its size with each filter, keeping the
+// pixel code or converting it to mono while scaling, and measures the
+// time needed for one scaled copy.
+
+// Parameters:
+// --width: width of the source image (default 1280)
+// --height: height of the source image (default 960)
+// --copies: number of scaled copies for each measurement (default 50)
+
+template <typename T>
+static double measure(const ImageOf<PixelRgb>& src, Image::ScaleFilter filter, int copies)
+{
+    ImageOf<T> dest;
+    double t0 = SystemClock::nowSystem();
+    for (int k = 0; k < copies; k++) {
+        dest.copy(src, src.width() / 2, src.height() / 2, filter);
+    }
+    return (SystemClock::nowSystem() - t0) / copies;
+}
+
+int main(int argc, char* argv[])
+{
+    Property p;
+    p.fromCommand(argc, argv);
+    int width = p.check("width", Value(1280)).asInt32();
+    int height = p.check("height", Value(960)).asInt32();
+    int copies = p.check("copies", Value(50)).asInt32();
+
+    ImageOf<PixelRgb> src;
+    src.resize(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            src(x, y) = PixelRgb(x & 0xff, y & 0xff, (x + y) & 0xff);
+        }
+    }
+
+    const char* names[] = { "nearest", "bilinear", "area" };
+    Image::ScaleFilter filters[] = { Image::SCALE_NEAREST, Image::SCALE_BILINEAR, Image::SCALE_AREA };
+    for (int i = 0; i < 3; i++) {
+        printf("%-10s rgb to rgb     %10.3f ms per copy\n", names[i],
+               measure<PixelRgb>(src, filters[i], copies) * 1e3);
+        printf("%-10s rgb to mono    %10.3f ms per copy\n", names[i],
+               measure<PixelMono>(src, filters[i], copies) * 1e3);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+
+using namespace yarp::os;
+
+// Priority carrier benchmark.
+// Connects several ports to the same input, using the priority carrier
+// with each connection inhibiting the next one, and measures the time
+// needed to deliver a message. The same measurement is done with plain
+// tcp connections, the difference is the overhead of the arbitration.
+
+// Parameters:
+// --connections: number of competing connections (default 50)
+// --messages: number of messages sent, round robin over the connections (default 2000)
+
+static const std::string inName = "/bench/priority/in";
+
+static std::string outName(int i)
+{
+    return "/bench/priority/out" + std::to_string(i);
+}
+
+static double measure(int connections, int messages, bool priority)
+{
+    BufferedPort<Bottle> in;
+    in.open(inName);
+    std::vector<Port*> outs;
+    for (int i = 0; i < connections; i++) {
+        Port* out = new Port;
+        out->open(outName(i));
+        std::string carrier = "tcp";
+        if (priority) {
+            carrier += "+recv.priority+st.10+tc.1+bs.10+(ex (" + outName((i + 1) % connections) + " -5))";
+        }
+        if (!Network::connect(outName(i), inName, carrier)) {
+            fprintf(stderr, "Cannot connect %s to %s with %s\n", outName(i).c_str(), inName.c_str(), carrier.c_str());
+        }
+        outs.push_back(out);
+    }
+
+    Bottle msg;
+    msg.addInt32(0);
+    double t0 = SystemClock::nowSystem();
+    for (int k = 0; k < messages; k++) {
+        msg.get(0) = Value(k);
+        outs[k % connections]->write(msg);
+    }
+    double t = (SystemClock::nowSystem() - t0) / messages;
+
+    for (auto out : outs) {
+        out->close();
+        delete out;
+    }
+    in.close();
+    return t;
+}
+
+int main(int argc, char* argv[])
+{
+    Property p;
+    p.fromCommand(argc, argv);
+    int connections = p.check("connections", Value(50)).asInt32();
+    int messages = p.check("messages", Value(2000)).asInt32();
+
+    Network yarp;
+    if (!yarp.checkNetwork(1.0)) {
+        Network::setLocalMode(true);
+    }
+    Network::setVerbosity(-1);
+
+    double plain = measure(connections, messages, false);
+    double priority = measure(connections, messages, true);
+    printf("tcp, %d connections                %10.3f us per message\n", connections, plain * 1e6);
+    printf("priority, %d connections           %10.3f us per message\n", connections, priority * 1e6);
+    printf("arbitration overhead               %10.3f us per message\n", (priority - plain) * 1e6);
+    return 0;
+}
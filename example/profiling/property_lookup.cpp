@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/SystemClock.h>
+
+using namespace yarp::os;
+
+// Property benchmark.
+// Measures the workloads typical of device configuration: parsing a
+// configuration file with groups, copying it (as done when the options
+// are propagated to the subdevices), and looking up keys, either existing
+// or missing.
+
+// Parameters:
+// --keys: number of keys in each group of the configuration (default 50)
+// --groups: number of groups in the configuration (default 10)
+// --iterations: number of repetitions of each measurement (default 200)
+
+template <typename F>
+static double timeit(int iterations, F f)
+{
+    double t0 = SystemClock::nowSystem();
+    for (int i = 0; i < iterations; i++) {
+        f();
+    }
+    return (SystemClock::nowSystem() - t0) / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    Property p;
+    p.fromCommand(argc, argv);
+    int keys = p.check("keys", Value(50)).asInt32();
+    int groups = p.check("groups", Value(10)).asInt32();
+    int iterations = p.check("iterations", Value(200)).asInt32();
+
+    std::vector<std::string> names;
+    std::string config;
+    for (int k = 0; k < keys; k++) {
+        names.push_back("parameter_" + std::to_string(k));
+        config += names.back() + " " + std::to_string(k * 0.5) + "\n";
+    }
+    for (int g = 0; g < groups; g++) {
+        config += "[GROUP_" + std::to_string(g) + "]\n";
+        for (int k = 0; k < keys; k++) {
+            config += names[k] + " " + std::to_string(k) + " " + std::to_string(g) + "\n";
+        }
+    }
+
+    Property conf;
+    double parse = timeit(iterations, [&]() { conf.fromConfig(config.c_str()); });
+    printf("fromConfig (%d groups x %d keys)  %10.3f us\n", groups, keys, parse * 1e6);
+
+    double copy = timeit(iterations, [&]() { Property c(conf); });
+    printf("copy                              %10.3f us\n", copy * 1e6);
+
+    Property flat;
+    for (int k = 0; k < keys; k++) {
+        flat.put(names[k], k);
+    }
+    std::vector<std::string> missing;
+    for (int k = 0; k < keys; k++) {
+        missing.push_back("missing_" + std::to_string(k));
+    }
+
+    double sum = 0;
+    double find = timeit(iterations * 100, [&]() {
+        for (int k = 0; k < keys; k++) {
+            sum += flat.find(names[k]).asFloat64();
+        }
+    });
+    printf("find, existing keys               %10.3f ns per key\n", find * 1e9 / keys);
+
+    int found = 0;
+    double check = timeit(iterations * 100, [&]() {
+        for (int k = 0; k < keys; k++) {
+            found += flat.check(missing[k]) ? 1 : 0;
+        }
+    });
+    printf("check, missing keys               %10.3f ns per key\n", check * 1e9 / keys);
+
+    std::vector<std::string> groupNames;
+    for (int g = 0; g < groups; g++) {
+        groupNames.push_back("GROUP_" + std::to_string(g));
+    }
+    double group = timeit(iterations * 100, [&]() {
+        for (int g = 0; g < groups; g++) {
+            sum += conf.findGroup(groupNames[g]).size();
+        }
+    });
+    printf("findGroup                         %10.3f ns per group\n", group * 1e9 / groups);
+
+    // prevent the lookups from being optimized away
+    return (sum < 0 || found != 0) ? 1 : 0;
+}
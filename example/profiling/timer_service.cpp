@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <yarp/os/Network.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Time.h>
+#include <yarp/os/Timer.h>
+
+using namespace yarp::os;
+
+// Single thread timers benchmark.
+// Creates many timers sharing the timer thread (newThread == false) and
+// measures the CPU used by the process and the firing jitter, i.e. the
+// delay between the expected and the actual time of each callback.
+// Set YARP_TIMER_WORKERS to run the callbacks on a pool of worker threads.
+
+// Parameters:
+// --timers: number of timers (default 10000)
+// --period: period of the timers in seconds (default 1.0), the timers are
+//           started at random offsets within a period
+// --time: duration of each measurement in seconds (default 10)
+
+class JitterStats
+{
+    std::mutex mutex;
+    std::vector<double> samples;
+
+public:
+    bool callback(const YarpTimerEvent& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(event.currentReal - event.currentExpected);
+        return true;
+    }
+
+    void report()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (samples.empty()) {
+            printf("  no callbacks\n");
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (double s : samples) {
+            sum += s;
+        }
+        printf("  callbacks %zu | jitter mean %.3f ms, median %.3f ms, 99%% %.3f ms, max %.3f ms\n",
+               samples.size(),
+               1000 * sum / samples.size(),
+               1000 * samples[samples.size() / 2],
+               1000 * samples[(samples.size() * 99) / 100],
+               1000 * samples.back());
+        samples.clear();
+    }
+};
+
+static void measureCpu(const char* what, double duration)
+{
+    std::clock_t c0 = std::clock();
+    double t0 = Time::now();
+    Time::delay(duration);
+    double cpu = double(std::clock() - c0) / CLOCKS_PER_SEC;
+    double wall = Time::now() - t0;
+    printf("%s: cpu %.1f%% of one core\n", what, 100.0 * cpu / wall);
+}
+
+int main(int argc, char* argv[])
+{
+    Network yarp;
+
+    Property p;
+    p.fromCommand(argc, argv);
+    int count = p.check("timers", Value(10000)).asInt32();
+    double period = p.check("period", Value(1.0)).asFloat64();
+    double duration = p.check("time", Value(10.0)).asFloat64();
+
+    JitterStats stats;
+    std::vector<std::unique_ptr<Timer>> timers;
+
+    // idle: a single timer, far in the future
+    timers.emplace_back(new Timer(TimerSettings(1000.0), &JitterStats::callback, &stats, false));
+    timers.back()->start();
+    measureCpu("1 idle timer", duration);
+    timers.clear();
+
+    for (int i = 0; i < count; i++) {
+        timers.emplace_back(new Timer(TimerSettings(period), &JitterStats::callback, &stats, false));
+    }
+    for (int i = 0; i < count; i++) {
+        timers[i]->start();
+        if (i % 100 == 99) {
+            // spread the deadlines over a period
+            Time::delay(period * 100 / count);
+        }
+    }
+    char what[100];
+    sprintf(what, "%d timers, period %.3f s", count, period);
+    measureCpu(what, duration);
+    stats.report();
+
+    for (auto& t : timers) {
+        t->stop();
+    }
+    timers.clear();
+    return 0;
+}
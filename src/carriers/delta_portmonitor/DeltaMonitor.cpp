@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "DeltaMonitor.h"
+
+#include <yarp/os/Bytes.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/OutputStream.h>
+#include <yarp/os/impl/BufferedConnectionWriter.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace yarp::os;
+
+namespace {
+
+// number of consecutive messages that did not compress well enough before
+// switching to bypass mode
+constexpr int maxMisses = 8;
+
+// run-length encoding tokens: a control byte c < 128 is followed by c+1
+// literal bytes, a control byte c >= 128 is followed by one byte repeated
+// c-128+minRun times.
+constexpr size_t maxLiteral = 128;
+constexpr size_t minRun = 3;
+constexpr size_t maxRun = 127 + minRun;
+
+class VectorOutputStream : public OutputStream
+{
+public:
+    using OutputStream::write;
+
+    explicit VectorOutputStream(std::vector<unsigned char>& out) :
+            out(out)
+    {
+        out.clear();
+    }
+
+    void write(const Bytes& b) override
+    {
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(b.get());
+        out.insert(out.end(), data, data + b.length());
+    }
+
+    void close() override
+    {
+    }
+
+    bool isOk() const override
+    {
+        return true;
+    }
+
+private:
+    std::vector<unsigned char>& out;
+};
+
+} // namespace
+
+
+DeltaMonitorObject::EncodedWriter::EncodedWriter() :
+        mode(MODE_RAW),
+        seq(0),
+        rawSize(0),
+        elementSize(1),
+        payload(nullptr),
+        payloadSize(0)
+{
+}
+
+bool DeltaMonitorObject::EncodedWriter::write(ConnectionWriter& connection) const
+{
+    connection.appendInt32(BOTTLE_TAG_LIST);
+    connection.appendInt32(5);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(mode);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(seq);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(rawSize);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(elementSize);
+    connection.appendInt32(BOTTLE_TAG_BLOB);
+    connection.appendInt32(static_cast<std::int32_t>(payloadSize));
+    connection.appendExternalBlock(reinterpret_cast<const char*>(payload), payloadSize);
+    connection.convertTextMode();
+    return !connection.isError();
+}
+
+
+DeltaMonitorObject::RawWriter::RawWriter() :
+        data(nullptr),
+        size(0)
+{
+}
+
+bool DeltaMonitorObject::RawWriter::write(ConnectionWriter& connection) const
+{
+    connection.appendExternalBlock(reinterpret_cast<const char*>(data), size);
+    return !connection.isError();
+}
+
+
+DeltaMonitorObject::DeltaMonitorObject() :
+        senderSide(false),
+        elementSize(8),
+        keyframeInterval(100),
+        minRatio(0.9),
+        bypassPeriod(100),
+        seq(0),
+        misses(0),
+        bypassCountdown(0),
+        synchronized(false),
+        rawBytes(0.0),
+        sentBytes(0.0)
+{
+}
+
+bool DeltaMonitorObject::create(const yarp::os::Property& options)
+{
+    senderSide = (options.find("sender_side").asBool());
+    seq = 0;
+    misses = 0;
+    bypassCountdown = 0;
+    synchronized = false;
+    rawBytes = 0.0;
+    sentBytes = 0.0;
+    return true;
+}
+
+void DeltaMonitorObject::destroy(void)
+{
+}
+
+bool DeltaMonitorObject::setparam(const yarp::os::Property& params)
+{
+    if (params.check("element_size")) {
+        int size = params.find("element_size").asInt32();
+        if (size <= 0) {
+            yError() << "DeltaMonitorObject: element_size must be positive";
+            return false;
+        }
+        elementSize = static_cast<size_t>(size);
+    }
+    if (params.check("keyframe_interval")) {
+        keyframeInterval = params.find("keyframe_interval").asInt32();
+    }
+    if (params.check("min_ratio")) {
+        minRatio = params.find("min_ratio").asFloat64();
+    }
+    if (params.check("bypass_period")) {
+        bypassPeriod = params.find("bypass_period").asInt32();
+    }
+    return true;
+}
+
+bool DeltaMonitorObject::getparam(yarp::os::Property& params)
+{
+    params.put("element_size", static_cast<int>(elementSize));
+    params.put("keyframe_interval", keyframeInterval);
+    params.put("min_ratio", minRatio);
+    params.put("bypass_period", bypassPeriod);
+    params.put("bypass", bypassCountdown > 0 ? 1 : 0);
+    params.put("ratio", (rawBytes > 0.0) ? sentBytes / rawBytes : 1.0);
+    return true;
+}
+
+bool DeltaMonitorObject::accept(yarp::os::Things& thing)
+{
+    if (senderSide) {
+        if (thing.getPortWriter() == nullptr) {
+            yError() << "DeltaMonitorObject: nothing to send";
+            return false;
+        }
+        return true;
+    }
+
+    Bottle* bt = thing.cast_as<Bottle>();
+    if (bt == nullptr) {
+        yError() << "DeltaMonitorObject: expected type Bottle in receiver side, but got wrong data type!";
+        return false;
+    }
+
+    // decode here, so that messages that cannot be rebuilt (e.g. a delta
+    // after a lost message) are dropped instead of being delivered
+    return decode(*bt);
+}
+
+yarp::os::Things& DeltaMonitorObject::update(yarp::os::Things& thing)
+{
+    if (senderSide) {
+        if (!encode(*thing.getPortWriter())) {
+            return thing;
+        }
+        th.setPortWriter(&encodedWriter);
+        return th;
+    }
+
+    rawWriter.data = current.data();
+    rawWriter.size = current.size();
+    th.setPortWriter(&rawWriter);
+    return th;
+}
+
+bool DeltaMonitorObject::encode(yarp::os::PortWriter& writer)
+{
+    // serialize the message, reusing the buffers of the previous one
+    std::swap(previous, current);
+    serializer.restart();
+    if (!writer.write(serializer)) {
+        yError() << "DeltaMonitorObject: failed to serialize the message";
+        return false;
+    }
+    VectorOutputStream os(current);
+    serializer.write(os);
+
+    const size_t size = current.size();
+    const std::uint32_t msgSeq = seq++;
+    encodedWriter.seq = static_cast<std::int32_t>(msgSeq);
+    encodedWriter.rawSize = static_cast<std::int32_t>(size);
+    encodedWriter.elementSize = static_cast<std::int32_t>(elementSize);
+    rawBytes += size;
+
+    if (bypassCountdown > 0) {
+        bypassCountdown--;
+        encodedWriter.mode = MODE_RAW;
+        encodedWriter.payload = current.data();
+        encodedWriter.payloadSize = size;
+        sentBytes += size;
+        return true;
+    }
+
+    const unsigned char* source = current.data();
+    bool delta = (previous.size() == size) &&
+                 (keyframeInterval <= 0 || msgSeq % static_cast<std::uint32_t>(keyframeInterval) != 0);
+    if (delta) {
+        residual.resize(size);
+        for (size_t i = 0; i < size; i++) {
+            residual[i] = current[i] ^ previous[i];
+        }
+        source = residual.data();
+    }
+
+    shuffled.resize(size);
+    shuffle(source, shuffled.data(), size, elementSize);
+    rleEncode(shuffled.data(), size, encoded);
+
+    if (encoded.size() >= minRatio * size) {
+        // not worth it, send the message as it is
+        if (++misses >= maxMisses) {
+            misses = 0;
+            bypassCountdown = bypassPeriod;
+        }
+        encodedWriter.mode = MODE_RAW;
+        encodedWriter.payload = current.data();
+        encodedWriter.payloadSize = size;
+    } else {
+        misses = 0;
+        encodedWriter.mode = delta ? MODE_DELTA : MODE_KEY;
+        encodedWriter.payload = encoded.data();
+        encodedWriter.payloadSize = encoded.size();
+    }
+    sentBytes += encodedWriter.payloadSize;
+    return true;
+}
+
+bool DeltaMonitorObject::decode(const yarp::os::Bottle& msg)
+{
+    if (msg.size() != 5 || !msg.get(4).isBlob()) {
+        yError() << "DeltaMonitorObject: malformed message";
+        return false;
+    }
+
+    std::int32_t mode = msg.get(0).asInt32();
+    std::uint32_t msgSeq = static_cast<std::uint32_t>(msg.get(1).asInt32());
+    std::int32_t rawSize = msg.get(2).asInt32();
+    std::int32_t msgElementSize = msg.get(3).asInt32();
+    const unsigned char* payload = reinterpret_cast<const unsigned char*>(msg.get(4).asBlob());
+    size_t payloadSize = msg.get(4).asBlobLength();
+
+    if (rawSize < 0 || msgElementSize <= 0) {
+        yError() << "DeltaMonitorObject: malformed message";
+        return false;
+    }
+
+    bool inSequence = synchronized && (msgSeq == seq + 1u);
+    seq = msgSeq;
+    const size_t size = static_cast<size_t>(rawSize);
+
+    std::swap(previous, current);
+    current.resize(size);
+
+    switch (mode) {
+    case MODE_RAW:
+        if (payloadSize != size) {
+            yError() << "DeltaMonitorObject: malformed message";
+            synchronized = false;
+            return false;
+        }
+        memcpy(current.data(), payload, size);
+        break;
+    case MODE_KEY:
+    case MODE_DELTA:
+        if (mode == MODE_DELTA && (!inSequence || previous.size() != size)) {
+            // the previous message was lost, wait for the next key frame
+            synchronized = false;
+            return false;
+        }
+        shuffled.resize(size);
+        if (!rleDecode(payload, payloadSize, shuffled.data(), size)) {
+            yError() << "DeltaMonitorObject: corrupted message";
+            synchronized = false;
+            return false;
+        }
+        unshuffle(shuffled.data(), current.data(), size, static_cast<size_t>(msgElementSize));
+        if (mode == MODE_DELTA) {
+            for (size_t i = 0; i < size; i++) {
+                current[i] ^= previous[i];
+            }
+        }
+        break;
+    default:
+        yError() << "DeltaMonitorObject: unknown encoding" << mode;
+        synchronized = false;
+        return false;
+    }
+
+    synchronized = true;
+    return true;
+}
+
+void DeltaMonitorObject::shuffle(const unsigned char* in, unsigned char* out, size_t size, size_t elementSize)
+{
+    const size_t count = size / elementSize;
+    for (size_t b = 0; b < elementSize; b++) {
+        unsigned char* dst = out + b * count;
+        const unsigned char* src = in + b;
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = src[i * elementSize];
+        }
+    }
+    // trailing bytes that do not make a whole element
+    const size_t done = count * elementSize;
+    memcpy(out + done, in + done, size - done);
+}
+
+void DeltaMonitorObject::unshuffle(const unsigned char* in, unsigned char* out, size_t size, size_t elementSize)
+{
+    const size_t count = size / elementSize;
+    for (size_t b = 0; b < elementSize; b++) {
+        const unsigned char* src = in + b * count;
+        unsigned char* dst = out + b;
+        for (size_t i = 0; i < count; i++) {
+            dst[i * elementSize] = src[i];
+        }
+    }
+    const size_t done = count * elementSize;
+    memcpy(out + done, in + done, size - done);
+}
+
+void DeltaMonitorObject::rleEncode(const unsigned char* in, size_t size, std::vector<unsigned char>& out)
+{
+    out.clear();
+    size_t i = 0;
+    size_t literalStart = 0;
+
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            size_t len = std::min(end - literalStart, maxLiteral);
+            out.push_back(static_cast<unsigned char>(len - 1));
+            out.insert(out.end(), in + literalStart, in + literalStart + len);
+            literalStart += len;
+        }
+    };
+
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < maxRun && in[i + run] == in[i]) {
+            run++;
+        }
+        if (run >= minRun) {
+            flushLiterals(i);
+            out.push_back(static_cast<unsigned char>(128 + run - minRun));
+            out.push_back(in[i]);
+            i += run;
+            literalStart = i;
+        } else {
+            i += run;
+        }
+    }
+    flushLiterals(size);
+}
+
+bool DeltaMonitorObject::rleDecode(const unsigned char* in, size_t size, unsigned char* out, size_t outSize)
+{
+    size_t i = 0;
+    size_t o = 0;
+    while (i < size) {
+        unsigned char c = in[i++];
+        if (c < 128) {
+            size_t len = static_cast<size_t>(c) + 1;
+            if (i + len > size || o + len > outSize) {
+                return false;
+            }
+            memcpy(out + o, in + i, len);
+            i += len;
+            o += len;
+        } else {
+            size_t len = static_cast<size_t>(c) - 128 + minRun;
+            if (i >= size || o + len > outSize) {
+                return false;
+            }
+            memset(out + o, in[i++], len);
+            o += len;
+        }
+    }
+    return o == outSize;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_DELTA_CARRIER_DELTAMONITOR_H
+#define YARP_DELTA_CARRIER_DELTAMONITOR_H
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Things.h>
+#include <yarp/os/MonitorObject.h>
+#include <yarp/os/PortWriter.h>
+#include <yarp/os/impl/BufferedConnectionWriter.h>
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * Lossless compression of numeric streams.
+ *
+ * The sender side serializes each message, XORs it with the previous one,
+ * shuffles the bytes by element size and run-length encodes the result.
+ * The receiver side keeps the same state and rebuilds the original bytes.
+ * All the buffers are owned by the monitor object (one per connection side)
+ * and reused across messages.
+ */
+class DeltaMonitorObject : public yarp::os::MonitorObject
+{
+public:
+    enum Mode : std::int32_t {
+        MODE_RAW = 0,  ///< message sent as it is
+        MODE_KEY = 1,  ///< encoded without the previous message
+        MODE_DELTA = 2 ///< encoded as difference from the previous message
+    };
+
+    DeltaMonitorObject();
+
+    bool create(const yarp::os::Property& options) override;
+    void destroy(void) override;
+
+    bool setparam(const yarp::os::Property& params) override;
+    bool getparam(yarp::os::Property& params) override;
+
+    bool accept(yarp::os::Things& thing) override;
+    yarp::os::Things& update(yarp::os::Things& thing) override;
+
+    /**
+     * Group the bytes of the elements by position: first the first byte of
+     * every element, then the second one, and so on.  The bytes that do not
+     * make a whole element are copied as they are.
+     */
+    static void shuffle(const unsigned char* in, unsigned char* out, size_t size, size_t elementSize);
+
+    /**
+     * Undo shuffle().
+     */
+    static void unshuffle(const unsigned char* in, unsigned char* out, size_t size, size_t elementSize);
+
+    /**
+     * Run-length encode size bytes, replacing the content of out.
+     */
+    static void rleEncode(const unsigned char* in, size_t size, std::vector<unsigned char>& out);
+
+    /**
+     * Decode the output of rleEncode().
+     * @return false if the data is corrupted or does not decode to exactly
+     *         outSize bytes
+     */
+    static bool rleDecode(const unsigned char* in, size_t size, unsigned char* out, size_t outSize);
+
+private:
+    /**
+     * Writes an encoded message with the same wire format of a Bottle
+     * (mode seq raw_size element_size {blob}), without copying the payload.
+     */
+    class EncodedWriter : public yarp::os::PortWriter
+    {
+    public:
+        EncodedWriter();
+        bool write(yarp::os::ConnectionWriter& connection) const override;
+
+        std::int32_t mode;
+        std::int32_t seq;
+        std::int32_t rawSize;
+        std::int32_t elementSize;
+        const unsigned char* payload;
+        size_t payloadSize;
+    };
+
+    /**
+     * Writes back the decoded bytes, that are the original serialization of
+     * the message.
+     */
+    class RawWriter : public yarp::os::PortWriter
+    {
+    public:
+        RawWriter();
+        bool write(yarp::os::ConnectionWriter& connection) const override;
+
+        const unsigned char* data;
+        size_t size;
+    };
+
+    bool encode(yarp::os::PortWriter& writer);
+    bool decode(const yarp::os::Bottle& msg);
+
+    bool senderSide;
+
+    // parameters
+    size_t elementSize;
+    int keyframeInterval;
+    double minRatio;
+    int bypassPeriod;
+
+    // per-connection state
+    std::uint32_t seq;
+    int misses;
+    int bypassCountdown;
+    bool synchronized;
+    std::vector<unsigned char> current;
+    std::vector<unsigned char> previous;
+    std::vector<unsigned char> residual;
+    std::vector<unsigned char> shuffled;
+    std::vector<unsigned char> encoded;
+    yarp::os::impl::BufferedConnectionWriter serializer;
+
+    // statistics
+    double rawBytes;
+    double sentBytes;
+
+    EncodedWriter encodedWriter;
+    RawWriter rawWriter;
+    yarp::os::Things th;
+};
+
+#endif // YARP_DELTA_CARRIER_DELTAMONITOR_H
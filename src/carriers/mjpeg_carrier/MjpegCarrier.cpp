@@ -8,38 +8,7 @@
  */
 
 #include <cstdio>
-
-
-/*
-  On Windows, libjpeg does some slightly odd-ball stuff, including
-  unconditionally defining INT32 to be "long".  This needs to
-  be worked around.  Work around begins...
- */
-#if defined(_WIN32)
-#define INT32 long  // jpeg's definition
-#define QGLOBAL_H 1
-#endif
-
-#ifdef _MSC_VER
-#pragma warning (push)
-#pragma warning (disable : 4091)
-#endif
-
-extern "C" {
-#include <jpeglib.h>
-}
-
-#ifdef _MSC_VER
-#pragma warning (pop)
-#endif
-
-#if defined(_WIN32)
-#undef INT32
-#undef QGLOBAL_H
-#endif
-/*
-  work around ends.
- */
+#include <cstdlib>
 
 
 #include "MjpegCarrier.h"
@@ -48,6 +17,7 @@ extern "C" {
 #include <yarp/sig/ImageNetworkHeader.h>
 #include <yarp/os/Name.h>
 #include <yarp/os/Bytes.h>
+#include <yarp/os/Log.h>
 
 #include "WireImage.h"
 
@@ -56,17 +26,7 @@ using namespace yarp::sig;
 
 #define dbg_printf if (0) printf
 
-typedef struct {
-    struct jpeg_destination_mgr pub;
-
-    JOCTET *buffer;
-    int bufsize;
-    JOCTET cache[1000000];  // need to make this variable...
-} net_destination_mgr;
-
-typedef net_destination_mgr *net_destination_ptr;
-
-void send_net_data(JOCTET *data, int len, void *client) {
+static void send_net_data(const char *data, int len, void *client) {
     dbg_printf("Send %d bytes\n", len);
     ConnectionState *p = (ConnectionState *)client;
     char hdr[1000];
@@ -80,7 +40,7 @@ void send_net_data(JOCTET *data, int len, void *client) {
 Content-Length: %d%s%s", brk, len, brk, brk);
     Bytes hbuf(hdr,strlen(hdr));
     p->os().write(hbuf);
-    Bytes buf((char *)data,len);
+    Bytes buf(const_cast<char*>(data),len);
     /*
       // add corruption now and then, for testing.
     static int ct = 0;
@@ -98,50 +58,38 @@ Content-Length: %d%s%s", brk, len, brk, brk);
 
 }
 
-static void init_net_destination(j_compress_ptr cinfo) {
-    //printf("Initializing destination\n");
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    dest->buffer = &(dest->cache[0]);
-    dest->bufsize = sizeof(dest->cache);
-    dest->pub.next_output_byte = dest->buffer;
-    dest->pub.free_in_buffer = dest->bufsize;
-}
-
-static boolean empty_net_output_buffer(j_compress_ptr cinfo) {
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    printf("Empty buffer - PROBLEM\n");
-    send_net_data(dest->buffer,dest->bufsize-dest->pub.free_in_buffer,
-                  cinfo->client_data);
-    dest->pub.next_output_byte = dest->buffer;
-    dest->pub.free_in_buffer = dest->bufsize;
-    return TRUE;
-}
-
-static void term_net_destination(j_compress_ptr cinfo) {
-    net_destination_ptr dest = (net_destination_ptr)cinfo->dest;
-    //printf("Terminating net %d %d\n", dest->bufsize,dest->pub.free_in_buffer);
-    send_net_data(dest->buffer,dest->bufsize-dest->pub.free_in_buffer,
-                  cinfo->client_data);
+namespace {
+
+// Value of a parameter in the query of a request, e.g. "quality" in
+// "GET /?action=stream&quality=80"
+std::string getRequestParameter(const std::string& request, const std::string& key) {
+    size_t at = 0;
+    while ((at = request.find(key + "=", at)) != std::string::npos) {
+        if (at > 0 && (request[at-1] == '&' || request[at-1] == '?')) {
+            size_t from = at + key.length() + 1;
+            size_t to = request.find_first_of("& \r\n", from);
+            return request.substr(from, to == std::string::npos ? std::string::npos : to - from);
+        }
+        at += key.length();
+    }
+    return "";
 }
 
-void jpeg_net_dest(j_compress_ptr cinfo) {
-    net_destination_ptr dest;
-
-      //ERREXIT(cinfo, JERR_BUFFER_SIZE);
+} // namespace
 
-    /* The destination object is made permanent so that multiple JPEG images
-     * can be written to the same buffer without re-executing jpeg_net_dest.
-     */
-    if (cinfo->dest == nullptr) {    /* first time for this JPEG object? */
-        cinfo->dest = (struct jpeg_destination_mgr *)
-            (*cinfo->mem->alloc_large) ((j_common_ptr) cinfo, JPOOL_PERMANENT,
-                                        sizeof(net_destination_mgr));
+void MjpegCarrier::configureEncoder(const std::string& request) {
+    std::string quality = getRequestParameter(request, "quality");
+    if (!quality.empty()) {
+        compression.setQuality(atoi(quality.c_str()));
+    }
+    std::string subsampling = getRequestParameter(request, "subsampling");
+    if (!subsampling.empty() && !compression.setSubsampling(subsampling)) {
+        yWarning("mjpeg: unknown subsampling %s, expected 444, 422 or 420", subsampling.c_str());
+    }
+    std::string threads = getRequestParameter(request, "threads");
+    if (!threads.empty()) {
+        compression.setThreads(atoi(threads.c_str()));
     }
-
-    dest = (net_destination_ptr) cinfo->dest;
-    dest->pub.init_destination = init_net_destination;
-    dest->pub.empty_output_buffer = empty_net_output_buffer;
-    dest->pub.term_destination = term_net_destination;
 }
 
 bool MjpegCarrier::write(ConnectionState& proto, SizedWriter& writer) {
@@ -149,47 +97,16 @@ bool MjpegCarrier::write(ConnectionState& proto, SizedWriter& writer) {
     FlexImage *img = rep.checkForImage(writer);
 
     if (img==nullptr) return false;
-    int w = img->width();
-    int h = img->height();
-    int row_stride = img->getRowSize();
-    JOCTET *data = (JOCTET*)img->getRawImage();
-
-    JSAMPROW row_pointer[1];
-
-    struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    cinfo.err = jpeg_std_error(&jerr);
-    cinfo.client_data = &proto;
-    jpeg_create_compress(&cinfo);
-    jpeg_net_dest(&cinfo);
-    cinfo.image_width = w;
-    cinfo.image_height = h;
-
-    if (img->getPixelCode() != VOCAB_PIXEL_MONO) {
-        cinfo.in_color_space = JCS_RGB;
-        cinfo.input_components = 3;
-    }
-    else {
-        cinfo.in_color_space = JCS_GRAYSCALE;
-        cinfo.input_components = 1;
-    }
 
-    jpeg_set_defaults(&cinfo);
-    //jpeg_set_quality(&cinfo, 85, TRUE);
+    Bytes jpeg;
     dbg_printf("Starting to compress...\n");
-    jpeg_start_compress(&cinfo, TRUE);
-    if(!envelope.empty()) {
-        jpeg_write_marker(&cinfo, JPEG_COM, reinterpret_cast<const JOCTET*>(envelope.c_str()), envelope.length() + 1);
-        envelope.clear();
-    }
-    dbg_printf("Done compressing (height %d)\n", cinfo.image_height);
-    while (cinfo.next_scanline < cinfo.image_height) {
-        dbg_printf("Writing row %d...\n", cinfo.next_scanline);
-        row_pointer[0] = data + cinfo.next_scanline * row_stride;
-        jpeg_write_scanlines(&cinfo, row_pointer, 1);
+    bool ok = compression.compress(*img, envelope, jpeg);
+    envelope.clear();
+    if (!ok) {
+        return false;
     }
-    jpeg_finish_compress(&cinfo);
-    jpeg_destroy_compress(&cinfo);
+    dbg_printf("Done compressing (%zu bytes)\n", jpeg.length());
+    send_net_data(jpeg.get(), (int)jpeg.length(), &proto);
 
     return true;
 }
@@ -202,11 +119,25 @@ bool MjpegCarrier::reply(ConnectionState& proto, SizedWriter& writer) {
 bool MjpegCarrier::sendHeader(ConnectionState& proto) {
     Name n(proto.getRoute().getCarrierName() + "://test");
     std::string pathValue = n.getCarrierModifier("path");
-    std::string target = "GET /?action=stream\n\n";
+    std::string target = "GET /?action=stream";
     if (pathValue!="") {
         target = "GET /";
         target += pathValue;
     }
+    // Encoder options are forwarded to the sender in the query of the
+    // request, after the path if one was given
+    const char* options[] = { "quality", "subsampling", "threads" };
+    for (const char* option : options) {
+        bool hasOption = false;
+        std::string value = n.getCarrierModifier(option, &hasOption);
+        if (hasOption) {
+            target += (target.find('?') == std::string::npos) ? "?" : "&";
+            target += std::string(option) + "=" + value;
+        }
+    }
+    if (pathValue=="") {
+        target += "\n\n";
+    }
     target += " HTTP/1.1\n";
     Contact host = proto.getRoute().getToContact();
     if (host.getHost()!="") {
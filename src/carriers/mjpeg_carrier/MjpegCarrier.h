@@ -13,6 +13,7 @@
 #include <yarp/os/Carrier.h>
 #include <yarp/os/NetType.h>
 #include "MjpegStream.h"
+#include "MjpegCompression.h"
 
 #include <cstring>
 
@@ -39,12 +40,23 @@ namespace yarp {
  * You can also view yarp image ports from a browser.  Do a "yarp name query /portname" to find their port number NNN, then go to:
  *   http://localhost:NNN/?output=stream
  *
+ * The encoder on the sender side can be tuned for each connection:
+ *   yarp connect /src /view mjpeg+quality.90+subsampling.444+threads.4
+ * - quality: jpeg quality, between 1 and 100 (default 75)
+ * - subsampling: chroma subsampling, 444, 422 or 420 (default 420)
+ * - threads: number of threads encoding horizontal strips of each frame (default 1)
+ * The same options can be added to the request from a browser, e.g.
+ *   http://localhost:NNN/?action=stream&quality=50
+ *
  */
 class yarp::os::MjpegCarrier : public Carrier {
 private:
     bool firstRound;
     bool sender;
     std::string envelope;
+    yarp::mjpeg::MjpegCompression compression;
+
+    void configureEncoder(const std::string& request);
 public:
     MjpegCarrier() {
         firstRound = true;
@@ -145,10 +157,11 @@ public:
     }
 
     virtual bool expectExtraHeader(ConnectionState& proto) override {
-        std::string txt;
-        do {
+        std::string txt = proto.is().readLine();
+        configureEncoder(txt);
+        while (txt!="") {
             txt = proto.is().readLine();
-        } while (txt!="");
+        }
         return true;
     }
 
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "MjpegCompression.h"
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Image.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <csetjmp>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define INT32 long  // jpeg's definition
+#define QGLOBAL_H 1
+#endif
+
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable : 4091)
+#endif
+
+extern "C" {
+#include <jpeglib.h>
+}
+
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+
+#if defined(_WIN32)
+#undef INT32
+#undef QGLOBAL_H
+#endif
+
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace yarp::mjpeg;
+
+namespace {
+
+struct compress_error_mgr {
+    struct jpeg_error_mgr pub;
+    jmp_buf setjmp_buffer;
+};
+
+void compress_error_exit(j_common_ptr cinfo) {
+    compress_error_mgr *err = (compress_error_mgr *) cinfo->err;
+    (*cinfo->err->output_message) (cinfo);
+    longjmp(err->setjmp_buffer, 1);
+}
+
+// Destination manager writing to a vector that is only ever grown, so that
+// after the first few frames no allocation happens anymore.
+struct vector_destination_mgr {
+    struct jpeg_destination_mgr pub;
+    std::vector<JOCTET> *buffer;
+    size_t length;
+};
+
+void init_vector_destination(j_compress_ptr cinfo) {
+    vector_destination_mgr *dest = (vector_destination_mgr *) cinfo->dest;
+    if (dest->buffer->size() < 65536) {
+        dest->buffer->resize(65536);
+    }
+    dest->pub.next_output_byte = dest->buffer->data();
+    dest->pub.free_in_buffer = dest->buffer->size();
+    dest->length = 0;
+}
+
+boolean empty_vector_output_buffer(j_compress_ptr cinfo) {
+    // libjpeg calls this only when the whole buffer is full
+    vector_destination_mgr *dest = (vector_destination_mgr *) cinfo->dest;
+    size_t used = dest->buffer->size();
+    dest->buffer->resize(used * 2);
+    dest->pub.next_output_byte = dest->buffer->data() + used;
+    dest->pub.free_in_buffer = dest->buffer->size() - used;
+    return TRUE;
+}
+
+void term_vector_destination(j_compress_ptr cinfo) {
+    vector_destination_mgr *dest = (vector_destination_mgr *) cinfo->dest;
+    dest->length = dest->buffer->size() - dest->pub.free_in_buffer;
+}
+
+
+/*
+ * Offset of the first byte of entropy coded data, i.e. the end of the SOS
+ * segment, or 0 if the data is not a well formed jpeg.
+ * The offset of the image height in the SOF segment is stored in sofHeight.
+ */
+size_t findScanData(const JOCTET *data, size_t length, size_t& sofHeight) {
+    size_t at = 2; // SOI
+    while (at + 4 <= length) {
+        if (data[at] != 0xFF) {
+            return 0;
+        }
+        JOCTET marker = data[at + 1];
+        size_t segment = (data[at + 2] << 8) | data[at + 3];
+        if (marker >= 0xC0 && marker <= 0xC2) {
+            sofHeight = at + 5;
+        }
+        at += 2 + segment;
+        if (marker == 0xDA) {
+            return (at <= length) ? at : 0;
+        }
+    }
+    return 0;
+}
+
+
+class StripEncoder {
+public:
+    struct jpeg_compress_struct cinfo;
+    struct compress_error_mgr jerr;
+    vector_destination_mgr dest;
+    std::vector<JOCTET> buffer;
+    std::vector<JSAMPROW> rows;
+
+    StripEncoder() {
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = compress_error_exit;
+        jpeg_create_compress(&cinfo);
+        dest.pub.init_destination = init_vector_destination;
+        dest.pub.empty_output_buffer = empty_vector_output_buffer;
+        dest.pub.term_destination = term_vector_destination;
+        dest.buffer = &buffer;
+        dest.length = 0;
+        cinfo.dest = &dest.pub;
+    }
+
+    StripEncoder(const StripEncoder&) = delete;
+    StripEncoder& operator=(const StripEncoder&) = delete;
+
+    ~StripEncoder() {
+        jpeg_destroy_compress(&cinfo);
+    }
+
+    bool encode(const unsigned char *data, int width, int height,
+                size_t rowSize, bool mono, int quality, int hSamp, int vSamp,
+                unsigned int restartInterval, const std::string& envelope) {
+        rows.resize(height);
+        for (int r = 0; r < height; r++) {
+            rows[r] = (JSAMPROW)(data + r * rowSize);
+        }
+
+        if (setjmp(jerr.setjmp_buffer)) {
+            jpeg_abort_compress(&cinfo);
+            return false;
+        }
+
+        cinfo.image_width = width;
+        cinfo.image_height = height;
+        if (!mono) {
+            cinfo.in_color_space = JCS_RGB;
+            cinfo.input_components = 3;
+        } else {
+            cinfo.in_color_space = JCS_GRAYSCALE;
+            cinfo.input_components = 1;
+        }
+        jpeg_set_defaults(&cinfo);
+        jpeg_set_quality(&cinfo, quality, TRUE);
+        if (!mono) {
+            cinfo.comp_info[0].h_samp_factor = hSamp;
+            cinfo.comp_info[0].v_samp_factor = vSamp;
+        }
+        cinfo.restart_interval = restartInterval;
+
+        jpeg_start_compress(&cinfo, TRUE);
+        if (!envelope.empty()) {
+            jpeg_write_marker(&cinfo, JPEG_COM, reinterpret_cast<const JOCTET*>(envelope.c_str()), envelope.length() + 1);
+        }
+        while (cinfo.next_scanline < cinfo.image_height) {
+            jpeg_write_scanlines(&cinfo, rows.data() + cinfo.next_scanline,
+                                 cinfo.image_height - cinfo.next_scanline);
+        }
+        jpeg_finish_compress(&cinfo);
+        return true;
+    }
+};
+
+} // namespace
+
+
+class MjpegCompressionHelper {
+public:
+    int quality;
+    int hSamp;
+    int vSamp;
+    int threads;
+
+    std::vector<std::unique_ptr<StripEncoder>> encoders;
+    std::vector<JOCTET> output;
+
+    // strip workers, encoder 0 is used by the calling thread
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    unsigned long generation;
+    int running;
+    bool stopping;
+
+    struct {
+        const unsigned char *data;
+        int width;
+        int height;
+        size_t rowSize;
+        bool mono;
+        int stripRows;
+        unsigned int restartInterval;
+    } job;
+    std::vector<char> results;
+
+    MjpegCompressionHelper() :
+            quality(75),
+            hSamp(2),
+            vSamp(2),
+            threads(1),
+            generation(0),
+            running(0),
+            stopping(false),
+            job()
+    {
+    }
+
+    ~MjpegCompressionHelper() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        started.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    bool encodeStrip(size_t index, const std::string& envelope) {
+        int first = (int)index * job.stripRows;
+        int rows = std::min(job.stripRows, job.height - first);
+        return encoders[index]->encode(job.data + first * job.rowSize,
+                                       job.width, rows, job.rowSize,
+                                       job.mono, quality, hSamp, vSamp,
+                                       job.restartInterval, envelope);
+    }
+
+    void work(size_t index) {
+        static const std::string noEnvelope;
+        unsigned long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                started.wait(lock, [&]{ return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            // Strips beyond the current job are not encoded
+            bool ok = true;
+            bool active = (int)index * job.stripRows < job.height;
+            if (active) {
+                ok = encodeStrip(index, noEnvelope);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            results[index] = ok;
+            if (--running == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+    void reserve(size_t strips) {
+        while (encoders.size() < strips) {
+            encoders.emplace_back(new StripEncoder);
+        }
+        results.resize(encoders.size());
+        while (workers.size() + 1 < strips) {
+            workers.emplace_back(&MjpegCompressionHelper::work, this, workers.size() + 1);
+        }
+    }
+
+    bool compress(const Image& img, const std::string& envelope, Bytes& result) {
+        job.data = img.getRawImage();
+        job.width = (int)img.width();
+        job.height = (int)img.height();
+        job.rowSize = img.getRowSize();
+        job.mono = (img.getPixelCode() == VOCAB_PIXEL_MONO);
+
+        // Strips must contain whole MCU rows, and a single restart interval
+        int mcuWidth = job.mono ? 8 : 8 * hSamp;
+        int mcuHeight = job.mono ? 8 : 8 * vSamp;
+        int mcuRows = (job.height + mcuHeight - 1) / mcuHeight;
+        int mcuPerRow = (job.width + mcuWidth - 1) / mcuWidth;
+        int strips = std::max(1, std::min(threads, mcuRows));
+        int stripMcuRows = (mcuRows + strips - 1) / std::max(1, strips);
+        if (strips > 1) {
+            strips = (mcuRows + stripMcuRows - 1) / stripMcuRows;
+        }
+        if (strips <= 1 || (long)stripMcuRows * mcuPerRow > 65535) {
+            reserve(1);
+            job.stripRows = job.height;
+            job.restartInterval = 0;
+            if (!encodeStrip(0, envelope)) {
+                return false;
+            }
+            result = Bytes((char*)encoders[0]->buffer.data(), encoders[0]->dest.length);
+            return true;
+        }
+
+        reserve(strips);
+        job.stripRows = stripMcuRows * mcuHeight;
+        job.restartInterval = stripMcuRows * mcuPerRow;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = (int)workers.size();
+            generation++;
+        }
+        started.notify_all();
+        bool ok = encodeStrip(0, envelope);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&]{ return running == 0; });
+        }
+        for (int i = 1; i < strips; i++) {
+            ok = ok && results[i];
+        }
+        if (!ok) {
+            return false;
+        }
+
+        // Join the strips: headers of the first strip, with the full image
+        // height, followed by the scan data of all the strips separated by
+        // restart markers.
+        output.clear();
+        for (int i = 0; i < strips; i++) {
+            const StripEncoder& enc = *encoders[i];
+            const JOCTET *data = enc.buffer.data();
+            size_t length = enc.dest.length;
+            size_t sofHeight = 0;
+            size_t scan = findScanData(data, length, sofHeight);
+            if (scan == 0 || length < scan + 2 || sofHeight == 0) {
+                yError("mjpeg: cannot join jpeg strips");
+                return false;
+            }
+            if (i == 0) {
+                output.insert(output.end(), data, data + length - 2);
+                output[sofHeight] = (JOCTET)(job.height >> 8);
+                output[sofHeight + 1] = (JOCTET)(job.height & 0xFF);
+            } else {
+                output.push_back(0xFF);
+                output.push_back((JOCTET)(JPEG_RST0 + ((i - 1) & 7)));
+                output.insert(output.end(), data + scan, data + length - 2);
+            }
+        }
+        output.push_back(0xFF);
+        output.push_back((JOCTET)JPEG_EOI);
+        result = Bytes((char*)output.data(), output.size());
+        return true;
+    }
+};
+
+#define HELPER(x) (*((MjpegCompressionHelper*)(x)))
+
+MjpegCompression::MjpegCompression() {
+    system_resource = new MjpegCompressionHelper;
+    yAssert(system_resource!=nullptr);
+}
+
+MjpegCompression::~MjpegCompression() {
+    if (system_resource!=nullptr) {
+        delete &HELPER(system_resource);
+        system_resource = nullptr;
+    }
+}
+
+void MjpegCompression::setQuality(int quality) {
+    HELPER(system_resource).quality = std::max(1, std::min(100, quality));
+}
+
+bool MjpegCompression::setSubsampling(const std::string& subsampling) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    if (subsampling == "444") {
+        helper.hSamp = 1;
+        helper.vSamp = 1;
+    } else if (subsampling == "422") {
+        helper.hSamp = 2;
+        helper.vSamp = 1;
+    } else if (subsampling == "420") {
+        helper.hSamp = 2;
+        helper.vSamp = 2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void MjpegCompression::setThreads(int threads) {
+    HELPER(system_resource).threads = std::max(1, threads);
+}
+
+bool MjpegCompression::compress(const Image& image,
+                                const std::string& envelope,
+                                Bytes& result) {
+    MjpegCompressionHelper& helper = HELPER(system_resource);
+    return helper.compress(image, envelope, result);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP2_MJPEGCOMPRESSION_INC
+#define YARP2_MJPEGCOMPRESSION_INC
+
+#include <yarp/os/Bytes.h>
+#include <yarp/sig/Image.h>
+
+#include <string>
+
+namespace yarp {
+    namespace mjpeg {
+        class MjpegCompression;
+    }
+}
+
+/**
+ * Persistent jpeg encoder, one for each mjpeg connection.
+ *
+ * The libjpeg contexts and the output buffers are created once and reused
+ * for all the frames. When more than one thread is requested, the image
+ * is split in horizontal strips, each strip is encoded by a different
+ * thread and the strips are joined in a single jpeg using restart markers.
+ */
+class yarp::mjpeg::MjpegCompression {
+private:
+    void *system_resource;
+public:
+    MjpegCompression();
+
+    virtual ~MjpegCompression();
+
+    /**
+     * Set the jpeg quality, between 1 and 100 (default 75).
+     */
+    void setQuality(int quality);
+
+    /**
+     * Set the chroma subsampling, one of "444", "422" or "420"
+     * (default "420").
+     */
+    bool setSubsampling(const std::string& subsampling);
+
+    /**
+     * Set the number of threads used to encode a frame (default 1).
+     */
+    void setThreads(int threads);
+
+    /**
+     * Compress an image.  The result points to an internal buffer, that
+     * is valid until the next call.
+     */
+    bool compress(const yarp::sig::Image& image,
+                  const std::string& envelope,
+                  yarp::os::Bytes& result);
+};
+
+#endif
@@ -14,6 +14,7 @@
 #include <csetjmp>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #if defined(_WIN32)
 #define INT32 long  // jpeg's definition
@@ -116,14 +117,17 @@ void jpeg_net_src (j_decompress_ptr cinfo, char *buf, int buflen) {
 class MjpegDecompressionHelper {
 public:
     bool active;
+    bool pending;
     struct jpeg_decompress_struct cinfo;
     struct net_error_mgr jerr;
     JOCTET error_buffer[4];
+    std::vector<JSAMPROW> rows;
     yarp::os::InputStream::readEnvelopeCallbackType readEnvelopeCallback;
     void* readEnvelopeCallbackData;
 
     MjpegDecompressionHelper() :
             active(false),
+            pending(false),
             readEnvelopeCallback(nullptr),
             readEnvelopeCallbackData(nullptr)
     {
@@ -142,56 +146,83 @@ public:
     void init() {
         jpeg_create_decompress(&cinfo);
     }
-    bool decompress(const Bytes& cimg, FlexImage& img) {
+    bool readHeader(const Bytes& cimg, FlexImage& img) {
         bool debug = false;
 
         if (!active) {
             init();
             active = true;
         }
+        if (pending) {
+            jpeg_abort_decompress(&cinfo);
+            pending = false;
+        }
         cinfo.client_data = &error_buffer;
         cinfo.err = jpeg_std_error(&jerr.pub);
         jerr.pub.error_exit = net_error_exit;
 
         if (setjmp(jerr.setjmp_buffer)) {
-            jpeg_finish_decompress(&cinfo);
+            jpeg_abort_decompress(&cinfo);
             return false;
         }
 
         jpeg_net_src(&cinfo,(char*)cimg.get(),cimg.length());
         jpeg_save_markers(&cinfo, JPEG_COM, 0xFFFF);
         jpeg_read_header(&cinfo, TRUE);
-        jpeg_calc_output_dimensions(&cinfo);
 
         if(cinfo.jpeg_color_space == JCS_GRAYSCALE) {
             img.setPixelCode(VOCAB_PIXEL_MONO);
+            cinfo.out_color_space = JCS_GRAYSCALE;
         }
         else
         {
             img.setPixelCode(VOCAB_PIXEL_RGB);
+            cinfo.out_color_space = JCS_RGB;
         }
+        jpeg_calc_output_dimensions(&cinfo);
 
         if (debug) printf("Got image %dx%d\n", cinfo.output_width, cinfo.output_height);
         img.resize(cinfo.output_width,cinfo.output_height);
-        jpeg_start_decompress(&cinfo);
-        //int row_stride = cinfo.output_width * cinfo.output_components;
 
-        int at = 0;
-        while (cinfo.output_scanline < cinfo.output_height) {
-            JSAMPLE *lines[1];
-            lines[0] = (JSAMPLE*)(img.getPixelAddress(0,at));
-            jpeg_read_scanlines(&cinfo, lines, 1);
-            at++;
-        }
         if(readEnvelopeCallback && cinfo.marker_list && cinfo.marker_list->data_length > 0) {
             Bytes envelope(reinterpret_cast<char*>(cinfo.marker_list->data), cinfo.marker_list->data_length);
             readEnvelopeCallback(readEnvelopeCallbackData, envelope);
         }
-        if (debug) printf("Read image!\n");
+        pending = true;
+        return true;
+    }
+
+    bool readPixels(unsigned char* dest, size_t rowSize) {
+        if (!pending) {
+            return false;
+        }
+        pending = false;
+
+        if (setjmp(jerr.setjmp_buffer)) {
+            jpeg_abort_decompress(&cinfo);
+            return false;
+        }
+
+        jpeg_start_decompress(&cinfo);
+        rows.resize(cinfo.output_height);
+        for (size_t i = 0; i < rows.size(); i++) {
+            rows[i] = (JSAMPROW)(dest + i * rowSize);
+        }
+        while (cinfo.output_scanline < cinfo.output_height) {
+            jpeg_read_scanlines(&cinfo, rows.data() + cinfo.output_scanline,
+                                cinfo.output_height - cinfo.output_scanline);
+        }
         jpeg_finish_decompress(&cinfo);
         return true;
     }
 
+    bool decompress(const Bytes& cimg, FlexImage& img) {
+        if (!readHeader(cimg, img)) {
+            return false;
+        }
+        return readPixels(img.getRawImage(), img.getRowSize());
+    }
+
     void fini() {
         jpeg_destroy_decompress(&cinfo);
     }
@@ -225,6 +256,17 @@ bool MjpegDecompression::decompress(const yarp::os::Bytes& data,
     return helper.decompress(data, image);
 }
 
+bool MjpegDecompression::readHeader(const yarp::os::Bytes& data,
+                                    FlexImage &image) {
+    MjpegDecompressionHelper& helper = HELPER(system_resource);
+    return helper.readHeader(data, image);
+}
+
+bool MjpegDecompression::readPixels(unsigned char* dest, size_t rowSize) {
+    MjpegDecompressionHelper& helper = HELPER(system_resource);
+    return helper.readPixels(dest, rowSize);
+}
+
 bool MjpegDecompression::setReadEnvelopeCallback(InputStream::readEnvelopeCallbackType callback,
                                                  void* data)
 {
@@ -30,6 +30,20 @@ public:
     bool decompress(const yarp::os::Bytes& data,
                     yarp::sig::FlexImage& image);
 
+    /**
+     * Read the jpeg headers, and set pixel code and size of the image
+     * without decoding it.  The data must stay valid until readPixels()
+     * is called.
+     */
+    bool readHeader(const yarp::os::Bytes& data,
+                    yarp::sig::FlexImage& image);
+
+    /**
+     * Decode the image whose header was read by the last readHeader()
+     * call straight into dest, using rowSize bytes for each row.
+     */
+    bool readPixels(unsigned char* dest, size_t rowSize);
+
     bool isAutomatic() const;
 
     bool setReadEnvelopeCallback(yarp::os::InputStream::readEnvelopeCallbackType callback,
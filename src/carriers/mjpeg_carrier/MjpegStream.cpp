@@ -26,8 +26,23 @@ yarp::conf::ssize_t MjpegStream::read(Bytes& b) {
     if (remaining==0) {
         if (phase==1) {
             phase = 2;
+            int size = (int)img.getRawImageSize();
+            if (decodePending) {
+                // The image is usually read in a single call, straight into
+                // its final storage: decode there and save a copy.
+                decodePending = false;
+                if ((int)b.length()>=size) {
+                    if (!decompression.readPixels((unsigned char*)b.get(), img.getRowSize())) {
+                        yError("Skipping a problematic JPEG frame");
+                    }
+                    return size;
+                }
+                if (!decompression.readPixels(img.getRawImage(), img.getRowSize())) {
+                    yError("Skipping a problematic JPEG frame");
+                }
+            }
             cursor = (char*)(img.getRawImage());
-            remaining = img.getRawImageSize();
+            remaining = size;
         } else if (phase==3) {
             phase = 4;
             cursor = nullptr;
@@ -80,7 +95,8 @@ yarp::conf::ssize_t MjpegStream::read(Bytes& b) {
         if (autocompress) {
             cimg.allocate(len);
             delegate->getInputStream().readFull(cimg.bytes());
-            if (!decompression.decompress(cimg.bytes(), img)) {
+            decodePending = decompression.readHeader(cimg.bytes(), img);
+            if (!decodePending) {
                 if (delegate->getInputStream().isOk()) {
                     yError("Skipping a problematic JPEG frame");
                 }
@@ -45,6 +45,7 @@ private:
     char *cursor;
     int remaining;
     bool autocompress;
+    bool decodePending;
     yarp::os::Bytes envelope;
 public:
     MjpegStream(TwoWayStream *delegate, bool autocompress) :
@@ -53,7 +54,8 @@ public:
             phase(0),
             cursor(NULL),
             remaining(0),
-            autocompress(autocompress)
+            autocompress(autocompress),
+            decodePending(false)
     {}
 
     virtual ~MjpegStream() {
@@ -7,6 +7,8 @@
  */
 
 #include <yarp/os/Log.h>
+#include <algorithm>
+#include <map>
 #include <string>
 
 #ifdef WITH_YARPMATH
@@ -79,6 +81,10 @@ bool PriorityCarrier::configure(yarp::os::ConnectionState& proto) {
     excitation = options.findGroup("ex");
     isVirtual = options.check("virtual");
 
+    getPeers().lock();
+    group->invalidate();
+    getPeers().unlock();
+
 #ifdef WITH_PRIORITY_DEBUG
     if(options.check("debug"))
     {
@@ -201,23 +207,15 @@ double PriorityCarrier::getActualInput(double t)
         return 0.0;
 
     double E = 0;
-    for (PriorityGroup::iterator it = group->peerSet.begin(); it!=group->peerSet.end(); it++)
+    if(groupIndex < group->links.size())
     {
-        PriorityCarrier *peer = it->first;
-        if(peer != this)
+        const std::vector<std::pair<size_t, double> >& inputs = group->links[groupIndex];
+        for(size_t i=0; i<inputs.size(); i++)
         {
-            for(size_t i=0; i<peer->excitation.size(); i++)
-            {
-                Value v = peer->excitation.get(i);
-                if(v.isList() && (v.asList()->size()>=2))
-                {
-                    Bottle* b = v.asList();
-                    // an exitatory to this priority carrier
-                    if(sourceName == b->get(0).asString().c_str())
-                        E += peer->getActualInput(t) * (b->get(1).asFloat64()/10.0);
-                }
-            }
-
+            // an exitatory to this priority carrier
+            PriorityCarrier *peer = group->peers[inputs[i].first];
+            if(peer != this)
+                E += peer->getActualInput(t) * inputs[i].second;
         }
     }
     E += baias;
@@ -230,69 +228,142 @@ double PriorityCarrier::getActualInput(double t)
  * Class PriorityGroup
  */
 
-bool PriorityGroup::recalculate(double t)
+PriorityGroup::PriorityGroup() :
+        compiled(false),
+        stale(true)
 {
-#ifdef WITH_YARPMATH
-    //TODO: find the correct way to get the size of peerSet
-    int nConnections = 0;
-    for(PriorityGroup::iterator it=peerSet.begin(); it!=peerSet.end(); it++)
-        nConnections++;
+}
 
-    // calculate matrices X, B, InvA and Y
-    X.resize(nConnections, 1);
-    B.resize(nConnections, 1);
-    Y.resize(nConnections, 1);
-    InvA.resize(nConnections, nConnections);
-    InvA.eye();
+void PriorityGroup::add(PriorityCarrier *entity)
+{
+    PeerRecord<PriorityCarrier>::add(entity);
+    compiled = false;
+}
 
-    int row = 0;
-    for(PriorityGroup::iterator rowItr=peerSet.begin(); rowItr!=peerSet.end(); rowItr++)
+void PriorityGroup::remove(PriorityCarrier *entity)
+{
+    PeerRecord<PriorityCarrier>::remove(entity);
+    compiled = false;
+}
+
+// The parameters of a peer changed, its links must be compiled again.
+void PriorityGroup::invalidate()
+{
+    compiled = false;
+}
+
+// Resolves the excitatory links, given by source name, into peer indices.
+void PriorityGroup::compile()
+{
+    peers.clear();
+    for(PriorityGroup::iterator it=peerSet.begin(); it!=peerSet.end(); it++)
     {
-        PriorityCarrier *peer = rowItr->first;
-        // call 'getActualStimulation' to update 'isActive'
-        peer->getActualStimulation(t);
-        double xi = (peer->isActive) ? STIMUL_THRESHOLD : 0.0;
-        B(row,0) = peer->baias * xi;
-        X(row,0) = xi;
+        it->first->groupIndex = peers.size();
+        peers.push_back(it->first);
+    }
+    size_t n = peers.size();
 
-        int col = 0;
-        for(PriorityGroup::iterator colItr=peerSet.begin(); colItr!=peerSet.end(); colItr++)
+    std::multimap<std::string, size_t> sources;
+    for(size_t i=0; i<n; i++)
+        sources.insert(std::make_pair(peers[i]->sourceName, i));
+
+    std::vector<std::map<size_t, double> > weights(n);
+    for(size_t j=0; j<n; j++)
+    {
+        const Bottle& excitation = peers[j]->excitation;
+        for(size_t k=0; k<excitation.size(); k++)
         {
-            PriorityCarrier *peerCol = colItr->first;
-            for(size_t i=0; i<peerCol->excitation.size(); i++)
+            Value v = excitation.get(k);
+            if(v.isList() && (v.asList()->size()>=2))
             {
-                Value v = peerCol->excitation.get(i);
-                if(v.isList() && (v.asList()->size()>=2))
-                {
-                    Bottle* b = v.asList();
-                    // an exitatory link to this connection
-                    if(peer->sourceName == b->get(0).asString().c_str())
-                        InvA(row,col) = -(b->get(1).asFloat64()/10.0)*xi;
-                }
+                Bottle* b = v.asList();
+                // an exitatory link from the peer j to the peers of this source
+                std::pair<std::multimap<std::string, size_t>::iterator,
+                          std::multimap<std::string, size_t>::iterator> range;
+                range = sources.equal_range(b->get(0).asString());
+                for(std::multimap<std::string, size_t>::iterator it=range.first; it!=range.second; it++)
+                    weights[it->second][j] = b->get(1).asFloat64()/10.0;
             }
-            col++;
         }
-        row++;
     }
 
-    //fprintf(stdout, "A:\n %s\n", InvA.toString(1).c_str());
+    links.assign(n, std::vector<std::pair<size_t, double> >());
+    for(size_t i=0; i<n; i++)
+        links[i].assign(weights[i].begin(), weights[i].end());
 
-    // calclulating the determinant
-    double determinant = yarp::math::det(InvA);
-    if(determinant == 0)
+    active.assign(n, 0);
+    Y.assign(n, 0.0);
+    reducedIndex.assign(n, -1);
+    compiled = true;
+    stale = true;
+}
+
+bool PriorityGroup::recalculate(double t)
+{
+#ifdef WITH_YARPMATH
+    if(!compiled)
+        compile();
+
+    // x(t) changes only when a peer enters or leaves the active state,
+    // and the network is solved again only in that case.
+    for(size_t i=0; i<peers.size(); i++)
     {
-        yError("Inconsistent regulation! non-invertible weight matrix");
-        return false;
+        // call 'getActualStimulation' to update 'isActive'
+        peers[i]->getActualStimulation(t);
+        char xi = (peers[i]->isActive) ? 1 : 0;
+        if(active[i] != xi)
+        {
+            active[i] = xi;
+            stale = true;
+        }
+    }
+    if(!stale)
+        return true;
+
+    // The rows of (I-A) of the inactive peers are the identity and their
+    // biases are zero, so their output is zero and only the active peers
+    // are solved.
+    activeRows.clear();
+    for(size_t i=0; i<peers.size(); i++)
+    {
+        reducedIndex[i] = (active[i]) ? static_cast<int>(activeRows.size()) : -1;
+        if(active[i])
+            activeRows.push_back(i);
     }
 
-    // inverting the weight matrix
-    InvA = yarp::math::luinv(InvA);
-    Y = InvA * B;
+    std::fill(Y.begin(), Y.end(), 0.0);
+    size_t nActive = activeRows.size();
+    if(nActive > 0)
+    {
+        yarp::sig::Matrix A(nActive, nActive);
+        yarp::sig::Vector B(nActive);
+        A.eye();
+        for(size_t row=0; row<nActive; row++)
+        {
+            size_t i = activeRows[row];
+            B[row] = peers[i]->baias * STIMUL_THRESHOLD;
+            for(size_t l=0; l<links[i].size(); l++)
+            {
+                int col = reducedIndex[links[i][l].first];
+                if(col >= 0)
+                    A(row,col) -= links[i][l].second * STIMUL_THRESHOLD;
+            }
+        }
 
-    //fprintf(stdout, "X:\n %s\n", X.toString(1).c_str());
-    //fprintf(stdout, "B:\n %s\n", B.toString(1).c_str());
-    //fprintf(stdout, "Y:\n %s\n", Y.toString(1).c_str());
+        // calclulating the determinant
+        double determinant = yarp::math::det(A);
+        if(determinant == 0)
+        {
+            yError("Inconsistent regulation! non-invertible weight matrix");
+            return false;
+        }
+
+        yarp::sig::Vector y = yarp::math::luinv(A) * B;
+        for(size_t row=0; row<nActive; row++)
+            Y[activeRows[row]] = y[row];
+    }
 
+    stale = false;
     return true;
 #else
     return false;
@@ -313,13 +384,12 @@ bool PriorityGroup::acceptIncomingData(yarp::os::ConnectionReader& reader,
     if(!recalculate(tNow))
         return false;
 
-    int row = 0;
     PriorityCarrier *maxPeer = nullptr;
     double maxStimuli = 0.0;
-    for(PriorityGroup::iterator it=peerSet.begin(); it!=peerSet.end(); it++)
+    for(size_t i=0; i<peers.size(); i++)
     {
-        PriorityCarrier *peer = it->first;
-        double output = Y(row,0) * X(row,0);
+        PriorityCarrier *peer = peers[i];
+        double output = (active[i]) ? Y[i] * STIMUL_THRESHOLD : 0.0;
         peer->yi = output;      // only for debug purpose
 
         if(!peer->isVirtual)
@@ -330,19 +400,21 @@ bool PriorityGroup::acceptIncomingData(yarp::os::ConnectionReader& reader,
                 maxPeer = peer;
             }
         }
-        row++;
     }
     accept = (maxPeer == source);
 
 #else
+    if(!compiled)
+        compile();
+
     // first checks whether actual input signal is positive or not
     double actualInput = source->getActualInput(tNow);
     accept = (actualInput > 0);
     if(accept)
     {
-        for (PriorityGroup::iterator it = peerSet.begin(); it!=peerSet.end(); it++)
+        for(size_t i=0; i<peers.size(); i++)
         {
-            PriorityCarrier *peer = it->first;
+            PriorityCarrier *peer = peers[i];
             if(peer != source)
             {
                 if(actualInput < peer->getActualInput(tNow))
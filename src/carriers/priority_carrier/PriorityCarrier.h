@@ -10,6 +10,8 @@
 #define PRIORITYCARRIER_INC
 
 #include <cmath>
+#include <utility>
+#include <vector>
 #include <yarp/os/ModifyingCarrier.h>
 #include <yarp/os/Election.h>
 #include <yarp/os/NullConnectionReader.h>
@@ -40,21 +42,37 @@ namespace yarp {
  *
  * Manager for priority-aware inputs to a given port.
  *
+ * The excitatory links between the peers are compiled into an indexed
+ * sparse structure when the set of peers or their parameters change, and
+ * the network is solved again only when the set of active peers changes.
+ *
  */
 class yarp::os::PriorityGroup : public PeerRecord<PriorityCarrier> {
 public:
+    PriorityGroup();
     virtual ~PriorityGroup() {}
+    void add(PriorityCarrier *entity);
+    void remove(PriorityCarrier *entity);
+    void invalidate();
     virtual bool acceptIncomingData(yarp::os::ConnectionReader& reader,
                                     PriorityCarrier *source);
     bool recalculate(double t);
 
+private:
+    void compile();
+
 public:
-    yarp::sig::Matrix InvA;         // the inverse of matrix (I-A) in the equation y(t) = [(I-A)^(-1) * B] .*x(t)
-    yarp::sig::Matrix B;            // matrix of biases B in the equation y(t) = [(I-A)^(-1) * B] .*x(t)
-    yarp::sig::Matrix Y;            // matrix y(t)
-    yarp::sig::Matrix X;            // matrix x(t)
-    //yarp::os::Semaphore semDebug;   // this semaphor is used only when debug mode is active
-                                    // to control the access to matrices from debug thread
+    std::vector<PriorityCarrier*> peers;    // the peers, in the same order of peerSet
+    std::vector<std::vector<std::pair<size_t, double> > > links;
+                                            // links[i] lists the peers j exciting the peer i, with weight e(i,j)
+    std::vector<char> active;               // x(t) of each peer, for the current solution
+    std::vector<double> Y;                  // y(t) = [(I-A)^(-1) * B] for the current active set
+
+private:
+    bool compiled;                          // false if the links must be compiled again
+    bool stale;                             // false if Y is the solution for the current active set
+    std::vector<size_t> activeRows;         // indices of the active peers
+    std::vector<int> reducedIndex;          // index of each peer among the active ones, or -1
 };
 
 
@@ -97,6 +115,7 @@ public:
 #endif //WITH_PRIORITY_DEBUG
     {
         group = 0/*NULL*/;
+        groupIndex = 0;
         timeConstant = timeArrival = 0;
         timeResting = 0;
         stimulation = 0;
@@ -167,6 +186,11 @@ public:
         isVirtual = property.check("virtual", Value(isVirtual)).asBool();
         if(property.check("ex"))
             excitation = property.findGroup("ex");
+        if(group) {
+            getPeers().lock();
+            group->invalidate();
+            getPeers().unlock();
+        }
     }
 
     virtual void getCarrierParams(yarp::os::Property& params) const override {
@@ -191,6 +215,7 @@ public:
     double baias;                   // baias value for excitation
     Bottle excitation;              // a list of exitatory signals as (name, value)
     std::string sourceName;
+    size_t groupIndex;              // index of this carrier in the peers of its group
 
     double yi;                      // this is set in the recalculate() for the debug purpose
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "VideoCarrier.h"
+#include "VideoFrameHeader.h"
+
+#include <yarp/os/Log.h>
+#include <yarp/os/Name.h>
+#include <yarp/sig/Image.h>
+
+#include "WireImage.h"
+
+#include <cstdlib>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace yarp::video;
+
+static const char *videoHeader = "YARP_VID";
+
+void VideoCarrier::getHeader(Bytes& header) const {
+    for (size_t i=0; i<8 && i<header.length(); i++) {
+        header.get()[i] = videoHeader[i];
+    }
+}
+
+bool VideoCarrier::checkHeader(const Bytes& header) {
+    if (header.length()!=8) {
+        return false;
+    }
+    for (size_t i=0; i<8; i++) {
+        if (header.get()[i] != videoHeader[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VideoCarrier::configureEncoder(const std::string& carrierName) {
+    Name n(carrierName + "://test");
+    bool hasOption = false;
+    std::string value = n.getCarrierModifier("codec", &hasOption);
+    if (hasOption) {
+        codec = value;
+    }
+    if (!encoder.setCodec(codec)) {
+        yError("video: unknown codec %s, expected h264 or h265", codec.c_str());
+        return false;
+    }
+    value = n.getCarrierModifier("bitrate", &hasOption);
+    if (hasOption) {
+        encoder.setBitrate(atoi(value.c_str()));
+    }
+    value = n.getCarrierModifier("gop", &hasOption);
+    if (hasOption) {
+        encoder.setGop(atoi(value.c_str()));
+    }
+    value = n.getCarrierModifier("preset", &hasOption);
+    if (hasOption) {
+        encoder.setPreset(value);
+    }
+    value = n.getCarrierModifier("tune", &hasOption);
+    if (hasOption) {
+        encoder.setTune(value);
+    }
+    return true;
+}
+
+bool VideoCarrier::sendHeader(ConnectionState& proto) {
+    if (!configureEncoder(proto.getRoute().getCarrierName())) {
+        return false;
+    }
+    if (!defaultSendHeader(proto)) {
+        return false;
+    }
+    // the receiver needs to know which decoder to use
+    std::string line = codec + "\r\n";
+    Bytes b((char*)line.c_str(), line.length());
+    proto.os().write(b);
+    proto.os().flush();
+    return proto.os().isOk();
+}
+
+bool VideoCarrier::expectExtraHeader(ConnectionState& proto) {
+    codec = proto.is().readLine();
+    if (!codec.empty() && codec[codec.length()-1] == '\r') {
+        codec.erase(codec.length()-1);
+    }
+    return proto.is().isOk();
+}
+
+bool VideoCarrier::respondToHeader(ConnectionState& proto) {
+    stream = new VideoStream(proto.giveStreams(), codec);
+    proto.takeStreams(stream);
+    return true;
+}
+
+bool VideoCarrier::write(ConnectionState& proto, SizedWriter& writer) {
+    WireImage rep;
+    FlexImage *img = rep.checkForImage(writer);
+    if (img==nullptr) {
+        yError("video: only images can be sent through this carrier");
+        return false;
+    }
+
+    Bytes packet;
+    bool ok = encoder.encode(*img, packet);
+    if (!ok) {
+        envelope.clear();
+        return false;
+    }
+
+    VideoFrameHeader header;
+    header.packetLen = (int)packet.length();
+    header.width = (int)img->width();
+    header.height = (int)img->height();
+    header.pixelCode = VideoEncoder::transmittedPixelCode(img->getPixelCode());
+    header.envelopeLen = (int)envelope.length();
+    Bytes hbuf((char*)&header, sizeof(header));
+    proto.os().write(hbuf);
+    proto.os().write(packet);
+    if (!envelope.empty()) {
+        Bytes ebuf((char*)envelope.c_str(), envelope.length());
+        proto.os().write(ebuf);
+        envelope.clear();
+    }
+    proto.os().flush();
+    return proto.os().isOk();
+}
+
+bool VideoCarrier::expectIndex(ConnectionState& proto) {
+    if (stream==nullptr) {
+        return false;
+    }
+    size_t length = 0;
+    if (!stream->readFrame(length)) {
+        return false;
+    }
+    proto.setRemainingLength((int)length);
+    return true;
+}
+
+bool VideoCarrier::sendAck(ConnectionState& proto) {
+    // a single byte, asking for a keyframe if the stream cannot be decoded
+    char request = (stream!=nullptr && stream->takeKeyframeRequest()) ? 1 : 0;
+    Bytes b(&request, 1);
+    proto.os().write(b);
+    proto.os().flush();
+    return proto.os().isOk();
+}
+
+bool VideoCarrier::expectAck(ConnectionState& proto) {
+    char request = 0;
+    Bytes b(&request, 1);
+    if (proto.is().readFull(b) != 1) {
+        return false;
+    }
+    if (request != 0) {
+        encoder.requestKeyframe();
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_VIDEOCARRIER_INC
+#define YARP_VIDEOCARRIER_INC
+
+#include <yarp/os/AbstractCarrier.h>
+
+#include "VideoEncoder.h"
+#include "VideoStream.h"
+
+#include <string>
+
+namespace yarp {
+    namespace os {
+        class VideoCarrier;
+    }
+}
+
+/**
+ * A carrier that compresses images with a software H.264 or H.265
+ * encoder at the sender, and decodes them at the receiver straight into
+ * the image read.  Each connection has its own encoder:
+ *
+ *   yarp connect /cam /viewer video+codec.h264+bitrate.2000+gop.30
+ *
+ * Options: codec (h264 or h265), bitrate (kbit/s, constant quality if
+ * not given), gop (frames between keyframes), preset and tune of the
+ * encoder (default veryfast and zerolatency).  When the receiver cannot
+ * decode a frame it asks for a keyframe in the acknowledgement.
+ */
+class yarp::os::VideoCarrier : public AbstractCarrier {
+private:
+    std::string envelope;
+    std::string codec;
+    yarp::video::VideoEncoder encoder;
+    VideoStream *stream;
+
+    bool configureEncoder(const std::string& carrierName);
+public:
+    VideoCarrier() : codec("h264"), stream(nullptr) {
+    }
+
+    virtual Carrier *create() const override {
+        return new VideoCarrier();
+    }
+
+    virtual std::string getName() const override {
+        return "video";
+    }
+
+    virtual bool isConnectionless() const override {
+        return false;
+    }
+
+    virtual bool canEscape() const override {
+        return false;
+    }
+
+    virtual bool requireAck() const override {
+        return true;
+    }
+
+    virtual bool supportReply() const override {
+        return false;
+    }
+
+    virtual std::string toString() const override {
+        return "video_carrier";
+    }
+
+    virtual void handleEnvelope(const std::string& envelope) override {
+        this->envelope = envelope;
+    }
+
+    virtual void getHeader(Bytes& header) const override;
+
+    virtual bool checkHeader(const Bytes& header) override;
+
+    virtual bool sendHeader(ConnectionState& proto) override;
+
+    virtual bool expectExtraHeader(ConnectionState& proto) override;
+
+    virtual bool respondToHeader(ConnectionState& proto) override;
+
+    virtual bool write(ConnectionState& proto, SizedWriter& writer) override;
+
+    virtual bool expectIndex(ConnectionState& proto) override;
+
+    virtual bool sendAck(ConnectionState& proto) override;
+
+    virtual bool expectAck(ConnectionState& proto) override;
+};
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef __STDC_CONSTANT_MACROS
+#define __STDC_CONSTANT_MACROS
+#endif
+
+#include "VideoDecoder.h"
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Image.h>
+
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+using namespace yarp::os;
+using namespace yarp::video;
+
+namespace {
+
+AVPixelFormat targetFormat(int pixelCode) {
+    switch (pixelCode) {
+    case VOCAB_PIXEL_MONO: return AV_PIX_FMT_GRAY8;
+    case VOCAB_PIXEL_RGB: return AV_PIX_FMT_RGB24;
+    case VOCAB_PIXEL_BGR: return AV_PIX_FMT_BGR24;
+    case VOCAB_PIXEL_RGBA: return AV_PIX_FMT_RGBA;
+    case VOCAB_PIXEL_BGRA: return AV_PIX_FMT_BGRA;
+    default: return AV_PIX_FMT_NONE;
+    }
+}
+
+} // namespace
+
+class VideoDecoderHelper {
+public:
+    std::string codecName;
+    AVCodecContext *context;
+    AVPacket *packet;
+    AVFrame *frame;
+    AVFrame *picture;
+    SwsContext *convert;
+    bool hasPicture;
+    std::vector<uint8_t> buffer;
+
+    VideoDecoderHelper() :
+            codecName("h264"),
+            context(nullptr),
+            packet(nullptr),
+            frame(nullptr),
+            picture(nullptr),
+            convert(nullptr),
+            hasPicture(false)
+    {
+    }
+
+    ~VideoDecoderHelper() {
+        close();
+        if (convert != nullptr) {
+            sws_freeContext(convert);
+            convert = nullptr;
+        }
+    }
+
+    void close() {
+        if (context != nullptr) {
+            avcodec_free_context(&context);
+        }
+        if (packet != nullptr) {
+            av_packet_free(&packet);
+        }
+        if (frame != nullptr) {
+            av_frame_free(&frame);
+        }
+        if (picture != nullptr) {
+            av_frame_free(&picture);
+        }
+        hasPicture = false;
+    }
+
+    bool open() {
+        close();
+        AVCodecID id = (codecName == "h265") ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264;
+        const AVCodec *codec = avcodec_find_decoder(id);
+        if (codec == nullptr) {
+            yError("video: no %s decoder available in libavcodec", codecName.c_str());
+            return false;
+        }
+        context = avcodec_alloc_context3(codec);
+        if (context == nullptr) {
+            return false;
+        }
+        // one packet in, one picture out
+        context->flags |= AV_CODEC_FLAG_LOW_DELAY;
+        if (avcodec_open2(context, codec, nullptr) < 0) {
+            yError("video: cannot open the %s decoder", codecName.c_str());
+            close();
+            return false;
+        }
+        packet = av_packet_alloc();
+        frame = av_frame_alloc();
+        picture = av_frame_alloc();
+        if (packet == nullptr || frame == nullptr || picture == nullptr) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    bool decode(const Bytes& data) {
+        if (context == nullptr && !open()) {
+            return false;
+        }
+        if (data.length() == 0) {
+            return false;
+        }
+        // the decoder reads past the end of the packet
+        buffer.assign(data.get(), data.get() + data.length());
+        buffer.resize(data.length() + AV_INPUT_BUFFER_PADDING_SIZE, 0);
+        packet->data = buffer.data();
+        packet->size = static_cast<int>(data.length());
+        int ret = avcodec_send_packet(context, packet);
+        packet->data = nullptr;
+        packet->size = 0;
+        if (ret < 0) {
+            return false;
+        }
+        bool decoded = false;
+        while (avcodec_receive_frame(context, frame) == 0) {
+            // keep only the most recent picture
+            av_frame_unref(picture);
+            av_frame_move_ref(picture, frame);
+            decoded = true;
+        }
+        hasPicture = hasPicture || decoded;
+        return decoded;
+    }
+
+    bool readPixels(unsigned char* dest, size_t rowSize, int pixelCode,
+                    size_t width, size_t height) {
+        AVPixelFormat format = targetFormat(pixelCode);
+        if (!hasPicture || format == AV_PIX_FMT_NONE ||
+            picture->width != static_cast<int>(width) ||
+            picture->height != static_cast<int>(height)) {
+            return false;
+        }
+        convert = sws_getCachedContext(convert,
+                                       picture->width, picture->height,
+                                       static_cast<AVPixelFormat>(picture->format),
+                                       picture->width, picture->height, format,
+                                       SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (convert == nullptr) {
+            return false;
+        }
+        uint8_t *dst[1] = { dest };
+        int stride[1] = { static_cast<int>(rowSize) };
+        sws_scale(convert, picture->data, picture->linesize, 0, picture->height, dst, stride);
+        return true;
+    }
+};
+
+#define HELPER(x) (*((VideoDecoderHelper*)(x)))
+
+VideoDecoder::VideoDecoder() {
+    system_resource = new VideoDecoderHelper;
+    yAssert(system_resource!=nullptr);
+}
+
+VideoDecoder::~VideoDecoder() {
+    if (system_resource!=nullptr) {
+        delete &HELPER(system_resource);
+        system_resource = nullptr;
+    }
+}
+
+bool VideoDecoder::setCodec(const std::string& codec) {
+    if (codec != "h264" && codec != "h265") {
+        return false;
+    }
+    VideoDecoderHelper& helper = HELPER(system_resource);
+    if (helper.codecName != codec) {
+        helper.codecName = codec;
+        helper.close();
+    }
+    return true;
+}
+
+bool VideoDecoder::decode(const Bytes& packet) {
+    return HELPER(system_resource).decode(packet);
+}
+
+bool VideoDecoder::readPixels(unsigned char* dest, size_t rowSize,
+                              int pixelCode, size_t width, size_t height) {
+    return HELPER(system_resource).readPixels(dest, rowSize, pixelCode, width, height);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_VIDEODECODER_INC
+#define YARP_VIDEODECODER_INC
+
+#include <yarp/os/Bytes.h>
+
+#include <string>
+
+namespace yarp {
+    namespace video {
+        class VideoDecoder;
+    }
+}
+
+/**
+ * Decodes the packets of a VideoEncoder.  The last picture decoded is
+ * kept, and converted to the pixel code wanted on request.
+ */
+class yarp::video::VideoDecoder {
+private:
+    void *system_resource;
+public:
+    VideoDecoder();
+
+    virtual ~VideoDecoder();
+
+    /**
+     * Set the codec, "h264" or "h265" (default "h264").
+     */
+    bool setCodec(const std::string& codec);
+
+    /**
+     * Decode a packet.  Returns false if the packet does not give a new
+     * picture, e.g. when the stream was joined after its last keyframe:
+     * the previous picture is kept.
+     */
+    bool decode(const yarp::os::Bytes& packet);
+
+    /**
+     * Write the last picture decoded straight into dest, in the pixel
+     * code given and using rowSize bytes for each row.  Returns false if
+     * there is no picture of the size given.
+     */
+    bool readPixels(unsigned char* dest, size_t rowSize,
+                    int pixelCode, size_t width, size_t height);
+};
+
+#endif
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef __STDC_CONSTANT_MACROS
+#define __STDC_CONSTANT_MACROS
+#endif
+
+#include "VideoEncoder.h"
+
+#include <yarp/os/Log.h>
+#include <yarp/sig/Image.h>
+
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/opt.h>
+#include <libswscale/swscale.h>
+}
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace yarp::video;
+
+namespace {
+
+AVPixelFormat sourceFormat(int pixelCode) {
+    switch (pixelCode) {
+    case VOCAB_PIXEL_MONO: return AV_PIX_FMT_GRAY8;
+    case VOCAB_PIXEL_RGB: return AV_PIX_FMT_RGB24;
+    case VOCAB_PIXEL_BGR: return AV_PIX_FMT_BGR24;
+    case VOCAB_PIXEL_RGBA: return AV_PIX_FMT_RGBA;
+    case VOCAB_PIXEL_BGRA: return AV_PIX_FMT_BGRA;
+    default: return AV_PIX_FMT_NONE;
+    }
+}
+
+} // namespace
+
+class VideoEncoderHelper {
+public:
+    std::string codecName;
+    int bitrate;
+    int gop;
+    std::string preset;
+    std::string tune;
+    bool keyframe;
+
+    AVCodecContext *context;
+    AVFrame *frame;
+    AVPacket *packet;
+    SwsContext *convert;
+    int64_t pts;
+    FlexImage rgb;
+    std::vector<unsigned char> buffer;
+
+    VideoEncoderHelper() :
+            codecName("h264"),
+            bitrate(0),
+            gop(60),
+            preset("veryfast"),
+            tune("zerolatency"),
+            keyframe(true),
+            context(nullptr),
+            frame(nullptr),
+            packet(nullptr),
+            convert(nullptr),
+            pts(0)
+    {
+        rgb.setPixelCode(VOCAB_PIXEL_RGB);
+    }
+
+    ~VideoEncoderHelper() {
+        close();
+        if (convert != nullptr) {
+            sws_freeContext(convert);
+            convert = nullptr;
+        }
+    }
+
+    void close() {
+        if (context != nullptr) {
+            avcodec_free_context(&context);
+        }
+        if (frame != nullptr) {
+            av_frame_free(&frame);
+        }
+        if (packet != nullptr) {
+            av_packet_free(&packet);
+        }
+    }
+
+    bool open(int width, int height) {
+        close();
+        AVCodecID id = (codecName == "h265") ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264;
+        const AVCodec *codec = avcodec_find_encoder(id);
+        if (codec == nullptr) {
+            yError("video: no %s encoder available in libavcodec", codecName.c_str());
+            return false;
+        }
+        context = avcodec_alloc_context3(codec);
+        if (context == nullptr) {
+            return false;
+        }
+        context->width = width;
+        context->height = height;
+        context->pix_fmt = AV_PIX_FMT_YUV420P;
+        // images carry their own timestamps, this only orders the frames
+        context->time_base = AVRational{1, 30};
+        context->framerate = AVRational{30, 1};
+        context->gop_size = gop;
+        context->max_b_frames = 0;
+        if (bitrate > 0) {
+            context->bit_rate = static_cast<int64_t>(bitrate) * 1000;
+            context->rc_max_rate = context->bit_rate;
+            context->rc_buffer_size = static_cast<int>(context->bit_rate);
+        }
+        av_opt_set(context->priv_data, "preset", preset.c_str(), 0);
+        if (!tune.empty()) {
+            av_opt_set(context->priv_data, "tune", tune.c_str(), 0);
+        }
+        // a receiver that lost packets starts again from the next
+        // keyframe, so it must not refer to earlier pictures
+        av_opt_set(context->priv_data, "forced-idr", "1", 0);
+        if (avcodec_open2(context, codec, nullptr) < 0) {
+            yError("video: cannot open the %s encoder for %dx%d images", codecName.c_str(), width, height);
+            close();
+            return false;
+        }
+
+        frame = av_frame_alloc();
+        packet = av_packet_alloc();
+        if (frame == nullptr || packet == nullptr) {
+            close();
+            return false;
+        }
+        frame->format = context->pix_fmt;
+        frame->width = width;
+        frame->height = height;
+        if (av_frame_get_buffer(frame, 0) < 0) {
+            close();
+            return false;
+        }
+        pts = 0;
+        keyframe = true;
+        return true;
+    }
+
+    bool encode(const Image& input, Bytes& result) {
+        const Image *image = &input;
+        if (sourceFormat(image->getPixelCode()) == AV_PIX_FMT_NONE) {
+            rgb.copy(input);
+            image = &rgb;
+        }
+        int width = static_cast<int>(image->width());
+        int height = static_cast<int>(image->height());
+        if (width % 2 != 0 || height % 2 != 0) {
+            yError("video: the width and height of the images must be even, got %dx%d", width, height);
+            return false;
+        }
+        if (context == nullptr || context->width != width || context->height != height) {
+            if (!open(width, height)) {
+                return false;
+            }
+        }
+
+        AVPixelFormat format = sourceFormat(image->getPixelCode());
+        convert = sws_getCachedContext(convert,
+                                       width, height, format,
+                                       width, height, context->pix_fmt,
+                                       SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (convert == nullptr) {
+            return false;
+        }
+        if (av_frame_make_writable(frame) < 0) {
+            return false;
+        }
+        // rows are addressed through getRow(), whatever the image origin
+        const uint8_t *src[1] = { image->getRow(0) };
+        int stride[1] = { static_cast<int>(image->getRowSize()) };
+        if (height > 1) {
+            stride[0] = static_cast<int>(image->getRow(1) - image->getRow(0));
+        }
+        sws_scale(convert, src, stride, 0, height, frame->data, frame->linesize);
+
+        frame->pts = pts++;
+        frame->pict_type = keyframe ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+        keyframe = false;
+        if (avcodec_send_frame(context, frame) < 0) {
+            yError("video: cannot encode an image");
+            return false;
+        }
+
+        buffer.clear();
+        while (avcodec_receive_packet(context, packet) == 0) {
+            buffer.insert(buffer.end(), packet->data, packet->data + packet->size);
+            av_packet_unref(packet);
+        }
+        result = Bytes(reinterpret_cast<char*>(buffer.data()), buffer.size());
+        return true;
+    }
+};
+
+#define HELPER(x) (*((VideoEncoderHelper*)(x)))
+
+VideoEncoder::VideoEncoder() {
+    system_resource = new VideoEncoderHelper;
+    yAssert(system_resource!=nullptr);
+}
+
+VideoEncoder::~VideoEncoder() {
+    if (system_resource!=nullptr) {
+        delete &HELPER(system_resource);
+        system_resource = nullptr;
+    }
+}
+
+bool VideoEncoder::setCodec(const std::string& codec) {
+    if (codec != "h264" && codec != "h265") {
+        return false;
+    }
+    VideoEncoderHelper& helper = HELPER(system_resource);
+    if (helper.codecName != codec) {
+        helper.codecName = codec;
+        helper.close();
+    }
+    return true;
+}
+
+void VideoEncoder::setBitrate(int kbps) {
+    HELPER(system_resource).bitrate = std::max(0, kbps);
+}
+
+void VideoEncoder::setGop(int frames) {
+    HELPER(system_resource).gop = std::max(1, frames);
+}
+
+void VideoEncoder::setPreset(const std::string& preset) {
+    HELPER(system_resource).preset = preset;
+}
+
+void VideoEncoder::setTune(const std::string& tune) {
+    HELPER(system_resource).tune = tune;
+}
+
+void VideoEncoder::requestKeyframe() {
+    HELPER(system_resource).keyframe = true;
+}
+
+int VideoEncoder::transmittedPixelCode(int pixelCode) {
+    if (sourceFormat(pixelCode) == AV_PIX_FMT_NONE) {
+        return VOCAB_PIXEL_RGB;
+    }
+    return pixelCode;
+}
+
+bool VideoEncoder::encode(const Image& image, Bytes& result) {
+    return HELPER(system_resource).encode(image, result);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_VIDEOENCODER_INC
+#define YARP_VIDEOENCODER_INC
+
+#include <yarp/os/Bytes.h>
+#include <yarp/sig/Image.h>
+
+#include <string>
+
+namespace yarp {
+    namespace video {
+        class VideoEncoder;
+    }
+}
+
+/**
+ * Encodes a stream of images with a software H.264 or H.265 encoder
+ * (libx264 or libx265 through libavcodec).  The encoder is opened on the
+ * first image, and again whenever the size of the images changes.
+ */
+class yarp::video::VideoEncoder {
+private:
+    void *system_resource;
+public:
+    VideoEncoder();
+
+    virtual ~VideoEncoder();
+
+    /**
+     * Set the codec, "h264" or "h265" (default "h264").
+     */
+    bool setCodec(const std::string& codec);
+
+    /**
+     * Set the target bitrate in kbit/s.  With 0 (default) the encoder
+     * keeps a constant quality instead.
+     */
+    void setBitrate(int kbps);
+
+    /**
+     * Set the maximum number of frames between two keyframes (default 60).
+     */
+    void setGop(int frames);
+
+    /**
+     * Set the encoder preset, e.g. "ultrafast" or "veryfast" (default
+     * "veryfast").
+     */
+    void setPreset(const std::string& preset);
+
+    /**
+     * Set the encoder tuning (default "zerolatency", that makes each
+     * image produce its packet straight away).
+     */
+    void setTune(const std::string& tune);
+
+    /**
+     * Make the next image a keyframe.
+     */
+    void requestKeyframe();
+
+    /**
+     * Pixel code of the images a receiver gets back for images of the
+     * given code: mono, rgb, bgr, rgba and bgra are kept, the other
+     * codes are sent as rgb.
+     */
+    static int transmittedPixelCode(int pixelCode);
+
+    /**
+     * Encode an image.  The result points to an internal buffer, that
+     * is valid until the next call.
+     */
+    bool encode(const yarp::sig::Image& image, yarp::os::Bytes& result);
+};
+
+#endif
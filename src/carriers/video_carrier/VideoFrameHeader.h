@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_VIDEOFRAMEHEADER_INC
+#define YARP_VIDEOFRAMEHEADER_INC
+
+#include <yarp/conf/system.h>
+#include <yarp/os/NetInt32.h>
+
+// Sent before each compressed frame: the packet of the codec follows,
+// then the envelope of the message.
+YARP_BEGIN_PACK
+class VideoFrameHeader {
+public:
+    yarp::os::NetInt32 packetLen;
+    yarp::os::NetInt32 width;
+    yarp::os::NetInt32 height;
+    yarp::os::NetInt32 pixelCode;
+    yarp::os::NetInt32 envelopeLen;
+
+    VideoFrameHeader() : packetLen(0), width(0), height(0),
+                         pixelCode(0), envelopeLen(0) {}
+};
+YARP_END_PACK
+
+#endif
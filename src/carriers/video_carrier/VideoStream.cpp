@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "VideoStream.h"
+#include "VideoFrameHeader.h"
+
+#include <yarp/os/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace yarp::video;
+
+namespace {
+
+// Larger values come from a corrupted stream, and would make the
+// receiver allocate memory without bound.
+const int maxImageSide = 16384;
+const int maxEnvelopeLen = 1 << 20;
+
+// A compressed frame is normally much smaller than the raw image, this
+// leaves room for the headers of the codec and for noisy pictures.
+const long long packetSlack = 1 << 16;
+
+} // namespace
+
+VideoStream::VideoStream(TwoWayStream *delegate, const std::string& codec) :
+        delegate(delegate),
+        phase(0),
+        cursor(nullptr),
+        remaining(0),
+        decodePending(false),
+        keyframeNeeded(false),
+        envelopeCallback(nullptr),
+        envelopeCallbackData(nullptr)
+{
+    if (!decoder.setCodec(codec)) {
+        yError("video: unknown codec %s", codec.c_str());
+    }
+}
+
+bool VideoStream::readFrame(size_t& length) {
+    InputStream& is = delegate->getInputStream();
+    VideoFrameHeader header;
+    Bytes hbuf((char*)&header, sizeof(header));
+    if (is.readFull(hbuf) != (yarp::conf::ssize_t)sizeof(header)) {
+        return false;
+    }
+    int packetLen = header.packetLen;
+    int envelopeLen = header.envelopeLen;
+    int width = header.width;
+    int height = header.height;
+    if (width < 0 || height < 0 || width > maxImageSide || height > maxImageSide ||
+        envelopeLen < 0 || envelopeLen > maxEnvelopeLen || packetLen < 0 ||
+        packetLen > (long long)width * height * 4 + packetSlack) {
+        yError("video: corrupted frame header");
+        return false;
+    }
+
+    packet.resize(packetLen);
+    Bytes pbuf(packet.data(), packet.size());
+    if (is.readFull(pbuf) != packetLen) {
+        return false;
+    }
+    envelope.resize(envelopeLen);
+    if (envelopeLen > 0) {
+        Bytes ebuf(&envelope[0], envelope.size());
+        if (is.readFull(ebuf) != envelopeLen) {
+            return false;
+        }
+    }
+
+    if (!decoder.decode(pbuf) && packetLen > 0) {
+        // e.g. the stream was joined, or went wrong, after a keyframe:
+        // the last picture is repeated until the next one
+        keyframeNeeded = true;
+    }
+
+    img.setPixelCode(header.pixelCode);
+    img.resize(width, height);
+    imgHeader.setFromImage(img);
+    decodePending = true;
+    phase = 1;
+    cursor = (char*)(&imgHeader);
+    remaining = sizeof(imgHeader);
+    length = sizeof(imgHeader) + img.getRawImageSize();
+
+    if (envelopeCallback != nullptr && !envelope.empty()) {
+        envelopeCallback(envelopeCallbackData, Bytes(&envelope[0], envelope.size()));
+    }
+    return true;
+}
+
+bool VideoStream::takeKeyframeRequest() {
+    bool request = keyframeNeeded;
+    keyframeNeeded = false;
+    return request;
+}
+
+void VideoStream::readPixels(unsigned char* dest) {
+    if (!decoder.readPixels(dest, img.getRowSize(), img.getPixelCode(), img.width(), img.height())) {
+        // nothing decoded yet for this size
+        memset(dest, 0, img.getRawImageSize());
+    }
+}
+
+yarp::conf::ssize_t VideoStream::read(Bytes& b) {
+    if (remaining == 0) {
+        if (phase != 1) {
+            return -1;
+        }
+        phase = 2;
+        size_t size = img.getRawImageSize();
+        if (decodePending) {
+            // The image is usually read in a single call, straight into
+            // its final storage: convert the picture there.
+            decodePending = false;
+            if (b.length() >= size) {
+                readPixels((unsigned char*)b.get());
+                remaining = 0;
+                phase = 0;
+                return size;
+            }
+            readPixels(img.getRawImage());
+        }
+        cursor = (char*)(img.getRawImage());
+        remaining = size;
+    }
+    size_t allow = std::min(remaining, b.length());
+    memcpy(b.get(), cursor, allow);
+    cursor += allow;
+    remaining -= allow;
+    return allow;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_VIDEOSTREAM_INC
+#define YARP_VIDEOSTREAM_INC
+
+#include <yarp/os/InputStream.h>
+#include <yarp/os/OutputStream.h>
+#include <yarp/os/TwoWayStream.h>
+#include <yarp/sig/Image.h>
+#include <yarp/sig/ImageNetworkHeader.h>
+
+#include "VideoDecoder.h"
+
+#include <string>
+#include <vector>
+
+namespace yarp {
+    namespace os {
+        class VideoStream;
+    }
+}
+
+/**
+ * Receiving side of the video carrier: reads the compressed frames and
+ * presents them as images in the standard YARP format.
+ */
+class yarp::os::VideoStream : public TwoWayStream,
+                              public InputStream,
+                              public OutputStream
+{
+private:
+    TwoWayStream *delegate;
+    yarp::video::VideoDecoder decoder;
+    yarp::sig::FlexImage img;
+    yarp::sig::ImageNetworkHeader imgHeader;
+    std::vector<char> packet;
+    std::string envelope;
+    int phase;
+    char *cursor;
+    size_t remaining;
+    bool decodePending;
+    bool keyframeNeeded;
+    InputStream::readEnvelopeCallbackType envelopeCallback;
+    void* envelopeCallbackData;
+
+    void readPixels(unsigned char* dest);
+public:
+    VideoStream(TwoWayStream *delegate, const std::string& codec);
+
+    virtual ~VideoStream() {
+        if (delegate!=nullptr) {
+            delete delegate;
+            delegate = nullptr;
+        }
+    }
+
+    /**
+     * Read and decode the next frame.
+     * @param length set to the size of the message that will be read
+     */
+    bool readFrame(size_t& length);
+
+    /**
+     * Check (and clear) if the stream could not be decoded since the
+     * last call, and the sender should start again from a keyframe.
+     */
+    bool takeKeyframeRequest();
+
+    virtual InputStream& getInputStream() override { return *this; }
+    virtual OutputStream& getOutputStream() override { return *this; }
+
+    virtual const Contact& getLocalAddress() const override {
+        return delegate->getLocalAddress();
+    }
+
+    virtual const Contact& getRemoteAddress() const override {
+        return delegate->getRemoteAddress();
+    }
+
+    virtual bool isOk() const override {
+        return delegate->isOk();
+    }
+
+    virtual void reset() override {
+        delegate->reset();
+    }
+
+    virtual void close() override {
+        delegate->close();
+    }
+
+    virtual void beginPacket() override {
+        delegate->beginPacket();
+    }
+
+    virtual void endPacket() override {
+        delegate->endPacket();
+    }
+
+    using yarp::os::OutputStream::write;
+    virtual void write(const Bytes& b) override {
+        delegate->getOutputStream().write(b);
+    }
+
+    using yarp::os::InputStream::read;
+    virtual yarp::conf::ssize_t read(Bytes& b) override;
+
+    virtual void interrupt() override {
+        delegate->getInputStream().interrupt();
+    }
+
+    virtual bool setReadEnvelopeCallback(InputStream::readEnvelopeCallbackType callback, void* data) override {
+        envelopeCallback = callback;
+        envelopeCallbackData = data;
+        return true;
+    }
+};
+
+#endif
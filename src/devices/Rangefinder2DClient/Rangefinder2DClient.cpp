@@ -57,7 +57,7 @@ Rangefinder2DInputPortProcessor::Rangefinder2DInputPortProcessor()
     resetStat();
 }
 
-void Rangefinder2DInputPortProcessor::onRead(yarp::os::Bottle &b)
+void Rangefinder2DInputPortProcessor::onRead(yarp::dev::LaserScan2D &b)
 {
     now=SystemClock::nowSystem();
     mutex.lock();
@@ -74,7 +74,7 @@ void Rangefinder2DInputPortProcessor::onRead(yarp::os::Bottle &b)
         //compare network time
         if (tmpDT*1000<LASER_TIMEOUT)
         {
-            state = b.get(1).asInt32();
+            state = b.status;
         }
         else
         {
@@ -85,7 +85,11 @@ void Rangefinder2DInputPortProcessor::onRead(yarp::os::Bottle &b)
     prev=now;
     count++;
 
-    lastBottle=b;
+    // the vectors of lastScan keep their capacity, no allocation is
+    // needed once the size of the scan is known
+    lastScan.ranges.assign(b.ranges.begin(), b.ranges.end());
+    lastScan.intensities.assign(b.intensities.begin(), b.intensities.end());
+    lastScan.status = b.status;
     Stamp newStamp;
     getEnvelope(newStamp);
 
@@ -98,7 +102,7 @@ void Rangefinder2DInputPortProcessor::onRead(yarp::os::Bottle &b)
     //now compare timestamps
     if ((1000*(newStamp.getTime()-lastStamp.getTime()))<LASER_TIMEOUT)
     {
-        state = b.get(1).asInt32();
+        state = b.status;
     }
     else
     {
@@ -109,13 +113,13 @@ void Rangefinder2DInputPortProcessor::onRead(yarp::os::Bottle &b)
     mutex.unlock();
 }
 
-inline int Rangefinder2DInputPortProcessor::getLast(yarp::os::Bottle &data, Stamp &stmp)
+inline int Rangefinder2DInputPortProcessor::getLast(yarp::dev::LaserScan2D &data, Stamp &stmp)
 {
     mutex.lock();
     int ret=state;
     if (ret != IRangefinder2D::DEVICE_GENERAL_ERROR)
     {
-        data=lastBottle;
+        data=lastScan;
         stmp = lastStamp;
     }
     mutex.unlock();
@@ -126,11 +130,12 @@ inline int Rangefinder2DInputPortProcessor::getLast(yarp::os::Bottle &data, Stam
 bool Rangefinder2DInputPortProcessor::getData(yarp::sig::Vector &ranges)
 {
     mutex.lock();
-    if (lastBottle.size()==0) { mutex.unlock(); return false; }
-    unsigned int size = lastBottle.get(0).asList()->size();
-    ranges.resize(size);
-    for (unsigned int i = 0; i < size; i++)
-        ranges[i] = lastBottle.get(0).asList()->get(i).asFloat64();
+    if (count==0) { mutex.unlock(); return false; }
+    size_t size = lastScan.ranges.size();
+    if (ranges.size() != size)
+        ranges.resize(size);
+    for (size_t i = 0; i < size; i++)
+        ranges[i] = lastScan.ranges[i];
     mutex.unlock();
     return true;
 }
@@ -138,7 +143,7 @@ bool Rangefinder2DInputPortProcessor::getData(yarp::sig::Vector &ranges)
 yarp::dev::IRangefinder2D::Device_status Rangefinder2DInputPortProcessor::getStatus()
 {
     mutex.lock();
-    yarp::dev::IRangefinder2D::Device_status status = (yarp::dev::IRangefinder2D::Device_status) lastBottle.get(3).asInt32();
+    yarp::dev::IRangefinder2D::Device_status status = (yarp::dev::IRangefinder2D::Device_status) lastScan.status;
     mutex.unlock();
     return status;
 }
@@ -307,7 +312,7 @@ bool yarp::dev::Rangefinder2DClient::getRawData(yarp::sig::Vector &data)
 
 bool yarp::dev::Rangefinder2DClient::getLaserMeasurement(std::vector<LaserMeasurementData> &data)
 {
-    yarp::sig::Vector ranges;
+    yarp::sig::Vector& ranges = ranges_buffer;
     inputPort.getData(ranges);
     size_t size = ranges.size();
     data.resize(size);
@@ -24,6 +24,7 @@
 #include <yarp/os/BufferedPort.h>
 #include <yarp/dev/PreciselyTimed.h>
 #include <yarp/dev/IRangefinder2D.h>
+#include <yarp/dev/LaserScan2D.h>
 #include <yarp/dev/ControlBoardInterfaces.h>
 #include <yarp/dev/ControlBoardHelpers.h>
 #include <yarp/sig/Vector.h>
@@ -42,9 +43,9 @@ const int LASER_TIMEOUT=100; //ms
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-class Rangefinder2DInputPortProcessor : public yarp::os::BufferedPort<yarp::os::Bottle>
+class Rangefinder2DInputPortProcessor : public yarp::os::BufferedPort<yarp::dev::LaserScan2D>
 {
-    yarp::os::Bottle lastBottle;
+    yarp::dev::LaserScan2D lastScan;
     yarp::os::Mutex mutex;
     yarp::os::Stamp lastStamp;
     double deltaT;
@@ -62,10 +63,10 @@ public:
 
     Rangefinder2DInputPortProcessor();
 
-    using yarp::os::BufferedPort<yarp::os::Bottle>::onRead;
-    virtual void onRead(yarp::os::Bottle &v) override;
+    using yarp::os::BufferedPort<yarp::dev::LaserScan2D>::onRead;
+    virtual void onRead(yarp::dev::LaserScan2D &v) override;
 
-    inline int getLast(yarp::os::Bottle &data, yarp::os::Stamp &stmp);
+    inline int getLast(yarp::dev::LaserScan2D &data, yarp::os::Stamp &stmp);
 
     inline int getIterations();
 
@@ -104,6 +105,7 @@ protected:
     double device_position_theta;
     std::string laser_frame_name;
     std::string robot_frame_name;
+    yarp::sig::Vector ranges_buffer;
 
 #endif /*DOXYGEN_SHOULD_SKIP_THIS*/
 
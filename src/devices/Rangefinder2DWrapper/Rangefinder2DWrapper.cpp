@@ -570,7 +570,6 @@ void Rangefinder2DWrapper::run()
     {
         bool ret = true;
         IRangefinder2D::Device_status status;
-        yarp::sig::Vector ranges;
         ret &= sens_p->getRawData(ranges);
         ret &= sens_p->getDeviceStatus(status);
 
@@ -583,12 +582,15 @@ void Rangefinder2DWrapper::run()
 
             int ranges_size = ranges.size();
 
-            yarp::os::Bottle& b = streamingPort.prepare();
-            b.clear();
-            Bottle& bl = b.addList();
-
-            bl.read(ranges);
-            b.addInt32(status);
+            // the scan is written in place, the buffers of the prepared
+            // object are reused
+            LaserScan2D& scan = streamingPort.prepare();
+            scan.ranges.resize(ranges_size);
+            for (int i = 0; i < ranges_size; i++)
+            {
+                scan.ranges[i] = static_cast<yarp::conf::float32_t>(ranges[i]);
+            }
+            scan.status = status;
             streamingPort.setEnvelope(lastStateStamp);
             streamingPort.write();
 
@@ -44,6 +44,7 @@
 #include <yarp/dev/Wrapper.h>
 #include <yarp/dev/api.h>
 #include <yarp/dev/PreciselyTimed.h>
+#include <yarp/dev/LaserScan2D.h>
 
 // ROS state publisher
 #include <yarp/os/Node.h>
@@ -95,10 +96,11 @@ private:
     std::string streamingPortName;
     std::string rpcPortName;
     yarp::os::Port rpcPort;
-    yarp::os::BufferedPort<yarp::os::Bottle> streamingPort;
+    yarp::os::BufferedPort<yarp::dev::LaserScan2D> streamingPort;
     yarp::dev::IRangefinder2D *sens_p;
     yarp::dev::IPreciselyTimed *iTimed;
     yarp::os::Stamp lastStateStamp;
+    yarp::sig::Vector ranges;
     double _period;
     std::string sensorId;
     double minAngle, maxAngle;
@@ -16,7 +16,13 @@
 
 #include "ffmpeg_api.h"
 
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #define ERROR_PROBLEM
 
@@ -77,12 +83,12 @@ public:
 
     // video buffers
     AVFrame         *pFrame;
-    AVFrame         *pFrameRGB;
     AVFrame         *pAudio;
-    uint8_t         *buffer;
+    struct SwsContext *convertCtx;
     int16_t         *audioBuffer;
     int16_t         *audioBufferAt;
     int audioBufferLen;
+    double lastTime;    // presentation time of the last video packet
 
     DecoderState() :
         bytesRemaining(0),
@@ -92,12 +98,12 @@ public:
         pCodecCtx(nullptr),
         pCodec(nullptr),
         pFrame(nullptr),
-        pFrameRGB(nullptr),
         pAudio(nullptr),
-        buffer(nullptr),
+        convertCtx(nullptr),
         audioBuffer(nullptr),
         audioBufferAt(nullptr),
-        audioBufferLen(0)
+        audioBufferLen(0),
+        lastTime(0)
 {}
 
     bool isFinished() {
@@ -115,11 +121,8 @@ public:
         if (audioBuffer!=nullptr) {
             delete [] audioBuffer;
         }
-        if (buffer!=nullptr) {
-            delete [] buffer;
-        }
-        if (pFrameRGB!=nullptr) {
-            av_free(pFrameRGB);
+        if (convertCtx!=nullptr) {
+            sws_freeContext(convertCtx);
         }
         if (pFrame!=nullptr) {
             av_free(pFrame);
@@ -148,10 +151,14 @@ public:
         return index;
     }
 
-    bool getCodec(AVFormatContext *pFormatCtx) {
+    bool getCodec(AVFormatContext *pFormatCtx, int threads = 1) {
         // Get a pointer to the codec context for the video stream
         pCodecCtx=pFormatCtx->streams[index]->codec;
 
+        // Decode several frames at once (0 threads: as many as cores)
+        pCodecCtx->thread_count = threads;
+        pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
         // Find the decoder for the video stream
         pCodec=avcodec_find_decoder(pCodecCtx->codec_id);
         if(pCodec==nullptr) {
@@ -172,22 +179,10 @@ public:
     bool allocateImage() {
         // Allocate video frame
         pFrame=YARP_avcodec_alloc_frame();
-
-        // Allocate an AVFrame structure
-        pFrameRGB=YARP_avcodec_alloc_frame();
-        if(pFrameRGB==nullptr) {
+        if(pFrame==nullptr) {
             printf("Could not allocate a frame\n");
             return false;
         }
-
-        // Determine required buffer size and allocate buffer
-        int numBytes=avpicture_get_size(AV_PIX_FMT_RGB24, pCodecCtx->width,
-                                        pCodecCtx->height);
-        buffer=new uint8_t[numBytes];
-
-        // Assign appropriate parts of buffer to image planes in pFrameRGB
-        avpicture_fill((AVPicture *)pFrameRGB, buffer, AV_PIX_FMT_RGB24,
-                       pCodecCtx->width, pCodecCtx->height);
         return true;
     }
 
@@ -276,22 +271,14 @@ public:
             bytesWritten += ct;
             if (bytesRead==packet.size) {
                 int num_samples = bytesWritten/(sizeof(int16_t)*num_channels);
-                sound.resize(num_samples,num_channels);
+                sound.setInterleaved(audioBuffer,num_samples,num_channels);
                 sound.setFrequency(num_rate);
-
-                int idx = 0;
-                for (int i=0; i<num_samples; i++) {
-                    for (int j=0; j<num_channels; j++) {
-                        sound.set(audioBuffer[idx],i,j);
-                        idx++;
-                    }
-                }
             }
         }
         return true;
     }
 
-    bool getVideo(AVPacket& packet) {
+    bool getVideo(AVPacket& packet, ImageOf<PixelRgb>& image) {
         // Decode video frame
 #ifdef FFEPOCH3
         avcodec_decode_video2(pCodecCtx, pFrame, &frameFinished,
@@ -303,46 +290,43 @@ public:
 
         // Did we get a video frame?
         if(frameFinished) {
-            // Convert the image from its native format to RGB
+            // Convert the image from its native format to RGB, straight
+            // into the image
             int w = pCodecCtx->width;
             int h = pCodecCtx->height;
-            static struct SwsContext *img_convert_ctx = nullptr;
-            if (img_convert_ctx==nullptr) {
-                img_convert_ctx = sws_getContext(w,h,
-                                                 pCodecCtx->pix_fmt,
-                                                 w, h, AV_PIX_FMT_RGB24,
-                                                 //0,
-                                                 //SWS_BILINEAR,
-                                                 SWS_BICUBIC,
-                                                 nullptr, nullptr, nullptr);
-            }
-            if (img_convert_ctx!=nullptr) {
-                sws_scale(img_convert_ctx, ((AVPicture*)pFrame)->data,
-                          ((AVPicture*)pFrame)->linesize, 0,
-                          pCodecCtx->height,
-                          ((AVPicture*)pFrameRGB)->data,
-                          ((AVPicture*)pFrameRGB)->linesize);
-            } else {
+            convertCtx = sws_getCachedContext(convertCtx,
+                                              w, h, pCodecCtx->pix_fmt,
+                                              w, h, AV_PIX_FMT_RGB24,
+                                              SWS_BICUBIC,
+                                              nullptr, nullptr, nullptr);
+            if (convertCtx==nullptr) {
                 printf("Software scaling not working\n");
-                ::exit(1);
+                return false;
             }
+            image.resize(w,h);
+            uint8_t *data[4] = { image.getRawImage(), nullptr, nullptr, nullptr };
+            int linesize[4] = { (int)image.getRowSize(), 0, 0, 0 };
+            sws_scale(convertCtx, pFrame->data, pFrame->linesize, 0, h,
+                      data, linesize);
         }
         return frameFinished;
     }
 
+    // Get a frame still held by the decoder at the end of the media,
+    // e.g. with frame threading several frames are in flight
+    bool drainVideo(ImageOf<PixelRgb>& image) {
+        AVPacket packet;
+        av_init_packet(&packet);
+        packet.data = nullptr;
+        packet.size = 0;
+        return getVideo(packet, image);
+    }
 
-    bool getVideo(ImageOf<PixelRgb>& image) {
-        if (frameFinished) {
-            FlexImage flex;
-            flex.setPixelCode(VOCAB_PIXEL_RGB);
-            flex.setQuantum((pFrameRGB->linesize[0]));
-            flex.setExternal(pFrameRGB->data[0],
-                             pCodecCtx->width,
-                             pCodecCtx->height);
-            image.copy(flex);
+    void flush() {
+        if (pCodecCtx!=nullptr) {
+            avcodec_flush_buffers(pCodecCtx);
         }
-
-        return frameFinished;
+        frameFinished = 0;
     }
 
     bool haveFrame() {
@@ -350,10 +334,95 @@ public:
     }
 };
 
+// The result of decoding up to the next image (or sound, in audio sync)
+class DecodedFrame {
+public:
+    ImageOf<PixelRgb> image;
+    Sound sound;
+    bool gotVideo;      // image holds a new frame
+    double time;        // presentation time
+    bool restarted;     // first frame after looping back to the start
+    bool ok;            // false at the end of the media
+
+    DecodedFrame() : gotVideo(false), time(0), restarted(false), ok(false) {}
+};
+
+// Frames decoded ahead by the background thread, and their buffers, which
+// are reused so that images are converted straight into their storage
+class FrameQueue {
+public:
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::unique_ptr<DecodedFrame>> frames;
+    std::vector<DecodedFrame*> unused;
+    std::deque<DecodedFrame*> ready;
+    bool closing;
+
+    FrameQueue() : closing(false) {}
+
+    void allocate(size_t count) {
+        for (size_t i=0; i<count; i++) {
+            frames.emplace_back(new DecodedFrame);
+            unused.push_back(frames.back().get());
+        }
+    }
+
+    DecodedFrame *takeUnused() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return closing || !unused.empty(); });
+        if (closing) {
+            return nullptr;
+        }
+        DecodedFrame *frame = unused.back();
+        unused.pop_back();
+        return frame;
+    }
+
+    void putUnused(DecodedFrame *frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        unused.push_back(frame);
+        changed.notify_all();
+    }
+
+    DecodedFrame *takeReady() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return closing || !ready.empty(); });
+        if (ready.empty()) {
+            return nullptr;
+        }
+        DecodedFrame *frame = ready.front();
+        ready.pop_front();
+        return frame;
+    }
+
+    void putReady(DecodedFrame *frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(frame);
+        changed.notify_all();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+        changed.notify_all();
+    }
+};
+
 class FfmpegHelper {
 public:
     DecoderState videoDecoder;
     DecoderState audioDecoder;
+
+    // decoding on request
+    DecodedFrame current;
+
+    // decoding ahead
+    FrameQueue queue;
+    std::thread thread;
+    DecodedFrame *shown;    // last frame with an image given out
+    bool finished;
+
+    FfmpegHelper() : shown(nullptr), finished(false) {}
 };
 
 
@@ -600,9 +669,13 @@ bool FfmpegGrabber::open(yarp::os::Searchable & config) {
     _hasVideo = (videoStream!=-1);
     _hasAudio = (audioStream!=-1);
 
+    // each decoding thread holds back a frame, which only recorded media
+    // can afford
+    int threads = config.check("threads",Value(needRateControl?0:1),
+                               "video decoding threads (0 for automatic, default 1 for live sources)").asInt32();
     bool ok = true;
     if (_hasVideo) {
-        ok = ok && videoDecoder.getCodec(pFormatCtx);
+        ok = ok && videoDecoder.getCodec(pFormatCtx, threads);
     }
     if (_hasAudio) {
         ok = ok && audioDecoder.getCodec(pAudioFormatCtx);
@@ -633,6 +706,16 @@ bool FfmpegGrabber::open(yarp::os::Searchable & config) {
     if (!(_hasVideo||_hasAudio)) {
         return false;
     }
+
+    // decoding ahead adds latency, it is only worth it for recorded media
+    decodeAhead = config.check("decode_ahead",Value(needRateControl?8:0),
+                               "frames decoded in advance by a background thread (0 to decode on request)").asInt32();
+    if (decodeAhead>0) {
+        // the frames waiting, the one being decoded and the one shown
+        helper.queue.allocate(decodeAhead+2);
+        helper.thread = std::thread(&FfmpegGrabber::decodeAheadLoop, this);
+    }
+
     active = true;
     return true;
 }
@@ -651,6 +734,14 @@ bool FfmpegGrabber::close() {
         return false;
     }
 
+    if (system_resource!=nullptr) {
+        FfmpegHelper& helper = HELPER(system_resource);
+        helper.queue.close();
+        if (helper.thread.joinable()) {
+            helper.thread.join();
+        }
+    }
+
     // Close the video file
     if (pFormatCtx!=nullptr) {
         YARP_av_close_input_file(pFormatCtx);
@@ -685,37 +776,36 @@ bool FfmpegGrabber::getSound(yarp::sig::Sound& sound) {
 }
 
 
-bool FfmpegGrabber::getAudioVisual(yarp::sig::ImageOf<yarp::sig::PixelRgb>& image,
-                                   yarp::sig::Sound& sound) {
+bool FfmpegGrabber::decodeNext(yarp::sig::ImageOf<yarp::sig::PixelRgb>& image,
+                               yarp::sig::Sound& sound,
+                               bool& gotVideo,
+                               double& time,
+                               bool& restarted) {
 
     FfmpegHelper& helper = HELPER(system_resource);
     DecoderState& videoDecoder = helper.videoDecoder;
     DecoderState& audioDecoder = helper.audioDecoder;
 
-    bool tryAgain = false;
     bool triedAgain = false;
+    gotVideo = false;
+    restarted = false;
 
     do {
 
         bool gotAudio = false;
-        bool gotVideo = false;
-        if (startTime<0.5) {
-            startTime = SystemClock::nowSystem();
-        }
-        double time_target = 0;
+        time = 0;
         while(av_read_frame(pFormatCtx, &packet)>=0) {
             // Is this a packet from the video stream?
             DBG printf("frame ");
             bool done = false;
             if (packet.stream_index==videoDecoder.getIndex()) {
                 DBG printf("video ");
-                done = videoDecoder.getVideo(packet);
-                image.resize(1,1);
+                done = videoDecoder.getVideo(packet,image);
                 if (done) {
                     //printf("got a video frame\n");
                     gotVideo = true;
                 }
-            } if (packet.stream_index==audioDecoder.getIndex()) {
+            } else if (packet.stream_index==audioDecoder.getIndex()) {
                 DBG printf("audio ");
                 done = audioDecoder.getAudio(packet,sound);
                 if (done) {
@@ -729,47 +819,143 @@ bool FfmpegGrabber::getAudioVisual(yarp::sig::ImageOf<yarp::sig::PixelRgb>& imag
             double rbase = av_q2d(time_base);
 
             DBG printf(" time=%g ", packet.pts*rbase);
-            time_target = packet.pts*rbase;
+            time = packet.pts*rbase;
+            if (packet.stream_index==videoDecoder.getIndex()) {
+                videoDecoder.lastTime = time;
+            }
 
             av_free_packet(&packet);
             DBG printf(" %d\n", done);
             if (((imageSync?gotVideo:videoDecoder.haveFrame())||!_hasVideo)&&
                 ((imageSync?1:gotAudio)||!_hasAudio)) {
-                if (_hasVideo) {
-                    videoDecoder.getVideo(image);
-                } else {
-                    image.resize(0,0);
-                }
-                if (needRateControl) {
-                    double now = (SystemClock::nowSystem()-startTime)*pace;
-                    double delay = time_target-now;
-                    if (delay>0) {
-                        DBG printf("DELAY %g ", delay);
-                        SystemClock::delaySystem(delay);
-                    } else {
-                        DBG printf("NODELAY %g ", delay);
-                    }
-                }
-                DBG printf("IMAGE size %zux%zu  ", image.width(), image.height());
-                DBG printf("SOUND size %zu\n", sound.getSamples());
-                if (!_hasAudio) {
-                    sound.resize(0,0);
-                }
                 return true;
             }
         }
 
-        tryAgain = !triedAgain;
-
-        if (tryAgain) {
-            if (!shouldLoop) {
-                return false;
+        if (_hasVideo && videoDecoder.drainVideo(image)) {
+            gotVideo = true;
+            AVStream *stream = pFormatCtx->streams[videoDecoder.getIndex()];
+            double rate = av_q2d(stream->r_frame_rate);
+            if (rate>0) {
+                videoDecoder.lastTime += 1.0/rate;
             }
-            av_seek_frame(pFormatCtx,-1,0,AVSEEK_FLAG_BACKWARD);
-            startTime = SystemClock::nowSystem();
-            triedAgain = true;
+            time = videoDecoder.lastTime;
+            return true;
+        }
+
+        if (triedAgain || !shouldLoop) {
+            return false;
+        }
+        av_seek_frame(pFormatCtx,-1,0,AVSEEK_FLAG_BACKWARD);
+        // drop what the decoders kept from the end of the media
+        if (_hasVideo) {
+            videoDecoder.flush();
         }
-    } while (tryAgain);
+        if (_hasAudio) {
+            audioDecoder.flush();
+        }
+        restarted = true;
+        triedAgain = true;
+    } while (true);
 
     return false;
 }
+
+
+void FfmpegGrabber::decodeAheadLoop() {
+    FfmpegHelper& helper = HELPER(system_resource);
+    while (true) {
+        DecodedFrame *frame = helper.queue.takeUnused();
+        if (frame==nullptr) {
+            return;
+        }
+        frame->ok = decodeNext(frame->image, frame->sound,
+                               frame->gotVideo, frame->time,
+                               frame->restarted);
+        helper.queue.putReady(frame);
+        if (!frame->ok) {
+            return;
+        }
+    }
+}
+
+
+bool FfmpegGrabber::getAudioVisual(yarp::sig::ImageOf<yarp::sig::PixelRgb>& image,
+                                   yarp::sig::Sound& sound) {
+
+    FfmpegHelper& helper = HELPER(system_resource);
+
+    if (startTime<0.5) {
+        startTime = SystemClock::nowSystem();
+    }
+
+    DecodedFrame *frame = nullptr;
+    if (decodeAhead>0) {
+        if (helper.finished) {
+            return false;
+        }
+        frame = helper.queue.takeReady();
+        if (frame==nullptr) {
+            return false;
+        }
+        if (!frame->ok) {
+            helper.finished = true;
+            helper.queue.putUnused(frame);
+            return false;
+        }
+    } else {
+        frame = &helper.current;
+        // the image is kept, for when no new frame is decoded
+        bool gotVideo = false;
+        if (!decodeNext(frame->image, frame->sound, gotVideo,
+                        frame->time, frame->restarted)) {
+            return false;
+        }
+    }
+
+    if (frame->restarted) {
+        startTime = SystemClock::nowSystem();
+    }
+
+    if (_hasVideo) {
+        const DecodedFrame *source = frame;
+        if (decodeAhead>0) {
+            // without a new image, the last one is given again
+            if (frame->gotVideo) {
+                if (helper.shown!=nullptr) {
+                    helper.queue.putUnused(helper.shown);
+                }
+                helper.shown = frame;
+            }
+            source = helper.shown;
+        }
+        if (source!=nullptr) {
+            image.copy(source->image);
+        }
+    } else {
+        image.resize(0,0);
+    }
+    if (_hasAudio) {
+        sound = frame->sound;
+    } else {
+        sound.resize(0,0);
+    }
+    double time_target = frame->time;
+    if (decodeAhead>0 && frame!=helper.shown) {
+        helper.queue.putUnused(frame);
+    }
+
+    if (needRateControl) {
+        double now = (SystemClock::nowSystem()-startTime)*pace;
+        double delay = time_target-now;
+        if (delay>0) {
+            DBG printf("DELAY %g ", delay);
+            SystemClock::delaySystem(delay);
+        } else {
+            DBG printf("NODELAY %g ", delay);
+        }
+    }
+    DBG printf("IMAGE size %zux%zu  ", image.width(), image.height());
+    DBG printf("SOUND size %zu\n", sound.getSamples());
+    return true;
+}
@@ -39,6 +39,12 @@ namespace yarp {
  *
  * An image frame grabber device using ffmpeg to capture images from
  * AVI files.
+ *
+ * Recorded media are decoded ahead of time by a background thread, that
+ * keeps up to "decode_ahead" frames ready (0 decodes each frame when it
+ * is requested, the default for live sources).  Video decoding uses
+ * "threads" threads (0 picks them automatically, the default for recorded
+ * media; live sources default to 1, so that frames are not delayed).
  */
 class yarp::dev::FfmpegGrabber : public IFrameGrabberImage,
             public IAudioGrabberSound,
@@ -67,7 +73,8 @@ public:
         m_h(0),
         m_channels(0),
         m_rate(0),
-        m_capture(nullptr)
+        m_capture(nullptr),
+        decodeAhead(0)
     {
         memset(&packet,0,sizeof(packet));
     }
@@ -144,6 +151,16 @@ protected:
 
     bool openFile(AVFormatContext **ppFormatCtx,
                   const char *fname);
+
+    int decodeAhead;
+
+    bool decodeNext(yarp::sig::ImageOf<yarp::sig::PixelRgb>& image,
+                    yarp::sig::Sound& sound,
+                    bool& gotVideo,
+                    double& time,
+                    bool& restarted);
+
+    void decodeAheadLoop();
 };
 
 
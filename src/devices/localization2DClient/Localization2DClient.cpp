@@ -68,17 +68,23 @@ bool yarp::dev::Localization2DClient::open(yarp::os::Searchable &config)
         return false;
     }
 
-    /*
-    //currently unused
-    bool ok=Network::connect(remote_streaming_name.c_str(), local_streaming_name.c_str(), "tcp");
-    if (!ok)
+    if (!m_pose_stream.open(local_streaming_name.c_str()))
     {
-        yError("Navigation2DClient::open() error could not connect to %s", remote_streaming_name.c_str());
+        yError("Localization2DClient::open() error could not open port %s, check network", local_streaming_name.c_str());
         return false;
-    }*/
+    }
+    m_pose_stream.setTimeout(config.check("pose_timeout", Value(0.2)).asFloat64());
+    m_pose_stream.useCallback();
 
     bool ok = true;
 
+    ok = Network::connect(remote_streaming_name.c_str(), local_streaming_name.c_str(), "tcp");
+    if (!ok)
+    {
+        //the position is then asked to the server every time
+        yWarning("Localization2DClient::open() could not connect to %s, the pose is not streamed", remote_streaming_name.c_str());
+    }
+
     ok = Network::connect(local_rpc.c_str(), remote_rpc.c_str());
     if (!ok)
     {
@@ -120,6 +126,11 @@ bool  yarp::dev::Localization2DClient::setInitialPose(Map2DLocation& loc)
 
 bool  yarp::dev::Localization2DClient::getCurrentPosition(Map2DLocation& loc)
 {
+    if (m_pose_stream.getLatest(loc))
+    {
+        return true;
+    }
+
     yarp::os::Bottle b;
     yarp::os::Bottle resp;
 
@@ -151,8 +162,15 @@ bool  yarp::dev::Localization2DClient::getCurrentPosition(Map2DLocation& loc)
     return true;
 }
 
+bool  yarp::dev::Localization2DClient::getPositionAt(double timestamp, Map2DLocation& loc)
+{
+    return m_pose_stream.getAt(timestamp, loc);
+}
+
 bool yarp::dev::Localization2DClient::close()
 {
+    m_pose_stream.interrupt();
+    m_pose_stream.close();
     m_rpc_port_localization_server.close();
     return true;
 }
@@ -34,6 +34,7 @@
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/dev/Map2DLocation.h>
 #include <yarp/dev/ILocalization2D.h>
+#include <yarp/dev/impl/PoseStreamCache.h>
 
 namespace yarp {
     namespace dev {
@@ -52,6 +53,10 @@ namespace yarp {
  * |:--------------:|:--------------:|:-------:|:--------------:|:-------------:|:-----------: |:-----------------------------------------------------------------:|:-----:|
  * | local          |      -         | string  | -   |   -           | Yes          | Full port name opened by the Localization2DClient device.                             |       |
  * | remote         |      -         | string  | -   |   -           | Yes          | Full port name of the port opened on the server side, to which the Localization2DClient connects to.                           | E.g.(https://github.com/robotology/navigation/src/localizationServer)    |
+ * | pose_timeout   |      -         | double  | s   |   0.2         | No           | How long a pose streamed by the server is used, before asking the server again.             |       |
+ *
+ * If the server streams the pose of the robot on <remote>/stream:o, getCurrentPosition() is answered from the
+ * last pose received, and getPositionAt() interpolates between the recent ones. Otherwise the server is asked each time.
  */
 
 class yarp::dev::Localization2DClient : public DeviceDriver,
@@ -61,6 +66,7 @@ class yarp::dev::Localization2DClient : public DeviceDriver,
 protected:
     yarp::os::Mutex               m_mutex;
     yarp::os::Port                m_rpc_port_localization_server;
+    yarp::dev::impl::PoseStreamCache m_pose_stream;
     std::string         m_local_name;
     std::string         m_remote_name;
 
@@ -73,6 +79,7 @@ public:
 
     /* The following methods belong to ILocalization2D interface */
     bool   getCurrentPosition(yarp::dev::Map2DLocation &loc) override;
+    bool   getPositionAt(double timestamp, yarp::dev::Map2DLocation &loc) override;
     bool   setInitialPose(yarp::dev::Map2DLocation& loc) override;
 };
 
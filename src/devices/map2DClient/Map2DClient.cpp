@@ -31,6 +31,56 @@ using namespace yarp::sig;
 
 //------------------------------------------------------------------------------------------------------------------------------
 
+void Map2DCache::onRead(yarp::dev::MapGrid2DDelta& delta)
+{
+    LockGuard lock(m_mutex);
+    auto it = m_maps.find(delta.map_name);
+    if (it != m_maps.end())
+    {
+        //if a delta was lost, the copy is brought up to date by the next get_map()
+        it->second.applyDelta(delta);
+    }
+}
+
+bool Map2DCache::find(const std::string& map_name, std::int32_t& epoch, std::int64_t& version)
+{
+    LockGuard lock(m_mutex);
+    auto it = m_maps.find(map_name);
+    if (it == m_maps.end())
+    {
+        return false;
+    }
+    epoch = it->second.getEpoch();
+    version = it->second.getVersion();
+    return true;
+}
+
+bool Map2DCache::apply(const yarp::dev::MapGrid2DDelta& delta, yarp::dev::MapGrid2D& map)
+{
+    LockGuard lock(m_mutex);
+    MapGrid2D& cached = m_maps[delta.map_name];
+    if (!cached.applyDelta(delta))
+    {
+        return false;
+    }
+    map = cached;
+    return true;
+}
+
+void Map2DCache::remove(const std::string& map_name)
+{
+    LockGuard lock(m_mutex);
+    m_maps.erase(map_name);
+}
+
+void Map2DCache::clear()
+{
+    LockGuard lock(m_mutex);
+    m_maps.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+
 bool yarp::dev::Map2DClient::open(yarp::os::Searchable &config)
 {
     m_local_name.clear();
@@ -70,6 +120,26 @@ bool yarp::dev::Map2DClient::open(yarp::os::Searchable &config)
         return false;
     }
 
+    std::string local_deltas = m_local_name;
+    local_deltas += "/mapClient_deltas:i";
+
+    std::string remote_deltas = m_map_server;
+    remote_deltas += "/deltas:o";
+
+    if (!m_maps_cache.open(local_deltas.c_str()))
+    {
+        yError("Map2DClient::open() error could not open port %s, check network", local_deltas.c_str());
+        return false;
+    }
+    m_maps_cache.useCallback();
+
+    ok=Network::connect(remote_deltas.c_str(), local_deltas.c_str());
+    if (!ok)
+    {
+        //the cached maps are still updated by get_map(), one request behind
+        yWarning("Map2DClient::open() could not connect to %s, maps will not be kept in sync", remote_deltas.c_str());
+    }
+
     return true;
 }
 
@@ -106,6 +176,54 @@ bool yarp::dev::Map2DClient::store_map(const MapGrid2D& map)
 }
 
 bool yarp::dev::Map2DClient::get_map(std::string map_name, MapGrid2D& map)
+{
+    //only the tiles modified since the cached copy was updated are transferred
+    std::int32_t epoch = 0;
+    std::int64_t version = 0;
+    m_maps_cache.find(map_name, epoch, version);
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        yarp::os::Bottle b;
+        yarp::os::Bottle resp;
+
+        b.addVocab(VOCAB_IMAP);
+        b.addVocab(VOCAB_IMAP_GET_MAP_DELTA);
+        b.addString(map_name);
+        b.addInt32(epoch);
+        b.addInt64(version);
+
+        bool ret = m_rpcPort_to_Map2DServer.write(b, resp);
+        if (!ret)
+        {
+            yError() << "Map2DClient::get_map() error on writing on rpc port";
+            return false;
+        }
+        if (resp.get(0).asVocab() != VOCAB_IMAP_OK)
+        {
+            //the map does not exist, or the server does not send deltas
+            m_maps_cache.remove(map_name);
+            return get_whole_map(map_name, map);
+        }
+        MapGrid2DDelta delta;
+        if (!Property::copyPortable(resp.get(1), delta))
+        {
+            yError() << "Map2DClient::get_map() failed copyPortable()";
+            return false;
+        }
+        if (m_maps_cache.apply(delta, map))
+        {
+            return true;
+        }
+        //the cached copy was updated in the meantime, ask for the whole map
+        epoch = 0;
+        version = 0;
+    }
+    yError() << "Map2DClient::get_map() unable to apply the map received from server";
+    return false;
+}
+
+bool yarp::dev::Map2DClient::get_whole_map(std::string map_name, MapGrid2D& map)
 {
     yarp::os::Bottle b;
     yarp::os::Bottle resp;
@@ -166,6 +284,7 @@ bool yarp::dev::Map2DClient::clear()
         yError() << "Map2DClient::clear() error on writing on rpc port";
         return false;
     }
+    m_maps_cache.clear();
     return true;
 }
 
@@ -225,6 +344,7 @@ bool yarp::dev::Map2DClient::remove_map(std::string map_name)
         yError() << "Map2DClient::remove_map() error on writing on rpc port";
         return false;
     }
+    m_maps_cache.remove(map_name);
     return true;
 }
 
@@ -387,6 +507,8 @@ bool   yarp::dev::Map2DClient::clearAllLocations()
 
 bool yarp::dev::Map2DClient::close()
 {
+    m_maps_cache.interrupt();
+    m_maps_cache.close();
     return true;
 }
 
@@ -26,11 +26,16 @@
 #include <yarp/dev/IMap2D.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/dev/MapGrid2D.h>
+#include <yarp/dev/MapGrid2DDelta.h>
 #include <yarp/dev/Map2DLocation.h>
 #include <yarp/os/Semaphore.h>
 #include <yarp/os/Time.h>
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/os/RecursiveMutex.h>
+#include <yarp/os/Mutex.h>
+
+#include <map>
+#include <string>
 
 namespace yarp {
     namespace dev {
@@ -38,6 +43,29 @@ namespace yarp {
     }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * The copies of the maps already retrieved from the server, kept up to date by the
+ * deltas streamed by the server.
+ */
+class Map2DCache : public yarp::os::BufferedPort<yarp::dev::MapGrid2DDelta>
+{
+    std::map<std::string, yarp::dev::MapGrid2D> m_maps;
+    yarp::os::Mutex m_mutex;
+
+public:
+    using yarp::os::BufferedPort<yarp::dev::MapGrid2DDelta>::onRead;
+    virtual void onRead(yarp::dev::MapGrid2DDelta& delta) override;
+
+    bool find(const std::string& map_name, std::int32_t& epoch, std::int64_t& version);
+    bool apply(const yarp::dev::MapGrid2DDelta& delta, yarp::dev::MapGrid2D& map);
+    void remove(const std::string& map_name);
+    void clear();
+};
+
+#endif /*DOXYGEN_SHOULD_SKIP_THIS*/
+
 /**
  * @ingroup dev_impl_network_clients
  *
@@ -49,6 +77,8 @@ namespace yarp {
  * |:--------------:|:--------------:|:-------:|:--------------:|:-------------:|:-----------: |:-----------------------------------------------------------------:|:-----:|
  * | local          |      -         | string  | -   |   -           | Yes          | Full port name opened by the Map2DClient device.                             |       |
  * | remote         |     -          | string  | -   |   -           | Yes          | Full port name of the port remotely opened by the Map2DServer, to which the Map2DClient connects to.           |  |
+ *
+ * The maps retrieved with get_map() are cached: later requests only transfer the tiles modified in the meantime.
  */
 
 class yarp::dev::Map2DClient : public DeviceDriver,
@@ -58,6 +88,9 @@ class yarp::dev::Map2DClient : public DeviceDriver,
 protected:
 
     yarp::os::Port                m_rpcPort_to_Map2DServer;
+    Map2DCache                    m_maps_cache;
+
+    bool get_whole_map(std::string map_name, yarp::dev::MapGrid2D& map);
     std::string         m_local_name;
     std::string         m_map_server;
 
@@ -86,8 +86,11 @@ void Map2DServer::parse_vocab_command(yarp::os::Bottle& in, yarp::os::Bottle& ou
                 }
                 else
                 {
-                    //the map already exists
-                    m_maps_storage[map_name] = the_map;
+                    //the map already exists: only the tiles that differ are marked as modified,
+                    //and they are sent to the clients that keep a copy of the map
+                    std::int64_t previous_version = it->second.getVersion();
+                    it->second.mergeFrom(the_map);
+                    publishDelta(it->second, previous_version);
                     out.clear();
                     out.addVocab(VOCAB_IMAP_OK);
                 }
@@ -117,6 +120,28 @@ void Map2DServer::parse_vocab_command(yarp::os::Bottle& in, yarp::os::Bottle& ou
                 yError() << "Map" << name << "not found";
             }
         }
+        else if (cmd == VOCAB_IMAP_GET_MAP_DELTA)
+        {
+            string name = in.get(2).asString();
+            std::int32_t epoch = in.get(3).asInt32();
+            std::int64_t since = in.get(4).asInt64();
+            auto it = m_maps_storage.find(name);
+            if (it != m_maps_storage.end())
+            {
+                MapGrid2DDelta delta;
+                it->second.getDelta(epoch, since, delta);
+                out.clear();
+                out.addVocab(VOCAB_IMAP_OK);
+                yarp::os::Bottle& deltabot = out.addList();
+                Property::copyPortable(delta, deltabot);
+            }
+            else
+            {
+                out.clear();
+                out.addVocab(VOCAB_IMAP_ERROR);
+                yError() << "Map" << name << "not found";
+            }
+        }
         else if (cmd == VOCAB_IMAP_GET_NAMES)
         {
             out.clear();
@@ -453,6 +478,19 @@ bool Map2DServer::read(yarp::os::ConnectionReader& connection)
     return true;
 }
 
+void Map2DServer::publishDelta(const yarp::dev::MapGrid2D& map, std::int64_t since)
+{
+    if (map.getVersion() == since || m_deltasPort.getOutputCount() == 0)
+    {
+        return;
+    }
+    //the delta is sent in the background, so that the rpc reply is not delayed
+    //by slow clients: a client that misses it updates its copy with get_map
+    MapGrid2DDelta& delta = m_deltasPort.prepare();
+    map.getDelta(map.getEpoch(), since, delta);
+    m_deltasPort.write();
+}
+
 bool Map2DServer::saveMaps(std::string mapsfile)
 {
     if (m_maps_storage.size() == 0)
@@ -607,6 +645,19 @@ bool Map2DServer::open(yarp::os::Searchable &config)
     }
     m_rpcPort.setReader(*this);
 
+    //open the port streaming the modified tiles of the maps
+    std::string deltasPortName = m_rpcPortName;
+    if (deltasPortName.size() > 4 && deltasPortName.substr(deltasPortName.size() - 4) == "/rpc")
+    {
+        deltasPortName.resize(deltasPortName.size() - 4);
+    }
+    deltasPortName += "/deltas:o";
+    if (!m_deltasPort.open(deltasPortName.c_str()))
+    {
+        yError("Map2DServer: failed to open port %s", deltasPortName.c_str());
+        return false;
+    }
+
     //ROS configuration
     if (config.check("ROS"))
     {
@@ -729,6 +780,8 @@ bool Map2DServer::close()
         m_rosSubscriberPort_map.close();
         m_rosSubscriberPort_metamap.close();
     }
+    m_deltasPort.interrupt();
+    m_deltasPort.close();
     yTrace("Map2DServer::Close");
     return true;
 }
@@ -35,6 +35,7 @@
 #include <yarp/os/RpcServer.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/dev/MapGrid2D.h>
+#include <yarp/dev/MapGrid2DDelta.h>
 #include <yarp/dev/Map2DLocation.h>
 #include <yarp/os/ResourceFinder.h>
 
@@ -72,6 +73,9 @@ namespace yarp
  * | name           |      -         | string  | -              | /mapServer/rpc   | No           | Full name of the rpc port opened by the Map2DServer device.       |       |
  * | mapCollection  |      -         | string  | -              |   -              | No           | The name of .ini file containing a map collection.                |       |
 
+ * The tiles of a map modified by a store_map() are streamed on the port <name>/deltas:o (without the trailing /rpc),
+ * so that the Map2DClient devices connected to it keep their copy of the map up to date.
+ *
  * \section Notes:
  * Integration with ROS map server is currently under development.
  */
@@ -108,6 +112,7 @@ private:
     #define ROSTOPICNAME_MAPMETADATA "/map_metadata"
 
     yarp::os::RpcServer                                     m_rpcPort;
+    yarp::os::BufferedPort<yarp::dev::MapGrid2DDelta>       m_deltasPort;
     yarp::os::Publisher<yarp::rosmsg::nav_msgs::OccupancyGrid>             m_rosPublisherPort_map;
     yarp::os::Publisher<yarp::rosmsg::nav_msgs::MapMetaData>               m_rosPublisherPort_metamap;
     yarp::os::Subscriber<yarp::rosmsg::nav_msgs::OccupancyGrid>            m_rosSubscriberPort_map;
@@ -120,6 +125,7 @@ private:
     void parse_string_command(yarp::os::Bottle& in, yarp::os::Bottle& out);
     void parse_vocab_command(yarp::os::Bottle& in, yarp::os::Bottle& out);
     bool updateVizMarkers();
+    void publishDelta(const yarp::dev::MapGrid2D& map, std::int64_t since);
 
 #endif //DOXYGEN_SHOULD_SKIP_THIS
 };
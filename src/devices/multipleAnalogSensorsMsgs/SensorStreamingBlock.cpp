@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "SensorStreamingBlock.h"
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+
+using namespace yarp::os;
+
+bool SensorStreamingBlock::read(ConnectionReader& connection)
+{
+    connection.convertTextMode();
+
+    if (connection.expectInt32() != BOTTLE_TAG_LIST ||
+        connection.expectInt32() != nrOfSensorTypes) {
+        return false;
+    }
+
+    for (auto& block : blocks) {
+        std::int32_t tag = connection.expectInt32();
+        std::int32_t len = connection.expectInt32();
+        if (connection.isError() || len < 0) {
+            return false;
+        }
+        // an empty list may be sent without the type
+        if (tag != (BOTTLE_TAG_LIST | BOTTLE_TAG_FLOAT64) && !(tag == BOTTLE_TAG_LIST && len == 0)) {
+            return false;
+        }
+        block.resize(len);
+        if (len > 0 && !connection.expectBlock(reinterpret_cast<char*>(block.data()), len * sizeof(double))) {
+            return false;
+        }
+    }
+
+    return !connection.isError();
+}
+
+bool SensorStreamingBlock::write(ConnectionWriter& connection) const
+{
+    connection.appendInt32(BOTTLE_TAG_LIST);
+    connection.appendInt32(nrOfSensorTypes);
+    for (const auto& block : blocks) {
+        connection.appendInt32(BOTTLE_TAG_LIST | BOTTLE_TAG_FLOAT64);
+        connection.appendInt32(static_cast<std::int32_t>(block.size()));
+        if (!block.empty()) {
+            connection.appendExternalBlock(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(double));
+        }
+    }
+
+    connection.convertTextMode();
+    return !connection.isError();
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_DEV_MULTIPLEANALOGSENSORSMSGS_SENSORSTREAMINGBLOCK_H
+#define YARP_DEV_MULTIPLEANALOGSENSORSMSGS_SENSORSTREAMINGBLOCK_H
+
+#include <yarp/os/Portable.h>
+
+#include <vector>
+
+/**
+ * The measurements of all the sensors, in the flat streaming format.
+ *
+ * There is one block of float64 for each sensor type, containing for each
+ * sensor its timestamp followed by its measurement. The size of each
+ * measurement is not sent with the data, but once through the RPC port
+ * (see SensorStreamingLayout), so a block is serialized as a single chunk.
+ * On the wire it is a Bottle with a list of float64 for each sensor type.
+ */
+class SensorStreamingBlock : public yarp::os::Portable
+{
+public:
+    enum SensorType
+    {
+        ThreeAxisGyroscopes,
+        ThreeAxisLinearAccelerometers,
+        ThreeAxisMagnetometers,
+        OrientationSensors,
+        TemperatureSensors,
+        SixAxisForceTorqueSensors,
+        ContactLoadCellArrays,
+        EncoderArrays,
+        SkinPatches,
+        nrOfSensorTypes
+    };
+
+    std::vector<double> blocks[nrOfSensorTypes];
+
+    bool read(yarp::os::ConnectionReader& connection) override;
+    bool write(yarp::os::ConnectionWriter& connection) const override;
+};
+
+#endif // YARP_DEV_MULTIPLEANALOGSENSORSMSGS_SENSORSTREAMINGBLOCK_H
@@ -15,6 +15,7 @@
 #include <yarp/os/Wire.h>
 #include <yarp/os/idl/WireTypes.h>
 #include <SensorRPCData.h>
+#include <SensorStreamingLayout.h>
 
 class MultipleAnalogSensorsMetadata;
 
@@ -26,6 +27,12 @@ public:
    * Read the sensor metadata necessary to configure the MultipleAnalogSensorsClient device.
    */
   virtual SensorRPCData getMetadata();
+  /**
+   * Read the format of the measurements streamed by the server: if flat is
+   * false the measurements are streamed as SensorStreamingData, otherwise
+   * as a SensorStreamingBlock with the given layout.
+   */
+  virtual SensorStreamingLayout getStreamingLayout();
   virtual bool read(yarp::os::ConnectionReader& connection) override;
   virtual std::vector<std::string> help(const std::string& functionName="--all");
 };
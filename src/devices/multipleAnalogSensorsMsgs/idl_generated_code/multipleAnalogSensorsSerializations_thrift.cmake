@@ -7,5 +7,5 @@
 ## This is an automatically-generated file.
 ## It could get re-generated if the ALLOW_IDL_GENERATION flag is on
 
-set(headers include/SensorMeasurement.h;include/SensorMeasurements.h;include/SensorStreamingData.h;include/SensorMetadata.h;include/SensorRPCData.h;include/MultipleAnalogSensorsMetadata.h)
-set(sources src/SensorMeasurement.cpp;src/SensorMeasurements.cpp;src/SensorStreamingData.cpp;src/SensorMetadata.cpp;src/SensorRPCData.cpp;src/MultipleAnalogSensorsMetadata.cpp)
+set(headers include/SensorMeasurement.h;include/SensorMeasurements.h;include/SensorStreamingData.h;include/SensorMetadata.h;include/SensorRPCData.h;include/SensorStreamingLayout.h;include/MultipleAnalogSensorsMetadata.h)
+set(sources src/SensorMeasurement.cpp;src/SensorMeasurements.cpp;src/SensorStreamingData.cpp;src/SensorMetadata.cpp;src/SensorRPCData.cpp;src/SensorStreamingLayout.cpp;src/MultipleAnalogSensorsMetadata.cpp)
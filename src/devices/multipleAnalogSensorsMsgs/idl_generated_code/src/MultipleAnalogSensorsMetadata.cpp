@@ -22,6 +22,14 @@ public:
   virtual bool read(yarp::os::ConnectionReader& connection) override;
 };
 
+class MultipleAnalogSensorsMetadata_getStreamingLayout : public yarp::os::Portable {
+public:
+  SensorStreamingLayout _return;
+  void init();
+  virtual bool write(yarp::os::ConnectionWriter& connection) const override;
+  virtual bool read(yarp::os::ConnectionReader& connection) override;
+};
+
 bool MultipleAnalogSensorsMetadata_getMetadata::write(yarp::os::ConnectionWriter& connection) const {
   yarp::os::idl::WireWriter writer(connection);
   if (!writer.writeListHeader(1)) return false;
@@ -42,6 +50,26 @@ bool MultipleAnalogSensorsMetadata_getMetadata::read(yarp::os::ConnectionReader&
 void MultipleAnalogSensorsMetadata_getMetadata::init() {
 }
 
+bool MultipleAnalogSensorsMetadata_getStreamingLayout::write(yarp::os::ConnectionWriter& connection) const {
+  yarp::os::idl::WireWriter writer(connection);
+  if (!writer.writeListHeader(1)) return false;
+  if (!writer.writeTag("getStreamingLayout",1,1)) return false;
+  return true;
+}
+
+bool MultipleAnalogSensorsMetadata_getStreamingLayout::read(yarp::os::ConnectionReader& connection) {
+  yarp::os::idl::WireReader reader(connection);
+  if (!reader.readListReturn()) return false;
+  if (!reader.read(_return)) {
+    reader.fail();
+    return false;
+  }
+  return true;
+}
+
+void MultipleAnalogSensorsMetadata_getStreamingLayout::init() {
+}
+
 MultipleAnalogSensorsMetadata::MultipleAnalogSensorsMetadata() {
   yarp().setOwner(*this);
 }
@@ -55,6 +83,25 @@ SensorRPCData MultipleAnalogSensorsMetadata::getMetadata() {
   bool ok = yarp().write(helper,helper);
   return ok?helper._return:_return;
 }
+SensorStreamingLayout MultipleAnalogSensorsMetadata::getStreamingLayout() {
+  SensorStreamingLayout _return;
+  MultipleAnalogSensorsMetadata_getStreamingLayout helper;
+  helper.init();
+  if (!yarp().canWrite()) {
+    yError("Missing server method '%s'?","SensorStreamingLayout MultipleAnalogSensorsMetadata::getStreamingLayout()");
+  }
+  bool ok = yarp().write(helper,helper);
+  return ok?helper._return:_return;
+}
+
+// FNV-1a hash of the tag of a command, used to dispatch it
+static std::uint32_t MultipleAnalogSensorsMetadata_tagHash(const std::string& tag) {
+  std::uint32_t hash = 2166136261U;
+  for (char c : tag) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+  }
+  return hash;
+}
 
 bool MultipleAnalogSensorsMetadata::read(yarp::os::ConnectionReader& connection) {
   yarp::os::idl::WireReader reader(connection);
@@ -64,38 +111,56 @@ bool MultipleAnalogSensorsMetadata::read(yarp::os::ConnectionReader& connection)
   bool direct = (tag=="__direct__");
   if (direct) tag = reader.readTag();
   while (!reader.isError()) {
-    // TODO: use quick lookup, this is just a test
-    if (tag == "getMetadata") {
-      SensorRPCData _return;
-      _return = getMetadata();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(9)) return false;
-        if (!writer.write(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "help") {
-      std::string functionName;
-      if (!reader.readString(functionName)) {
-        functionName = "--all";
+    switch (MultipleAnalogSensorsMetadata_tagHash(tag)) {
+    case 1605265930U:
+      if (tag == "getMetadata") {
+        SensorRPCData _return;
+        _return = getMetadata();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(9)) return false;
+          if (!writer.write(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      std::vector<std::string> _return=help(functionName);
-      yarp::os::idl::WireWriter writer(reader);
+      break;
+    case 3359313035U:
+      if (tag == "getStreamingLayout") {
+        SensorStreamingLayout _return;
+        _return = getStreamingLayout();
+        yarp::os::idl::WireWriter writer(reader);
         if (!writer.isNull()) {
-          if (!writer.writeListHeader(2)) return false;
-          if (!writer.writeTag("many",1, 0)) return false;
-          if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
-          std::vector<std::string> ::iterator _iterHelp;
-          for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
-          {
-            if (!writer.writeString(*_iterHelp)) return false;
-           }
-          if (!writer.writeListEnd()) return false;
+          if (!writer.writeListHeader(10)) return false;
+          if (!writer.write(_return)) return false;
         }
-      reader.accept();
-      return true;
+        reader.accept();
+        return true;
+      }
+      break;
+    case 946971642U:
+      if (tag == "help") {
+        std::string functionName;
+        if (!reader.readString(functionName)) {
+          functionName = "--all";
+        }
+        std::vector<std::string> _return=help(functionName);
+        yarp::os::idl::WireWriter writer(reader);
+          if (!writer.isNull()) {
+            if (!writer.writeListHeader(2)) return false;
+            if (!writer.writeTag("many",1, 0)) return false;
+            if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
+            std::vector<std::string> ::iterator _iterHelp;
+            for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
+            {
+              if (!writer.writeString(*_iterHelp)) return false;
+             }
+            if (!writer.writeListEnd()) return false;
+          }
+        reader.accept();
+        return true;
+      }
+      break;
     }
     if (reader.noMore()) { reader.fail(); return false; }
     std::string next_tag = reader.readTag();
@@ -111,6 +176,7 @@ std::vector<std::string> MultipleAnalogSensorsMetadata::help(const std::string&
   if(showAll) {
     helpString.push_back("*** Available commands:");
     helpString.push_back("getMetadata");
+    helpString.push_back("getStreamingLayout");
     helpString.push_back("help");
   }
   else {
@@ -118,6 +184,12 @@ std::vector<std::string> MultipleAnalogSensorsMetadata::help(const std::string&
       helpString.push_back("SensorRPCData getMetadata() ");
       helpString.push_back("Read the sensor metadata necessary to configure the MultipleAnalogSensorsClient device. ");
     }
+    if (functionName=="getStreamingLayout") {
+      helpString.push_back("SensorStreamingLayout getStreamingLayout() ");
+      helpString.push_back("Read the format of the measurements streamed by the server: if flat is ");
+      helpString.push_back("false the measurements are streamed as SensorStreamingData, otherwise ");
+      helpString.push_back("as a SensorStreamingBlock with the given layout. ");
+    }
     if (functionName=="help") {
       helpString.push_back("std::vector<std::string> help(const std::string& functionName=\"--all\")");
       helpString.push_back("Return list of available commands, or help message for a specific function");
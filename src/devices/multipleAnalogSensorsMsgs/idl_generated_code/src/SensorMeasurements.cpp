@@ -13,7 +13,6 @@
 
 bool SensorMeasurements::read_measurements(yarp::os::idl::WireReader& reader) {
   {
-    measurements.clear();
     uint32_t _size0;
     yarp::os::idl::WireState _etype3;
     reader.readListBegin(_etype3, _size0);
@@ -32,7 +31,6 @@ bool SensorMeasurements::read_measurements(yarp::os::idl::WireReader& reader) {
 }
 bool SensorMeasurements::nested_read_measurements(yarp::os::idl::WireReader& reader) {
   {
-    measurements.clear();
     uint32_t _size5;
     yarp::os::idl::WireState _etype8;
     reader.readListBegin(_etype8, _size5);
@@ -171,7 +169,7 @@ bool SensorMeasurements::Editor::read(yarp::os::ConnectionReader& connection) {
   yarp::os::idl::WireWriter writer(reader);
   if (writer.isNull()) return true;
   writer.writeListHeader(1);
-  writer.writeVocab(VOCAB2('o','k'));
+  writer.writeVocab(yarp::os::createVocab('o','k'));
   return true;
 }
 
@@ -13,7 +13,6 @@
 
 bool SensorRPCData::read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisGyroscopes.clear();
     uint32_t _size12;
     yarp::os::idl::WireState _etype15;
     reader.readListBegin(_etype15, _size12);
@@ -32,7 +31,6 @@ bool SensorRPCData::read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& reader)
 }
 bool SensorRPCData::nested_read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisGyroscopes.clear();
     uint32_t _size17;
     yarp::os::idl::WireState _etype20;
     reader.readListBegin(_etype20, _size17);
@@ -51,7 +49,6 @@ bool SensorRPCData::nested_read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& r
 }
 bool SensorRPCData::read_ThreeAxisLinearAccelerometers(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisLinearAccelerometers.clear();
     uint32_t _size22;
     yarp::os::idl::WireState _etype25;
     reader.readListBegin(_etype25, _size22);
@@ -70,7 +67,6 @@ bool SensorRPCData::read_ThreeAxisLinearAccelerometers(yarp::os::idl::WireReader
 }
 bool SensorRPCData::nested_read_ThreeAxisLinearAccelerometers(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisLinearAccelerometers.clear();
     uint32_t _size27;
     yarp::os::idl::WireState _etype30;
     reader.readListBegin(_etype30, _size27);
@@ -89,7 +85,6 @@ bool SensorRPCData::nested_read_ThreeAxisLinearAccelerometers(yarp::os::idl::Wir
 }
 bool SensorRPCData::read_ThreeAxisMagnetometers(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisMagnetometers.clear();
     uint32_t _size32;
     yarp::os::idl::WireState _etype35;
     reader.readListBegin(_etype35, _size32);
@@ -108,7 +103,6 @@ bool SensorRPCData::read_ThreeAxisMagnetometers(yarp::os::idl::WireReader& reade
 }
 bool SensorRPCData::nested_read_ThreeAxisMagnetometers(yarp::os::idl::WireReader& reader) {
   {
-    ThreeAxisMagnetometers.clear();
     uint32_t _size37;
     yarp::os::idl::WireState _etype40;
     reader.readListBegin(_etype40, _size37);
@@ -127,7 +121,6 @@ bool SensorRPCData::nested_read_ThreeAxisMagnetometers(yarp::os::idl::WireReader
 }
 bool SensorRPCData::read_OrientationSensors(yarp::os::idl::WireReader& reader) {
   {
-    OrientationSensors.clear();
     uint32_t _size42;
     yarp::os::idl::WireState _etype45;
     reader.readListBegin(_etype45, _size42);
@@ -146,7 +139,6 @@ bool SensorRPCData::read_OrientationSensors(yarp::os::idl::WireReader& reader) {
 }
 bool SensorRPCData::nested_read_OrientationSensors(yarp::os::idl::WireReader& reader) {
   {
-    OrientationSensors.clear();
     uint32_t _size47;
     yarp::os::idl::WireState _etype50;
     reader.readListBegin(_etype50, _size47);
@@ -165,7 +157,6 @@ bool SensorRPCData::nested_read_OrientationSensors(yarp::os::idl::WireReader& re
 }
 bool SensorRPCData::read_TemperatureSensors(yarp::os::idl::WireReader& reader) {
   {
-    TemperatureSensors.clear();
     uint32_t _size52;
     yarp::os::idl::WireState _etype55;
     reader.readListBegin(_etype55, _size52);
@@ -184,7 +175,6 @@ bool SensorRPCData::read_TemperatureSensors(yarp::os::idl::WireReader& reader) {
 }
 bool SensorRPCData::nested_read_TemperatureSensors(yarp::os::idl::WireReader& reader) {
   {
-    TemperatureSensors.clear();
     uint32_t _size57;
     yarp::os::idl::WireState _etype60;
     reader.readListBegin(_etype60, _size57);
@@ -203,7 +193,6 @@ bool SensorRPCData::nested_read_TemperatureSensors(yarp::os::idl::WireReader& re
 }
 bool SensorRPCData::read_SixAxisForceTorqueSensors(yarp::os::idl::WireReader& reader) {
   {
-    SixAxisForceTorqueSensors.clear();
     uint32_t _size62;
     yarp::os::idl::WireState _etype65;
     reader.readListBegin(_etype65, _size62);
@@ -222,7 +211,6 @@ bool SensorRPCData::read_SixAxisForceTorqueSensors(yarp::os::idl::WireReader& re
 }
 bool SensorRPCData::nested_read_SixAxisForceTorqueSensors(yarp::os::idl::WireReader& reader) {
   {
-    SixAxisForceTorqueSensors.clear();
     uint32_t _size67;
     yarp::os::idl::WireState _etype70;
     reader.readListBegin(_etype70, _size67);
@@ -241,7 +229,6 @@ bool SensorRPCData::nested_read_SixAxisForceTorqueSensors(yarp::os::idl::WireRea
 }
 bool SensorRPCData::read_ContactLoadCellArrays(yarp::os::idl::WireReader& reader) {
   {
-    ContactLoadCellArrays.clear();
     uint32_t _size72;
     yarp::os::idl::WireState _etype75;
     reader.readListBegin(_etype75, _size72);
@@ -260,7 +247,6 @@ bool SensorRPCData::read_ContactLoadCellArrays(yarp::os::idl::WireReader& reader
 }
 bool SensorRPCData::nested_read_ContactLoadCellArrays(yarp::os::idl::WireReader& reader) {
   {
-    ContactLoadCellArrays.clear();
     uint32_t _size77;
     yarp::os::idl::WireState _etype80;
     reader.readListBegin(_etype80, _size77);
@@ -279,7 +265,6 @@ bool SensorRPCData::nested_read_ContactLoadCellArrays(yarp::os::idl::WireReader&
 }
 bool SensorRPCData::read_EncoderArrays(yarp::os::idl::WireReader& reader) {
   {
-    EncoderArrays.clear();
     uint32_t _size82;
     yarp::os::idl::WireState _etype85;
     reader.readListBegin(_etype85, _size82);
@@ -298,7 +283,6 @@ bool SensorRPCData::read_EncoderArrays(yarp::os::idl::WireReader& reader) {
 }
 bool SensorRPCData::nested_read_EncoderArrays(yarp::os::idl::WireReader& reader) {
   {
-    EncoderArrays.clear();
     uint32_t _size87;
     yarp::os::idl::WireState _etype90;
     reader.readListBegin(_etype90, _size87);
@@ -317,7 +301,6 @@ bool SensorRPCData::nested_read_EncoderArrays(yarp::os::idl::WireReader& reader)
 }
 bool SensorRPCData::read_SkinPatches(yarp::os::idl::WireReader& reader) {
   {
-    SkinPatches.clear();
     uint32_t _size92;
     yarp::os::idl::WireState _etype95;
     reader.readListBegin(_etype95, _size92);
@@ -336,7 +319,6 @@ bool SensorRPCData::read_SkinPatches(yarp::os::idl::WireReader& reader) {
 }
 bool SensorRPCData::nested_read_SkinPatches(yarp::os::idl::WireReader& reader) {
   {
-    SkinPatches.clear();
     uint32_t _size97;
     yarp::os::idl::WireState _etype100;
     reader.readListBegin(_etype100, _size97);
@@ -803,7 +785,7 @@ bool SensorRPCData::Editor::read(yarp::os::ConnectionReader& connection) {
   yarp::os::idl::WireWriter writer(reader);
   if (writer.isNull()) return true;
   writer.writeListHeader(1);
-  writer.writeVocab(VOCAB2('o','k'));
+  writer.writeVocab(yarp::os::createVocab('o','k'));
   return true;
 }
 
@@ -0,0 +1,781 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+// This is an automatically generated file.
+// It could get re-generated if the ALLOW_IDL_GENERATION flag is on.
+
+#include <SensorStreamingLayout.h>
+
+bool SensorStreamingLayout::read_flat(yarp::os::idl::WireReader& reader) {
+  if (!reader.readBool(flat)) {
+    reader.fail();
+    return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_flat(yarp::os::idl::WireReader& reader) {
+  if (!reader.readBool(flat)) {
+    reader.fail();
+    return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size120;
+    yarp::os::idl::WireState _etype123;
+    reader.readListBegin(_etype123, _size120);
+    ThreeAxisGyroscopes.resize(_size120);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisGyroscopes.data(), _size120))
+    {
+      uint32_t _i124;
+      for (_i124 = 0; _i124 < _size120; ++_i124)
+      {
+        if (!reader.readI32(ThreeAxisGyroscopes[_i124])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_ThreeAxisGyroscopes(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size125;
+    yarp::os::idl::WireState _etype128;
+    reader.readListBegin(_etype128, _size125);
+    ThreeAxisGyroscopes.resize(_size125);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisGyroscopes.data(), _size125))
+    {
+      uint32_t _i129;
+      for (_i129 = 0; _i129 < _size125; ++_i129)
+      {
+        if (!reader.readI32(ThreeAxisGyroscopes[_i129])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_ThreeAxisLinearAccelerometers(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size130;
+    yarp::os::idl::WireState _etype133;
+    reader.readListBegin(_etype133, _size130);
+    ThreeAxisLinearAccelerometers.resize(_size130);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisLinearAccelerometers.data(), _size130))
+    {
+      uint32_t _i134;
+      for (_i134 = 0; _i134 < _size130; ++_i134)
+      {
+        if (!reader.readI32(ThreeAxisLinearAccelerometers[_i134])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_ThreeAxisLinearAccelerometers(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size135;
+    yarp::os::idl::WireState _etype138;
+    reader.readListBegin(_etype138, _size135);
+    ThreeAxisLinearAccelerometers.resize(_size135);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisLinearAccelerometers.data(), _size135))
+    {
+      uint32_t _i139;
+      for (_i139 = 0; _i139 < _size135; ++_i139)
+      {
+        if (!reader.readI32(ThreeAxisLinearAccelerometers[_i139])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_ThreeAxisMagnetometers(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size140;
+    yarp::os::idl::WireState _etype143;
+    reader.readListBegin(_etype143, _size140);
+    ThreeAxisMagnetometers.resize(_size140);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisMagnetometers.data(), _size140))
+    {
+      uint32_t _i144;
+      for (_i144 = 0; _i144 < _size140; ++_i144)
+      {
+        if (!reader.readI32(ThreeAxisMagnetometers[_i144])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_ThreeAxisMagnetometers(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size145;
+    yarp::os::idl::WireState _etype148;
+    reader.readListBegin(_etype148, _size145);
+    ThreeAxisMagnetometers.resize(_size145);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ThreeAxisMagnetometers.data(), _size145))
+    {
+      uint32_t _i149;
+      for (_i149 = 0; _i149 < _size145; ++_i149)
+      {
+        if (!reader.readI32(ThreeAxisMagnetometers[_i149])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_OrientationSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size150;
+    yarp::os::idl::WireState _etype153;
+    reader.readListBegin(_etype153, _size150);
+    OrientationSensors.resize(_size150);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, OrientationSensors.data(), _size150))
+    {
+      uint32_t _i154;
+      for (_i154 = 0; _i154 < _size150; ++_i154)
+      {
+        if (!reader.readI32(OrientationSensors[_i154])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_OrientationSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size155;
+    yarp::os::idl::WireState _etype158;
+    reader.readListBegin(_etype158, _size155);
+    OrientationSensors.resize(_size155);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, OrientationSensors.data(), _size155))
+    {
+      uint32_t _i159;
+      for (_i159 = 0; _i159 < _size155; ++_i159)
+      {
+        if (!reader.readI32(OrientationSensors[_i159])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_TemperatureSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size160;
+    yarp::os::idl::WireState _etype163;
+    reader.readListBegin(_etype163, _size160);
+    TemperatureSensors.resize(_size160);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, TemperatureSensors.data(), _size160))
+    {
+      uint32_t _i164;
+      for (_i164 = 0; _i164 < _size160; ++_i164)
+      {
+        if (!reader.readI32(TemperatureSensors[_i164])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_TemperatureSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size165;
+    yarp::os::idl::WireState _etype168;
+    reader.readListBegin(_etype168, _size165);
+    TemperatureSensors.resize(_size165);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, TemperatureSensors.data(), _size165))
+    {
+      uint32_t _i169;
+      for (_i169 = 0; _i169 < _size165; ++_i169)
+      {
+        if (!reader.readI32(TemperatureSensors[_i169])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_SixAxisForceTorqueSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size170;
+    yarp::os::idl::WireState _etype173;
+    reader.readListBegin(_etype173, _size170);
+    SixAxisForceTorqueSensors.resize(_size170);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, SixAxisForceTorqueSensors.data(), _size170))
+    {
+      uint32_t _i174;
+      for (_i174 = 0; _i174 < _size170; ++_i174)
+      {
+        if (!reader.readI32(SixAxisForceTorqueSensors[_i174])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_SixAxisForceTorqueSensors(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size175;
+    yarp::os::idl::WireState _etype178;
+    reader.readListBegin(_etype178, _size175);
+    SixAxisForceTorqueSensors.resize(_size175);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, SixAxisForceTorqueSensors.data(), _size175))
+    {
+      uint32_t _i179;
+      for (_i179 = 0; _i179 < _size175; ++_i179)
+      {
+        if (!reader.readI32(SixAxisForceTorqueSensors[_i179])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_ContactLoadCellArrays(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size180;
+    yarp::os::idl::WireState _etype183;
+    reader.readListBegin(_etype183, _size180);
+    ContactLoadCellArrays.resize(_size180);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ContactLoadCellArrays.data(), _size180))
+    {
+      uint32_t _i184;
+      for (_i184 = 0; _i184 < _size180; ++_i184)
+      {
+        if (!reader.readI32(ContactLoadCellArrays[_i184])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_ContactLoadCellArrays(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size185;
+    yarp::os::idl::WireState _etype188;
+    reader.readListBegin(_etype188, _size185);
+    ContactLoadCellArrays.resize(_size185);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, ContactLoadCellArrays.data(), _size185))
+    {
+      uint32_t _i189;
+      for (_i189 = 0; _i189 < _size185; ++_i189)
+      {
+        if (!reader.readI32(ContactLoadCellArrays[_i189])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_EncoderArrays(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size190;
+    yarp::os::idl::WireState _etype193;
+    reader.readListBegin(_etype193, _size190);
+    EncoderArrays.resize(_size190);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, EncoderArrays.data(), _size190))
+    {
+      uint32_t _i194;
+      for (_i194 = 0; _i194 < _size190; ++_i194)
+      {
+        if (!reader.readI32(EncoderArrays[_i194])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_EncoderArrays(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size195;
+    yarp::os::idl::WireState _etype198;
+    reader.readListBegin(_etype198, _size195);
+    EncoderArrays.resize(_size195);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, EncoderArrays.data(), _size195))
+    {
+      uint32_t _i199;
+      for (_i199 = 0; _i199 < _size195; ++_i199)
+      {
+        if (!reader.readI32(EncoderArrays[_i199])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read_SkinPatches(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size200;
+    yarp::os::idl::WireState _etype203;
+    reader.readListBegin(_etype203, _size200);
+    SkinPatches.resize(_size200);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, SkinPatches.data(), _size200))
+    {
+      uint32_t _i204;
+      for (_i204 = 0; _i204 < _size200; ++_i204)
+      {
+        if (!reader.readI32(SkinPatches[_i204])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_read_SkinPatches(yarp::os::idl::WireReader& reader) {
+  {
+    uint32_t _size205;
+    yarp::os::idl::WireState _etype208;
+    reader.readListBegin(_etype208, _size205);
+    SkinPatches.resize(_size205);
+    if (!reader.readListBlock(BOTTLE_TAG_INT32, SkinPatches.data(), _size205))
+    {
+      uint32_t _i209;
+      for (_i209 = 0; _i209 < _size205; ++_i209)
+      {
+        if (!reader.readI32(SkinPatches[_i209])) {
+          reader.fail();
+          return false;
+        }
+      }
+    }
+    reader.readListEnd();
+  }
+  return true;
+}
+bool SensorStreamingLayout::read(yarp::os::idl::WireReader& reader) {
+  if (!read_flat(reader)) return false;
+  if (!read_ThreeAxisGyroscopes(reader)) return false;
+  if (!read_ThreeAxisLinearAccelerometers(reader)) return false;
+  if (!read_ThreeAxisMagnetometers(reader)) return false;
+  if (!read_OrientationSensors(reader)) return false;
+  if (!read_TemperatureSensors(reader)) return false;
+  if (!read_SixAxisForceTorqueSensors(reader)) return false;
+  if (!read_ContactLoadCellArrays(reader)) return false;
+  if (!read_EncoderArrays(reader)) return false;
+  if (!read_SkinPatches(reader)) return false;
+  return !reader.isError();
+}
+
+bool SensorStreamingLayout::read(yarp::os::ConnectionReader& connection) {
+  yarp::os::idl::WireReader reader(connection);
+  if (!reader.readListHeader(10)) return false;
+  return read(reader);
+}
+
+bool SensorStreamingLayout::write_flat(const yarp::os::idl::WireWriter& writer) const {
+  if (!writer.writeBool(flat)) return false;
+  return true;
+}
+bool SensorStreamingLayout::nested_write_flat(const yarp::os::idl::WireWriter& writer) const {
+  if (!writer.writeBool(flat)) return false;
+  return true;
+}
+bool SensorStreamingLayout::write_ThreeAxisGyroscopes(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisGyroscopes.data(), static_cast<uint32_t>(ThreeAxisGyroscopes.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_ThreeAxisGyroscopes(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisGyroscopes.data(), static_cast<uint32_t>(ThreeAxisGyroscopes.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_ThreeAxisLinearAccelerometers(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisLinearAccelerometers.data(), static_cast<uint32_t>(ThreeAxisLinearAccelerometers.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_ThreeAxisLinearAccelerometers(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisLinearAccelerometers.data(), static_cast<uint32_t>(ThreeAxisLinearAccelerometers.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_ThreeAxisMagnetometers(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisMagnetometers.data(), static_cast<uint32_t>(ThreeAxisMagnetometers.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_ThreeAxisMagnetometers(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ThreeAxisMagnetometers.data(), static_cast<uint32_t>(ThreeAxisMagnetometers.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_OrientationSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, OrientationSensors.data(), static_cast<uint32_t>(OrientationSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_OrientationSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, OrientationSensors.data(), static_cast<uint32_t>(OrientationSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_TemperatureSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, TemperatureSensors.data(), static_cast<uint32_t>(TemperatureSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_TemperatureSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, TemperatureSensors.data(), static_cast<uint32_t>(TemperatureSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_SixAxisForceTorqueSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, SixAxisForceTorqueSensors.data(), static_cast<uint32_t>(SixAxisForceTorqueSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_SixAxisForceTorqueSensors(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, SixAxisForceTorqueSensors.data(), static_cast<uint32_t>(SixAxisForceTorqueSensors.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_ContactLoadCellArrays(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ContactLoadCellArrays.data(), static_cast<uint32_t>(ContactLoadCellArrays.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_ContactLoadCellArrays(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, ContactLoadCellArrays.data(), static_cast<uint32_t>(ContactLoadCellArrays.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_EncoderArrays(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, EncoderArrays.data(), static_cast<uint32_t>(EncoderArrays.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_EncoderArrays(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, EncoderArrays.data(), static_cast<uint32_t>(EncoderArrays.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write_SkinPatches(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, SkinPatches.data(), static_cast<uint32_t>(SkinPatches.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::nested_write_SkinPatches(const yarp::os::idl::WireWriter& writer) const {
+  {
+    if (!writer.writeListBlock(BOTTLE_TAG_INT32, SkinPatches.data(), static_cast<uint32_t>(SkinPatches.size()))) return false;
+  }
+  return true;
+}
+bool SensorStreamingLayout::write(const yarp::os::idl::WireWriter& writer) const {
+  if (!write_flat(writer)) return false;
+  if (!write_ThreeAxisGyroscopes(writer)) return false;
+  if (!write_ThreeAxisLinearAccelerometers(writer)) return false;
+  if (!write_ThreeAxisMagnetometers(writer)) return false;
+  if (!write_OrientationSensors(writer)) return false;
+  if (!write_TemperatureSensors(writer)) return false;
+  if (!write_SixAxisForceTorqueSensors(writer)) return false;
+  if (!write_ContactLoadCellArrays(writer)) return false;
+  if (!write_EncoderArrays(writer)) return false;
+  if (!write_SkinPatches(writer)) return false;
+  return !writer.isError();
+}
+
+bool SensorStreamingLayout::write(yarp::os::ConnectionWriter& connection) const {
+  yarp::os::idl::WireWriter writer(connection);
+  if (!writer.writeListHeader(10)) return false;
+  return write(writer);
+}
+bool SensorStreamingLayout::Editor::write(yarp::os::ConnectionWriter& connection) const {
+  if (!isValid()) return false;
+  yarp::os::idl::WireWriter writer(connection);
+  if (!writer.writeListHeader(dirty_count+1)) return false;
+  if (!writer.writeString("patch")) return false;
+  if (is_dirty_flat) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("flat")) return false;
+    if (!obj->nested_write_flat(writer)) return false;
+  }
+  if (is_dirty_ThreeAxisGyroscopes) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("ThreeAxisGyroscopes")) return false;
+    if (!obj->nested_write_ThreeAxisGyroscopes(writer)) return false;
+  }
+  if (is_dirty_ThreeAxisLinearAccelerometers) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("ThreeAxisLinearAccelerometers")) return false;
+    if (!obj->nested_write_ThreeAxisLinearAccelerometers(writer)) return false;
+  }
+  if (is_dirty_ThreeAxisMagnetometers) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("ThreeAxisMagnetometers")) return false;
+    if (!obj->nested_write_ThreeAxisMagnetometers(writer)) return false;
+  }
+  if (is_dirty_OrientationSensors) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("OrientationSensors")) return false;
+    if (!obj->nested_write_OrientationSensors(writer)) return false;
+  }
+  if (is_dirty_TemperatureSensors) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("TemperatureSensors")) return false;
+    if (!obj->nested_write_TemperatureSensors(writer)) return false;
+  }
+  if (is_dirty_SixAxisForceTorqueSensors) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("SixAxisForceTorqueSensors")) return false;
+    if (!obj->nested_write_SixAxisForceTorqueSensors(writer)) return false;
+  }
+  if (is_dirty_ContactLoadCellArrays) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("ContactLoadCellArrays")) return false;
+    if (!obj->nested_write_ContactLoadCellArrays(writer)) return false;
+  }
+  if (is_dirty_EncoderArrays) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("EncoderArrays")) return false;
+    if (!obj->nested_write_EncoderArrays(writer)) return false;
+  }
+  if (is_dirty_SkinPatches) {
+    if (!writer.writeListHeader(3)) return false;
+    if (!writer.writeString("set")) return false;
+    if (!writer.writeString("SkinPatches")) return false;
+    if (!obj->nested_write_SkinPatches(writer)) return false;
+  }
+  return !writer.isError();
+}
+bool SensorStreamingLayout::Editor::read(yarp::os::ConnectionReader& connection) {
+  if (!isValid()) return false;
+  yarp::os::idl::WireReader reader(connection);
+  reader.expectAccept();
+  if (!reader.readListHeader()) return false;
+  int len = reader.getLength();
+  if (len==0) {
+    yarp::os::idl::WireWriter writer(reader);
+    if (writer.isNull()) return true;
+    if (!writer.writeListHeader(1)) return false;
+    writer.writeString("send: 'help' or 'patch (param1 val1) (param2 val2)'");
+    return true;
+  }
+  std::string tag;
+  if (!reader.readString(tag)) return false;
+  if (tag=="help") {
+    yarp::os::idl::WireWriter writer(reader);
+    if (writer.isNull()) return true;
+    if (!writer.writeListHeader(2)) return false;
+    if (!writer.writeTag("many",1, 0)) return false;
+    if (reader.getLength()>0) {
+      std::string field;
+      if (!reader.readString(field)) return false;
+      if (field=="flat") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("bool flat")) return false;
+      }
+      if (field=="ThreeAxisGyroscopes") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  ThreeAxisGyroscopes")) return false;
+      }
+      if (field=="ThreeAxisLinearAccelerometers") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  ThreeAxisLinearAccelerometers")) return false;
+      }
+      if (field=="ThreeAxisMagnetometers") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  ThreeAxisMagnetometers")) return false;
+      }
+      if (field=="OrientationSensors") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  OrientationSensors")) return false;
+      }
+      if (field=="TemperatureSensors") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  TemperatureSensors")) return false;
+      }
+      if (field=="SixAxisForceTorqueSensors") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  SixAxisForceTorqueSensors")) return false;
+      }
+      if (field=="ContactLoadCellArrays") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  ContactLoadCellArrays")) return false;
+      }
+      if (field=="EncoderArrays") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  EncoderArrays")) return false;
+      }
+      if (field=="SkinPatches") {
+        if (!writer.writeListHeader(1)) return false;
+        if (!writer.writeString("std::vector<std::int32_t>  SkinPatches")) return false;
+      }
+    }
+    if (!writer.writeListHeader(11)) return false;
+    writer.writeString("*** Available fields:");
+    writer.writeString("flat");
+    writer.writeString("ThreeAxisGyroscopes");
+    writer.writeString("ThreeAxisLinearAccelerometers");
+    writer.writeString("ThreeAxisMagnetometers");
+    writer.writeString("OrientationSensors");
+    writer.writeString("TemperatureSensors");
+    writer.writeString("SixAxisForceTorqueSensors");
+    writer.writeString("ContactLoadCellArrays");
+    writer.writeString("EncoderArrays");
+    writer.writeString("SkinPatches");
+    return true;
+  }
+  bool nested = true;
+  bool have_act = false;
+  if (tag!="patch") {
+    if ((len-1)%2 != 0) return false;
+    len = 1 + ((len-1)/2);
+    nested = false;
+    have_act = true;
+  }
+  for (int i=1; i<len; i++) {
+    if (nested && !reader.readListHeader(3)) return false;
+    std::string act;
+    std::string key;
+    if (have_act) {
+      act = tag;
+    } else {
+      if (!reader.readString(act)) return false;
+    }
+    if (!reader.readString(key)) return false;
+    // inefficient code follows, bug paulfitz to improve it
+    if (key == "flat") {
+      will_set_flat();
+      if (!obj->nested_read_flat(reader)) return false;
+      did_set_flat();
+    } else if (key == "ThreeAxisGyroscopes") {
+      will_set_ThreeAxisGyroscopes();
+      if (!obj->nested_read_ThreeAxisGyroscopes(reader)) return false;
+      did_set_ThreeAxisGyroscopes();
+    } else if (key == "ThreeAxisLinearAccelerometers") {
+      will_set_ThreeAxisLinearAccelerometers();
+      if (!obj->nested_read_ThreeAxisLinearAccelerometers(reader)) return false;
+      did_set_ThreeAxisLinearAccelerometers();
+    } else if (key == "ThreeAxisMagnetometers") {
+      will_set_ThreeAxisMagnetometers();
+      if (!obj->nested_read_ThreeAxisMagnetometers(reader)) return false;
+      did_set_ThreeAxisMagnetometers();
+    } else if (key == "OrientationSensors") {
+      will_set_OrientationSensors();
+      if (!obj->nested_read_OrientationSensors(reader)) return false;
+      did_set_OrientationSensors();
+    } else if (key == "TemperatureSensors") {
+      will_set_TemperatureSensors();
+      if (!obj->nested_read_TemperatureSensors(reader)) return false;
+      did_set_TemperatureSensors();
+    } else if (key == "SixAxisForceTorqueSensors") {
+      will_set_SixAxisForceTorqueSensors();
+      if (!obj->nested_read_SixAxisForceTorqueSensors(reader)) return false;
+      did_set_SixAxisForceTorqueSensors();
+    } else if (key == "ContactLoadCellArrays") {
+      will_set_ContactLoadCellArrays();
+      if (!obj->nested_read_ContactLoadCellArrays(reader)) return false;
+      did_set_ContactLoadCellArrays();
+    } else if (key == "EncoderArrays") {
+      will_set_EncoderArrays();
+      if (!obj->nested_read_EncoderArrays(reader)) return false;
+      did_set_EncoderArrays();
+    } else if (key == "SkinPatches") {
+      will_set_SkinPatches();
+      if (!obj->nested_read_SkinPatches(reader)) return false;
+      did_set_SkinPatches();
+    } else {
+      // would be useful to have a fallback here
+    }
+  }
+  reader.accept();
+  yarp::os::idl::WireWriter writer(reader);
+  if (writer.isNull()) return true;
+  writer.writeListHeader(1);
+  writer.writeVocab(yarp::os::createVocab('o','k'));
+  return true;
+}
+
+std::string SensorStreamingLayout::toString() const {
+  yarp::os::Bottle b;
+  b.read(*this);
+  return b.toString();
+}
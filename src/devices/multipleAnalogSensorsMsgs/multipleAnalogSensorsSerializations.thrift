@@ -54,10 +54,35 @@ struct SensorRPCData
   9: list<SensorMetadata> SkinPatches;
 }
 
+/**
+ * Layout of the measurements streamed in the flat format, see SensorStreamingBlock.
+ * For each sensor type, the size of the measurement of each sensor.
+ */
+struct SensorStreamingLayout
+{
+  1: bool flat;
+  2: list<i32> ThreeAxisGyroscopes;
+  3: list<i32> ThreeAxisLinearAccelerometers;
+  4: list<i32> ThreeAxisMagnetometers;
+  5: list<i32> OrientationSensors;
+  6: list<i32> TemperatureSensors;
+  7: list<i32> SixAxisForceTorqueSensors;
+  8: list<i32> ContactLoadCellArrays;
+  9: list<i32> EncoderArrays;
+  10: list<i32> SkinPatches;
+}
+
 service MultipleAnalogSensorsMetadata
 {
   /**
    * Read the sensor metadata necessary to configure the MultipleAnalogSensorsClient device.
    */
   SensorRPCData getMetadata();
+
+  /**
+   * Read the format of the measurements streamed by the server: if flat is
+   * false the measurements are streamed as SensorStreamingData, otherwise
+   * as a SensorStreamingBlock with the given layout.
+   */
+  SensorStreamingLayout getStreamingLayout();
 }
@@ -13,15 +13,132 @@
 
 #include <yarp/os/LockGuard.h>
 
+#include <algorithm>
+
 namespace yarp {
 namespace dev {
 
-void SensorStreamingDataInputPort::onRead(SensorStreamingData& v)
+namespace {
+
+// computes the offsets of the measurements in a block, returns the size of the block
+size_t computeOffsets(const std::vector<std::int32_t>& sizes, std::vector<size_t>& offsets)
+{
+    offsets.resize(sizes.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        // the timestamp is followed by the measurement
+        offsets[i + 1] = offsets[i] + 1 + sizes[i];
+    }
+    return offsets.back();
+}
+
+// copies the thrift measurements of a sensor type into a block
+void flatten(const SensorMeasurements& measurements, std::vector<double>& block, std::vector<size_t>& offsets)
+{
+    const std::vector<SensorMeasurement>& m = measurements.measurements;
+    offsets.resize(m.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < m.size(); i++)
+    {
+        offsets[i + 1] = offsets[i] + 1 + m[i].measurement.size();
+    }
+    block.resize(offsets.back());
+    for (size_t i = 0; i < m.size(); i++)
+    {
+        block[offsets[i]] = m[i].timestamp;
+        std::copy(m[i].measurement.data(), m[i].measurement.data() + m[i].measurement.size(), block.begin() + offsets[i] + 1);
+    }
+}
+
+} // namespace
+
+void SensorStreamingDataInputPort::setLayout(const SensorStreamingLayout& layout)
 {
+    flat = layout.flat;
+    if (!flat)
+    {
+        return;
+    }
+    const std::vector<std::int32_t>* sizes[SensorStreamingBlock::nrOfSensorTypes] = {
+        &layout.ThreeAxisGyroscopes,
+        &layout.ThreeAxisLinearAccelerometers,
+        &layout.ThreeAxisMagnetometers,
+        &layout.OrientationSensors,
+        &layout.TemperatureSensors,
+        &layout.SixAxisForceTorqueSensors,
+        &layout.ContactLoadCellArrays,
+        &layout.EncoderArrays,
+        &layout.SkinPatches
+    };
+    for (size_t t = 0; t < SensorStreamingBlock::nrOfSensorTypes; t++)
+    {
+        size_t blockSize = computeOffsets(*sizes[t], offsets[t]);
+        incomingOffsets[t] = offsets[t];
+        incomingBlock.blocks[t].reserve(blockSize);
+        receivedData.blocks[t].reserve(blockSize);
+    }
+}
+
+bool SensorStreamingDataInputPort::read(yarp::os::ConnectionReader& connection)
+{
+    // The message is read without holding the lock, so that the
+    // measurements received before stay available in the meantime
+    if (flat)
+    {
+        if (!incomingBlock.read(connection))
+        {
+            return false;
+        }
+        for (size_t t = 0; t < SensorStreamingBlock::nrOfSensorTypes; t++)
+        {
+            if (incomingBlock.blocks[t].size() != incomingOffsets[t].back())
+            {
+                yError("MultipleAnalogSensorsClient: received measurements do not match the layout sent by the server.");
+                return false;
+            }
+        }
+    }
+    else
+    {
+        if (!incomingData.read(connection))
+        {
+            return false;
+        }
+        const SensorMeasurements* measurements[SensorStreamingBlock::nrOfSensorTypes] = {
+            &incomingData.ThreeAxisGyroscopes,
+            &incomingData.ThreeAxisLinearAccelerometers,
+            &incomingData.ThreeAxisMagnetometers,
+            &incomingData.OrientationSensors,
+            &incomingData.TemperatureSensors,
+            &incomingData.SixAxisForceTorqueSensors,
+            &incomingData.ContactLoadCellArrays,
+            &incomingData.EncoderArrays,
+            &incomingData.SkinPatches
+        };
+        for (size_t t = 0; t < SensorStreamingBlock::nrOfSensorTypes; t++)
+        {
+            flatten(*measurements[t], incomingBlock.blocks[t], incomingOffsets[t]);
+        }
+    }
+
     std::lock_guard<std::mutex> guard(dataMutex);
-    receivedData = v;
+    for (size_t t = 0; t < SensorStreamingBlock::nrOfSensorTypes; t++)
+    {
+        receivedData.blocks[t].swap(incomingBlock.blocks[t]);
+        offsets[t].swap(incomingOffsets[t]);
+    }
+    if (flat)
+    {
+        // the offsets do not change with the flat format
+        for (size_t t = 0; t < SensorStreamingBlock::nrOfSensorTypes; t++)
+        {
+            incomingOffsets[t] = offsets[t];
+        }
+    }
     lastTimeStampReadInSeconds = yarp::os::Time::now();
     status = yarp::dev::MAS_OK;
+    return true;
 }
 
 void SensorStreamingDataInputPort::updateTimeoutStatus() const
@@ -80,8 +197,8 @@ bool MultipleAnalogSensorsClient::open(yarp::os::Searchable& config)
         return false;
     }
 
-    ok = m_streamingPort.open(m_localStreamingPortName);
-    m_streamingPort.useCallback();
+    m_streamingPort.port.setReader(m_streamingPort);
+    ok = m_streamingPort.port.open(m_localStreamingPortName);
     if (!ok)
     {
         yError("MultipleAnalogSensorsClient: Failure to open the port %s.", m_localStreamingPortName.c_str());
@@ -100,16 +217,6 @@ bool MultipleAnalogSensorsClient::open(yarp::os::Searchable& config)
     }
     m_RPCConnectionActive = true;
 
-    ok = yarp::os::Network::connect(m_remoteStreamingPortName, m_localStreamingPortName);
-    if (!ok)
-    {
-        yError("MultipleAnalogSensorsClient: Failure connecting port %s to %s.", m_remoteStreamingPortName.c_str(), m_localStreamingPortName.c_str());
-        yError("MultipleAnalogSensorsClient: Check that the specified MultipleAnalogSensorsServer is up.");
-        close();
-        return false;
-    }
-    m_StreamingConnectionActive = true;
-
     // Once the connection is active, we just the metadata only once
     ok = m_RPCInterface.yarp().attachAsClient(m_rpcPort);
     if (!ok)
@@ -124,6 +231,21 @@ bool MultipleAnalogSensorsClient::open(yarp::os::Searchable& config)
     // here
     m_sensorsMetadata = m_RPCInterface.getMetadata();
 
+    // The format of the streaming data must be known before receiving it.
+    // A server that does not support the flat format returns a default
+    // layout, with flat set to false.
+    m_streamingPort.setLayout(m_RPCInterface.getStreamingLayout());
+
+    ok = yarp::os::Network::connect(m_remoteStreamingPortName, m_localStreamingPortName);
+    if (!ok)
+    {
+        yError("MultipleAnalogSensorsClient: Failure connecting port %s to %s.", m_remoteStreamingPortName.c_str(), m_localStreamingPortName.c_str());
+        yError("MultipleAnalogSensorsClient: Check that the specified MultipleAnalogSensorsServer is up.");
+        close();
+        return false;
+    }
+    m_StreamingConnectionActive = true;
+
     return true;
 }
 
@@ -138,7 +260,7 @@ bool MultipleAnalogSensorsClient::close()
         yarp::os::Network::disconnect(m_localRPCPortName, m_remoteRPCPortName);
     }
 
-    m_streamingPort.close();
+    m_streamingPort.port.close();
     m_rpcPort.close();
 
     return true;
@@ -185,7 +307,7 @@ bool MultipleAnalogSensorsClient::genericGetFrameName(const  std::vector<SensorM
 }
 
 bool MultipleAnalogSensorsClient::genericGetMeasure(const std::vector<SensorMetadata>& metadataVector, const std::string& tag,
-                                                    const SensorMeasurements& measurementsVector,
+                                                    SensorStreamingBlock::SensorType type,
                                                     size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     if (sens_index >= metadataVector.size())
@@ -204,16 +326,24 @@ bool MultipleAnalogSensorsClient::genericGetMeasure(const std::vector<SensorMeta
         return false;
     }
 
-    assert(metadataVector.size() == measurementsVector.measurements.size());
+    const std::vector<size_t>& offsets = m_streamingPort.offsets[type];
+    if (sens_index + 1 >= offsets.size())
+    {
+        yError("MultipleAnalogSensorsClient: No measurement received for sensor of type %s with index %lu.",
+               tag.c_str(), sens_index);
+        return false;
+    }
 
-    timestamp = measurementsVector.measurements[sens_index].timestamp;
-    out = measurementsVector.measurements[sens_index].measurement;
+    const double* measurement = m_streamingPort.receivedData.blocks[type].data() + offsets[sens_index];
+    timestamp = measurement[0];
+    out.resize(offsets[sens_index + 1] - offsets[sens_index] - 1);
+    std::copy(measurement + 1, measurement + 1 + out.size(), out.data());
 
     return true;
 }
 
 size_t MultipleAnalogSensorsClient::genericGetSize(const std::vector<SensorMetadata>& metadataVector,
-                                                   const std::string& tag, const SensorMeasurements& measurementsVector, size_t sens_index) const
+                                                   const std::string& tag, SensorStreamingBlock::SensorType type, size_t sens_index) const
 {
     if (sens_index >= metadataVector.size())
     {
@@ -229,7 +359,12 @@ size_t MultipleAnalogSensorsClient::genericGetSize(const std::vector<SensorMetad
         return 0;
     }
 
-    return measurementsVector.measurements[sens_index].measurement.size();
+    const std::vector<size_t>& offsets = m_streamingPort.offsets[type];
+    if (sens_index + 1 >= offsets.size())
+    {
+        return 0;
+    }
+    return offsets[sens_index + 1] - offsets[sens_index] - 1;
 }
 
 /*
@@ -257,7 +392,7 @@ bool MultipleAnalogSensorsClient::get{{SensorSingular}}Name(size_t sens_index, s
 bool MultipleAnalogSensorsClient::get{{SensorSingular}}Measure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.{{SensorTag}}, "{{SensorTag}}",
-                             m_streamingPort.receivedData.{{SensorTag}}, sens_index, out, timestamp);
+                             SensorStreamingBlock::{{SensorTag}}, sens_index, out, timestamp);
 }
 
 For the sensors (EncoderArray and SkinPatch) of which the measurements can change size, we also have:
@@ -291,7 +426,7 @@ bool MultipleAnalogSensorsClient::getThreeAxisGyroscopeFrameName(size_t sens_ind
 bool MultipleAnalogSensorsClient::getThreeAxisGyroscopeMeasure(size_t sens_index, yarp::sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.ThreeAxisGyroscopes, "ThreeAxisGyroscopes",
-                             m_streamingPort.receivedData.ThreeAxisGyroscopes, sens_index, out, timestamp);
+                             SensorStreamingBlock::ThreeAxisGyroscopes, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfThreeAxisLinearAccelerometers() const
@@ -317,7 +452,7 @@ bool MultipleAnalogSensorsClient::getThreeAxisLinearAccelerometerFrameName(size_
 bool MultipleAnalogSensorsClient::getThreeAxisLinearAccelerometerMeasure(size_t sens_index, yarp::sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.ThreeAxisLinearAccelerometers, "ThreeAxisLinearAccelerometers",
-                             m_streamingPort.receivedData.ThreeAxisLinearAccelerometers, sens_index, out, timestamp);
+                             SensorStreamingBlock::ThreeAxisLinearAccelerometers, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfThreeAxisMagnetometers() const
@@ -343,7 +478,7 @@ bool MultipleAnalogSensorsClient::getThreeAxisMagnetometerFrameName(size_t sens_
 bool MultipleAnalogSensorsClient::getThreeAxisMagnetometerMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.ThreeAxisMagnetometers, "ThreeAxisMagnetometers",
-                             m_streamingPort.receivedData.ThreeAxisMagnetometers, sens_index, out, timestamp);
+                             SensorStreamingBlock::ThreeAxisMagnetometers, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfOrientationSensors() const
@@ -369,7 +504,7 @@ bool MultipleAnalogSensorsClient::getOrientationSensorFrameName(size_t sens_inde
 bool MultipleAnalogSensorsClient::getOrientationSensorMeasureAsRollPitchYaw(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.OrientationSensors, "OrientationSensors",
-                             m_streamingPort.receivedData.OrientationSensors, sens_index, out, timestamp);
+                             SensorStreamingBlock::OrientationSensors, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfTemperatureSensors() const
@@ -395,7 +530,7 @@ bool MultipleAnalogSensorsClient::getTemperatureSensorFrameName(size_t sens_inde
 bool MultipleAnalogSensorsClient::getTemperatureSensorMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.TemperatureSensors, "TemperatureSensors",
-                             m_streamingPort.receivedData.TemperatureSensors, sens_index, out, timestamp);
+                             SensorStreamingBlock::TemperatureSensors, sens_index, out, timestamp);
 }
 
 bool MultipleAnalogSensorsClient::getTemperatureSensorMeasure(size_t sens_index, double& out, double& timestamp) const
@@ -429,7 +564,7 @@ bool MultipleAnalogSensorsClient::getSixAxisForceTorqueSensorFrameName(size_t se
 bool MultipleAnalogSensorsClient::getSixAxisForceTorqueSensorMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.SixAxisForceTorqueSensors, "SixAxisForceTorqueSensors",
-                             m_streamingPort.receivedData.SixAxisForceTorqueSensors, sens_index, out, timestamp);
+                             SensorStreamingBlock::SixAxisForceTorqueSensors, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfContactLoadCellArrays() const
@@ -450,13 +585,13 @@ bool MultipleAnalogSensorsClient::getContactLoadCellArrayName(size_t sens_index,
 bool MultipleAnalogSensorsClient::getContactLoadCellArrayMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.ContactLoadCellArrays, "ContactLoadCellArrays",
-                             m_streamingPort.receivedData.ContactLoadCellArrays, sens_index, out, timestamp);
+                             SensorStreamingBlock::ContactLoadCellArrays, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getContactLoadCellArraySize(size_t sens_index) const
 {
     return genericGetSize(m_sensorsMetadata.ContactLoadCellArrays, "ContactLoadCellArrays",
-                          m_streamingPort.receivedData.ContactLoadCellArrays, sens_index);
+                          SensorStreamingBlock::ContactLoadCellArrays, sens_index);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfEncoderArrays() const
@@ -477,13 +612,13 @@ bool MultipleAnalogSensorsClient::getEncoderArrayName(size_t sens_index, std::st
 bool MultipleAnalogSensorsClient::getEncoderArrayMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.EncoderArrays, "EncoderArrays",
-                             m_streamingPort.receivedData.EncoderArrays, sens_index, out, timestamp);
+                             SensorStreamingBlock::EncoderArrays, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getEncoderArraySize(size_t sens_index) const
 {
     return genericGetSize(m_sensorsMetadata.EncoderArrays, "EncoderArrays",
-                          m_streamingPort.receivedData.EncoderArrays, sens_index);
+                          SensorStreamingBlock::EncoderArrays, sens_index);
 }
 
 size_t MultipleAnalogSensorsClient::getNrOfSkinPatches() const
@@ -504,13 +639,13 @@ bool MultipleAnalogSensorsClient::getSkinPatchName(size_t sens_index, std::strin
 bool MultipleAnalogSensorsClient::getSkinPatchMeasure(size_t sens_index, sig::Vector& out, double& timestamp) const
 {
     return genericGetMeasure(m_sensorsMetadata.SkinPatches, "SkinPatches",
-                             m_streamingPort.receivedData.SkinPatches, sens_index, out, timestamp);
+                             SensorStreamingBlock::SkinPatches, sens_index, out, timestamp);
 }
 
 size_t MultipleAnalogSensorsClient::getSkinPatchSize(size_t sens_index) const
 {
     return genericGetSize(m_sensorsMetadata.SkinPatches, "SkinPatches",
-                          m_streamingPort.receivedData.SkinPatches, sens_index);
+                          SensorStreamingBlock::SkinPatches, sens_index);
 }
 
 
@@ -13,8 +13,10 @@
 
 #include "MultipleAnalogSensorsMetadata.h"
 #include "SensorStreamingData.h"
+#include "SensorStreamingBlock.h"
 
 #include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
 
 #include <mutex>
 
@@ -25,17 +27,37 @@ namespace yarp {
     }
 }
 
-class yarp::dev::SensorStreamingDataInputPort: public yarp::os::BufferedPort<SensorStreamingData>
+/**
+ * Reader of the streaming port, that keeps the last measurements received.
+ *
+ * The measurements of each sensor type are kept in a single block (see
+ * SensorStreamingBlock), and each measurement is accessed through its
+ * offset in the block. With the flat streaming format the offsets are
+ * computed once from the layout sent by the server, and a message is read
+ * directly into a block; with the thrift format the message is read as
+ * SensorStreamingData and then copied into the blocks.
+ */
+class yarp::dev::SensorStreamingDataInputPort: public yarp::os::PortReader
 {
+    // Buffers filled by the thread of the port, swapped with the
+    // received ones when a message is complete
+    SensorStreamingData incomingData;
+    SensorStreamingBlock incomingBlock;
+    std::vector<size_t> incomingOffsets[SensorStreamingBlock::nrOfSensorTypes];
+
 public:
-    SensorStreamingData receivedData;
+    yarp::os::Port port;
+    bool flat{false};
+    SensorStreamingBlock receivedData;
+    // for each sensor, the offset of its timestamp, followed by its measurement
+    std::vector<size_t> offsets[SensorStreamingBlock::nrOfSensorTypes];
     mutable yarp::dev::MAS_status status{yarp::dev::MAS_WAITING_FOR_FIRST_READ};
     mutable std::mutex dataMutex;
     double timeoutInSeconds{0.01};
     double lastTimeStampReadInSeconds{0.0};
 
-    using yarp::os::BufferedPort<SensorStreamingData>::onRead;
-    virtual void onRead(SensorStreamingData &v) override;
+    void setLayout(const SensorStreamingLayout& layout);
+    virtual bool read(yarp::os::ConnectionReader& connection) override;
     void updateTimeoutStatus() const;
 };
 
@@ -86,10 +108,10 @@ class yarp::dev::MultipleAnalogSensorsClient: public DeviceDriver,
     bool genericGetFrameName(const std::vector<SensorMetadata>& metadataVector, const std::string& tag,
                             size_t sens_index, std::string &frameName) const;
     bool genericGetMeasure(const std::vector<SensorMetadata>& metadataVector, const std::string& tag,
-                             const SensorMeasurements& measurementsVector,
+                             SensorStreamingBlock::SensorType type,
                              size_t sens_index, yarp::sig::Vector& out, double& timestamp) const;
     size_t genericGetSize(const std::vector<SensorMetadata>& metadataVector,
-                          const std::string& tag, const SensorMeasurements& measurementsVector, size_t sens_index) const;
+                          const std::string& tag, SensorStreamingBlock::SensorType type, size_t sens_index) const;
 
 
 public:
@@ -59,6 +59,14 @@ bool MultipleAnalogSensorsServer::open(os::Searchable& config)
 
     std::string name = config.find("name").asString().c_str();
 
+    std::string format = config.check("streaming_format", yarp::os::Value("thrift")).asString();
+    if (format != "thrift" && format != "flat")
+    {
+        yError("MultipleAnalogSensorsServer: streaming_format parameter is %s, but it should be thrift or flat, exiting.", format.c_str());
+        return false;
+    }
+    m_streamingLayout.flat = (format == "flat");
+
     // Reserve a fair amount of elements
     // It would be great if yarp::sig::Vector had a reserve method
     m_buffer.resize(100);
@@ -199,6 +207,41 @@ bool MultipleAnalogSensorsServer::populateAllSensorsMetadata()
     return ok;
 }
 
+namespace {
+
+template<typename Interface>
+void populateBlockLayout(Interface* wrappedDeviceInterface, size_t nrOfSensors,
+                         std::vector<std::int32_t>& layout,
+                         size_t (Interface::*getSizeMethodPtr)(size_t) const)
+{
+    layout.resize(nrOfSensors);
+    for (size_t i=0; i < nrOfSensors; i++)
+    {
+        layout[i] = static_cast<std::int32_t>(MAS_CALL_MEMBER_FN(wrappedDeviceInterface, getSizeMethodPtr)(i));
+    }
+}
+
+} // namespace
+
+void MultipleAnalogSensorsServer::populateStreamingLayout()
+{
+    m_streamingLayout.ThreeAxisGyroscopes.assign(m_sensorMetadata.ThreeAxisGyroscopes.size(), 3);
+    m_streamingLayout.ThreeAxisLinearAccelerometers.assign(m_sensorMetadata.ThreeAxisLinearAccelerometers.size(), 3);
+    m_streamingLayout.ThreeAxisMagnetometers.assign(m_sensorMetadata.ThreeAxisMagnetometers.size(), 3);
+    m_streamingLayout.OrientationSensors.assign(m_sensorMetadata.OrientationSensors.size(), 3);
+    m_streamingLayout.TemperatureSensors.assign(m_sensorMetadata.TemperatureSensors.size(), 1);
+    m_streamingLayout.SixAxisForceTorqueSensors.assign(m_sensorMetadata.SixAxisForceTorqueSensors.size(), 6);
+    populateBlockLayout(m_iContactLoadCellArrays, m_sensorMetadata.ContactLoadCellArrays.size(),
+                        m_streamingLayout.ContactLoadCellArrays,
+                        &IContactLoadCellArrays::getContactLoadCellArraySize);
+    populateBlockLayout(m_iEncoderArrays, m_sensorMetadata.EncoderArrays.size(),
+                        m_streamingLayout.EncoderArrays,
+                        &IEncoderArrays::getEncoderArraySize);
+    populateBlockLayout(m_iSkinPatches, m_sensorMetadata.SkinPatches.size(),
+                        m_streamingLayout.SkinPatches,
+                        &ISkinPatches::getSkinPatchSize);
+}
+
 bool MultipleAnalogSensorsServer::attachAll(const PolyDriverList& p)
 {
     // Attach the device
@@ -246,8 +289,20 @@ bool MultipleAnalogSensorsServer::attachAll(const PolyDriverList& p)
         return false;
     }
 
+    if (m_streamingLayout.flat)
+    {
+        populateStreamingLayout();
+    }
+
     // Attach was successful, open the ports
-    ok = m_streamingPort.open(m_streamingPortName);
+    if (m_streamingLayout.flat)
+    {
+        ok = m_flatStreamingPort.open(m_streamingPortName);
+    }
+    else
+    {
+        ok = m_streamingPort.open(m_streamingPortName);
+    }
     if (!ok)
     {
         yError("MultipleAnalogSensorsServer: failure in opening port named %s.", m_streamingPortName.c_str());
@@ -288,6 +343,7 @@ bool MultipleAnalogSensorsServer::detachAll()
 
     m_rpcPort.close();
     m_streamingPort.close();
+    m_flatStreamingPort.close();
 
     return true;
 }
@@ -297,6 +353,11 @@ SensorRPCData MultipleAnalogSensorsServer::getMetadata()
     return m_sensorMetadata;
 }
 
+SensorStreamingLayout MultipleAnalogSensorsServer::getStreamingLayout()
+{
+    return m_streamingLayout;
+}
+
 template<typename Interface>
 bool MultipleAnalogSensorsServer::genericStreamData(Interface* wrappedDeviceInterface,
                                                     const std::vector< SensorMetadata >& metadataVector,
@@ -328,8 +389,122 @@ bool MultipleAnalogSensorsServer::genericStreamData(Interface* wrappedDeviceInte
 }
 
 
+template<typename Interface>
+bool MultipleAnalogSensorsServer::genericStreamBlock(Interface* wrappedDeviceInterface,
+                                                     const std::vector< SensorMetadata >& metadataVector,
+                                                     const std::vector< std::int32_t >& layout,
+                                                     std::vector< double >& block,
+                                                     MAS_status (Interface::*getStatusMethodPtr)(size_t) const,
+                                                     bool (Interface::*getMeasureMethodPtr)(size_t, yarp::sig::Vector&, double&) const)
+{
+    // clear() keeps the capacity, so the block is allocated only once
+    block.clear();
+    if (wrappedDeviceInterface)
+    {
+        size_t nrOfSensors = metadataVector.size();
+        for (size_t i=0; i < nrOfSensors; i++)
+        {
+            double timestamp;
+            MAS_CALL_MEMBER_FN(wrappedDeviceInterface, getMeasureMethodPtr)(i, m_buffer, timestamp);
+            MAS_status status = MAS_CALL_MEMBER_FN(wrappedDeviceInterface, getStatusMethodPtr)(i);
+            if (status != MAS_OK)
+            {
+                yError("MultipleAnalogSensorsServer: failure in reading data from sensor %s, no data will be sent on the port.",
+                    metadataVector[i].name.c_str());
+                return false;
+            }
+            if (m_buffer.size() != static_cast<size_t>(layout[i]))
+            {
+                yError("MultipleAnalogSensorsServer: sensor %s has a measurement of size %zu instead of %d, no data will be sent on the port.",
+                    metadataVector[i].name.c_str(), m_buffer.size(), layout[i]);
+                return false;
+            }
+            block.push_back(timestamp);
+            block.insert(block.end(), m_buffer.data(), m_buffer.data() + m_buffer.size());
+        }
+    }
+
+    return true;
+}
+
+void MultipleAnalogSensorsServer::runFlat()
+{
+    SensorStreamingBlock& streamingBlock = m_flatStreamingPort.prepare();
+
+    bool ok = true;
+
+    ok = ok && genericStreamBlock(m_iThreeAxisGyroscopes, m_sensorMetadata.ThreeAxisGyroscopes,
+                                  m_streamingLayout.ThreeAxisGyroscopes,
+                                  streamingBlock.blocks[SensorStreamingBlock::ThreeAxisGyroscopes],
+                                  &IThreeAxisGyroscopes::getThreeAxisGyroscopeStatus,
+                                  &IThreeAxisGyroscopes::getThreeAxisGyroscopeMeasure);
+
+    ok = ok && genericStreamBlock(m_iThreeAxisLinearAccelerometers, m_sensorMetadata.ThreeAxisLinearAccelerometers,
+                                  m_streamingLayout.ThreeAxisLinearAccelerometers,
+                                  streamingBlock.blocks[SensorStreamingBlock::ThreeAxisLinearAccelerometers],
+                                  &IThreeAxisLinearAccelerometers::getThreeAxisLinearAccelerometerStatus,
+                                  &IThreeAxisLinearAccelerometers::getThreeAxisLinearAccelerometerMeasure);
+
+    ok = ok && genericStreamBlock(m_iThreeAxisMagnetometers, m_sensorMetadata.ThreeAxisMagnetometers,
+                                  m_streamingLayout.ThreeAxisMagnetometers,
+                                  streamingBlock.blocks[SensorStreamingBlock::ThreeAxisMagnetometers],
+                                  &IThreeAxisMagnetometers::getThreeAxisMagnetometerStatus,
+                                  &IThreeAxisMagnetometers::getThreeAxisMagnetometerMeasure);
+
+    ok = ok && genericStreamBlock(m_iOrientationSensors, m_sensorMetadata.OrientationSensors,
+                                  m_streamingLayout.OrientationSensors,
+                                  streamingBlock.blocks[SensorStreamingBlock::OrientationSensors],
+                                  &IOrientationSensors::getOrientationSensorStatus,
+                                  &IOrientationSensors::getOrientationSensorMeasureAsRollPitchYaw);
+
+    ok = ok && genericStreamBlock(m_iTemperatureSensors, m_sensorMetadata.TemperatureSensors,
+                                  m_streamingLayout.TemperatureSensors,
+                                  streamingBlock.blocks[SensorStreamingBlock::TemperatureSensors],
+                                  &ITemperatureSensors::getTemperatureSensorStatus,
+                                  &ITemperatureSensors::getTemperatureSensorMeasure);
+
+    ok = ok && genericStreamBlock(m_iSixAxisForceTorqueSensors, m_sensorMetadata.SixAxisForceTorqueSensors,
+                                  m_streamingLayout.SixAxisForceTorqueSensors,
+                                  streamingBlock.blocks[SensorStreamingBlock::SixAxisForceTorqueSensors],
+                                  &ISixAxisForceTorqueSensors::getSixAxisForceTorqueSensorStatus,
+                                  &ISixAxisForceTorqueSensors::getSixAxisForceTorqueSensorMeasure);
+
+    ok = ok && genericStreamBlock(m_iContactLoadCellArrays, m_sensorMetadata.ContactLoadCellArrays,
+                                  m_streamingLayout.ContactLoadCellArrays,
+                                  streamingBlock.blocks[SensorStreamingBlock::ContactLoadCellArrays],
+                                  &IContactLoadCellArrays::getContactLoadCellArrayStatus,
+                                  &IContactLoadCellArrays::getContactLoadCellArrayMeasure);
+
+    ok = ok && genericStreamBlock(m_iEncoderArrays, m_sensorMetadata.EncoderArrays,
+                                  m_streamingLayout.EncoderArrays,
+                                  streamingBlock.blocks[SensorStreamingBlock::EncoderArrays],
+                                  &IEncoderArrays::getEncoderArrayStatus,
+                                  &IEncoderArrays::getEncoderArrayMeasure);
+
+    ok = ok && genericStreamBlock(m_iSkinPatches, m_sensorMetadata.SkinPatches,
+                                  m_streamingLayout.SkinPatches,
+                                  streamingBlock.blocks[SensorStreamingBlock::SkinPatches],
+                                  &ISkinPatches::getSkinPatchStatus,
+                                  &ISkinPatches::getSkinPatchMeasure);
+
+    if (ok)
+    {
+        m_flatStreamingPort.write();
+    }
+    else
+    {
+        m_flatStreamingPort.unprepare();
+    }
+}
+
 void MultipleAnalogSensorsServer::run()
 {
+    if (m_streamingLayout.flat)
+    {
+        runFlat();
+        return;
+    }
+
     SensorStreamingData& streamingData = m_streamingPort.prepare();
 
     bool ok = true;
@@ -18,6 +18,7 @@
 // Thrift-generated classes
 #include "SensorStreamingData.h"
 #include "MultipleAnalogSensorsMetadata.h"
+#include "SensorStreamingBlock.h"
 
 namespace yarp {
     namespace dev {
@@ -40,6 +41,7 @@ namespace yarp {
  * |:--------------:|:--------------:|:-------:|:--------------:|:-------------:|:--------------------------: |:-----------------------------------------------------------------:|:-----:|
  * | name           |      -         | string  | -              |   -           | Yes                         | Prefix of the port opened by this device                          | MUST start with a '/' character |
  * | period         |      -         | int     | ms             |   -           | Yes                          | Refresh period of the broadcasted values in ms                    |  |
+ * | streaming_format |    -         | string  | -              | thrift        | No                          | Format of the measurements streamed: `thrift` or `flat`           | `flat` sends one contiguous block of float64 for each sensor type, its layout is sent once through the RPC port. It requires a client of the same YARP version |
  */
 class yarp::dev::MultipleAnalogSensorsServer : public yarp::os::PeriodicThread,
                                                public yarp::dev::DeviceDriver,
@@ -50,6 +52,7 @@ class yarp::dev::MultipleAnalogSensorsServer : public yarp::os::PeriodicThread,
     std::string m_streamingPortName;
     std::string m_RPCPortName;
     yarp::os::BufferedPort<SensorStreamingData> m_streamingPort;
+    yarp::os::BufferedPort<SensorStreamingBlock> m_flatStreamingPort;
     yarp::os::Port m_rpcPort;
     // Generic vector buffer
     yarp::sig::Vector m_buffer;
@@ -67,7 +70,9 @@ class yarp::dev::MultipleAnalogSensorsServer : public yarp::os::PeriodicThread,
 
     // Metadata to be server via the RPC port
     SensorRPCData m_sensorMetadata;
+    SensorStreamingLayout m_streamingLayout;
     bool populateAllSensorsMetadata();
+    void populateStreamingLayout();
     template<typename Interface>
     bool populateSensorsMetadata(Interface * wrappedDeviceInterface,
                                  std::vector<SensorMetadata>& metadataVector, const std::string& tag,
@@ -87,6 +92,15 @@ class yarp::dev::MultipleAnalogSensorsServer : public yarp::os::PeriodicThread,
                            MAS_status (Interface::*getStatusMethodPtr)(size_t) const,
                            bool (Interface::*getMeasureMethodPtr)(size_t, yarp::sig::Vector&, double&) const);
 
+    template<typename Interface>
+    bool genericStreamBlock(Interface* wrappedDeviceInterface,
+                            const std::vector< SensorMetadata >& metadataVector,
+                            const std::vector< std::int32_t >& layout,
+                            std::vector< double >& block,
+                            MAS_status (Interface::*getStatusMethodPtr)(size_t) const,
+                            bool (Interface::*getMeasureMethodPtr)(size_t, yarp::sig::Vector&, double&) const);
+    void runFlat();
+
 public:
     MultipleAnalogSensorsServer();
     ~MultipleAnalogSensorsServer();
@@ -105,6 +119,7 @@ public:
 
     /* MultipleAnalogSensorsMetadata */
     virtual SensorRPCData getMetadata() override;
+    virtual SensorStreamingLayout getStreamingLayout() override;
 };
 
 #endif
@@ -114,17 +114,23 @@ bool yarp::dev::Navigation2DClient::open(yarp::os::Searchable &config)
         return false;
     }
 
-    /*
-    //currently unused
-    bool ok=Network::connect(remote_streaming_name.c_str(), local_streaming_name.c_str(), "tcp");
-    if (!ok)
+    if (!m_pose_stream.open(local_streaming_name.c_str()))
     {
-        yError("Navigation2DClient::open() error could not connect to %s", remote_streaming_name.c_str());
+        yError("Navigation2DClient::open() error could not open port %s, check network", local_streaming_name.c_str());
         return false;
-    }*/
+    }
+    m_pose_stream.setTimeout(config.check("pose_timeout", Value(0.2)).asFloat64());
+    m_pose_stream.useCallback();
 
     bool ok = true;
 
+    ok = Network::connect(remote_streaming_name.c_str(), local_streaming_name.c_str(), "tcp");
+    if (!ok)
+    {
+        //the position is then asked to the localization server every time
+        yWarning("Navigation2DClient::open() could not connect to %s, the pose is not streamed", remote_streaming_name.c_str());
+    }
+
     ok = Network::connect(local_rpc_1.c_str(), remote_rpc_1.c_str());
     if (!ok)
     {
@@ -149,8 +155,15 @@ bool yarp::dev::Navigation2DClient::open(yarp::os::Searchable &config)
     return true;
 }
 
+bool  yarp::dev::Navigation2DClient::getPositionAt(double timestamp, Map2DLocation& loc)
+{
+    return m_pose_stream.getAt(timestamp, loc);
+}
+
 bool yarp::dev::Navigation2DClient::close()
 {
+    m_pose_stream.interrupt();
+    m_pose_stream.close();
     m_rpc_port_navigation_server.close();
     m_rpc_port_map_locations_server.close();
     m_rpc_port_localization_server.close();
@@ -331,6 +344,11 @@ bool  yarp::dev::Navigation2DClient::setInitialPose(Map2DLocation& loc)
 
 bool  yarp::dev::Navigation2DClient::getCurrentPosition(Map2DLocation& loc)
 {
+    if (m_pose_stream.getLatest(loc))
+    {
+        return true;
+    }
+
     yarp::os::Bottle b;
     yarp::os::Bottle resp;
 
@@ -27,6 +27,7 @@
 #include <string>
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/dev/INavigation2D.h>
+#include <yarp/dev/impl/PoseStreamCache.h>
 
 namespace yarp {
     namespace dev {
@@ -50,6 +51,10 @@ namespace yarp {
  * | navigation_server    |     -    | string  | -              |   -           | Yes          | Full port name of the port remotely opened by the Navigation server, to which the Navigation2DClient connects to.           |  |
  * | map_locations_server |     -    | string  | -              |   -           | Yes          | Full port name of the port remotely opened by the Map2DServer, to which the Navigation2DClient connects to.           |  |
  * | localization_server  |     -    | string  | -              |   -           | Yes          | Full port name of the port remotely opened by the Localization server, to which the Navigation2DClient connects to.           |  |
+ * | pose_timeout         |     -    | double  | s              |   0.2         | No           | How long a pose streamed by the Localization server is used, before asking the server again.           |  |
+ *
+ * If the Localization server streams the pose of the robot on <localization_server>/stream:o, getCurrentPosition() is answered
+ * from the last pose received, and getPositionAt() interpolates between the recent ones. Otherwise the server is asked each time.
  */
 
 class yarp::dev::Navigation2DClient: public DeviceDriver,
@@ -62,6 +67,7 @@ protected:
     yarp::os::Port                m_rpc_port_navigation_server;
     yarp::os::Port                m_rpc_port_map_locations_server;
     yarp::os::Port                m_rpc_port_localization_server;
+    yarp::dev::impl::PoseStreamCache m_pose_stream;
     std::string                   m_local_name;
     std::string                   m_navigation_server_name;
     std::string                   m_map_locations_server_name;
@@ -86,6 +92,7 @@ public:
     bool   getRelativeLocationOfCurrentTarget(double& x, double& y, double& theta) override;
 
     bool   getCurrentPosition(Map2DLocation &loc) override;
+    bool   getPositionAt(double timestamp, Map2DLocation &loc) override;
     bool   setInitialPose(yarp::dev::Map2DLocation& loc) override;
 
     bool   storeCurrentPosition(std::string location_name) override;
@@ -28,6 +28,8 @@ circularBuffer::circularBuffer(int bufferSize)
     maxsize  = bufferSize + 1;
     start = 0;
     end   = 0;
+    lost  = 0;
+    clearTo = noClear;
     elems = (SAMPLE *) calloc(maxsize, sizeof(SAMPLE));
 }
 
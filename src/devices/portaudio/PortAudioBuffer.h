@@ -20,7 +20,9 @@
 #define PortAudioBufferh
 
 #include <portaudio.h>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
 
 /* Select sample format. */
 #if 0
@@ -43,17 +45,29 @@ typedef unsigned char SAMPLE;
 #endif
 
 //----------------------------------------------------------------------------------
+/*
+ * Single producer, single consumer ring of samples shared between the
+ * portaudio callback and the driver. The producer only moves the end and
+ * the consumer only moves the start, so no lock is needed and the callback
+ * never waits. When the ring is full the new samples are dropped and
+ * counted. The producer drops the content of the ring by asking the
+ * consumer to do it, with requestClear().
+ */
 class circularBuffer
 {
-    int         maxsize;
-    int         start;
-    int         end;
-    SAMPLE      *elems;
+    size_t              maxsize;
+    std::atomic<size_t> start;
+    std::atomic<size_t> end;
+    std::atomic<size_t> lost;
+    std::atomic<size_t> clearTo;
+    SAMPLE              *elems;
+
+    static const size_t noClear = (size_t)-1;
 
     public:
     inline bool isFull()
     {
-        return (end + 1) % maxsize == start;
+        return (end.load(std::memory_order_acquire) + 1) % maxsize == start.load(std::memory_order_acquire);
     }
 
     inline const SAMPLE* getRawData()
@@ -63,52 +77,96 @@ class circularBuffer
 
     inline bool isEmpty()
     {
-        return end == start;
+        return end.load(std::memory_order_acquire) == start.load(std::memory_order_acquire);
     }
 
-    inline void write(SAMPLE elem)
+    // producer side
+    inline size_t write(const SAMPLE* data, size_t count)
     {
-        elems[end] = elem;
-        end = (end + 1) % maxsize;
-        if (end == start)
+        size_t e = end.load(std::memory_order_relaxed);
+        size_t s = start.load(std::memory_order_acquire);
+        size_t room = (s + maxsize - e - 1) % maxsize;
+        if (count > room)
         {
-            printf ("ERROR: buffer ovverrun!\n");
-            start = (start + 1) % maxsize; // full, overwrite
+            lost.fetch_add(count - room, std::memory_order_relaxed);
+            count = room;
         }
+        size_t first = (count < maxsize - e) ? count : maxsize - e;
+        memcpy(elems + e, data, first * sizeof(SAMPLE));
+        memcpy(elems, data + first, (count - first) * sizeof(SAMPLE));
+        end.store((e + count) % maxsize, std::memory_order_release);
+        return count;
+    }
+
+    inline void write(SAMPLE elem)
+    {
+        write(&elem, 1);
     }
 
     inline int size()
     {
-        int i;
-        if (end>start)
-            i = end-start;
-        else if (end==start)
-            i = 0;
-        else
-            i = maxsize - start + end;
-        return i;
+        size_t e = end.load(std::memory_order_acquire);
+        size_t s = start.load(std::memory_order_acquire);
+        return (int)((e + maxsize - s) % maxsize);
+    }
+
+    // consumer side
+    inline size_t read(SAMPLE* data, size_t count)
+    {
+        size_t s = start.load(std::memory_order_relaxed);
+        size_t c = clearTo.exchange(noClear, std::memory_order_acq_rel);
+        if (c != noClear)
+        {
+            // the samples up to c were dropped by the producer
+            s = c;
+        }
+        // loaded after the request, so that it is not behind it
+        size_t e = end.load(std::memory_order_acquire);
+        size_t available = (e + maxsize - s) % maxsize;
+        if (count > available)
+        {
+            count = available;
+        }
+        size_t first = (count < maxsize - s) ? count : maxsize - s;
+        memcpy(data, elems + s, first * sizeof(SAMPLE));
+        memcpy(data + first, elems, (count - first) * sizeof(SAMPLE));
+        start.store((s + count) % maxsize, std::memory_order_release);
+        return count;
     }
 
     inline SAMPLE read()
     {
-        if (end == start)
+        SAMPLE elem = SAMPLE_SILENCE;
+        if (read(&elem, 1) == 0)
         {
             printf ("ERROR: buffer underrun!\n");
         }
-        SAMPLE elem = elems[start];
-        start = (start + 1) % maxsize;
         return elem;
     }
 
     inline unsigned int getMaxSize()
     {
-        return maxsize;
+        return (unsigned int)maxsize;
+    }
+
+    // number of samples dropped because the ring was full
+    inline size_t getLost()
+    {
+        return lost.load(std::memory_order_relaxed);
     }
 
+    // drops the content of the ring, only while the consumer is not running
     inline void clear()
     {
-        start = 0;
-        end   = 0;
+        clearTo.store(noClear, std::memory_order_relaxed);
+        start.store(end.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // producer side: drops the samples written so far, the consumer skips
+    // them on its next read
+    inline void requestClear()
+    {
+        clearTo.store(end.load(std::memory_order_relaxed), std::memory_order_release);
     }
 
     circularBuffer(int bufferSize);
@@ -18,6 +18,7 @@
 
 #include <PortAudioDeviceDriver.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -72,19 +73,14 @@ static int bufferIOCallback( const void *inputBuffer, void *outputBuffer,
 
         if( inputBuffer == NULL )
         {
-            for( i=0; i<framesToCalc; i++ )
+            for( i=0; i<framesToCalc*num_channels; i++ )
             {
-                recdata->write(0); // left
-                if( num_channels == 2 ) recdata->write(0);  // right
+                recdata->write(SAMPLE_SILENCE);
             }
         }
         else
         {
-            for( i=0; i<framesToCalc; i++ )
-            {
-                recdata->write(*rptr++);  // left
-                if( num_channels == 2 ) recdata->write(*rptr++);  // right
-            }
+            recdata->write(rptr, framesToCalc*num_channels);
         }
         //note: you can record or play but not simultaneously (for now)
         return finished;
@@ -96,6 +92,7 @@ static int bufferIOCallback( const void *inputBuffer, void *outputBuffer,
         unsigned int i;
 
         unsigned int framesLeft = playdata->size();
+        unsigned int samplesPerBuffer = framesPerBuffer*num_channels;
 
         (void) inputBuffer; // just to prevent unused variable warnings
         (void) timeInfo;
@@ -105,24 +102,20 @@ static int bufferIOCallback( const void *inputBuffer, void *outputBuffer,
         if( framesLeft/num_channels < framesPerBuffer )
         {
             // final buffer
-            for( i=0; i<framesLeft/num_channels; i++ )
-            {
-                *wptr++ = playdata->read();  // left
-                if( num_channels == 2 ) *wptr++ = playdata->read();  // right
-            }
-            for( ; i<framesPerBuffer; i++ )
+            i = playdata->read(wptr, (framesLeft/num_channels)*num_channels);
+            for( ; i<samplesPerBuffer; i++ )
             {
-                *wptr++ = 0;  // left
-                if( num_channels == 2 ) *wptr++ = 0;  // right
+                wptr[i] = SAMPLE_SILENCE;
             }
             finished = paComplete;
         }
         else
         {
-            for( i=0; i<framesPerBuffer; i++ )
+            // a clear requested after size() was read leaves fewer samples
+            i = playdata->read(wptr, samplesPerBuffer);
+            for( ; i<samplesPerBuffer; i++ )
             {
-                *wptr++ = playdata->read();  // left
-                if( num_channels == 2 ) *wptr++ = playdata->read();  // right
+                wptr[i] = SAMPLE_SILENCE;
             }
             finished = paContinue;
         }
@@ -140,6 +133,7 @@ PortAudioDeviceDriver::PortAudioDeviceDriver() :
     i(0),
     numSamples(0),
     numBytes(0),
+    numLost(0),
     system_resource(NULL),
     numChannels(0),
     frequency(0),
@@ -279,7 +273,7 @@ void streamThread::handleError()
 void PortAudioDeviceDriver::handleError()
 {
     //Pa_Terminate();
-    dataBuffers.playData->clear();
+    dataBuffers.playData->requestClear();
 
     if( err != paNoError )
     {
@@ -350,18 +344,24 @@ bool PortAudioDeviceDriver::getSound(yarp::sig::Sound& sound)
     }
     buff_size_wdt = 0;
 
-    if (sound.getChannels()!=this->numChannels && sound.getSamples() != this->numSamples)
+    size_t count = this->numSamples*this->numChannels;
+    recSamples.resize(count);
+    size_t got = dataBuffers.recData->read(recSamples.data(), count);
+    if (got < count)
     {
-        sound.resize(this->numSamples,this->numChannels);
+        printf ("ERROR: buffer underrun!\n");
+        std::fill(recSamples.begin() + got, recSamples.end(), SAMPLE_SILENCE);
     }
-    sound.setFrequency(this->driverConfig.rate);
 
-    for (int i=0; i<this->numSamples; i++)
-        for (int j=0; j<this->numChannels; j++)
-            {
-                SAMPLE s = dataBuffers.recData->read();
-                sound.set(s,i,j);
-            }
+    size_t lost = dataBuffers.recData->getLost();
+    if (lost != numLost)
+    {
+        printf ("ERROR: buffer overrun, %zu samples lost!\n", lost - numLost);
+        numLost = lost;
+    }
+
+    sound.setInterleaved(recSamples.data(), this->numSamples, this->numChannels);
+    sound.setFrequency(this->driverConfig.rate);
     return true;
 }
 
@@ -427,20 +427,10 @@ void streamThread::run()
 
 bool PortAudioDeviceDriver::immediateSound(yarp::sig::Sound& sound)
 {
-    dataBuffers.playData->clear();
-
-    //unsigned char* dataP= sound.getRawData();
-    int num_bytes = sound.getBytesPerSample();
-    int num_channels = sound.getChannels();
-    int num_samples = sound.getRawDataSize()/num_channels/num_bytes;
-    // memcpy(data.samplesBuffer,dataP,num_samples/**num_bytes*num_channels*/);
-
-    for (int i=0; i<num_samples; i++)
-        for (int j=0; j<num_channels; j++)
-            dataBuffers.playData->write (sound.get(i,j));
+    // the callback may be reading the ring, it drops the old samples itself
+    dataBuffers.playData->requestClear();
 
-    pThread.something_to_play = true;
-    return true;
+    return writeSound(sound);
 }
 
 bool PortAudioDeviceDriver::renderSound(yarp::sig::Sound& sound)
@@ -477,20 +467,39 @@ bool PortAudioDeviceDriver::renderSound(yarp::sig::Sound& sound)
     return false;
 }
 
-bool PortAudioDeviceDriver::appendSound(yarp::sig::Sound& sound)
+bool PortAudioDeviceDriver::writeSound(yarp::sig::Sound& sound)
 {
-    //unsigned char* dataP= sound.getRawData();
-    int num_bytes = sound.getBytesPerSample();
-    int num_channels = sound.getChannels();
-    int num_samples = sound.getRawDataSize()/num_channels/num_bytes;
-    // memcpy(data.samplesBuffer,dataP,num_samples/**num_bytes*num_channels*/);
-
-    for (int i=0; i<num_samples; i++)
-        for (int j=0; j<num_channels; j++)
-            dataBuffers.playData->write (sound.get(i,j));
-
-    pThread.something_to_play = true;
+    size_t num_channels = sound.getChannels();
+    size_t num_samples = sound.getSamples();
+    playSamples.resize(num_samples*num_channels);
+    sound.getInterleaved(playSamples.data(), 0, num_samples);
+
+    // samples that do not fit in the buffer wait for the playback
+    size_t done = 0;
+    int wdt = 0;
+    while (true)
+    {
+        size_t written = dataBuffers.playData->write(playSamples.data() + done, playSamples.size() - done);
+        done += written;
+        pThread.something_to_play = true;
+        if (done == playSamples.size()) break;
+        if (written > 0)
+        {
+            wdt = 0;
+        }
+        else if (wdt++ == 200)
+        {
+            printf ("ERROR: buffer overrun, %zu samples not played!\n", playSamples.size() - done);
+            return false;
+        }
+        yarp::os::SystemClock::delaySystem(SLEEP_TIME);
+    }
     return true;
 }
 
+bool PortAudioDeviceDriver::appendSound(yarp::sig::Sound& sound)
+{
+    return writeSound(sound);
+}
+
 
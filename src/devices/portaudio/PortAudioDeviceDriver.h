@@ -27,6 +27,8 @@
 #include <portaudio.h>
 #include "PortAudioBuffer.h"
 
+#include <vector>
+
 #define DEFAULT_SAMPLE_RATE  (44100)
 #define DEFAULT_NUM_CHANNELS    (2)
 #define DEFAULT_DITHER_FLAG     (0)
@@ -77,6 +79,9 @@ private:
     int                 i;
     int                 numSamples;
     int                 numBytes;
+    size_t              numLost;
+    std::vector<SAMPLE> recSamples;
+    std::vector<SAMPLE> playSamples;
     streamThread        pThread;
 
     PortAudioDeviceDriver(const PortAudioDeviceDriver&);
@@ -117,6 +122,7 @@ public:
     bool abortSound(void);
     bool immediateSound(yarp::sig::Sound& sound);
     bool appendSound(yarp::sig::Sound& sound);
+    bool writeSound(yarp::sig::Sound& sound);
 
 protected:
     void *system_resource;
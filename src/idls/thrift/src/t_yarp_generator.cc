@@ -21,6 +21,7 @@
 #include <map>
 #include <set>
 
+#include <cstdint>
 #include <cstdlib>
 #include <sys/stat.h>
 #include <sstream>
@@ -258,6 +259,7 @@ void getNeededType(t_type* curType, std::set<string>& neededTypes)
                                           std::string index);
 
   std::string type_to_enum(t_type* ttype);
+  std::string list_block_tag(t_type* ttype);
 
   std::ofstream f_out_;
   std::ofstream f_out_common_; //in addition to **_index.h - can they be the same file?
@@ -311,6 +313,41 @@ void getNeededType(t_type* curType, std::set<string>& neededTypes)
 };
 
 
+// FNV-1a hash of the tag of a command, the same computed by the generated code
+static uint32_t tag_hash(const string& tag) {
+  uint32_t hash = 2166136261U;
+  for (string::size_type i = 0; i < tag.size(); i++) {
+    hash = (hash ^ static_cast<unsigned char>(tag[i])) * 16777619U;
+  }
+  return hash;
+}
+
+// The tag of the lists that are sent as a single block of untagged numbers,
+// or an empty string if the elements must be sent one by one
+string t_yarp_generator::list_block_tag(t_type* type) {
+  if (!type->is_list() || ((t_container*)type)->has_cpp_name()) {
+    return "";
+  }
+  t_type* elem = get_true_type(((t_list*)type)->get_elem_type());
+  if (!elem->is_base_type()) {
+    return "";
+  }
+  switch (((t_base_type*)elem)->get_base()) {
+  case t_base_type::TYPE_I8:
+    return "BOTTLE_TAG_INT8";
+  case t_base_type::TYPE_I16:
+    return "BOTTLE_TAG_INT16";
+  case t_base_type::TYPE_I32:
+    return "BOTTLE_TAG_INT32";
+  case t_base_type::TYPE_I64:
+    return "BOTTLE_TAG_INT64";
+  case t_base_type::TYPE_DOUBLE:
+    return "BOTTLE_TAG_FLOAT64";
+  default:
+    return "";
+  }
+}
+
 string t_yarp_generator::type_to_enum(t_type* type) {
   type = get_true_type(type);
 
@@ -2185,6 +2222,19 @@ void t_yarp_generator::generate_service(t_service* tservice) {
                    << endl;
 
     indent_down();
+    indent(f_cpp_) << endl
+                   << "// FNV-1a hash of the tag of a command, used to dispatch it" << endl
+                   << "static std::uint32_t " << service_name_ << "_tagHash(const std::string& tag) {" << endl;
+    indent_up();
+    indent(f_cpp_) << "std::uint32_t hash = 2166136261U;" << endl;
+    indent(f_cpp_) << "for (char c : tag) {" << endl;
+    indent_up();
+    indent(f_cpp_) << "hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;" << endl;
+    indent_down();
+    indent(f_cpp_) << "}" << endl;
+    indent(f_cpp_) << "return hash;" << endl;
+    indent_down();
+    indent(f_cpp_) << "}" << endl;
     indent(f_cpp_) << endl
                    << "bool " << service_name_
                    << "::read(yarp::os::ConnectionReader& connection) {"
@@ -2200,127 +2250,151 @@ void t_yarp_generator::generate_service(t_service* tservice) {
     indent(f_cpp_) << "if (direct) tag = reader.readTag();" << endl;
     indent(f_cpp_) << "while (!reader.isError()) {" << endl;
     indent_up();
-    indent(f_cpp_) << "// TODO: use quick lookup, this is just a test" << endl;
-    //indent_up();
-    fn_iter = functions.begin();
-    for ( ; fn_iter != functions.end(); fn_iter++) {
-      indent(f_cpp_) << "if (tag == \"" << (*fn_iter)->get_name() << "\") {" << endl;
-      indent_up();
-      vector<t_field*> args = (*fn_iter)->get_arglist()->get_members();
-      vector<t_field*>::iterator arg_iter = args.begin();
-      if (arg_iter != args.end()) {
-        for ( ; arg_iter != args.end(); arg_iter++) {
-          indent(f_cpp_) << declare_field(*arg_iter, false) << endl;
-        }
-        arg_iter = args.begin();
-        for ( ; arg_iter != args.end(); arg_iter++) {
-          generate_deserialize_field(f_cpp_, *arg_iter, "");
-        }
+    // The commands are dispatched on the hash of their tag, computed here
+    // for each of them and at run time by the tagHash() function; commands
+    // with the same hash (if any) share the same case.
+    vector<pair<uint32_t, vector<size_t> > > cases;
+    for (size_t k = 0; k <= functions.size(); k++) {
+      uint32_t hash = tag_hash((k < functions.size()) ? functions[k]->get_name() : "help");
+      size_t c = 0;
+      while (c < cases.size() && cases[c].first != hash) {
+        c++;
+      }
+      if (c == cases.size()) {
+        cases.push_back(make_pair(hash, vector<size_t>()));
       }
+      cases[c].second.push_back(k);
+    }
+    indent(f_cpp_) << "switch (" << service_name_ << "_tagHash(tag)) {" << endl;
+    for (size_t c = 0; c < cases.size(); c++) {
+      indent(f_cpp_) << "case " << cases[c].first << "U:" << endl;
+      indent_up();
+      for (size_t k : cases[c].second) {
+        if (k < functions.size()) {
+          fn_iter = functions.begin() + k;
+          indent(f_cpp_) << "if (tag == \"" << (*fn_iter)->get_name() << "\") {" << endl;
+          indent_up();
+          vector<t_field*> args = (*fn_iter)->get_arglist()->get_members();
+          vector<t_field*>::iterator arg_iter = args.begin();
+          if (arg_iter != args.end()) {
+            for ( ; arg_iter != args.end(); arg_iter++) {
+              indent(f_cpp_) << declare_field(*arg_iter, false) << endl;
+            }
+            arg_iter = args.begin();
+            for ( ; arg_iter != args.end(); arg_iter++) {
+              generate_deserialize_field(f_cpp_, *arg_iter, "");
+            }
+          }
 
-      if ((*fn_iter)->is_oneway()) {
-        indent(f_cpp_) << "if (!direct) {" << endl;
-        indent_up();
-        indent(f_cpp_) << service_name_ << "_" << (*fn_iter)->get_name() << " helper;" << endl;
-        indent(f_cpp_) << "helper.init(";
-        arg_iter = args.begin();
-        if (arg_iter != args.end()) {
-          bool first = true;
-          for ( ; arg_iter != args.end(); arg_iter++) {
-            if (!first) f_cpp_ << ",";
-            first = false;
-            f_cpp_ << (*arg_iter)->get_name();
+          if ((*fn_iter)->is_oneway()) {
+            indent(f_cpp_) << "if (!direct) {" << endl;
+            indent_up();
+            indent(f_cpp_) << service_name_ << "_" << (*fn_iter)->get_name() << " helper;" << endl;
+            indent(f_cpp_) << "helper.init(";
+            arg_iter = args.begin();
+            if (arg_iter != args.end()) {
+              bool first = true;
+              for ( ; arg_iter != args.end(); arg_iter++) {
+                if (!first) f_cpp_ << ",";
+                first = false;
+                f_cpp_ << (*arg_iter)->get_name();
+              }
+            }
+            f_cpp_ << ");" << endl;
+            indent(f_cpp_) << "yarp().callback(helper,*this,\"__direct__\");" << endl;
+            indent_down();
+            indent(f_cpp_) << "} else {" << endl;
+            indent_up();
           }
-        }
-        f_cpp_ << ");" << endl;
-        indent(f_cpp_) << "yarp().callback(helper,*this,\"__direct__\");" << endl;
-        indent_down();
-        indent(f_cpp_) << "} else {" << endl;
-        indent_up();
-      }
 
-      t_type* returntype = (*fn_iter)->get_returntype();
-      t_field returnfield(returntype, "_return");
-      if (!returntype->is_void()) {
-        indent(f_cpp_) << declare_field(&returnfield, false) << endl;
-        indent(f_cpp_) << "_return = ";
-      } else {
-        indent(f_cpp_);
-      }
-      f_cpp_ << (*fn_iter)->get_name() << "(";
-      arg_iter = args.begin();
-      if (arg_iter != args.end()) {
-        bool first = true;
-        for ( ; arg_iter != args.end(); arg_iter++) {
-          if (!first) f_cpp_ << ",";
-          first = false;
-          f_cpp_ << (*arg_iter)->get_name();
-        }
-      }
-      f_cpp_ << ");" << endl;
+          t_type* returntype = (*fn_iter)->get_returntype();
+          t_field returnfield(returntype, "_return");
+          if (!returntype->is_void()) {
+            indent(f_cpp_) << declare_field(&returnfield, false) << endl;
+            indent(f_cpp_) << "_return = ";
+          } else {
+            indent(f_cpp_);
+          }
+          f_cpp_ << (*fn_iter)->get_name() << "(";
+          arg_iter = args.begin();
+          if (arg_iter != args.end()) {
+            bool first = true;
+            for ( ; arg_iter != args.end(); arg_iter++) {
+              if (!first) f_cpp_ << ",";
+              first = false;
+              f_cpp_ << (*arg_iter)->get_name();
+            }
+          }
+          f_cpp_ << ");" << endl;
 
-      if ((*fn_iter)->is_oneway()) {
-        indent_down();
-        indent(f_cpp_) << "}" << endl;
-      }
+          if ((*fn_iter)->is_oneway()) {
+            indent_down();
+            indent(f_cpp_) << "}" << endl;
+          }
 
-      indent(f_cpp_) << "yarp::os::idl::WireWriter writer(reader);" << endl;
-      indent(f_cpp_) << "if (!writer.isNull()) {" << endl;
-      indent_up();
-      if (!(*fn_iter)->is_oneway()) {
-        indent(f_cpp_) << "if (!writer.writeListHeader("
-                       << flat_element_count(returntype)
-                       << ")) return false;" << endl;
-        if (!returntype->is_void()) {
-          generate_serialize_field(f_cpp_, &returnfield, "");
+          indent(f_cpp_) << "yarp::os::idl::WireWriter writer(reader);" << endl;
+          indent(f_cpp_) << "if (!writer.isNull()) {" << endl;
+          indent_up();
+          if (!(*fn_iter)->is_oneway()) {
+            indent(f_cpp_) << "if (!writer.writeListHeader("
+                           << flat_element_count(returntype)
+                           << ")) return false;" << endl;
+            if (!returntype->is_void()) {
+              generate_serialize_field(f_cpp_, &returnfield, "");
+            }
+          } else {
+            // we are a oneway function
+            // if someone is expecting a reply (e.g. yarp rpc), give one
+            // (regular thrift client won't be expecting a reply, and
+            // writer.isNull test will have succeeded and stopped us earlier)
+            indent(f_cpp_) << "if (!writer.writeOnewayResponse()) "
+                           << "return false;" << endl;
+          }
+          indent_down();
+          indent(f_cpp_) << "}" << endl;
+
+          indent(f_cpp_) << "reader.accept();" << endl;
+          indent(f_cpp_) << "return true;" << endl;
+          indent_down();
+          indent(f_cpp_) << "}" << endl;
+        } else {
+          // read "help" function
+          indent(f_cpp_) << "if (tag == \"help\") {" <<endl;
+          indent_up();
+          indent(f_cpp_) << "std::string functionName;" <<endl;
+          indent(f_cpp_) << "if (!reader.readString(functionName)) {" <<endl;
+          indent_up();
+          indent(f_cpp_) << "functionName = \"--all\";" <<endl;
+          indent_down();
+          indent(f_cpp_) << "}" <<endl;
+          indent(f_cpp_) << "std::vector<std::string> _return=help(functionName);" <<endl;
+          indent(f_cpp_) << "yarp::os::idl::WireWriter writer(reader);" << endl;
+          indent_up();
+          indent(f_cpp_) << "if (!writer.isNull()) {" << endl;
+          indent_up();
+          indent(f_cpp_) << "if (!writer.writeListHeader(2)) return false;" << endl;
+          indent(f_cpp_) << "if (!writer.writeTag(\"many\",1, 0)) return false;" << endl;
+          indent(f_cpp_) << "if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;" << endl;
+          indent(f_cpp_) << "std::vector<std::string> ::iterator _iterHelp;" << endl;
+          indent(f_cpp_) << "for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)" << endl;
+          indent(f_cpp_) << "{" << endl;
+          indent_up();
+          indent(f_cpp_) << "if (!writer.writeString(*_iterHelp)) return false;" << endl;
+          indent_down();
+          indent(f_cpp_) << " }" << endl;
+          indent(f_cpp_) << "if (!writer.writeListEnd()) return false;" << endl;
+          indent_down();
+          indent(f_cpp_) << "}" << endl;
+          indent_down();
+          indent(f_cpp_) << "reader.accept();" << endl;
+          indent(f_cpp_) << "return true;" << endl;
+          indent_down();
+          indent(f_cpp_) << "}" << endl;
         }
-      } else {
-        // we are a oneway function
-        // if someone is expecting a reply (e.g. yarp rpc), give one
-        // (regular thrift client won't be expecting a reply, and
-        // writer.isNull test will have succeeded and stopped us earlier)
-        indent(f_cpp_) << "if (!writer.writeOnewayResponse()) "
-                       << "return false;" << endl;
       }
+      indent(f_cpp_) << "break;" << endl;
       indent_down();
-      indent(f_cpp_) << "}" << endl;
-
-      indent(f_cpp_) << "reader.accept();" << endl;
-      indent(f_cpp_) << "return true;" << endl;
-      indent_down();
-      indent(f_cpp_) << "}" << endl;
     }
-    // read "help" function
-    indent(f_cpp_) << "if (tag == \"help\") {" <<endl;
-    indent_up();
-    indent(f_cpp_) << "std::string functionName;" <<endl;
-    indent(f_cpp_) << "if (!reader.readString(functionName)) {" <<endl;
-    indent_up();
-    indent(f_cpp_) << "functionName = \"--all\";" <<endl;
-    indent_down();
-    indent(f_cpp_) << "}" <<endl;
-    indent(f_cpp_) << "std::vector<std::string> _return=help(functionName);" <<endl;
-    indent(f_cpp_) << "yarp::os::idl::WireWriter writer(reader);" << endl;
-    indent_up();
-    indent(f_cpp_) << "if (!writer.isNull()) {" << endl;
-    indent_up();
-    indent(f_cpp_) << "if (!writer.writeListHeader(2)) return false;" << endl;
-    indent(f_cpp_) << "if (!writer.writeTag(\"many\",1, 0)) return false;" << endl;
-    indent(f_cpp_) << "if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;" << endl;
-    indent(f_cpp_) << "std::vector<std::string> ::iterator _iterHelp;" << endl;
-    indent(f_cpp_) << "for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)" << endl;
-    indent(f_cpp_) << "{" << endl;
-    indent_up();
-    indent(f_cpp_) << "if (!writer.writeString(*_iterHelp)) return false;" << endl;
-    indent_down();
-    indent(f_cpp_) << " }" << endl;
-    indent(f_cpp_) << "if (!writer.writeListEnd()) return false;" << endl;
-    indent_down();
-    indent(f_cpp_) << "}" << endl;
-    indent_down();
-    indent(f_cpp_) << "reader.accept();" << endl;
-    indent(f_cpp_) << "return true;" << endl;
-    indent_down();
     indent(f_cpp_) << "}" << endl;
 
     indent(f_cpp_) << "if (reader.noMore()) { reader.fail(); return false; }"
@@ -2510,6 +2584,15 @@ void t_yarp_generator::generate_serialize_container(ofstream& out,
 
   scope_up(out);
 
+  string block_tag = list_block_tag(ttype);
+  if (!block_tag.empty()) {
+    indent(out) <<
+      "if (!writer.writeListBlock(" << block_tag << ", " <<
+      prefix << ".data(), static_cast<uint32_t>(" << prefix << ".size()))) return false;" << endl;
+    scope_down(out);
+    return;
+  }
+
   if (ttype->is_map()) {
     indent(out) <<
       "if (!writer.writeMapBegin(" <<
@@ -2704,10 +2787,14 @@ void t_yarp_generator::generate_deserialize_container(ofstream& out,
 
   t_container* tcontainer = (t_container*)ttype;
   bool use_push = tcontainer->has_cpp_name();
+  string block_tag = list_block_tag(ttype);
 
-  indent(out) <<
-    prefix << ".clear();" << endl <<
-    indent() << "uint32_t " << size << ";" << endl;
+  // a list is resized, so that its elements (and the memory they own)
+  // are reused if it is read again
+  if (!ttype->is_list() || use_push) {
+    indent(out) << prefix << ".clear();" << endl;
+  }
+  indent(out) << "uint32_t " << size << ";" << endl;
 
   // Declare variables, read header
   if (ttype->is_map()) {
@@ -2733,6 +2820,14 @@ void t_yarp_generator::generate_deserialize_container(ofstream& out,
   }
 
 
+  // the elements of a list of numbers are read as a single block, if
+  // they were sent as such, otherwise one by one
+  if (!block_tag.empty()) {
+    indent(out) << "if (!reader.readListBlock(" << block_tag << ", " <<
+      prefix << ".data(), " << size << "))" << endl;
+    scope_up(out);
+  }
+
   // For loop iterates over elements
   string i = tmp("_i");
   out <<
@@ -2751,6 +2846,10 @@ void t_yarp_generator::generate_deserialize_container(ofstream& out,
 
     scope_down(out);
 
+  if (!block_tag.empty()) {
+    scope_down(out);
+  }
+
   // Read container end
   if (ttype->is_map()) {
     indent(out) << "reader.readMapEnd();" << endl;
@@ -19,6 +19,9 @@
 #include <yarp/os/QosStyle.h>
 #include <yarp/os/Time.h>
 
+#include <string>
+#include <vector>
+
 
 namespace yarp {
     namespace os {
@@ -42,6 +45,27 @@ namespace yarp {
  */
 class YARP_OS_API yarp::os::NetworkBase {
 public:
+    /**
+     * A connection to be made or removed by connectMany() and
+     * disconnectMany().
+     */
+    struct ConnectionRequest {
+        std::string src;      ///< the name of an output port
+        std::string dest;     ///< the name of an input port
+        std::string carrier;  ///< if set, replaces the carrier of the style
+        bool ok;              ///< set to the outcome of the request
+
+        ConnectionRequest(const std::string& src = "",
+                          const std::string& dest = "",
+                          const std::string& carrier = "") :
+                src(src),
+                dest(dest),
+                carrier(carrier),
+                ok(false)
+        {
+        }
+    };
+
     /**
      * Basic system initialization, not including plugins.
      * Must eventually make a matching call to finiMinimum().
@@ -145,6 +169,33 @@ public:
     static bool disconnect(const std::string& src, const std::string& dest,
                            const ContactStyle& style);
 
+    /**
+     * Request several connections between output and input ports.
+     * The ports are looked up with a single query to the name server,
+     * and the requests are sent to the ports concurrently.
+     * @param requests the connections; the outcome of each one is
+     *                 stored in its ok field
+     * @param style options for the connections
+     * @param parallelism the maximum number of requests in progress
+     * @return true if all the connections were made
+     */
+    static bool connectMany(std::vector<ConnectionRequest>& requests,
+                            const ContactStyle& style,
+                            size_t parallelism = 8);
+
+    /**
+     * Request that several output ports disconnect from input ports.
+     * See connectMany().
+     * @param requests the connections; the outcome of each one is
+     *                 stored in its ok field
+     * @param style options for network communication related to disconnection
+     * @param parallelism the maximum number of requests in progress
+     * @return true if all the connections were removed
+     */
+    static bool disconnectMany(std::vector<ConnectionRequest>& requests,
+                               const ContactStyle& style,
+                               size_t parallelism = 8);
+
     /**
      * Check if a connection exists between two ports.
      * @param src the name of an output port
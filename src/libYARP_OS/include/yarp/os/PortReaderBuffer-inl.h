@@ -10,6 +10,28 @@
 #ifndef YARP_OS_PORTREADERBUFFER_INL_H
 #define YARP_OS_PORTREADERBUFFER_INL_H
 
+namespace yarp {
+namespace os {
+namespace impl {
+
+template <typename T>
+inline bool copyObject(T& dest, const T& src, std::true_type)
+{
+    dest = src;
+    return true;
+}
+
+template <typename T>
+inline bool copyObject(T& dest, const T& src, std::false_type)
+{
+    YARP_UNUSED(dest);
+    YARP_UNUSED(src);
+    return false;
+}
+
+} // namespace impl
+} // namespace os
+} // namespace yarp
 
 template <typename T>
 yarp::os::PortReaderBuffer<T>::PortReaderBuffer(unsigned int maxBuffer) :
@@ -154,6 +176,17 @@ yarp::os::PortReader* yarp::os::PortReaderBuffer<T>::create() const
     return new T;
 }
 
+template <typename T>
+bool yarp::os::PortReaderBuffer<T>::copy(PortReader& dest, const Portable& src) const
+{
+    // subclasses of T may carry more than T knows how to assign
+    const T* obj = dynamic_cast<const T*>(&src);
+    if (obj == nullptr || typeid(*obj) != typeid(T) || typeid(dest) != typeid(T)) {
+        return false;
+    }
+    return impl::copyObject(*dynamic_cast<T*>(&dest), *obj, std::is_copy_assignable<T>());
+}
+
 template <typename T>
 void yarp::os::PortReaderBuffer<T>::setReplier(PortReader& reader)
 {
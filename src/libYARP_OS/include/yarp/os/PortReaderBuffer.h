@@ -23,6 +23,8 @@
 #include <yarp/os/PortReaderBufferBaseCreator.h>
 
 #include <cstdio>
+#include <type_traits>
+#include <typeinfo>
 
 namespace yarp {
     namespace os {
@@ -118,6 +120,14 @@ public:
      */
     virtual PortReader *create() const override;
 
+    /**
+     * Copy an object sent by a port of the same process, by assignment.
+     * This is done only if both objects are exactly of type T, and T is
+     * copy assignable: the assignment must give the same result as
+     * sending the object through the network.
+     */
+    virtual bool copy(PortReader& dest, const Portable& src) const override;
+
     // documented in TypedReader
     virtual void setReplier(PortReader& reader) override;
 
@@ -13,6 +13,8 @@
 #include <yarp/os/api.h>
 
 namespace yarp { namespace os { class PortReaderBufferBaseCreator; }}
+namespace yarp { namespace os { class PortReader; }}
+namespace yarp { namespace os { class Portable; }}
 
 namespace yarp {
 namespace os {
@@ -23,6 +25,15 @@ public:
     virtual ~PortReaderBufferBaseCreator();
 
     virtual yarp::os::PortReader *create() const = 0;
+
+    /**
+     * Copy an object sent by a port of the same process into an object
+     * made by create(), without serializing it.
+     *
+     * @return true iff the object was copied, false if it is not of
+     *         the expected type (the default)
+     */
+    virtual bool copy(yarp::os::PortReader& dest, const yarp::os::Portable& src) const;
 };
 
 } // namespace os
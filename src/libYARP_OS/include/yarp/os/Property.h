@@ -41,10 +41,9 @@ public:
     /**
      * Constructor.
      *
-     * @param hash_size a scalar controlling efficiency of the
-     * hash map storing the data.  Set to 0 for default size.
-     * The bigger this number, the more memory used, but the
-     * more efficient the map.
+     * @param hash_size the number of keys expected, used to size
+     * the hash table storing the data.  Set to 0 for default size.
+     * The table grows as needed, this just avoids rehashing.
      */
     Property(int hash_size = 0);
 
@@ -116,7 +116,9 @@ public:
      *        PERIODIC will run periodically
      * @param newThread whether the timer should be executed in a his own thread
      *        or with all the timers with newThread == false (in any case they
-     *        will not run in the main thread)
+     *        will not run in the main thread). The callbacks of the timers
+     *        sharing a thread can be distributed on a pool of threads, see
+     *        setWorkerCount().
      */
     Timer(const yarp::os::TimerSettings& settings, TimerCallback callback, bool newThread, yarp::os::Mutex* mutex = nullptr);
 
@@ -160,6 +162,8 @@ public:
 
     /**
      * @brief setSettings
+     * A running timer keeps running, with the new period from its next
+     * deadline.
      * @param settings the new settings
      */
     void setSettings(const yarp::os::TimerSettings& settings);
@@ -178,6 +182,18 @@ public:
 
     virtual bool isRunning();
 
+    /**
+     * @brief Sets the number of worker threads executing the callbacks of
+     *        the timers with newThread == false. With 0 workers the
+     *        callbacks are executed by the thread running the timers. If
+     *        never called, the YARP_TIMER_WORKERS environment variable is
+     *        used, and 0 if it is not set.
+     *        It takes effect when that thread starts, i.e. when the first
+     *        of those timers is created.
+     * @param count the number of worker threads
+     */
+    static void setWorkerCount(size_t count);
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     class PrivateImpl;
 private:
@@ -150,6 +150,14 @@ public:
 
     void readListBegin(WireState& nstate, std::uint32_t& len);
 
+    /**
+     * Read the elements of the list started by readListBegin() as a single
+     * block, if they are all of the type given by tag (as sent by
+     * WireWriter::writeListBlock()). Otherwise nothing is read and false is
+     * returned, and the elements must be read one by one.
+     */
+    bool readListBlock(std::int32_t tag, void* data, std::uint32_t len);
+
     void readSetBegin(WireState& nstate, std::uint32_t& len);
 
     void readMapBegin(WireState& nstate, WireState& nstate2, std::uint32_t& len);
@@ -90,6 +90,12 @@ public:
 
     bool writeListBegin(int tag, std::uint32_t len) const;
 
+    /**
+     * Write a list of numbers of the type given by tag (e.g.
+     * BOTTLE_TAG_FLOAT64) as a single block, tagged once.
+     */
+    bool writeListBlock(std::int32_t tag, const void* data, std::uint32_t len) const;
+
     bool writeSetBegin(int tag, std::uint32_t len) const;
 
     bool writeMapBegin(int tag, int tag2, std::uint32_t len) const;
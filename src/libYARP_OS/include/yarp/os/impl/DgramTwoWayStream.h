@@ -36,6 +36,11 @@ namespace yarp {
 /**
  * A stream abstraction for datagram communication.  It supports UDP and
  * MCAST.  This class is not concerned with making the stream reliable.
+ *
+ * Messages bigger than a datagram are split in several datagrams, each
+ * one carrying a checksum and its index in the message.  Where available
+ * (linux), datagrams are sent and received in batches with a single
+ * system call.
  */
 class YARP_OS_impl_API yarp::os::impl::DgramTwoWayStream : public TwoWayStream, public InputStream, public OutputStream
 {
@@ -50,7 +55,14 @@ public:
                           mutex(), readAt(0), readAvail(0),
                           writeAvail(0), pct(0), happy(true),
                           bufferAlertNeeded(false), bufferAlerted(false),
-                          multiMode(false), errCount(0), lastReportTime(0)
+                          multiMode(false), errCount(0), lastReportTime(0),
+                          batch(nullptr),
+                          readSize(0), writeSize(0),
+                          readSlots(1), writeSlots(1),
+                          readSlot(0), readCount(0), writeQueued(0),
+                          inSync(true),
+                          lostDatagrams(0), reorderedDatagrams(0),
+                          corruptedDatagrams(0)
     {
     }
 
@@ -147,7 +159,34 @@ public:
 
     virtual void onMonitorOutput() {}
 
+    /**
+     * Number of datagrams missing from the received messages, detected
+     * from the gaps in the datagram indexes.
+     */
+    size_t getLostDatagrams() const
+    {
+        return lostDatagrams;
+    }
+
+    /**
+     * Number of datagrams received out of order (and discarded).
+     */
+    size_t getReorderedDatagrams() const
+    {
+        return reorderedDatagrams;
+    }
+
+    /**
+     * Number of datagrams discarded because of a checksum error.
+     */
+    size_t getCorruptedDatagrams() const
+    {
+        return corruptedDatagrams;
+    }
+
 private:
+    class Batch;
+
     yarp::os::ManagedBytes monitor;
     bool closed, interrupting, reader;
 #ifdef YARP_HAS_ACE
@@ -172,9 +211,29 @@ private:
     int errCount;
     double lastReportTime;
 
+    // readBuffer and writeBuffer store readSlots and writeSlots datagrams
+    // of readSize and writeSize bytes
+    Batch *batch;
+    yarp::conf::ssize_t readSize, writeSize;
+    int readSlots, writeSlots;
+    int readSlot, readCount, writeQueued;
+
+    bool inSync;
+    size_t lostDatagrams;
+    size_t reorderedDatagrams;
+    size_t corruptedDatagrams;
+
     void allocate(int readSize=0, int writeSize=0);
 
     void configureSystemBuffers();
+
+    int getSocketBufferSize(int option);
+
+    yarp::conf::ssize_t receiveDatagram();
+
+    void sealDatagram();
+
+    void sendQueued();
 };
 
 #endif // YARP_OS_IMPL_DGRAMTWOWAYSTREAM_H
@@ -97,6 +97,7 @@ public:
     virtual std::string getName() const override;
 
     virtual bool requireAck() const override;
+    virtual bool supportReply() const override;
     virtual bool isConnectionless() const override;
     virtual bool canEscape() const override;
     virtual bool isLocal() const override;
@@ -111,14 +112,19 @@ public:
     virtual bool respondToHeader(ConnectionState& proto) override;
     virtual bool expectReplyToHeader(ConnectionState& proto) override;
     virtual bool expectIndex(ConnectionState& proto) override;
+    virtual bool sendAck(ConnectionState& proto) override;
+    virtual bool expectAck(ConnectionState& proto) override;
+    virtual void handleEnvelope(const std::string& envelope) override;
 
     void removePeer();
     void shutdown();
-    void accept(yarp::os::Portable *ref);
+    void accept(yarp::os::Portable *ref, const std::string& envelope = "");
 
 protected:
     bool doomed;
     yarp::os::Portable *ref;
+    std::string envelope;
+    bool pending;
     LocalCarrier *peer;
     yarp::os::Mutex peerMutex;
     yarp::os::Semaphore sent;
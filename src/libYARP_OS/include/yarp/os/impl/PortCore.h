@@ -427,6 +427,13 @@ public:
     // documented in PortManager
     virtual bool readBlock(yarp::os::ConnectionReader& reader, void *id, OutputStream *os) override;
 
+    /**
+     * Pass a message to a reader.  A message sent by a port of the same
+     * process carries the object itself: a PortReaderBuffer copies it,
+     * any other reader gets it serialized.
+     */
+    static bool readMessage(yarp::os::PortReader& target, yarp::os::ConnectionReader& reader);
+
 
     /**
      * Generate a description of the connections associated with the
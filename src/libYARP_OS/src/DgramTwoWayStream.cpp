@@ -37,14 +37,75 @@
 #  include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#  include <sys/socket.h>
+#  include <sys/uio.h>
+#endif
+
 #include <cerrno>
 #include <cstring>
+#include <vector>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
 
 #define CRC_SIZE 8
-#define UDP_MAX_DATAGRAM_SIZE 65507 - CRC_SIZE
+#define UDP_MAX_DATAGRAM_SIZE (65507 - CRC_SIZE)
+
+// Maximum number of datagrams sent or received with a single system call
+#define DGRAM_BATCH_SIZE 8
+
+// Receive buffer requested to the system when not set by the user
+#define DGRAM_DEFAULT_RECV_BUFFER_SIZE (4*1024*1024)
+
+
+/**
+ * Storage for the datagrams sent and received in a batch.
+ */
+class DgramTwoWayStream::Batch
+{
+public:
+    std::vector<yarp::conf::ssize_t> readLengths;
+    std::vector<yarp::conf::ssize_t> writeLengths;
+#if defined(__linux__)
+    std::vector<struct iovec> readIov;
+    std::vector<struct iovec> writeIov;
+    std::vector<struct mmsghdr> readMsgs;
+    std::vector<struct mmsghdr> writeMsgs;
+#endif
+
+    void resize(char *readBase, yarp::conf::ssize_t readSize, int readSlots,
+                char *writeBase, yarp::conf::ssize_t writeSize, int writeSlots)
+    {
+        readLengths.assign(readSlots, 0);
+        writeLengths.assign(writeSlots, 0);
+#if defined(__linux__)
+        readIov.resize(readSlots);
+        readMsgs.resize(readSlots);
+        for (int i=0; i<readSlots; i++) {
+            readIov[i].iov_base = readBase + i*readSize;
+            readIov[i].iov_len = readSize;
+            memset(&readMsgs[i], 0, sizeof(struct mmsghdr));
+            readMsgs[i].msg_hdr.msg_iov = &readIov[i];
+            readMsgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        writeIov.resize(writeSlots);
+        writeMsgs.resize(writeSlots);
+        for (int i=0; i<writeSlots; i++) {
+            writeIov[i].iov_base = writeBase + i*writeSize;
+            writeIov[i].iov_len = 0;
+            memset(&writeMsgs[i], 0, sizeof(struct mmsghdr));
+            writeMsgs[i].msg_hdr.msg_iov = &writeIov[i];
+            writeMsgs[i].msg_hdr.msg_iovlen = 1;
+        }
+#else
+        YARP_UNUSED(readBase);
+        YARP_UNUSED(readSize);
+        YARP_UNUSED(writeBase);
+        YARP_UNUSED(writeSize);
+#endif
+    }
+};
 
 
 static bool checkCrc(char *buf, yarp::conf::ssize_t length, yarp::conf::ssize_t crcLength, int pct,
@@ -219,43 +280,85 @@ void DgramTwoWayStream::allocate(int readSize, int writeSize) {
         _write_size = UDP_MAX_DATAGRAM_SIZE;
     }
 
+    int socketReadSize = -1;
+    if (dgram != nullptr) {
+        socketReadSize = getSocketBufferSize(SO_RCVBUF);
+    }
+
     if (_read_size < 0)
     {
-        #if defined(YARP_HAS_ACE)
-            //Defaults to socket size
-            if (dgram) {
-                int len = sizeof(_read_size);
-                int result = dgram->get_option(SOL_SOCKET, SO_RCVBUF, &_read_size, &len);
-                if (result < 0) {
-                    YARP_ERROR(Logger::get(), std::string("Failed to read buffer size from RCVBUF socket with error: ") +
-                               std::string(strerror(errno)) +
-                               std::string(". Setting read buffer size to UDP_MAX_DATAGRAM_SIZE."));
-                    _read_size = UDP_MAX_DATAGRAM_SIZE;
-                }
-            }
-        #else
-            socklen_t len = sizeof(_read_size);
-
-            int result = getsockopt(dgram_sockfd, SOL_SOCKET, SO_RCVBUF, &_read_size, &len);
-            if (result < 0) {
-                YARP_ERROR(Logger::get(), std::string("Failed to read buffer size from RCVBUF socket with error: ") +
-                           std::string(strerror(errno)) +
-                           std::string(". Setting read buffer size to UDP_MAX_DATAGRAM_SIZE."));
-                _read_size = UDP_MAX_DATAGRAM_SIZE;
+        if (socketReadSize < 0) {
+            YARP_ERROR(Logger::get(), std::string("Failed to read buffer size from RCVBUF socket with error: ") +
+                       std::string(strerror(errno)) +
+                       std::string(". Setting read buffer size to UDP_MAX_DATAGRAM_SIZE."));
+            _read_size = UDP_MAX_DATAGRAM_SIZE;
+        } else {
+            //Defaults to socket size, but no datagram is bigger than this
+            _read_size = socketReadSize;
+            if (_read_size > UDP_MAX_DATAGRAM_SIZE + CRC_SIZE) {
+                _read_size = UDP_MAX_DATAGRAM_SIZE + CRC_SIZE;
             }
-        #endif
+        }
+    }
+
+    readSlots = 1;
+    writeSlots = 1;
+#if defined(__linux__)
+    if (dgram != nullptr) {
+        readSlots = DGRAM_BATCH_SIZE;
+        // A burst bigger than the receive buffer (of the receiver on this
+        // machine, assumed to be the same of ours) would be dropped
+        writeSlots = (socketReadSize > 0) ? socketReadSize/2/_write_size : 1;
+        if (writeSlots < 1) {
+            writeSlots = 1;
+        }
+        if (writeSlots > DGRAM_BATCH_SIZE) {
+            writeSlots = DGRAM_BATCH_SIZE;
+        }
     }
+#endif
 
-    readBuffer.allocate(_read_size);
-    writeBuffer.allocate(_write_size);
+    this->readSize = _read_size;
+    this->writeSize = _write_size;
+    readBuffer.allocate(_read_size*readSlots);
+    writeBuffer.allocate(_write_size*writeSlots);
+    if (batch == nullptr) {
+        batch = new Batch;
+    }
+    batch->resize(readBuffer.get(), _read_size, readSlots,
+                  writeBuffer.get(), _write_size, writeSlots);
     readAt = 0;
     readAvail = 0;
+    readSlot = 0;
+    readCount = 0;
     writeAvail = CRC_SIZE;
+    writeQueued = 0;
     //happy = true;
     pct = 0;
 }
 
 
+int DgramTwoWayStream::getSocketBufferSize(int option) {
+    int size = -1;
+#if defined(YARP_HAS_ACE)
+    int len = sizeof(size);
+    int result = dgram->get_option(SOL_SOCKET, option, &size, &len);
+#else
+    socklen_t len = sizeof(size);
+    int result = getsockopt(dgram_sockfd, SOL_SOCKET, option, &size, &len);
+#endif
+    if (result < 0) {
+        return -1;
+    }
+    // in linux the value returned by getsockopt is "doubled"
+    // for some unknown reasons (see https://linux.die.net/man/7/socket)
+#if defined(__linux__)
+    size /= 2;
+#endif
+    return size;
+}
+
+
 void DgramTwoWayStream::configureSystemBuffers() {
     //By default the buffers are forced to the datagram size limit.
     //These can be overwritten by environment variables
@@ -271,6 +374,25 @@ void DgramTwoWayStream::configureSystemBuffers() {
         readBufferSize = NetType::toInt(socketReadBufferSize);
     } else if (socketBufferSize != "") {
         readBufferSize = NetType::toInt(socketBufferSize);
+    } else {
+        // Ask for a larger buffer than the usual system default, so that
+        // large messages are not dropped.  The system caps it silently to
+        // its limit (net.core.rmem_max on linux).
+        int defaultReadBufferSize = DGRAM_DEFAULT_RECV_BUFFER_SIZE;
+        if (getSocketBufferSize(SO_RCVBUF) < defaultReadBufferSize) {
+#if defined(YARP_HAS_ACE)
+            dgram->set_option(SOL_SOCKET, SO_RCVBUF,
+                              (void*)&defaultReadBufferSize, sizeof(defaultReadBufferSize));
+#else
+            setsockopt(dgram_sockfd, SOL_SOCKET, SO_RCVBUF,
+                       (void*)&defaultReadBufferSize, sizeof(defaultReadBufferSize));
+#endif
+            if (getSocketBufferSize(SO_RCVBUF) < defaultReadBufferSize) {
+                // Warn only when a datagram is dropped
+                bufferAlertNeeded = true;
+                bufferAlerted = false;
+            }
+        }
     }
 
     int writeBufferSize = -1;
@@ -631,6 +753,7 @@ bool DgramTwoWayStream::join(const Contact& group, bool sender,
 
 DgramTwoWayStream::~DgramTwoWayStream() {
     closeMain();
+    delete batch;
 }
 
 void DgramTwoWayStream::interrupt() {
@@ -747,47 +870,13 @@ yarp::conf::ssize_t DgramTwoWayStream::read(Bytes& b) {
         if (readAvail==0) {
             readAt = 0;
 
-
-            //yAssert(dgram != nullptr);
-            //YARP_DEBUG(Logger::get(), "DGRAM Waiting for something!");
             yarp::conf::ssize_t result = -1;
-#if defined(YARP_HAS_ACE)
-            if (dgram && restrictInterfaceIp.isValid()) {
-                /*
-                printf("Consider remote mcast\n");
-                printf("What we know:\n");
-                printf("  %s\n", restrictInterfaceIp.toString().c_str());
-                printf("  %s\n", localAddress.toString().c_str());
-                printf("  %s\n", remoteAddress.toString().c_str());
-                */
-                ACE_INET_Addr iface(restrictInterfaceIp.getPort(),
-                                    restrictInterfaceIp.getHost().c_str());
-                ACE_INET_Addr dummy((u_short)0, (ACE_UINT32)INADDR_ANY);
-                result =
-                    dgram->recv(readBuffer.get(), readBuffer.length(), dummy);
-                YARP_DEBUG(Logger::get(),
-                           std::string("MCAST Got ") + NetType::toString((int)result) +
-                           " bytes");
-
-            } else
-#endif
             if (dgram != nullptr) {
-                yAssert(dgram != nullptr);
-#if defined(YARP_HAS_ACE)
-                ACE_INET_Addr dummy((u_short)0, (ACE_UINT32)INADDR_ANY);
-                //YARP_DEBUG(Logger::get(), "DGRAM Waiting for something!");
-                result =
-                    dgram->recv(readBuffer.get(), readBuffer.length(), dummy);
-#else
-                result = recv(dgram_sockfd, readBuffer.get(), readBuffer.length(), 0);
-#endif
-                YARP_DEBUG(Logger::get(),
-                           std::string("DGRAM Got ") + NetType::toString((int)result) +
-                           " bytes");
+                result = receiveDatagram();
             } else {
                 onMonitorInput();
                 //printf("Monitored input of %d bytes\n", monitor.length());
-                if (monitor.length()>readBuffer.length()) {
+                if ((yarp::conf::ssize_t)monitor.length()>readSize) {
                     printf("Too big!\n");
                     std::exit(1);
                 }
@@ -812,9 +901,26 @@ yarp::conf::ssize_t DgramTwoWayStream::read(Bytes& b) {
 
             // deal with CRC
             int altPct = 0;
-            bool crcOk = checkCrc(readBuffer.get(), readAvail, CRC_SIZE, pct,
+            bool crcOk = checkCrc(readBuffer.get()+readAt, readAvail, CRC_SIZE, pct,
                                   &altPct);
             if (altPct!=-1) {
+                if (!crcOk) {
+                    // the datagrams following a drop, up to the next
+                    // message, are dropped too but not counted again
+                    if (!checkCrc(readBuffer.get()+readAt, readAvail, CRC_SIZE, altPct)) {
+                        corruptedDatagrams++;
+                    } else if (inSync) {
+                        if (altPct == 0) {
+                            // the end of the previous message is missing
+                            lostDatagrams++;
+                        } else if (altPct > pct) {
+                            lostDatagrams += altPct - pct;
+                        } else {
+                            reorderedDatagrams++;
+                        }
+                    }
+                    inSync = false;
+                }
                 pct++;
                 if (!crcOk) {
                     if (bufferAlertNeeded&&!bufferAlerted) {
@@ -839,7 +945,10 @@ yarp::conf::ssize_t DgramTwoWayStream::read(Bytes& b) {
                         double now = SystemClock::nowSystem();
                         if (now-lastReportTime>1) {
                             YARP_ERROR(Logger::get(),
-                                       std::string("*** ") + NetType::toString(errCount) + " datagram packet(s) dropped - checksum error ***");
+                                       std::string("*** ") + NetType::toString(errCount) + " datagram packet(s) dropped - checksum error ***" +
+                                       " (total: " + NetType::toString((long)lostDatagrams) + " lost, " +
+                                       NetType::toString((long)reorderedDatagrams) + " out of order, " +
+                                       NetType::toString((long)corruptedDatagrams) + " corrupted)");
                             lastReportTime = now;
                             errCount = 0;
                         }
@@ -847,6 +956,7 @@ yarp::conf::ssize_t DgramTwoWayStream::read(Bytes& b) {
                     reset();
                     return -1;
                 } else {
+                    inSync = true;
                     readAt += CRC_SIZE;
                     readAvail -= CRC_SIZE;
                 }
@@ -872,6 +982,50 @@ yarp::conf::ssize_t DgramTwoWayStream::read(Bytes& b) {
     return 0;
 }
 
+yarp::conf::ssize_t DgramTwoWayStream::receiveDatagram() {
+    // datagrams left from the last batch
+    readSlot++;
+    if (readSlot < readCount) {
+        readAt = readSlot*readSize;
+        return batch->readLengths[readSlot];
+    }
+    readSlot = 0;
+    readCount = 0;
+    readAt = 0;
+
+    yarp::conf::ssize_t result = -1;
+#if defined(__linux__)
+#  if defined(YARP_HAS_ACE)
+    int fd = dgram->get_handle();
+#  else
+    int fd = dgram_sockfd;
+#  endif
+    // wait for one datagram, then take all the ones already arrived
+    int n = -1;
+    do {
+        n = recvmmsg(fd, batch->readMsgs.data(), readSlots, MSG_WAITFORONE, nullptr);
+    } while (n < 0 && errno == EINTR && !closed);
+    if (n > 0) {
+        for (int i=0; i<n; i++) {
+            batch->readLengths[i] = batch->readMsgs[i].msg_len;
+        }
+        readCount = n;
+        result = batch->readLengths[0];
+    }
+#elif defined(YARP_HAS_ACE)
+    ACE_INET_Addr dummy((u_short)0, (ACE_UINT32)INADDR_ANY);
+    result = dgram->recv(readBuffer.get(), readSize, dummy);
+    readCount = 1;
+#else
+    result = recv(dgram_sockfd, readBuffer.get(), readSize, 0);
+    readCount = 1;
+#endif
+    YARP_DEBUG(Logger::get(),
+               std::string("DGRAM Got ") + NetType::toString((int)result) +
+               " bytes");
+    return result;
+}
+
 void DgramTwoWayStream::write(const Bytes& b) {
     //YARP_DEBUG(Logger::get(), "DGRAM prep writing");
     //printf("DGRAM write %d bytes\n", b.length());
@@ -886,24 +1040,34 @@ void DgramTwoWayStream::write(const Bytes& b) {
     Bytes local = b;
     while (local.length()>0) {
         //YARP_DEBUG(Logger::get(), "DGRAM prep writing");
+        char *datagram = writeBuffer.get() + writeQueued*writeSize;
         yarp::conf::ssize_t rem = local.length();
-        yarp::conf::ssize_t space = writeBuffer.length()-writeAvail;
+        yarp::conf::ssize_t space = writeSize-writeAvail;
         bool shouldFlush = false;
         if (rem>=space) {
             rem = space;
             shouldFlush = true;
         }
-        memcpy(writeBuffer.get()+writeAvail, local.get(), rem);
+        memcpy(datagram+writeAvail, local.get(), rem);
         writeAvail+=rem;
         local = Bytes(local.get()+rem, local.length()-rem);
         if (shouldFlush) {
-            flush();
+            sealDatagram();
+            if (writeQueued == writeSlots) {
+                sendQueued();
+            }
         }
     }
 }
 
 
 void DgramTwoWayStream::flush() {
+    sealDatagram();
+    sendQueued();
+}
+
+
+void DgramTwoWayStream::sealDatagram() {
     if (writeBuffer.get() == nullptr) {
         return;
     }
@@ -912,83 +1076,143 @@ void DgramTwoWayStream::flush() {
     if (writeAvail<=CRC_SIZE) {
         return;
     }
-    addCrc(writeBuffer.get(), writeAvail, CRC_SIZE, pct);
+    char *datagram = writeBuffer.get() + writeQueued*writeSize;
+    addCrc(datagram, writeAvail, CRC_SIZE, pct);
     pct++;
 
-    if (writeAvail>0) {
-        //yAssert(dgram != nullptr);
-        yarp::conf::ssize_t len = 0;
+    if (dgram != nullptr) {
+        batch->writeLengths[writeQueued] = writeAvail;
+        writeQueued++;
+    } else {
+        Bytes b(datagram, writeAvail);
+        monitor = ManagedBytes(b, false);
+        monitor.copy();
+        //printf("Monitored output of %d bytes\n", monitor.length());
+        onMonitorOutput();
+    }
 
-#if defined(YARP_HAS_ACE)
-        if (mgram != nullptr) {
-            len = mgram->send(writeBuffer.get(), writeAvail);
-            YARP_DEBUG(Logger::get(),
-                       std::string("MCAST - wrote ") +
-                       NetType::toString((int)len) + " bytes"
-                       );
-        } else
-#endif
-            if (dgram != nullptr) {
-#if defined(YARP_HAS_ACE)
-            len = dgram->send(writeBuffer.get(), writeAvail,
-                              remoteHandle);
+    // make space for CRC
+    writeAvail = CRC_SIZE;
+}
+
+
+void DgramTwoWayStream::sendQueued() {
+    if (writeQueued == 0 || dgram == nullptr) {
+        writeQueued = 0;
+        return;
+    }
+
+    bool longDgrams = false;
+    for (int i=0; i<writeQueued; i++) {
+        if (batch->writeLengths[i]>writeSize*0.75) {
+            longDgrams = true;
+        }
+    }
+
+    bool failed = false;
+    bool partial = false;
+
+#if defined(__linux__)
+#  if defined(YARP_HAS_ACE)
+    int fd = dgram->get_handle();
+    void *name = remoteHandle.get_addr();
+    socklen_t nameLength = remoteHandle.get_size();
+#  else
+    int fd = dgram_sockfd;
+    void *name = nullptr;
+    socklen_t nameLength = 0;
+#  endif
+    for (int i=0; i<writeQueued; i++) {
+        batch->writeIov[i].iov_len = batch->writeLengths[i];
+        batch->writeMsgs[i].msg_hdr.msg_name = name;
+        batch->writeMsgs[i].msg_hdr.msg_namelen = nameLength;
+    }
+    int sent = 0;
+    while (sent < writeQueued) {
+        int n = sendmmsg(fd, batch->writeMsgs.data()+sent, writeQueued-sent, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = true;
+            break;
+        }
+        for (int i=sent; i<sent+n; i++) {
+            if ((yarp::conf::ssize_t)batch->writeMsgs[i].msg_len != batch->writeLengths[i]) {
+                partial = true;
+            }
+        }
+        sent += n;
+    }
+    YARP_DEBUG(Logger::get(),
+               std::string("DGRAM - wrote ") +
+               NetType::toString(sent) + " datagrams to " +
+               remoteAddress.toString()
+               );
 #else
-            len = send(dgram_sockfd, writeBuffer.get(),
-                       writeAvail, 0);
-#endif
-            YARP_DEBUG(Logger::get(),
-                       std::string("DGRAM - wrote ") +
-                       NetType::toString((int)len) + " bytes to " +
-                       remoteAddress.toString()
-                       );
+    for (int i=0; i<writeQueued && !failed; i++) {
+        char *datagram = writeBuffer.get() + i*writeSize;
+        yarp::conf::ssize_t len = 0;
+#  if defined(YARP_HAS_ACE)
+        if (mgram != nullptr) {
+            len = mgram->send(datagram, batch->writeLengths[i]);
         } else {
-            Bytes b(writeBuffer.get(), writeAvail);
-            monitor = ManagedBytes(b, false);
-            monitor.copy();
-            //printf("Monitored output of %d bytes\n", monitor.length());
-            len = monitor.length();
-            onMonitorOutput();
-        }
-        //if (len>WRITE_SIZE*0.75) {
-        if (len>writeBuffer.length()*0.75) {
-            YARP_DEBUG(Logger::get(),
-                       "long dgrams might need a little time");
-
-            // Under heavy loads, packets could get dropped
-            // 640x480x3 images correspond to about 15 datagrams
-            // so there's not much time possible between them
-            // looked at iperf, it just does a busy-waiting delay
-            // there's an implementation below, but commented out -
-            // better solution was to increase recv buffer size
-
-            double first = yarp::os::SystemClock::nowSystem();
-            double now;
-            int ct = 0;
-            do {
-                //printf("Busy wait... %d\n", ct);
-                yarp::os::SystemClock::delaySystem(0);
-                now = yarp::os::SystemClock::nowSystem();
-                ct++;
-            } while (now-first<0.001);
+            len = dgram->send(datagram, batch->writeLengths[i],
+                              remoteHandle);
         }
-
+#  else
+        len = send(dgram_sockfd, datagram,
+                   batch->writeLengths[i], 0);
+#  endif
+        YARP_DEBUG(Logger::get(),
+                   std::string("DGRAM - wrote ") +
+                   NetType::toString((int)len) + " bytes to " +
+                   remoteAddress.toString()
+                   );
         if (len < 0) {
-            happy = false;
-            YARP_DEBUG(Logger::get(), "DGRAM failed to send message with error: " + std::string(strerror(errno)));
-            return;
+            failed = true;
+        } else if (len != batch->writeLengths[i]) {
+            partial = true;
         }
-        writeAvail -= len;
+    }
+#endif
+    writeQueued = 0;
 
-        if (writeAvail!=0) {
-            // well, we have a problem
-            // checksums will cause dumping
-            YARP_DEBUG(Logger::get(), "dgram/mcast send behaving badly");
-        }
+    if (failed) {
+        happy = false;
+        YARP_DEBUG(Logger::get(), "DGRAM failed to send message with error: " + std::string(strerror(errno)));
+        return;
     }
-    // finally: writeAvail should be 0
 
-    // make space for CRC
-    writeAvail = CRC_SIZE;
+    if (partial) {
+        // well, we have a problem
+        // checksums will cause dumping
+        YARP_DEBUG(Logger::get(), "dgram/mcast send behaving badly");
+    }
+
+    if (longDgrams) {
+        YARP_DEBUG(Logger::get(),
+                   "long dgrams might need a little time");
+
+        // Under heavy loads, packets could get dropped
+        // 640x480x3 images correspond to about 15 datagrams
+        // so there's not much time possible between them
+        // looked at iperf, it just does a busy-waiting delay
+        // there's an implementation below, but commented out -
+        // better solution was to increase recv buffer size
+        // (the batches are limited by the recv buffer size, so
+        // only one pause is needed for each batch)
+
+        double first = yarp::os::SystemClock::nowSystem();
+        double now;
+        int ct = 0;
+        do {
+            //printf("Busy wait... %d\n", ct);
+            yarp::os::SystemClock::delaySystem(0);
+            now = yarp::os::SystemClock::nowSystem();
+            ct++;
+        } while (now-first<0.001);
+    }
 }
 
 
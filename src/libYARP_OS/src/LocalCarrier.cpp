@@ -8,6 +8,7 @@
  */
 
 #include <yarp/os/impl/LocalCarrier.h>
+#include <yarp/os/InputProtocol.h>
 #include <yarp/os/Portable.h>
 #include <yarp/os/impl/Logger.h>
 
@@ -129,6 +130,7 @@ bool yarp::os::impl::LocalCarrierStream::isOk() const {
 
 yarp::os::impl::LocalCarrier::LocalCarrier() : peerMutex(), sent(0), received(0) {
     ref = nullptr;
+    pending = false;
     peer = nullptr;
     doomed = false;
 }
@@ -160,6 +162,8 @@ void yarp::os::impl::LocalCarrier::shutdown() {
             wasPeer->removePeer();
         }
         peerMutex.unlock();
+        // release a sender still waiting for this receiver
+        received.post();
     }
 }
 
@@ -168,6 +172,11 @@ std::string yarp::os::impl::LocalCarrier::getName() const {
 }
 
 bool yarp::os::impl::LocalCarrier::requireAck() const {
+    // the sender waits until the receiver is done with the object
+    return true;
+}
+
+bool yarp::os::impl::LocalCarrier::supportReply() const {
     return false;
 }
 
@@ -262,7 +271,7 @@ bool yarp::os::impl::LocalCarrier::write(ConnectionState& proto, SizedWriter& wr
     if (ref != nullptr) {
         peerMutex.lock();
         if (peer != nullptr) {
-            peer->accept(ref);
+            peer->accept(ref, envelope);
         } else {
             YARP_ERROR(Logger::get(),
                         "local send failed - write without peer");
@@ -272,6 +281,7 @@ bool yarp::os::impl::LocalCarrier::write(ConnectionState& proto, SizedWriter& wr
         YARP_ERROR(Logger::get(),
                     "local send failed - no object");
     }
+    envelope.clear();
 
     return true;
 }
@@ -295,8 +305,13 @@ bool yarp::os::impl::LocalCarrier::expectIndex(ConnectionState& proto) {
     sent.wait();
     YARP_DEBUG(Logger::get(), "local recv: got send");
     proto.setReference(ref);
-    received.post();
+    InputProtocol *ip = dynamic_cast<InputProtocol*>(&proto);
+    if (ip != nullptr) {
+        ip->setEnvelope(envelope);
+    }
     if (ref != nullptr) {
+        // the receipt is sent once the object has been read, see sendAck()
+        pending = true;
         YARP_DEBUG(Logger::get(), "local recv: received");
     } else {
         YARP_DEBUG(Logger::get(), "local recv: shutdown");
@@ -307,8 +322,29 @@ bool yarp::os::impl::LocalCarrier::expectIndex(ConnectionState& proto) {
     return true;
 }
 
-void yarp::os::impl::LocalCarrier::accept(yarp::os::Portable *ref) {
+bool yarp::os::impl::LocalCarrier::sendAck(ConnectionState& proto) {
+    YARP_UNUSED(proto);
+    if (pending) {
+        pending = false;
+        YARP_DEBUG(Logger::get(), "local recv: send receipt");
+        received.post();
+    }
+    return true;
+}
+
+bool yarp::os::impl::LocalCarrier::expectAck(ConnectionState& proto) {
+    YARP_UNUSED(proto);
+    // the receipt was already waited for in accept()
+    return true;
+}
+
+void yarp::os::impl::LocalCarrier::handleEnvelope(const std::string& envelope) {
+    this->envelope = envelope;
+}
+
+void yarp::os::impl::LocalCarrier::accept(yarp::os::Portable *ref, const std::string& envelope) {
     this->ref = ref;
+    this->envelope = envelope;
     YARP_DEBUG(Logger::get(), "local send: send ref");
     sent.post();
     if (ref != nullptr && !doomed) {
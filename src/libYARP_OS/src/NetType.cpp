@@ -11,6 +11,7 @@
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/ManagedBytes.h>
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
@@ -66,54 +67,70 @@ int NetType::toInt(const std::string& x) {
 
 
 /*
-  PNG's nice and simple CRC code
-  (from http://www.w3.org/TR/PNG-CRCAppendix.html)
+  CRC-32 as in PNG and zlib (from http://www.w3.org/TR/PNG-CRCAppendix.html),
+  computed 8 bytes at a time with the "slicing-by-8" tables.
 */
 
-/* Table of CRCs of all 8-bit messages. */
-static unsigned long crc_table[256];
-
-/* Flag: has the table been computed? Initially false. */
-static int crc_table_computed = 0;
-
-/* Make the table for a fast CRC. */
-static void make_crc_table() {
-    unsigned long c;
-    int n, k;
-
-    for (n = 0; n < 256; n++) {
-        c = (unsigned long) n;
-        for (k = 0; k < 8; k++) {
-            if (c & 1)
-                c = 0xedb88320L ^ (c >> 1);
-            else
-                c = c >> 1;
+namespace {
+class CrcTables
+{
+public:
+    std::uint32_t t[8][256];
+
+    CrcTables()
+    {
+        for (std::uint32_t n = 0; n < 256; n++) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xedb88320U ^ (c >> 1)) : (c >> 1);
+            }
+            t[0][n] = c;
+        }
+        for (std::uint32_t n = 0; n < 256; n++) {
+            for (int k = 1; k < 8; k++) {
+                t[k][n] = (t[k-1][n] >> 8) ^ t[0][t[k-1][n] & 0xff];
+            }
         }
-        crc_table[n] = c;
     }
-    crc_table_computed = 1;
-}
+};
+} // namespace
 
 /* Update a running CRC with the bytes buf[0..len-1]--the CRC
    should be initialized to all 1's, and the transmitted value
    is the 1's complement of the final running CRC (see the
    crc() routine below)). */
 
-static unsigned long update_crc(unsigned long crc, unsigned char *buf,
+static std::uint32_t update_crc(std::uint32_t crc, const unsigned char *buf,
                                 size_t len) {
-
-    unsigned long c = crc;
-    size_t n;
-
-    if (!crc_table_computed)
-        make_crc_table();
-    for (n = 0; n < len; n++) {
-        c = crc_table[(c ^ buf[n]) & 0xff] ^ (c >> 8);
+    static const CrcTables tables;
+    const std::uint32_t (&t)[8][256] = tables.t;
+
+    std::uint32_t c = crc;
+    while (len >= 8) {
+        std::uint32_t lo = c ^ (std::uint32_t(buf[0]) |
+                                (std::uint32_t(buf[1]) << 8) |
+                                (std::uint32_t(buf[2]) << 16) |
+                                (std::uint32_t(buf[3]) << 24));
+        std::uint32_t hi = std::uint32_t(buf[4]) |
+                           (std::uint32_t(buf[5]) << 8) |
+                           (std::uint32_t(buf[6]) << 16) |
+                           (std::uint32_t(buf[7]) << 24);
+        c = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+            t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+            t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+            t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+        buf += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        c = t[0][(c ^ *buf) & 0xff] ^ (c >> 8);
+        buf++;
+        len--;
     }
     return c;
 }
 
 /* Return the CRC of the bytes buf[0..len-1]. */
 unsigned long NetType::getCrc(char *buf, size_t len) {
-    return update_crc(0xffffffffL, (unsigned char *)buf, len) ^ 0xffffffffL;
+    return update_crc(0xffffffffU, (const unsigned char *)buf, len) ^ 0xffffffffU;
 }
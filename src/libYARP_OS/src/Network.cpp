@@ -42,10 +42,14 @@
 # endif
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <map>
 #include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
@@ -99,6 +103,19 @@ static bool needsLookup(const Contact& contact)
     return true;
 }
 
+typedef std::map<std::string, Contact> ContactCache;
+
+static Contact lookupName(const std::string& name, const ContactCache* cache)
+{
+    if (cache != nullptr) {
+        ContactCache::const_iterator it = cache->find(name);
+        if (it != cache->end()) {
+            return it->second;
+        }
+    }
+    return NetworkBase::queryName(name);
+}
+
 static int noteDud(const Contact& src)
 {
     NameStore *store = getNameSpace().getQueryBypass();
@@ -317,7 +334,8 @@ static std::string extractCarrierNameOnly(std::string &carrier_name_with_params)
 static int metaConnect(const std::string& src,
                        const std::string& dest,
                        ContactStyle style,
-                       int mode) {
+                       int mode,
+                       const ContactCache* cache = nullptr) {
     YARP_SPRINTF3(Logger::get(), debug,
                   "working on connection %s to %s (%s)",
                   src.c_str(),
@@ -362,7 +380,7 @@ static int metaConnect(const std::string& src,
     Contact staticSrc;
     Contact staticDest;
     if (needsLookup(dynamicSrc)&&(topicalNeedsLookup||!topical)) {
-        staticSrc = NetworkBase::queryName(dynamicSrc.getName());
+        staticSrc = lookupName(dynamicSrc.getName(), cache);
         if (!staticSrc.isValid()) {
             if (!style.persistent) {
                 if (!style.quiet) {
@@ -385,7 +403,7 @@ static int metaConnect(const std::string& src,
     }
 
     if (needsLookup(dynamicDest)&&(topicalNeedsLookup||!topical)) {
-        staticDest = NetworkBase::queryName(dynamicDest.getName());
+        staticDest = lookupName(dynamicDest.getName(), cache);
         if (!staticDest.isValid()) {
             if (!style.persistent) {
                 if (!style.quiet) {
@@ -677,6 +695,114 @@ bool NetworkBase::disconnect(const std::string& src,
     return result == 0;
 }
 
+/*
+   Connections made together share a single lookup of the ports: the
+   name server lists its registrations, and the ports that are not
+   found there are looked up one by one as usual.
+*/
+static void fillContactCache(const std::vector<NetworkBase::ConnectionRequest>& requests,
+                             const ContactStyle& style,
+                             ContactCache& cache)
+{
+    // without a name server there is nothing to list, a name store given
+    // as a bypass is asked as the name server
+    if (NetworkBase::getLocalMode() && NetworkBase::getQueryBypass() == nullptr) {
+        return;
+    }
+    std::set<std::string> names;
+    for (const auto& request : requests) {
+        Contact src = Contact::fromString(request.src);
+        Contact dest = Contact::fromString(request.dest);
+        if (needsLookup(src)) {
+            names.insert(src.getName());
+        }
+        if (needsLookup(dest)) {
+            names.insert(dest.getName());
+        }
+    }
+    if (names.size() < 2) {
+        return;
+    }
+
+    Bottle cmd, reply;
+    cmd.addString("bot");
+    cmd.addString("list");
+    ContactStyle query;
+    query.quiet = true;
+    query.timeout = style.timeout;
+    if (!NetworkBase::writeToNameServer(cmd, reply, query)) {
+        return;
+    }
+    for (size_t i = 1; i < reply.size(); i++) {
+        Bottle* entry = reply.get(i).asList();
+        if (entry == nullptr) {
+            continue;
+        }
+        std::string name = entry->find("name").asString();
+        int port = entry->find("port_number").asInt32();
+        if (port <= 0 || names.find(name) == names.end()) {
+            continue;
+        }
+        cache[name] = Contact(name,
+                              entry->find("carrier").asString(),
+                              entry->find("ip").asString(),
+                              port);
+    }
+}
+
+static bool metaConnectMany(std::vector<NetworkBase::ConnectionRequest>& requests,
+                            const ContactStyle& style,
+                            size_t parallelism,
+                            int mode)
+{
+    ContactCache cache;
+    fillContactCache(requests, style, cache);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> ok(true);
+    auto work = [&]() {
+        for (size_t i = next++; i < requests.size(); i = next++) {
+            NetworkBase::ConnectionRequest& request = requests[i];
+            ContactStyle s = style;
+            if (!request.carrier.empty()) {
+                s.carrier = request.carrier;
+            }
+            request.ok = (metaConnect(request.src, request.dest, s, mode, &cache) == 0);
+            if (!request.ok) {
+                ok = false;
+            }
+        }
+    };
+
+    if (parallelism < 1) {
+        parallelism = 1;
+    }
+    if (parallelism > requests.size()) {
+        parallelism = requests.size();
+    }
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < parallelism; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return ok;
+}
+
+bool NetworkBase::connectMany(std::vector<ConnectionRequest>& requests,
+                              const ContactStyle& style,
+                              size_t parallelism) {
+    return metaConnectMany(requests, style, parallelism, YARP_ENACT_CONNECT);
+}
+
+bool NetworkBase::disconnectMany(std::vector<ConnectionRequest>& requests,
+                                 const ContactStyle& style,
+                                 size_t parallelism) {
+    return metaConnectMany(requests, style, parallelism, YARP_ENACT_DISCONNECT);
+}
+
 bool NetworkBase::isConnected(const std::string& src,
                               const std::string& dest,
                               bool quiet) {
@@ -15,6 +15,7 @@
 #include <yarp/os/Name.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/PortInfo.h>
+#include <yarp/os/PortReaderBufferBase.h>
 #include <yarp/os/RosNameSpace.h>
 #include <yarp/os/StringOutputStream.h>
 #include <yarp/os/SystemInfo.h>
@@ -1328,12 +1329,22 @@ bool PortCore::readBlock(ConnectionReader& reader, void *id, OutputStream *os)
         // Read and ignore message, there is no where to send it.
         YARP_DEBUG(Logger::get(), "data received in PortCore, no reader for it");
         Bottle b;
-        result = b.read(reader);
+        result = readMessage(b, reader);
     }
     return result;
 }
 
 
+bool PortCore::readMessage(PortReader& target, ConnectionReader& reader)
+{
+    Portable *ref = reader.getReference();
+    if (ref==nullptr || dynamic_cast<PortReaderBufferBase*>(&target)!=nullptr) {
+        return target.read(reader);
+    }
+    return Portable::copyPortable(*ref, target);
+}
+
+
 bool PortCore::send(const PortWriter& writer,
                     PortReader *reader,
                     const PortWriter *callback)
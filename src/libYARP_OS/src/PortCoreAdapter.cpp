@@ -119,7 +119,7 @@ void yarp::os::impl::PortCoreAdapter::resumeFull()
 bool yarp::os::impl::PortCoreAdapter::read(ConnectionReader& reader)
 {
     if (permanentReadDelegate!=nullptr) {
-        bool result = permanentReadDelegate->read(reader);
+        bool result = readMessage(*permanentReadDelegate, reader);
         return result;
     }
 
@@ -130,7 +130,7 @@ bool yarp::os::impl::PortCoreAdapter::read(ConnectionReader& reader)
         // interrupt
         stateMutex.lock();
         if (readDelegate!=nullptr) {
-            readResult = readDelegate->read(reader);
+            readResult = readMessage(*readDelegate, reader);
         }
         stateMutex.unlock();
         produce.post();
@@ -152,12 +152,12 @@ bool yarp::os::impl::PortCoreAdapter::read(ConnectionReader& reader)
     stateMutex.lock();
     readResult = false;
     if (readDelegate!=nullptr) {
-        readResult = readDelegate->read(reader);
+        readResult = readMessage(*readDelegate, reader);
     } else {
         // read and ignore
         YARP_DEBUG(Logger::get(), "data received in Port, no reader for it");
         Bottle b;
-        b.read(reader);
+        readMessage(b, reader);
     }
     if (!readBackground) {
         readDelegate = nullptr;
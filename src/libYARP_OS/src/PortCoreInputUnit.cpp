@@ -199,20 +199,20 @@ void PortCoreInputUnit::run() {
 
         if (br.getReference()!=nullptr) {
             //printf("HAVE A REFERENCE\n");
+            PortManager& man = getOwner();
+            Bytes env = br.readEnvelope();
+            if (env.length()>0) {
+                man.setEnvelope(std::string(env.get(), env.length()));
+            }
             if (localReader!=nullptr) {
-                bool ok = localReader->read(br);
-                if (!br.isActive()) { break; }
-                if (!ok) continue;
+                PortCore::readMessage(*localReader, br);
             } else {
-                PortManager& man = getOwner();
-                bool ok = man.readBlock(br, id, nullptr);
-                if (!br.isActive()) { break; }
-                if (!ok) continue;
+                man.readBlock(br, id, nullptr);
             }
+            // the sender waits for this, whatever the outcome of the read
+            ip->endRead();
+            if (!br.isActive()) { break; }
             //printf("DONE WITH A REFERENCE\n");
-            if (ip!=nullptr) {
-                ip->endRead();
-            }
             continue;
         }
 
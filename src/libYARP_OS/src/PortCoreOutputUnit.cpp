@@ -17,6 +17,8 @@
 #include <yarp/os/impl/BufferedConnectionWriter.h>
 #include <yarp/os/Name.h>
 
+#include <memory>
+
 
 #define YMSG(x) printf x;
 #define YTRACE(x) YMSG(("at %s\n", x))
@@ -25,6 +27,33 @@
 using namespace yarp::os::impl;
 using namespace yarp::os;
 
+namespace {
+
+// Lets a writer that is not a Portable travel over a local connection,
+// where the receiver gets the object itself rather than its bytes.  The
+// receiver can only serialize it, since it is not the object it expects.
+class PortWriterReference : public Portable
+{
+public:
+    explicit PortWriterReference(const PortWriter& writer) : writer(writer) {}
+
+    bool write(ConnectionWriter& connection) const override
+    {
+        return writer.write(connection);
+    }
+
+    bool read(ConnectionReader& connection) override
+    {
+        YARP_UNUSED(connection);
+        return false;
+    }
+
+private:
+    const PortWriter& writer;
+};
+
+} // namespace
+
 PortCoreOutputUnit::PortCoreOutputUnit(PortCore& owner, int index, OutputProtocol *op) :
             PortCoreUnit(owner, index),
             op(op),
@@ -280,18 +309,21 @@ bool PortCoreOutputUnit::sendHelper()
                return (done = true);
         }
 
+        std::unique_ptr<PortWriterReference> wrapper;
         if (op->getConnection().isLocal()) {
             // WARNING Cast away const qualifier.
-            //         This may actually cause bugs when using the local carrier
-            //         with something that is actually const (i.e. that is using
-            //         some parts of memory that cannot be written.
+            //         The receiver only copies or serializes the object,
+            //         and the write does not return before it is done.
             yarp::os::PortWriter* pw = const_cast<yarp::os::PortWriter*>(cachedWriter);
             yarp::os::Portable* p = dynamic_cast<yarp::os::Portable*>(pw);
-            if(p == nullptr) {
-                YARP_ERROR(Logger::get(), "PortCoreOutputUnit: cast failed.");
-                return false;
+            if (p == nullptr) {
+                wrapper.reset(new PortWriterReference(*cachedWriter));
+                p = wrapper.get();
             }
             buf.setReference(p);
+            if (cachedEnvelope!="" && cachedEnvelope!="__ADMIN") {
+                op->getConnection().handleEnvelope(cachedEnvelope);
+            }
         } else {
             yAssert(cachedWriter != nullptr);
             bool ok = cachedWriter->write(buf);
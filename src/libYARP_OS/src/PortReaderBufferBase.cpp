@@ -352,6 +352,13 @@ PortReaderBufferBaseCreator::~PortReaderBufferBaseCreator()
 {
 }
 
+bool PortReaderBufferBaseCreator::copy(PortReader& dest, const Portable& src) const
+{
+    YARP_UNUSED(dest);
+    YARP_UNUSED(src);
+    return false;
+}
+
 PortReaderBufferBase::PortReaderBufferBase(unsigned int maxBuffer) :
         mPriv(new Private(*this, maxBuffer))
 {
@@ -443,13 +450,9 @@ PortReader *PortReaderBufferBase::readBase(bool& missed, bool cleanup)
 
 bool PortReaderBufferBase::read(ConnectionReader& connection)
 {
-    if (connection.getReference()!=nullptr) {
-        //printf("REF %ld %d\n", (long int)connection.getReference(),
-        //     connection.isValid());
-        return acceptObjectBase(connection.getReference(), nullptr);
-    }
+    Portable* ref = connection.getReference();
 
-    if (mPriv->replier != nullptr) {
+    if (ref == nullptr && mPriv->replier != nullptr) {
         if (connection.getWriter()) {
             return mPriv->replier->read(connection);
         }
@@ -472,7 +475,18 @@ bool PortReaderBufferBase::read(ConnectionReader& connection)
     bool ok = false;
     if (connection.isValid()) {
         yAssert(reader->getReader()!=nullptr);
-        ok = reader->getReader()->read(connection);
+        if (ref != nullptr) {
+            // An object sent by a port of the same process, that is still
+            // owned by the sender: copy it if it has the expected type,
+            // otherwise convert it through its serialization.
+            PortReader& target = *reader->getReader();
+            ok = (mPriv->creator != nullptr && mPriv->creator->copy(target, *ref));
+            if (!ok) {
+                ok = Portable::copyPortable(*ref, target);
+            }
+        } else {
+            ok = reader->getReader()->read(connection);
+        }
         reader->setEnvelope(connection.readEnvelope());
     } else {
         // this is a disconnection
@@ -19,10 +19,12 @@
 #include <yarp/os/impl/PlatformDirent.h>
 
 #include <algorithm>
-#include <map>
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
 
 using namespace yarp::os::impl;
 using namespace yarp::os;
@@ -73,33 +75,222 @@ public:
     }
 };
 
+/*
+ * The items of a Property, indexed by key.
+ *
+ * The items are allocated in blocks that are never moved, so that the
+ * references returned by find() and findGroup() stay valid when other keys
+ * are added; the items removed are reused.
+ * The items are indexed by an open addressing hash table (with linear
+ * probing) that stores the hash of each key, so that a lookup compares
+ * strings only when the hashes match, and never allocates.
+ */
+class PropertyTable {
+public:
+    struct Entry {
+        std::string key;
+        size_t hash;
+        PropertyItem item;
+
+        Entry() : hash(0) {}
+    };
+
+    explicit PropertyTable(size_t expected = 0) :
+        used(0),
+        tombstones(0) {
+        if (expected > 0) {
+            rehash(expected);
+        }
+    }
+
+    PropertyTable(const PropertyTable&) = delete;
+    PropertyTable& operator=(const PropertyTable&) = delete;
+
+    static size_t hashOf(const std::string& key) {
+        return std::hash<std::string>()(key);
+    }
+
+    Entry *find(const std::string& key) const {
+        return find(key, hashOf(key));
+    }
+
+    Entry *find(const std::string& key, size_t hash) const {
+        if (slots.empty()) {
+            return nullptr;
+        }
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.index == EMPTY) {
+                return nullptr;
+            }
+            if (slot.index >= 0 && slot.hash == hash) {
+                Entry& entry = at(slot.index);
+                if (entry.key == key) {
+                    return &entry;
+                }
+            }
+        }
+    }
+
+    Entry *insert(const std::string& key) {
+        size_t hash = hashOf(key);
+        Entry *entry = find(key, hash);
+        if (entry != nullptr) {
+            return entry;
+        }
+        if ((used + tombstones + 1) * 4 > slots.size() * 3) {
+            rehash(used + 1);
+        }
+        int index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<int>(blocks.size() * BLOCK_SIZE);
+            blocks.emplace_back(new Entry[BLOCK_SIZE]);
+            for (int i = BLOCK_SIZE - 1; i > 0; i--) {
+                freeList.push_back(index + i);
+            }
+        }
+        entry = &at(index);
+        entry->key = key;
+        entry->hash = hash;
+        place(hash, index);
+        used++;
+        return entry;
+    }
+
+    void erase(const std::string& key) {
+        if (slots.empty()) {
+            return;
+        }
+        size_t hash = hashOf(key);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; slots[i].index != EMPTY; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.index >= 0 && slot.hash == hash && at(slot.index).key == key) {
+                release(slot.index);
+                slot.index = DELETED;
+                used--;
+                tombstones++;
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        for (auto& slot : slots) {
+            if (slot.index >= 0) {
+                release(slot.index);
+            }
+            slot.index = EMPTY;
+        }
+        used = 0;
+        tombstones = 0;
+    }
+
+    size_t size() const {
+        return used;
+    }
+
+    // the entries, sorted by key
+    void sorted(std::vector<const Entry*>& entries) const {
+        entries.clear();
+        entries.reserve(used);
+        for (const auto& slot : slots) {
+            if (slot.index >= 0) {
+                entries.push_back(&at(slot.index));
+            }
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry* a, const Entry* b) { return a->key < b->key; });
+    }
+
+private:
+    static constexpr int BLOCK_SIZE = 16;
+    static constexpr int EMPTY = -1;
+    static constexpr int DELETED = -2;
+
+    struct Slot {
+        size_t hash;
+        int index;
+    };
+
+    Entry& at(int index) const {
+        return blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+    }
+
+    void release(int index) {
+        Entry& entry = at(index);
+        entry.key.clear();
+        entry.item.clear();
+        entry.item.bot.clear();
+        entry.item.singleton = false;
+        freeList.push_back(index);
+    }
+
+    void place(size_t hash, int index) {
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while (slots[i].index >= 0) {
+            i = (i + 1) & mask;
+        }
+        if (slots[i].index == DELETED) {
+            tombstones--;
+        }
+        slots[i].hash = hash;
+        slots[i].index = index;
+    }
+
+    // resize the table for the given number of keys, dropping the tombstones
+    void rehash(size_t keys) {
+        size_t capacity = 8;
+        while (capacity * 3 < keys * 4 + 4) {
+            capacity <<= 1;
+        }
+        if (capacity < slots.size()) {
+            capacity = slots.size();
+        }
+        std::vector<Slot> old(capacity, Slot{0, EMPTY});
+        old.swap(slots);
+        tombstones = 0;
+        for (const auto& slot : old) {
+            if (slot.index >= 0) {
+                place(slot.hash, slot.index);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Entry[]>> blocks;
+    std::vector<int> freeList;
+    std::vector<Slot> slots;
+    size_t used;
+    size_t tombstones;
+};
+
 class PropertyHelper {
 public:
-    std::map<std::string, PropertyItem> data;
+    PropertyTable data;
     Property& owner;
 
     PropertyHelper(Property& owner, int hash_size) :
+        data(hash_size > 0 ? hash_size : 0),
         owner(owner) {}
 
     PropertyItem *getPropNoCreate(const std::string& key) const {
-        auto it = data.find(key);
-        if (it==data.end()) {
+        PropertyTable::Entry *entry = data.find(key);
+        if (entry == nullptr) {
             return nullptr;
         }
-        return const_cast<PropertyItem*>(&(it->second));
+        return &(entry->item);
     }
 
     PropertyItem *getProp(const std::string& key, bool create = true) {
-        std::map<std::string, PropertyItem>::iterator entry = data.find(key);
-        if (entry == data.end()) {
-            if (!create) {
-                return nullptr;
-            }
-            data[key] = PropertyItem();
-            entry = data.find(key);
+        if (!create) {
+            return getPropNoCreate(key);
         }
-        yAssert(entry != data.end());
-        return &(entry->second);
+        return &(data.insert(key)->item);
     }
 
     void put(const std::string& key, const std::string& val) {
@@ -684,17 +875,40 @@ public:
         }
     }
 
-    std::string toString() const {
-        Bottle bot;
-        for (std::map<std::string, PropertyItem>::const_iterator it = data.begin(); it != data.end(); ++it) {
-            const PropertyItem& rec = it->second;
+    // the same order of the std::map used before, so that the output
+    // does not change
+    void toBottle(Bottle& bot) const {
+        std::vector<const PropertyTable::Entry*> entries;
+        data.sorted(entries);
+        for (const auto* entry : entries) {
+            const PropertyItem& rec = entry->item;
             Bottle& sub = bot.addList();
             rec.flush();
             sub.copy(rec.bot);
         }
+    }
+
+    std::string toString() const {
+        Bottle bot;
+        toBottle(bot);
         return bot.toString();
     }
 
+    // equivalent to fromString(alt.toString()), without the conversion to text
+    void copyFrom(const PropertyHelper& alt) {
+        if (&alt == this) {
+            return;
+        }
+        clear();
+        std::vector<const PropertyTable::Entry*> entries;
+        alt.data.sorted(entries);
+        for (const auto* entry : entries) {
+            const PropertyItem& rec = entry->item;
+            rec.flush();
+            putBottle(rec.bot.get(0).toString().c_str(), rec.bot);
+        }
+    }
+
     // expand any environment variables found
     std::string expand(const char *txt, Searchable& env, Searchable& env2) {
         //printf("expanding %s\n", txt);
@@ -897,7 +1111,9 @@ Property::Property(const Property& prop) : Searchable(), Portable() {
     hash_size = 0;
     implementation = new PropertyHelper(*this, 0);
     yAssert(implementation!=nullptr);
-    fromString(prop.toString());
+    if (prop.check()) {
+        HELPER(implementation).copyFrom(HELPER(prop.implementation));
+    }
 }
 
 
@@ -923,7 +1139,11 @@ Property::~Property() {
 
 const Property& Property::operator = (const Property& prop) {
     summon();
-    fromString(prop.toString());
+    if (prop.check()) {
+        HELPER(implementation).copyFrom(HELPER(prop.implementation));
+    } else {
+        clear();
+    }
     return *this;
 }
 
@@ -1043,7 +1263,8 @@ bool Property::read(ConnectionReader& reader) {
     Bottle b;
     bool ok = b.read(reader);
     if (ok) {
-        fromString(b.toString());
+        summon();
+        HELPER(implementation).fromBottle(b);
     }
     return ok;
 }
@@ -1051,7 +1272,10 @@ bool Property::read(ConnectionReader& reader) {
 
 bool Property::write(ConnectionWriter& writer) const {
     // for now just delegate to Bottle
-    Bottle b(toString());
+    Bottle b;
+    if (check()) {
+        HELPER(implementation).toBottle(b);
+    }
     return b.write(writer);
 }
 
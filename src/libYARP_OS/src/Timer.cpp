@@ -7,11 +7,22 @@
  */
 
 #include <yarp/os/Timer.h>
+#include <yarp/os/Network.h>
 #include <yarp/os/PeriodicThread.h>
+#include <yarp/os/Thread.h>
 #include <yarp/os/Time.h>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
 
 using namespace yarp::os;
 
@@ -47,6 +58,17 @@ public:
 
     virtual bool timerIsRunning() = 0;
 
+    virtual void setSettings(const TimerSettings& settings)
+    {
+        m_settings = settings;
+    }
+
+    // called by the destructor of the Timer
+    virtual void destroy()
+    {
+        delete this;
+    }
+
 
     TimerSettings    m_settings;
     TimerCallback    m_callback{nullptr};
@@ -60,26 +82,32 @@ class MonoThreadTimer : public yarp::os::Timer::PrivateImpl
 public:
     MonoThreadTimer(TimerSettings sett, TimerCallback call, yarp::os::Mutex* mutex = nullptr);
     ~MonoThreadTimer();
-    bool         m_active{ false };
-    unsigned int m_runTimes{1};
-    size_t       m_id{(size_t)-1};
+    bool          m_active{ false };
+    unsigned int  m_runTimes{1};
+    size_t        m_id{(size_t)-1};
+    // changed each time the timer is started or stopped, to discard the
+    // deadlines scheduled before
+    unsigned long m_generation{0};
+    // true while the callback is being executed
+    bool          m_dispatched{ false };
+    // the thread executing the callback
+    std::thread::id m_callbackThread;
+    // set when the timer is destroyed by its own callback
+    bool          m_destroyed{ false };
 
     virtual yarp::os::YarpTimerEvent getEventNow()
     {
         return PrivateImpl::getEventNow(m_runTimes);
     }
 
-    virtual bool startTimer() override
+    double nextDeadline() const
     {
-        m_startStamp = yarp::os::Time::now();
-        m_active     = true;
-        return true;
+        return m_startStamp + m_runTimes * m_settings.period;
     }
 
-    virtual void stopTimer() override
-    {
-        m_active = false;
-    }
+    virtual bool startTimer() override;
+
+    virtual void stopTimer() override;
 
     virtual bool stepTimer() override
     {
@@ -99,18 +127,60 @@ public:
     {
         return m_active;
     }
+
+    virtual void setSettings(const TimerSettings& settings) override;
+
+    virtual void destroy() override;
 };
 
-class TimerSingleton : public yarp::os::PeriodicThread
+/*
+ * Runs all the timers created with newThread == false.
+ *
+ * The active timers are kept in a min-heap ordered by deadline, and the
+ * thread sleeps until the earliest one, or until a timer is started or
+ * stopped. The callbacks are executed by the timer thread itself, or by a
+ * pool of worker threads (see Timer::setWorkerCount()). The lock is
+ * released while a callback runs, so that it can start, stop or destroy
+ * its own timer.
+ */
+class TimerSingleton : public yarp::os::Thread
 {
+    struct Deadline
+    {
+        double        time;
+        size_t        id;
+        unsigned long generation;
+
+        bool operator>(const Deadline& other) const
+        {
+            return time > other.time;
+        }
+    };
+
     std::mutex mu;
+    std::condition_variable wakeUp;
+    std::condition_variable callbackDone;
     std::map<size_t, MonoThreadTimer*> timers;
-    TimerSingleton() :
-            PeriodicThread(0.0)
-    {
-    }
+    size_t nextId{0};
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines;
+
+    std::thread::id timerThread;
+    std::vector<std::thread> workers;
+    std::deque<MonoThreadTimer*> ready;
+    std::condition_variable readyToRun;
+    bool workersStopping{false};
+    int workerCount{-1};
+
+    TimerSingleton() = default;
 
+    virtual bool threadInit() override;
     virtual void run() override;
+    virtual void onStop() override;
+    virtual void threadRelease() override;
+
+    void work();
+    void fire(MonoThreadTimer& timer, std::unique_lock<std::mutex>& lock);
+    void schedule(MonoThreadTimer& timer);
 
     virtual ~TimerSingleton()
     {
@@ -127,21 +197,101 @@ public:
 
     size_t addTimer(MonoThreadTimer* t)
     {
-        mu.lock();
-        timers[timers.size()] = t;
-        mu.unlock();
-        return timers.size() - 1;
+        std::lock_guard<std::mutex> lock(mu);
+        // ids are never reused, unlike the size of the map
+        size_t id = nextId++;
+        timers[id] = t;
+        return id;
     }
 
     void removeTimer(size_t id)
     {
-        mu.lock();
+        std::unique_lock<std::mutex> lock(mu);
+        auto it = timers.find(id);
+        if (it == timers.end()) {
+            return;
+        }
+        MonoThreadTimer* t = it->second;
+        t->m_active = false;
+        t->m_generation++;
+        auto pending = std::find(ready.begin(), ready.end(), t);
+        if (pending != ready.end()) {
+            ready.erase(pending);
+            t->m_dispatched = false;
+        }
+        // wait for a callback being executed by another thread
+        callbackDone.wait(lock, [t] { return !t->m_dispatched; });
         timers.erase(id);
-        mu.unlock();
+    }
+
+    // true if the timer must be destroyed by fire(), since it is executing
+    // the callback that destroys it
+    bool destroyedByCallback(MonoThreadTimer& t)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!t.m_dispatched || t.m_callbackThread != std::this_thread::get_id()) {
+            return false;
+        }
+        t.m_active = false;
+        t.m_generation++;
+        t.m_destroyed = true;
+        return true;
+    }
+
+    // true if called by the timer thread or by a worker
+    bool isTimerThread()
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        std::thread::id id = std::this_thread::get_id();
+        if (id == timerThread) {
+            return true;
+        }
+        for (auto& worker : workers) {
+            if (worker.get_id() == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void setWorkerCount(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        workerCount = (int)count;
+    }
+
+    void startTimer(MonoThreadTimer& t)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        t.m_startStamp = yarp::os::Time::now();
+        t.m_active = true;
+        t.m_generation++;
+        schedule(t);
+    }
+
+    void setSettings(MonoThreadTimer& t, const TimerSettings& settings)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        t.m_settings = settings;
+        // the deadline queued before is discarded, since it was computed
+        // with the old period; a timer executing its callback is scheduled
+        // again by fire() when it is done
+        if (t.m_active && !t.m_dispatched) {
+            t.m_generation++;
+            schedule(t);
+        }
+    }
+
+    void stopTimer(MonoThreadTimer& t)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        t.m_active = false;
+        t.m_generation++;
     }
 
     size_t getTimerCount()
     {
+        std::lock_guard<std::mutex> lock(mu);
         return timers.size();
     }
 };
@@ -160,23 +310,183 @@ MonoThreadTimer::~MonoThreadTimer()
 {
     TimerSingleton& singlInstance = TimerSingleton::self();
     singlInstance.removeTimer(m_id);
-    if (!singlInstance.getTimerCount()) {
+    // the timer thread cannot stop itself, it waits for the next timer
+    if (!singlInstance.getTimerCount() && !singlInstance.isTimerThread()) {
         singlInstance.stop();
     }
 }
 
+void MonoThreadTimer::destroy()
+{
+    if (!TimerSingleton::self().destroyedByCallback(*this)) {
+        delete this;
+    }
+}
+
+bool MonoThreadTimer::startTimer()
+{
+    TimerSingleton::self().startTimer(*this);
+    return true;
+}
+
+void MonoThreadTimer::stopTimer()
+{
+    TimerSingleton::self().stopTimer(*this);
+}
+
+void MonoThreadTimer::setSettings(const TimerSettings& settings)
+{
+    TimerSingleton::self().setSettings(*this, settings);
+}
+
+// must be called with mu locked
+void TimerSingleton::schedule(MonoThreadTimer& timer)
+{
+    bool earliest = deadlines.empty() || timer.nextDeadline() < deadlines.top().time;
+    deadlines.push({timer.nextDeadline(), timer.m_id, timer.m_generation});
+    if (earliest) {
+        wakeUp.notify_one();
+    }
+}
+
+// must be called with mu locked, the callback is executed with mu unlocked
+void TimerSingleton::fire(MonoThreadTimer& timer, std::unique_lock<std::mutex>& lock)
+{
+    unsigned long generation = timer.m_generation;
+    timer.m_dispatched = true;
+    timer.m_callbackThread = std::this_thread::get_id();
+
+    lock.unlock();
+    YarpTimerEvent tEvent = timer.getEventNow();
+    bool active = timer.step(tEvent, false);
+    timer.m_lastReal = tEvent.currentReal;
+    lock.lock();
+
+    timer.m_dispatched = false;
+    timer.m_callbackThread = std::thread::id();
+    if (timer.m_destroyed) {
+        lock.unlock();
+        delete &timer;
+        lock.lock();
+        callbackDone.notify_all();
+        return;
+    }
+
+    // unless it was stopped or restarted by the callback or by another
+    // thread in the meantime
+    if (timer.m_generation == generation) {
+        timer.m_active = active;
+    }
+    if (timer.m_active) {
+        schedule(timer);
+    }
+    callbackDone.notify_all();
+}
+
+bool TimerSingleton::threadInit()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    int count = workerCount;
+    if (count < 0) {
+        bool found = false;
+        std::string value = yarp::os::NetworkBase::getEnvironment("YARP_TIMER_WORKERS", &found);
+        count = found ? std::atoi(value.c_str()) : 0;
+    }
+    timerThread = std::this_thread::get_id();
+    workersStopping = false;
+    for (int i = 0; i < count; i++) {
+        workers.emplace_back(&TimerSingleton::work, this);
+    }
+    return true;
+}
+
 void TimerSingleton::run()
 {
-    mu.lock();
-    for (auto t : timers) {
-        MonoThreadTimer& timer = *t.second;
-        YarpTimerEvent tEvent = timer.getEventNow();
-        if (timer.m_active && tEvent.currentReal > tEvent.currentExpected) {
-            timer.m_active = timer.step(tEvent, false);
-            timer.m_lastReal = tEvent.currentReal;
+    std::unique_lock<std::mutex> lock(mu);
+    while (!isStopping()) {
+        if (deadlines.empty()) {
+            wakeUp.wait(lock);
+            continue;
         }
+
+        const Deadline next = deadlines.top();
+        auto it = timers.find(next.id);
+        if (it == timers.end() ||
+            it->second->m_generation != next.generation ||
+            !it->second->m_active ||
+            it->second->m_dispatched ||
+            it->second->nextDeadline() != next.time) {
+            // the timer was stopped, restarted or destroyed after scheduling,
+            // or it is running and will be scheduled again when it is done
+            deadlines.pop();
+            continue;
+        }
+
+        double wait = next.time - yarp::os::Time::now();
+        if (wait >= 0) {
+            // With a network clock the time may run at a different rate:
+            // check it again often, without spinning.
+            if (!yarp::os::Time::isSystemClock()) {
+                wait = std::min(wait, 0.001);
+            }
+            wakeUp.wait_for(lock, std::chrono::duration<double>(wait));
+            continue;
+        }
+
+        deadlines.pop();
+        MonoThreadTimer& timer = *it->second;
+        if (workers.empty()) {
+            fire(timer, lock);
+        } else {
+            timer.m_dispatched = true;
+            ready.push_back(&timer);
+            readyToRun.notify_one();
+        }
+    }
+}
+
+void TimerSingleton::work()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while (true) {
+        readyToRun.wait(lock, [this] { return workersStopping || !ready.empty(); });
+        if (workersStopping) {
+            return;
+        }
+        MonoThreadTimer& timer = *ready.front();
+        ready.pop_front();
+
+        if (timer.m_active) {
+            fire(timer, lock);
+        } else {
+            timer.m_dispatched = false;
+            callbackDone.notify_all();
+        }
+    }
+}
+
+void TimerSingleton::onStop()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    wakeUp.notify_all();
+}
+
+void TimerSingleton::threadRelease()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        workersStopping = true;
+        for (MonoThreadTimer* timer : ready) {
+            timer->m_dispatched = false;
+        }
+        ready.clear();
     }
-    mu.unlock();
+    readyToRun.notify_all();
+    callbackDone.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
 }
 
 class ThreadedTimer : public yarp::os::Timer::PrivateImpl,
@@ -220,6 +530,12 @@ public:
     {
         return isRunning();
     }
+
+    virtual void setSettings(const TimerSettings& settings) override
+    {
+        PrivateImpl::setSettings(settings);
+        setPeriod(settings.period);
+    }
 };
 
 bool ThreadedTimer::threadInit()
@@ -312,7 +628,7 @@ void ThreadedTimer::run()
 
 void Timer::setSettings(const TimerSettings& settings)
 {
-    impl->m_settings = settings;
+    impl->setSettings(settings);
 }
 
 const TimerSettings Timer::getSettings()
@@ -327,5 +643,10 @@ bool Timer::isRunning()
 
 Timer::~Timer()
 {
-    delete impl;
+    impl->destroy();
+}
+
+void Timer::setWorkerCount(size_t count)
+{
+    TimerSingleton::self().setWorkerCount(count);
 }
@@ -586,6 +586,41 @@ void WireReader::readListBegin(WireState& nstate, std::uint32_t& len)
     len = (std::uint32_t)state->len;
 }
 
+bool WireReader::readListBlock(std::int32_t tag, void* data, std::uint32_t len)
+{
+    if (state->code != tag) {
+        return false;
+    }
+    size_t size;
+    switch (tag) {
+    case BOTTLE_TAG_INT8:
+        size = sizeof(std::int8_t);
+        break;
+    case BOTTLE_TAG_INT16:
+        size = sizeof(std::int16_t);
+        break;
+    case BOTTLE_TAG_INT32:
+        size = sizeof(std::int32_t);
+        break;
+    case BOTTLE_TAG_INT64:
+        size = sizeof(std::int64_t);
+        break;
+    case BOTTLE_TAG_FLOAT32:
+        size = sizeof(yarp::conf::float32_t);
+        break;
+    case BOTTLE_TAG_FLOAT64:
+        size = sizeof(yarp::conf::float64_t);
+        break;
+    default:
+        return false;
+    }
+    if (len > 0 && !reader.expectBlock(static_cast<char*>(data), len * size)) {
+        return false;
+    }
+    state->len -= len;
+    return !reader.isError();
+}
+
 void WireReader::readSetBegin(WireState& nstate, std::uint32_t& len)
 {
     readListBegin(nstate, len);
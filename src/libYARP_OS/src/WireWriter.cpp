@@ -179,6 +179,38 @@ bool WireWriter::writeListBegin(int tag, std::uint32_t len) const {
     return !writer.isError();
 }
 
+bool WireWriter::writeListBlock(std::int32_t tag, const void* data, std::uint32_t len) const {
+    size_t size;
+    switch (tag) {
+    case BOTTLE_TAG_INT8:
+        size = sizeof(std::int8_t);
+        break;
+    case BOTTLE_TAG_INT16:
+        size = sizeof(std::int16_t);
+        break;
+    case BOTTLE_TAG_INT32:
+        size = sizeof(std::int32_t);
+        break;
+    case BOTTLE_TAG_INT64:
+        size = sizeof(std::int64_t);
+        break;
+    case BOTTLE_TAG_FLOAT32:
+        size = sizeof(yarp::conf::float32_t);
+        break;
+    case BOTTLE_TAG_FLOAT64:
+        size = sizeof(yarp::conf::float64_t);
+        break;
+    default:
+        return false;
+    }
+    writer.appendInt32(BOTTLE_TAG_LIST | tag);
+    writer.appendInt32((int)len);
+    if (len > 0) {
+        writer.appendBlock(static_cast<const char*>(data), len * size);
+    }
+    return !writer.isError();
+}
+
 bool WireWriter::writeSetBegin(int tag, std::uint32_t len) const {
     return writeListBegin(tag, len);
 }
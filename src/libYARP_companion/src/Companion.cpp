@@ -47,7 +47,9 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
 #include <string>
+#include <vector>
 
 
 using namespace yarp::companion::impl;
@@ -237,7 +239,9 @@ Companion::Companion() :
     adminMode(false),
     waitConnect(false)
 {
-   add("check",      &Companion::cmdCheck,
+    add("bench",      &Companion::cmdBench,
+        "measure latency and throughput of the carriers between local ports");
+    add("check",      &Companion::cmdCheck,
         "run a simple sanity check to see if yarp is working");
     add("clean",  &Companion::cmdClean,
         "try to remove inactive entries from the name server");
@@ -2467,6 +2471,348 @@ int Companion::cmdSample(int argc, char *argv[]) {
 }
 
 
+namespace {
+
+// A message of the benchmark, in the same format of a Bottle containing
+// a sequence number, the time it was sent, and a blob.
+class BenchMessage : public Portable {
+public:
+    std::int32_t seq;
+    double time;
+    std::vector<char> payload;
+
+    BenchMessage() : seq(0), time(0.0) {}
+
+    virtual bool read(ConnectionReader& connection) override {
+        connection.convertTextMode();
+        if (connection.expectInt32() != BOTTLE_TAG_LIST || connection.expectInt32() != 3) {
+            return false;
+        }
+        if (connection.expectInt32() != BOTTLE_TAG_INT32) {
+            return false;
+        }
+        seq = connection.expectInt32();
+        if (connection.expectInt32() != BOTTLE_TAG_FLOAT64) {
+            return false;
+        }
+        time = connection.expectFloat64();
+        if (connection.expectInt32() != BOTTLE_TAG_BLOB) {
+            return false;
+        }
+        std::int32_t len = connection.expectInt32();
+        if (connection.isError() || len < 0) {
+            return false;
+        }
+        payload.resize(len);
+        return len == 0 || connection.expectBlock(payload.data(), len);
+    }
+
+    virtual bool write(ConnectionWriter& connection) const override {
+        connection.appendInt32(BOTTLE_TAG_LIST);
+        connection.appendInt32(3);
+        connection.appendInt32(BOTTLE_TAG_INT32);
+        connection.appendInt32(seq);
+        connection.appendInt32(BOTTLE_TAG_FLOAT64);
+        connection.appendFloat64(time);
+        connection.appendInt32(BOTTLE_TAG_BLOB);
+        connection.appendInt32(static_cast<std::int32_t>(payload.size()));
+        if (!payload.empty()) {
+            connection.appendExternalBlock(payload.data(), payload.size());
+        }
+        connection.convertTextMode();
+        return !connection.isError();
+    }
+};
+
+// Records the latency of the messages received by a subscriber.
+class BenchReceiver : public PortReader {
+public:
+    Mutex mutex;
+    std::vector<double> latencies;
+    size_t bytes;
+    std::int32_t lastSeq;
+    BenchMessage msg;
+
+    BenchReceiver() : bytes(0), lastSeq(-1) {}
+
+    void reset(size_t expected) {
+        mutex.lock();
+        latencies.clear();
+        latencies.reserve(expected);
+        bytes = 0;
+        lastSeq = -1;
+        mutex.unlock();
+    }
+
+    size_t received() {
+        mutex.lock();
+        size_t n = latencies.size();
+        mutex.unlock();
+        return n;
+    }
+
+    virtual bool read(ConnectionReader& connection) override {
+        // the local carrier passes the object sent
+        const BenchMessage* m = dynamic_cast<BenchMessage*>(connection.getReference());
+        if (m == nullptr) {
+            if (!msg.read(connection)) {
+                return false;
+            }
+            m = &msg;
+        }
+        double now = SystemClock::nowSystem();
+        mutex.lock();
+        if (m->seq > lastSeq) {
+            latencies.push_back(now - m->time);
+            bytes += m->payload.size();
+            lastSeq = m->seq;
+        }
+        mutex.unlock();
+        return true;
+    }
+};
+
+struct BenchResult {
+    std::string carrier;
+    size_t size;
+    double rate;
+    int fanout;
+    int sent;
+    size_t received;
+    double elapsed;
+    double throughput;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    double cpu;
+};
+
+double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// Values of an option given as --key v1 v2 ..., or the default.
+std::vector<std::string> benchList(Property& options, const char* key, const char* def) {
+    std::vector<std::string> values;
+    Bottle& group = options.findGroup(key);
+    for (size_t i = 1; i < group.size(); i++) {
+        values.push_back(group.get(i).toString());
+    }
+    if (values.empty()) {
+        Bottle b(def);
+        for (size_t i = 0; i < b.size(); i++) {
+            values.push_back(b.get(i).toString());
+        }
+    }
+    return values;
+}
+
+// Converts the values of an option to numbers not less than min, and
+// integers if asked. On error a message is printed and false returned.
+bool benchNumbers(const std::vector<std::string>& values, const char* key, double min,
+                  bool integer, std::vector<double>& numbers) {
+    numbers.clear();
+    for (const auto& value : values) {
+        char* end = nullptr;
+        double x = strtod(value.c_str(), &end);
+        if (value.empty() || *end != '\0' || !std::isfinite(x) || x < min ||
+            (integer && (x != std::floor(x) || x > 2147483647.0))) {
+            fprintf(stderr, "Invalid value '%s' for --%s, see \"yarp bench --help\"\n",
+                    value.c_str(), key);
+            return false;
+        }
+        numbers.push_back(x);
+    }
+    return true;
+}
+
+bool benchRun(const std::string& prefix, const std::string& carrier, size_t size, double rate,
+              int fanout, double duration, BenchResult& result) {
+    Port pub;
+    std::vector<Port> subs(fanout);
+    std::vector<BenchReceiver> receivers(fanout);
+    bool ok = pub.open(prefix + "/pub");
+    for (int i = 0; ok && i < fanout; i++) {
+        subs[i].setReader(receivers[i]);
+        ok = subs[i].open(prefix + "/sub" + std::to_string(i));
+    }
+    for (int i = 0; ok && i < fanout; i++) {
+        ok = NetworkBase::connect(pub.getName(), subs[i].getName(), carrier, true);
+        if (!ok) {
+            fprintf(stderr, "Cannot connect with carrier %s\n", carrier.c_str());
+        }
+    }
+
+    if (ok) {
+        BenchMessage msg;
+        msg.payload.assign(size, 'x');
+        size_t expected = (rate > 0) ? static_cast<size_t>(rate * duration) + 1 : 0;
+        for (auto& receiver : receivers) {
+            receiver.reset(expected);
+        }
+
+        std::clock_t cpu0 = std::clock();
+        double start = SystemClock::nowSystem();
+        double end = start + duration;
+        double next = start;
+        int sent = 0;
+        while (SystemClock::nowSystem() < end) {
+            if (rate > 0) {
+                double wait = next - SystemClock::nowSystem();
+                if (wait > 0) {
+                    SystemClock::delaySystem(wait);
+                }
+                next += 1.0 / rate;
+            }
+            msg.seq = sent;
+            msg.time = SystemClock::nowSystem();
+            pub.write(msg);
+            sent++;
+        }
+
+        // give the last messages some time to arrive
+        double deadline = SystemClock::nowSystem() + 1.0;
+        while (SystemClock::nowSystem() < deadline) {
+            size_t received = 0;
+            for (auto& receiver : receivers) {
+                received += receiver.received();
+            }
+            if (received >= static_cast<size_t>(sent) * fanout) {
+                break;
+            }
+            SystemClock::delaySystem(0.01);
+        }
+        double elapsed = SystemClock::nowSystem() - start;
+        std::clock_t cpu1 = std::clock();
+
+        std::vector<double> latencies;
+        size_t bytes = 0;
+        for (auto& receiver : receivers) {
+            receiver.mutex.lock();
+            latencies.insert(latencies.end(), receiver.latencies.begin(), receiver.latencies.end());
+            bytes += receiver.bytes;
+            receiver.mutex.unlock();
+        }
+
+        result.carrier = carrier;
+        result.size = size;
+        result.rate = rate;
+        result.fanout = fanout;
+        result.sent = sent;
+        result.received = latencies.size();
+        result.elapsed = elapsed;
+        result.throughput = bytes / elapsed;
+        result.p50 = percentile(latencies, 0.5);
+        result.p90 = percentile(latencies, 0.9);
+        result.p99 = percentile(latencies, 0.99);
+        result.max = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+        result.cpu = static_cast<double>(cpu1 - cpu0) / CLOCKS_PER_SEC / elapsed;
+    }
+
+    pub.close();
+    for (auto& sub : subs) {
+        sub.close();
+    }
+    return ok;
+}
+
+} // namespace
+
+
+int Companion::cmdBench(int argc, char *argv[]) {
+    Property options;
+    options.fromCommand(argc, argv, false);
+    if (options.check("help")) {
+        printf("This is yarp bench. Syntax:\n");
+        printf("  yarp bench [--carrier tcp udp ...] [--size 100 10000 ...] [--rate 0 100 ...]\n");
+        printf("             [--fanout 1 4 ...] [--duration 2] [--output results.csv] [--verbose]\n");
+        printf("A publisher and 'fanout' subscribers are opened in this process, and\n");
+        printf("connected with each carrier.  Messages of each size are sent for\n");
+        printf("'duration' seconds, at the given rate (0 is as fast as possible).\n");
+        printf("Throughput, latency percentiles and the CPU used by the process\n");
+        printf("(1.0 is one core) are reported for each combination, and written as\n");
+        printf("CSV to the 'output' file, if given.\n");
+        printf("Carriers can include port monitors, e.g. \"tcp+send.portmonitor+...\".\n");
+        printf("The name server is used if available, otherwise the ports are local.\n");
+        return 0;
+    }
+
+    std::vector<std::string> carriers = benchList(options, "carrier", "tcp fast_tcp udp");
+    std::vector<double> sizes;
+    std::vector<double> rates;
+    std::vector<double> fanouts;
+    std::vector<double> durations;
+    if (!benchNumbers(benchList(options, "size", "100 10000 1000000"), "size", 1, true, sizes) ||
+        !benchNumbers(benchList(options, "rate", "0"), "rate", 0, false, rates) ||
+        !benchNumbers(benchList(options, "fanout", "1"), "fanout", 1, true, fanouts) ||
+        !benchNumbers(benchList(options, "duration", "2"), "duration", 0, false, durations)) {
+        return 1;
+    }
+    double duration = durations[0];
+    std::string prefix = options.check("name", Value("/yarp/bench")).asString();
+
+    if (!NetworkBase::checkNetwork(1.0)) {
+        NetworkBase::setLocalMode(true);
+    }
+    if (!options.check("verbose")) {
+        NetworkBase::setVerbosity(-1);
+    }
+
+    FILE* out = nullptr;
+    if (options.check("output")) {
+        std::string fname = options.find("output").asString();
+        out = fopen(fname.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot open %s\n", fname.c_str());
+            return 1;
+        }
+        fprintf(out, "carrier,size,rate,fanout,sent,received,throughput_MBps,"
+                     "latency_p50_us,latency_p90_us,latency_p99_us,latency_max_us,cpu\n");
+    }
+
+    printf("%-24s %9s %7s %6s %8s %8s %9s %9s %9s %9s %9s %5s\n",
+           "carrier", "size", "rate", "fanout", "sent", "recv", "MB/s",
+           "p50 us", "p90 us", "p99 us", "max us", "cpu");
+    int failures = 0;
+    for (const auto& carrier : carriers) {
+        for (const auto& size : sizes) {
+            for (const auto& rate : rates) {
+                for (const auto& fanout : fanouts) {
+                    BenchResult r;
+                    if (!benchRun(prefix, carrier, (size_t)size, rate, (int)fanout, duration, r)) {
+                        failures++;
+                        continue;
+                    }
+                    printf("%-24s %9zu %7g %6d %8d %8zu %9.2f %9.1f %9.1f %9.1f %9.1f %5.2f\n",
+                           r.carrier.c_str(), r.size, r.rate, r.fanout, r.sent, r.received,
+                           r.throughput / 1e6, r.p50 * 1e6, r.p90 * 1e6, r.p99 * 1e6,
+                           r.max * 1e6, r.cpu);
+                    fflush(stdout);
+                    if (out != nullptr) {
+                        fprintf(out, "%s,%zu,%g,%d,%d,%zu,%f,%f,%f,%f,%f,%f\n",
+                                r.carrier.c_str(), r.size, r.rate, r.fanout, r.sent, r.received,
+                                r.throughput / 1e6, r.p50 * 1e6, r.p90 * 1e6, r.p99 * 1e6,
+                                r.max * 1e6, r.cpu);
+                        fflush(out);
+                    }
+                }
+            }
+        }
+    }
+
+    if (out != nullptr) {
+        fclose(out);
+    }
+    return (failures == 0) ? 0 : 1;
+}
+
+
 void Companion::applyArgs(yarp::os::Contactable& port) {
     if (argType!="") {
         port.promiseType(Type::byNameOnWire(argType.c_str()));
@@ -39,6 +39,14 @@ public:
     */
     virtual bool   getCurrentPosition(yarp::dev::Map2DLocation& loc) = 0;
 
+    /**
+    * Gets the position of the robot w.r.t world reference frame at a given time, interpolated between recent estimates.
+    * @param timestamp the time of the requested position, in the same clock as yarp::os::Time::now()
+    * @param loc the location of the robot
+    * @return true/false (false if the position at that time is not known, or if it is not supported by the device)
+    */
+    virtual bool   getPositionAt(double timestamp, yarp::dev::Map2DLocation& loc) { return false; }
+
     /**
     * Sets the initial pose for the localization algorithm which estimates the current position of the robot w.r.t world reference frame.
     * @param loc the location of the robot
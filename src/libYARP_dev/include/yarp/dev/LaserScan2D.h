@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_DEV_LASERSCAN2D_H
+#define YARP_DEV_LASERSCAN2D_H
+
+#include <yarp/conf/numeric.h>
+#include <yarp/os/Portable.h>
+#include <yarp/dev/api.h>
+
+#include <vector>
+
+/*!
+ * \file LaserScan2D.h contains the definition of the laser scan type
+ * streamed by the Rangefinder2DWrapper
+ */
+
+namespace yarp {
+    namespace dev {
+        class LaserScan2D;
+    }
+}
+
+/**
+ * A planar laser scan, as streamed by the Rangefinder2DWrapper.
+ *
+ * On the wire the scan is a Bottle, (ranges status [intensities]), with
+ * the ranges and the optional intensities sent as homogeneous lists of
+ * float32, so that it can still be read as a Bottle.
+ * When reading, the scan is decoded directly in the (reused) vectors;
+ * the old format, with the ranges sent as a list of float64, is accepted
+ * too.
+ */
+class YARP_dev_API yarp::dev::LaserScan2D : public yarp::os::Portable
+{
+public:
+    /**
+     * The measured distances.
+     */
+    YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::vector<yarp::conf::float32_t>) ranges;
+
+    /**
+     * The intensity of each measurement, empty if not available.
+     */
+    YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::vector<yarp::conf::float32_t>) intensities;
+
+    /**
+     * The device status, see IRangefinder2D::Device_status.
+     */
+    int status;
+
+    LaserScan2D();
+
+    bool read(yarp::os::ConnectionReader& connection) override;
+    bool write(yarp::os::ConnectionWriter& connection) const override;
+};
+
+#endif // YARP_DEV_LASERSCAN2D_H
@@ -14,6 +14,10 @@
 #include <yarp/sig/Vector.h>
 #include <yarp/math/Vec2D.h>
 #include <yarp/dev/api.h>
+#include <yarp/dev/MapGrid2DDelta.h>
+
+#include <cstdint>
+#include <vector>
 
 /**
 * \file MapGrid2D.h contains the definition of a map type
@@ -58,7 +62,21 @@ namespace yarp
 
                 //std::vector<map_link> links_to_other_maps;
 
+                //the map is divided in tiles of TILE_SIZE x TILE_SIZE cells. Each tile keeps the version
+                //of the map when it was last modified, so that only the modified tiles are transferred.
+                std::int64_t m_version;
+                std::int32_t m_epoch;
+                size_t       m_tile_cols;
+                size_t       m_tile_rows;
+                YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::vector<std::int64_t>) m_tile_versions;
+
             private:
+                //versioning of the tiles: resetTiles() after a change of size, touchCell() after a change of a cell
+                void resetTiles();
+                void touchCell(size_t x, size_t y);
+                void touchAllTiles();
+                bool tileDiffers(size_t col, size_t row, const MapGrid2D& other) const;
+
                 //performs an obstacles enlargement on the specified cell.
                 void enlargeCell(XYCell cell);
 
@@ -73,6 +91,11 @@ namespace yarp
                 bool loadMapYarpAndRos(std::string yarp_img_filename, std::string ros_yaml_filename);
 
             public:
+                /**
+                * The size of the tiles the map is transferred in, expressed in cells.
+                */
+                static const size_t TILE_SIZE = 64;
+
                 MapGrid2D();
                 virtual ~MapGrid2D();
 
@@ -249,6 +272,46 @@ namespace yarp
                 */
                 bool   enlargeObstacles(double size);
 
+                //-------------------------------incremental transfer functions------------------------
+
+                /**
+                * Retrieves the version of the map, which increases every time the map is modified.
+                * @return the version of the map.
+                */
+                std::int64_t getVersion() const;
+
+                /**
+                * Retrieves the epoch of the map, a random identifier which distinguishes the versions of unrelated maps.
+                * The epoch changes when the map is read from a connection, and it is preserved by copies and deltas.
+                * @return the epoch of the map.
+                */
+                std::int32_t getEpoch() const;
+
+                /**
+                * Retrieves the tiles modified after a given version of the map.
+                * @param epoch,since the epoch and version of a copy of this map, previously obtained from a delta.
+                * If the epoch does not match (e.g. the copy was obtained from another map), the delta contains the whole map.
+                * @param delta the modified tiles, with the current metadata of the map.
+                * @return true always.
+                */
+                bool   getDelta(std::int32_t epoch, std::int64_t since, MapGrid2DDelta& delta) const;
+
+                /**
+                * Applies a delta to this map. A delta containing the whole map (base_version 0) can be always applied,
+                * otherwise this map must be at the version the delta was computed from.
+                * @param delta the delta to apply.
+                * @return true if the delta was applied, false if it does not apply to this map or it is malformed.
+                */
+                bool   applyDelta(const MapGrid2DDelta& delta);
+
+                /**
+                * Replaces the content of this map with the one of another map, keeping the versioning of this map.
+                * Only the tiles that actually differ are marked as modified: a later delta contains only those.
+                * @param other the map to copy.
+                * @return true always.
+                */
+                bool   mergeFrom(const MapGrid2D& other);
+
                 //-------------------------------file access functions-------------------------------
 
                 /**
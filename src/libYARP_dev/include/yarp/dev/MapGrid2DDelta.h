@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_DEV_MAPGRID2DDELTA_H
+#define YARP_DEV_MAPGRID2DDELTA_H
+
+#include <yarp/os/Portable.h>
+#include <yarp/dev/api.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* \file MapGrid2DDelta.h contains the definition of the MapGrid2DDelta type
+*/
+namespace yarp
+{
+    namespace dev
+    {
+        /**
+        * The tiles of a MapGrid2D modified after a given version of the map,
+        * together with the map metadata.
+        * A delta from version 0 contains every tile, i.e. the whole map.
+        * Deltas are produced by MapGrid2D::getDelta() and applied by MapGrid2D::applyDelta().
+        */
+        class YARP_dev_API MapGrid2DDelta : public yarp::os::Portable
+        {
+        public:
+            enum tile_encoding
+            {
+                TILE_RAW = 0,  // occupancy cells, then flag cells
+                TILE_RLE = 1   // same cells, as (count, value) pairs
+            };
+
+            struct Tile
+            {
+                std::int32_t col;
+                std::int32_t row;
+                std::string  data;  // encoding byte, then the cells
+            };
+
+            MapGrid2DDelta();
+
+            YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::string) map_name;
+            std::int32_t epoch;          // identifies the map the versions refer to
+            std::int64_t base_version;   // version of the map the delta applies to, 0 for the whole map
+            std::int64_t version;        // version of the map after applying the delta
+            std::int32_t width;          // map size, in cells
+            std::int32_t height;
+            double       origin_x;
+            double       origin_y;
+            double       origin_theta;
+            double       resolution;
+            std::int32_t tile_size;      // tiles are tile_size x tile_size cells
+            YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::vector<Tile>) tiles;
+
+            /*
+            * Read a delta from a connection.
+            * return true iff a delta was read correctly
+            */
+            virtual bool read(yarp::os::ConnectionReader& connection) override;
+
+            /**
+            * Write a delta to a connection.
+            * return true iff a delta was written correctly
+            */
+            virtual bool write(yarp::os::ConnectionWriter& connection) const override;
+        };
+    }
+}
+
+#endif // YARP_DEV_MAPGRID2DDELTA_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_DEV_IMPL_POSESTREAMCACHE_H
+#define YARP_DEV_IMPL_POSESTREAMCACHE_H
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/BufferedPort.h>
+#include <yarp/os/Mutex.h>
+#include <yarp/dev/api.h>
+#include <yarp/dev/Map2DLocation.h>
+
+#include <vector>
+
+namespace yarp {
+    namespace dev {
+        namespace impl {
+            class PoseStreamCache;
+        }
+    }
+}
+
+/**
+ * Receives the poses streamed by a localization server, and keeps the most
+ * recent ones so that the position of the robot can be given without
+ * asking the server.
+ *
+ * Each message is a bottle (map_id x y theta), timestamped by its envelope
+ * (or by its arrival when the envelope is missing).  A pose is considered
+ * stale if nothing was received for longer than the timeout.
+ */
+class YARP_dev_API yarp::dev::impl::PoseStreamCache : public yarp::os::BufferedPort<yarp::os::Bottle>
+{
+public:
+    /**
+     * @param history number of poses kept for interpolation.
+     */
+    explicit PoseStreamCache(size_t history = 64);
+
+    /**
+     * Set how long a pose is valid after it was received, in seconds.
+     */
+    void setTimeout(double timeout);
+
+    using yarp::os::BufferedPort<yarp::os::Bottle>::onRead;
+    virtual void onRead(yarp::os::Bottle& b) override;
+
+    /**
+     * Get the most recent pose.
+     * @return false if no pose was received within the timeout.
+     */
+    bool getLatest(yarp::dev::Map2DLocation& loc);
+
+    /**
+     * Get the pose at a given time, interpolated between the poses received.
+     * Times after the most recent pose give that pose, as long as it is
+     * not stale.
+     * @return false if the time is outside the history kept, or the poses
+     * around it refer to different maps.
+     */
+    bool getAt(double timestamp, yarp::dev::Map2DLocation& loc);
+
+private:
+    struct Sample
+    {
+        double time;
+        double received;
+        yarp::dev::Map2DLocation loc;
+    };
+
+    bool isStale(const Sample& sample) const;
+
+    yarp::os::Mutex m_mutex;
+    YARP_SUPPRESS_DLL_INTERFACE_WARNING_ARG(std::vector<Sample>) m_history;
+    size_t m_next;
+    size_t m_count;
+    double m_timeout;
+};
+
+#endif // YARP_DEV_IMPL_POSESTREAMCACHE_H
@@ -13,6 +13,7 @@
 #include <yarp/os/ResourceFinder.h>
 #include <yarp/os/Time.h>
 #include <yarp/os/Network.h>
+#include <yarp/os/RecursiveMutex.h>
 #include <yarp/os/Terminator.h>
 #include <yarp/os/YarpPlugin.h>
 #include <yarp/dev/PolyDriver.h>
@@ -31,6 +32,9 @@ using namespace yarp::dev;
 class DriversHelper : public YarpPluginSelector {
 public:
     std::vector<DriverCreator *> delegates;
+    // devices can be opened concurrently, and the first lookup of a
+    // device type loads it and adds it to the delegates
+    yarp::os::RecursiveMutex mutex;
 
     ~DriversHelper() {
         for (unsigned int i=0; i<delegates.size(); i++) {
@@ -47,6 +51,7 @@ public:
     std::string toString() {
         std::string s;
         Property done;
+        mutex.lock();
         for (unsigned int i=0; i<delegates.size(); i++) {
             if (delegates[i]==nullptr) continue;
             std::string name = delegates[i]->getName();
@@ -70,6 +75,7 @@ public:
             }
             s += "\n";
         }
+        mutex.unlock();
 
         scan();
         Bottle lst = getSelectedPlugins();
@@ -124,24 +130,31 @@ public:
 
     void add(DriverCreator *creator) {
         if (creator!=nullptr) {
+            mutex.lock();
             delegates.push_back(creator);
+            mutex.unlock();
         }
     }
 
     DriverCreator *load(const char *name);
 
     DriverCreator *find(const char *name) {
+        mutex.lock();
         for (unsigned int i=0; i<delegates.size(); i++) {
             if (delegates[i]==nullptr) continue;
             std::string s = delegates[i]->toString();
             if (s==name) {
+                mutex.unlock();
                 return delegates[i];
             }
         }
-        return load(name);
+        DriverCreator *creator = load(name);
+        mutex.unlock();
+        return creator;
     }
 
     bool remove(const char *name) {
+        mutex.lock();
         for (unsigned int i=0; i<delegates.size(); i++) {
             if (delegates[i]==nullptr) continue;
             std::string s = delegates[i]->toString();
@@ -150,6 +163,7 @@ public:
                 delegates[i] = nullptr;
             }
         }
+        mutex.unlock();
         return false;
     }
 };
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/dev/LaserScan2D.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+#include <yarp/dev/IRangefinder2D.h>
+
+using namespace yarp::dev;
+using namespace yarp::os;
+
+namespace {
+
+bool readNumber(ConnectionReader& connection, std::int32_t tag, yarp::conf::float32_t& value)
+{
+    switch (tag) {
+    case BOTTLE_TAG_FLOAT32:
+        value = connection.expectFloat32();
+        return true;
+    case BOTTLE_TAG_FLOAT64:
+        value = static_cast<yarp::conf::float32_t>(connection.expectFloat64());
+        return true;
+    case BOTTLE_TAG_INT32:
+        value = static_cast<yarp::conf::float32_t>(connection.expectInt32());
+        return true;
+    default:
+        return false;
+    }
+}
+
+// reads a list of numbers, with the tag already consumed
+bool readList(ConnectionReader& connection, std::int32_t tag, std::vector<yarp::conf::float32_t>& values)
+{
+    if ((tag & BOTTLE_TAG_LIST) == 0) {
+        return false;
+    }
+    std::int32_t subtag = tag & ~BOTTLE_TAG_LIST;
+    std::int32_t len = connection.expectInt32();
+    if (connection.isError() || len < 0) {
+        return false;
+    }
+    values.resize(len);
+    if (len == 0) {
+        return true;
+    }
+    if (subtag == BOTTLE_TAG_FLOAT32) {
+        return connection.expectBlock(reinterpret_cast<char*>(values.data()), len * sizeof(yarp::conf::float32_t));
+    }
+    for (std::int32_t i = 0; i < len; i++) {
+        std::int32_t itemTag = (subtag != 0) ? subtag : connection.expectInt32();
+        if (!readNumber(connection, itemTag, values[i])) {
+            return false;
+        }
+    }
+    return !connection.isError();
+}
+
+void writeList(ConnectionWriter& connection, const std::vector<yarp::conf::float32_t>& values)
+{
+    connection.appendInt32(BOTTLE_TAG_LIST | BOTTLE_TAG_FLOAT32);
+    connection.appendInt32(static_cast<std::int32_t>(values.size()));
+    if (!values.empty()) {
+        connection.appendExternalBlock(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(yarp::conf::float32_t));
+    }
+}
+
+} // namespace
+
+
+LaserScan2D::LaserScan2D() :
+        status(IRangefinder2D::DEVICE_GENERAL_ERROR)
+{
+}
+
+bool LaserScan2D::read(ConnectionReader& connection)
+{
+    // auto-convert text mode interaction
+    connection.convertTextMode();
+
+    if (connection.expectInt32() != BOTTLE_TAG_LIST) {
+        return false;
+    }
+    std::int32_t len = connection.expectInt32();
+    if (len < 2) {
+        return false;
+    }
+
+    if (!readList(connection, connection.expectInt32(), ranges)) {
+        return false;
+    }
+
+    if (connection.expectInt32() != BOTTLE_TAG_INT32) {
+        return false;
+    }
+    status = connection.expectInt32();
+
+    if (len > 2) {
+        if (!readList(connection, connection.expectInt32(), intensities)) {
+            return false;
+        }
+    } else {
+        intensities.clear();
+    }
+
+    return !connection.isError();
+}
+
+bool LaserScan2D::write(ConnectionWriter& connection) const
+{
+    connection.appendInt32(BOTTLE_TAG_LIST);
+    connection.appendInt32(intensities.empty() ? 2 : 3);
+    writeList(connection, ranges);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(status);
+    if (!intensities.empty()) {
+        writeList(connection, intensities);
+    }
+
+    connection.convertTextMode();
+    return !connection.isError();
+}
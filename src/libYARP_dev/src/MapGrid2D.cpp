@@ -16,6 +16,8 @@
 #include <algorithm>
 #include <fstream>
 #include <cmath>
+#include <cstring>
+#include <random>
 
 using namespace yarp::dev;
 using namespace yarp::sig;
@@ -40,6 +42,50 @@ string extractExtensionFromFile(string full_filename)
     return full_filename.substr(start, 3);
 }
 
+//a random non-zero identifier, so that the versions of unrelated maps are never mixed up
+static std::int32_t newMapEpoch()
+{
+    std::random_device rd;
+    std::int32_t epoch = 0;
+    while (epoch == 0)
+    {
+        epoch = (std::int32_t)(rd());
+    }
+    return epoch;
+}
+
+//run-length encoding of the cells of a tile, as (count, value) pairs
+static void encodeRLE(const std::vector<unsigned char>& cells, std::string& out)
+{
+    for (size_t i = 0; i < cells.size();)
+    {
+        size_t run = 1;
+        while (i + run < cells.size() && run < 255 && cells[i + run] == cells[i])
+        {
+            run++;
+        }
+        out += (char)(run);
+        out += (char)(cells[i]);
+        i += run;
+    }
+}
+
+static bool decodeRLE(const char* data, size_t len, std::vector<unsigned char>& cells)
+{
+    if (len % 2 != 0) return false;
+    size_t pos = 0;
+    for (size_t i = 0; i < len; i += 2)
+    {
+        size_t run = (unsigned char)(data[i]);
+        if (run == 0 || pos + run > cells.size()) return false;
+        memset(&cells[pos], data[i + 1], run);
+        pos += run;
+    }
+    return pos == cells.size();
+}
+
+
+const size_t MapGrid2D::TILE_SIZE;
 
 bool MapGrid2D::isIdenticalTo(const MapGrid2D& other) const
 {
@@ -79,6 +125,9 @@ MapGrid2D::MapGrid2D()
             m_map_flags.safePixel(x, y) = MapGrid2D::map_flags::MAP_CELL_FREE;
         }
     }
+    m_version = 0;
+    m_epoch = newMapEpoch();
+    resetTiles();
 }
 
 MapGrid2D::~MapGrid2D()
@@ -168,7 +217,12 @@ bool MapGrid2D::setMapImage(yarp::sig::ImageOf<PixelRgb>& image)
     {
         for (size_t x = 0; x < m_width; x++)
         {
-            m_map_flags.safePixel(x, y) = PixelToCellData(image.safePixel(x, y));
+            CellData flag = PixelToCellData(image.safePixel(x, y));
+            if (m_map_flags.safePixel(x, y) != flag)
+            {
+                m_map_flags.safePixel(x, y) = flag;
+                touchCell(x, y);
+            }
         }
     }
     return true;
@@ -188,6 +242,7 @@ bool MapGrid2D::enlargeObstacles(double size)
                 }
             }
         }
+        touchAllTiles();
         return true;
     }
     size_t repeat_num = (size_t)(std::ceil(size/m_resolution));
@@ -217,6 +272,7 @@ bool MapGrid2D::enlargeObstacles(double size)
             enlargeCell(*it);
         }
     }
+    touchAllTiles();
     return true;
 }
 
@@ -668,6 +724,7 @@ bool  MapGrid2D::crop (int left, int top, int right, int bottom)
     m_map_flags.copy(new_map_flags);
     this->m_width=m_map_occupancy.width();
     this->m_height=m_map_occupancy.height();
+    resetTiles();
     yDebug() << m_origin.x << m_origin.y;
     m_origin.x = m_origin.x+(left*m_resolution);
     m_origin.y = m_origin.y+(double(original_height)-double(bottom))*m_resolution;
@@ -775,6 +832,10 @@ bool MapGrid2D::read(yarp::os::ConnectionReader& connection)
     ok &= connection.expectBlock((char*)mem, memsize);
     if (!ok) return false;
 
+    //this is a new map, unrelated to any previous content
+    m_epoch = newMapEpoch();
+    resetTiles();
+
     return !connection.isError();
         return true;
 }
@@ -872,6 +933,7 @@ bool MapGrid2D::setOrigin(double x, double y, double theta)
         m_origin.x = x;
         m_origin.y = y;
         m_origin.theta = fmod(theta, 360.0);
+        m_version++;
         return true;
     }
     else
@@ -880,6 +942,7 @@ bool MapGrid2D::setOrigin(double x, double y, double theta)
         m_origin.x = x;
         m_origin.y = y;
         m_origin.theta = fmod(theta, 360.0);
+        m_version++;
         return true;
     }
 }
@@ -899,6 +962,7 @@ bool MapGrid2D::setResolution(double resolution)
         return false;
     }
     m_resolution = resolution;
+    m_version++;
     return true;
 }
 
@@ -912,6 +976,7 @@ bool MapGrid2D::setMapName(std::string map_name)
     if (map_name != "")
     {
         m_map_name = map_name;
+        m_version++;
         return true;
     }
     yError() << "MapGrid2D::setMapName() invalid map name";
@@ -954,6 +1019,7 @@ bool MapGrid2D::setSize_in_cells(size_t x, size_t y)
     m_map_flags.zero();
     m_width = x;
     m_height = y;
+    resetTiles();
     return true;
 }
 
@@ -976,7 +1042,11 @@ bool MapGrid2D::setMapFlag(XYCell cell, map_flags flag)
         yError() << "Invalid cell requested " << cell.x << " " << cell.y;
         return false;
     }
-    m_map_flags.safePixel(cell.x, cell.y) = flag;
+    if (m_map_flags.safePixel(cell.x, cell.y) != flag)
+    {
+        m_map_flags.safePixel(cell.x, cell.y) = flag;
+        touchCell(cell.x, cell.y);
+    }
     return true;
 }
 
@@ -998,7 +1068,12 @@ bool MapGrid2D::setOccupancyData(XYCell cell, double occupancy)
         yError() << "Invalid cell requested " << cell.x << " " << cell.y;
         return false;
     }
-    m_map_occupancy.safePixel(cell.x, cell.y) = (yarp::sig::PixelMono)(occupancy);
+    yarp::sig::PixelMono occ = (yarp::sig::PixelMono)(occupancy);
+    if (m_map_occupancy.safePixel(cell.x, cell.y) != occ)
+    {
+        m_map_occupancy.safePixel(cell.x, cell.y) = occ;
+        touchCell(cell.x, cell.y);
+    }
     return true;
 }
 
@@ -1028,6 +1103,16 @@ bool MapGrid2D::setOccupancyGrid(yarp::sig::ImageOf<yarp::sig::PixelMono>& image
         yError() << "The size of given occupancy grid does not correspond to the current map. Use method setSize() first.";
         return false;
     }
+    for (size_t y = 0; y < m_height; y++)
+    {
+        for (size_t x = 0; x < m_width; x++)
+        {
+            if (m_map_occupancy.safePixel(x, y) != image.safePixel(x, y))
+            {
+                touchCell(x, y);
+            }
+        }
+    }
     m_map_occupancy = image;
     return true;
 }
@@ -1037,3 +1122,253 @@ bool MapGrid2D::getOccupancyGrid(yarp::sig::ImageOf<yarp::sig::PixelMono>& image
     image = m_map_occupancy;
     return true;
 }
+
+void MapGrid2D::resetTiles()
+{
+    m_tile_cols = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tile_rows = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+    m_version++;
+    m_tile_versions.assign(m_tile_cols * m_tile_rows, m_version);
+}
+
+void MapGrid2D::touchCell(size_t x, size_t y)
+{
+    m_version++;
+    m_tile_versions[(y / TILE_SIZE) * m_tile_cols + x / TILE_SIZE] = m_version;
+}
+
+void MapGrid2D::touchAllTiles()
+{
+    m_version++;
+    std::fill(m_tile_versions.begin(), m_tile_versions.end(), m_version);
+}
+
+bool MapGrid2D::tileDiffers(size_t col, size_t row, const MapGrid2D& other) const
+{
+    size_t x0 = col * TILE_SIZE;
+    size_t y0 = row * TILE_SIZE;
+    size_t w = std::min(TILE_SIZE, m_width - x0);
+    size_t h = std::min(TILE_SIZE, m_height - y0);
+    for (size_t y = y0; y < y0 + h; y++)
+    {
+        if (memcmp(m_map_occupancy.getRow(y) + x0, other.m_map_occupancy.getRow(y) + x0, w) != 0) return true;
+        if (memcmp(m_map_flags.getRow(y) + x0, other.m_map_flags.getRow(y) + x0, w) != 0) return true;
+    }
+    return false;
+}
+
+std::int64_t MapGrid2D::getVersion() const
+{
+    return m_version;
+}
+
+std::int32_t MapGrid2D::getEpoch() const
+{
+    return m_epoch;
+}
+
+bool MapGrid2D::getDelta(std::int32_t epoch, std::int64_t since, MapGrid2DDelta& delta) const
+{
+    //a copy of another map, or of a later version of this map, needs the whole map
+    if (epoch != m_epoch || since > m_version)
+    {
+        since = 0;
+    }
+
+    delta.map_name = m_map_name;
+    delta.epoch = m_epoch;
+    delta.base_version = since;
+    delta.version = m_version;
+    delta.width = (std::int32_t)(m_width);
+    delta.height = (std::int32_t)(m_height);
+    delta.origin_x = m_origin.x;
+    delta.origin_y = m_origin.y;
+    delta.origin_theta = m_origin.theta;
+    delta.resolution = m_resolution;
+    delta.tile_size = (std::int32_t)(TILE_SIZE);
+    delta.tiles.clear();
+
+    std::vector<unsigned char> cells;
+    std::string rle;
+    for (size_t row = 0; row < m_tile_rows; row++)
+    {
+        for (size_t col = 0; col < m_tile_cols; col++)
+        {
+            if (m_tile_versions[row * m_tile_cols + col] <= since) continue;
+
+            size_t x0 = col * TILE_SIZE;
+            size_t y0 = row * TILE_SIZE;
+            size_t w = std::min(TILE_SIZE, m_width - x0);
+            size_t h = std::min(TILE_SIZE, m_height - y0);
+            cells.resize(2 * w * h);
+            for (size_t y = 0; y < h; y++)
+            {
+                memcpy(&cells[y * w], m_map_occupancy.getRow(y0 + y) + x0, w);
+                memcpy(&cells[(h + y) * w], m_map_flags.getRow(y0 + y) + x0, w);
+            }
+
+            MapGrid2DDelta::Tile tile;
+            tile.col = (std::int32_t)(col);
+            tile.row = (std::int32_t)(row);
+            //maps are mostly made of large uniform areas, that compress well
+            rle.clear();
+            encodeRLE(cells, rle);
+            if (rle.size() < cells.size())
+            {
+                tile.data.reserve(rle.size() + 1);
+                tile.data += (char)(MapGrid2DDelta::TILE_RLE);
+                tile.data += rle;
+            }
+            else
+            {
+                tile.data.reserve(cells.size() + 1);
+                tile.data += (char)(MapGrid2DDelta::TILE_RAW);
+                tile.data.append((const char*)(cells.data()), cells.size());
+            }
+            delta.tiles.push_back(std::move(tile));
+        }
+    }
+    return true;
+}
+
+bool MapGrid2D::applyDelta(const MapGrid2DDelta& delta)
+{
+    if (delta.tile_size != (std::int32_t)(TILE_SIZE) || delta.width <= 0 || delta.height <= 0)
+    {
+        yError() << "MapGrid2D::applyDelta() invalid delta";
+        return false;
+    }
+    if (delta.base_version != 0 && (delta.epoch != m_epoch || delta.base_version != m_version))
+    {
+        //the delta was computed from another version of the map
+        return false;
+    }
+
+    size_t width = delta.width;
+    size_t height = delta.height;
+    size_t cols = (width + TILE_SIZE - 1) / TILE_SIZE;
+    size_t rows = (height + TILE_SIZE - 1) / TILE_SIZE;
+    bool resized = (width != m_width || height != m_height);
+    if ((resized || delta.base_version == 0) && delta.tiles.size() != cols * rows)
+    {
+        yError() << "MapGrid2D::applyDelta() the delta does not contain the whole map";
+        return false;
+    }
+
+    //decode everything before modifying the map
+    std::vector<std::vector<unsigned char>> decoded(delta.tiles.size());
+    for (size_t i = 0; i < delta.tiles.size(); i++)
+    {
+        const MapGrid2DDelta::Tile& tile = delta.tiles[i];
+        if (tile.col < 0 || tile.row < 0 || (size_t)(tile.col) >= cols || (size_t)(tile.row) >= rows || tile.data.empty())
+        {
+            yError() << "MapGrid2D::applyDelta() invalid tile";
+            return false;
+        }
+        size_t w = std::min(TILE_SIZE, width - tile.col * TILE_SIZE);
+        size_t h = std::min(TILE_SIZE, height - tile.row * TILE_SIZE);
+        decoded[i].resize(2 * w * h);
+        const char* data = tile.data.data() + 1;
+        size_t len = tile.data.size() - 1;
+        bool ok = false;
+        if (tile.data[0] == MapGrid2DDelta::TILE_RAW && len == decoded[i].size())
+        {
+            memcpy(decoded[i].data(), data, len);
+            ok = true;
+        }
+        else if (tile.data[0] == MapGrid2DDelta::TILE_RLE)
+        {
+            ok = decodeRLE(data, len, decoded[i]);
+        }
+        if (!ok)
+        {
+            yError() << "MapGrid2D::applyDelta() invalid tile data";
+            return false;
+        }
+    }
+
+    if (resized)
+    {
+        m_map_occupancy.resize(width, height);
+        m_map_flags.resize(width, height);
+        m_width = width;
+        m_height = height;
+        m_tile_cols = cols;
+        m_tile_rows = rows;
+        m_tile_versions.assign(cols * rows, 0);
+    }
+    for (size_t i = 0; i < delta.tiles.size(); i++)
+    {
+        const MapGrid2DDelta::Tile& tile = delta.tiles[i];
+        size_t x0 = tile.col * TILE_SIZE;
+        size_t y0 = tile.row * TILE_SIZE;
+        size_t w = std::min(TILE_SIZE, width - x0);
+        size_t h = std::min(TILE_SIZE, height - y0);
+        for (size_t y = 0; y < h; y++)
+        {
+            memcpy(m_map_occupancy.getRow(y0 + y) + x0, &decoded[i][y * w], w);
+            memcpy(m_map_flags.getRow(y0 + y) + x0, &decoded[i][(h + y) * w], w);
+        }
+        m_tile_versions[tile.row * m_tile_cols + tile.col] = delta.version;
+    }
+
+    m_map_name = delta.map_name;
+    m_origin.x = delta.origin_x;
+    m_origin.y = delta.origin_y;
+    m_origin.theta = delta.origin_theta;
+    m_resolution = delta.resolution;
+    m_epoch = delta.epoch;
+    m_version = delta.version;
+    return true;
+}
+
+bool MapGrid2D::mergeFrom(const MapGrid2D& other)
+{
+    bool changed = (m_map_name != other.m_map_name ||
+                    m_origin.x != other.m_origin.x ||
+                    m_origin.y != other.m_origin.y ||
+                    m_origin.theta != other.m_origin.theta ||
+                    m_resolution != other.m_resolution);
+    m_map_name = other.m_map_name;
+    m_origin = other.m_origin;
+    m_resolution = other.m_resolution;
+    m_occupied_thresh = other.m_occupied_thresh;
+    m_free_thresh = other.m_free_thresh;
+
+    if (m_width != other.m_width || m_height != other.m_height)
+    {
+        m_map_occupancy = other.m_map_occupancy;
+        m_map_flags = other.m_map_flags;
+        m_width = other.m_width;
+        m_height = other.m_height;
+        resetTiles();
+        return true;
+    }
+
+    std::vector<size_t> modified;
+    for (size_t row = 0; row < m_tile_rows; row++)
+    {
+        for (size_t col = 0; col < m_tile_cols; col++)
+        {
+            if (tileDiffers(col, row, other))
+            {
+                modified.push_back(row * m_tile_cols + col);
+            }
+        }
+    }
+    if (!modified.empty())
+    {
+        m_map_occupancy = other.m_map_occupancy;
+        m_map_flags = other.m_map_flags;
+        changed = true;
+    }
+    if (changed)
+    {
+        m_version++;
+        for (size_t tile : modified)
+        {
+            m_tile_versions[tile] = m_version;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/dev/MapGrid2DDelta.h>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/ConnectionReader.h>
+#include <yarp/os/ConnectionWriter.h>
+
+using namespace yarp::dev;
+using namespace yarp::os;
+
+MapGrid2DDelta::MapGrid2DDelta() :
+        epoch(0),
+        base_version(0),
+        version(0),
+        width(0),
+        height(0),
+        origin_x(0),
+        origin_y(0),
+        origin_theta(0),
+        resolution(0),
+        tile_size(0)
+{
+}
+
+bool MapGrid2DDelta::read(yarp::os::ConnectionReader& connection)
+{
+    // auto-convert text mode interaction
+    connection.convertTextMode();
+
+    if (connection.expectInt32() != BOTTLE_TAG_LIST) return false;
+    if (connection.expectInt32() != 12) return false;
+
+    connection.expectInt32();
+    std::int32_t siz = connection.expectInt32();
+    if (siz < 0 || siz > 65536) return false;
+    map_name.resize(siz);
+    if (siz > 0 && !connection.expectBlock(&map_name[0], siz)) return false;
+    // strings coming from a Bottle include their terminator
+    map_name = map_name.c_str();
+    connection.expectInt32();
+    epoch = connection.expectInt32();
+    connection.expectInt32();
+    base_version = connection.expectInt64();
+    connection.expectInt32();
+    version = connection.expectInt64();
+    connection.expectInt32();
+    width = connection.expectInt32();
+    connection.expectInt32();
+    height = connection.expectInt32();
+    connection.expectInt32();
+    origin_x = connection.expectFloat64();
+    connection.expectInt32();
+    origin_y = connection.expectFloat64();
+    connection.expectInt32();
+    origin_theta = connection.expectFloat64();
+    connection.expectInt32();
+    resolution = connection.expectFloat64();
+    connection.expectInt32();
+    tile_size = connection.expectInt32();
+    if (width < 0 || height < 0 || tile_size <= 0) return false;
+
+    if (connection.expectInt32() != BOTTLE_TAG_LIST) return false;
+    std::int32_t count = connection.expectInt32();
+    std::int64_t max_count = ((std::int64_t)(width) + tile_size - 1) / tile_size *
+                             (((std::int64_t)(height) + tile_size - 1) / tile_size);
+    if (count < 0 || count > max_count) return false;
+    // worst case: every cell of both layers in its own run, plus the encoding byte
+    std::int64_t max_data = 4 * (std::int64_t)(tile_size) * tile_size + 1;
+    tiles.resize(count);
+    for (auto& tile : tiles)
+    {
+        if (connection.expectInt32() != BOTTLE_TAG_LIST) return false;
+        if (connection.expectInt32() != 3) return false;
+        connection.expectInt32();
+        tile.col = connection.expectInt32();
+        connection.expectInt32();
+        tile.row = connection.expectInt32();
+        connection.expectInt32();
+        std::int32_t len = connection.expectInt32();
+        if (len <= 0 || len > max_data) return false;
+        tile.data.resize(len);
+        if (!connection.expectBlock(&tile.data[0], len)) return false;
+    }
+
+    return !connection.isError();
+}
+
+bool MapGrid2DDelta::write(yarp::os::ConnectionWriter& connection) const
+{
+    connection.appendInt32(BOTTLE_TAG_LIST);
+    connection.appendInt32(12);
+    connection.appendInt32(BOTTLE_TAG_STRING);
+    connection.appendRawString(map_name);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(epoch);
+    connection.appendInt32(BOTTLE_TAG_INT64);
+    connection.appendInt64(base_version);
+    connection.appendInt32(BOTTLE_TAG_INT64);
+    connection.appendInt64(version);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(width);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(height);
+    connection.appendInt32(BOTTLE_TAG_FLOAT64);
+    connection.appendFloat64(origin_x);
+    connection.appendInt32(BOTTLE_TAG_FLOAT64);
+    connection.appendFloat64(origin_y);
+    connection.appendInt32(BOTTLE_TAG_FLOAT64);
+    connection.appendFloat64(origin_theta);
+    connection.appendInt32(BOTTLE_TAG_FLOAT64);
+    connection.appendFloat64(resolution);
+    connection.appendInt32(BOTTLE_TAG_INT32);
+    connection.appendInt32(tile_size);
+
+    connection.appendInt32(BOTTLE_TAG_LIST);
+    connection.appendInt32((std::int32_t)(tiles.size()));
+    for (const auto& tile : tiles)
+    {
+        connection.appendInt32(BOTTLE_TAG_LIST);
+        connection.appendInt32(3);
+        connection.appendInt32(BOTTLE_TAG_INT32);
+        connection.appendInt32(tile.col);
+        connection.appendInt32(BOTTLE_TAG_INT32);
+        connection.appendInt32(tile.row);
+        connection.appendInt32(BOTTLE_TAG_BLOB);
+        connection.appendInt32((std::int32_t)(tile.data.size()));
+        connection.appendExternalBlock(tile.data.data(), tile.data.size());
+    }
+
+    connection.convertTextMode();
+    return !connection.isError();
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/dev/impl/PoseStreamCache.h>
+
+#include <yarp/os/LockGuard.h>
+#include <yarp/os/Stamp.h>
+#include <yarp/os/Time.h>
+
+#include <cmath>
+
+using yarp::dev::impl::PoseStreamCache;
+using yarp::dev::Map2DLocation;
+using namespace yarp::os;
+
+PoseStreamCache::PoseStreamCache(size_t history) :
+        m_history(history > 2 ? history : 2),
+        m_next(0),
+        m_count(0),
+        m_timeout(0.2)
+{
+}
+
+void PoseStreamCache::setTimeout(double timeout)
+{
+    LockGuard lock(m_mutex);
+    m_timeout = timeout;
+}
+
+void PoseStreamCache::onRead(yarp::os::Bottle& b)
+{
+    if (b.size() != 4)
+    {
+        return;
+    }
+
+    Sample sample;
+    sample.received = Time::now();
+    Stamp stamp;
+    if (getEnvelope(stamp) && stamp.isValid())
+    {
+        sample.time = stamp.getTime();
+    }
+    else
+    {
+        sample.time = sample.received;
+    }
+    sample.loc.map_id = b.get(0).asString();
+    sample.loc.x = b.get(1).asFloat64();
+    sample.loc.y = b.get(2).asFloat64();
+    sample.loc.theta = b.get(3).asFloat64();
+
+    LockGuard lock(m_mutex);
+    if (m_count > 0)
+    {
+        // poses out of order would break the interpolation
+        const Sample& last = m_history[(m_next + m_history.size() - 1) % m_history.size()];
+        if (sample.time < last.time)
+        {
+            return;
+        }
+    }
+    m_history[m_next] = sample;
+    m_next = (m_next + 1) % m_history.size();
+    if (m_count < m_history.size())
+    {
+        m_count++;
+    }
+}
+
+bool PoseStreamCache::isStale(const Sample& sample) const
+{
+    return Time::now() - sample.received > m_timeout;
+}
+
+bool PoseStreamCache::getLatest(Map2DLocation& loc)
+{
+    LockGuard lock(m_mutex);
+    if (m_count == 0)
+    {
+        return false;
+    }
+    const Sample& last = m_history[(m_next + m_history.size() - 1) % m_history.size()];
+    if (isStale(last))
+    {
+        return false;
+    }
+    loc = last.loc;
+    return true;
+}
+
+bool PoseStreamCache::getAt(double timestamp, Map2DLocation& loc)
+{
+    LockGuard lock(m_mutex);
+    if (m_count == 0)
+    {
+        return false;
+    }
+    size_t size = m_history.size();
+    const Sample& last = m_history[(m_next + size - 1) % size];
+    if (timestamp >= last.time)
+    {
+        if (isStale(last))
+        {
+            return false;
+        }
+        loc = last.loc;
+        return true;
+    }
+
+    // newest to oldest, looking for the poses around the timestamp
+    for (size_t i = 1; i < m_count; i++)
+    {
+        const Sample& after = m_history[(m_next + size - i) % size];
+        const Sample& before = m_history[(m_next + size - i - 1) % size];
+        if (timestamp < before.time)
+        {
+            continue;
+        }
+        if (before.loc.map_id != after.loc.map_id)
+        {
+            return false;
+        }
+        double dt = after.time - before.time;
+        double a = (dt > 0) ? (timestamp - before.time) / dt : 1.0;
+        // theta is in degrees, turn the shortest way
+        double dtheta = std::fmod(after.loc.theta - before.loc.theta + 540.0, 360.0) - 180.0;
+        loc.map_id = after.loc.map_id;
+        loc.x = before.loc.x + a * (after.loc.x - before.loc.x);
+        loc.y = before.loc.y + a * (after.loc.y - before.loc.y);
+        loc.theta = before.loc.theta + a * dtheta;
+        return true;
+    }
+    return false;
+}
@@ -537,29 +537,36 @@ bool ControlBoardRemapper::setPid(const PidControlTypeEnum& pidtype, int j, cons
 bool ControlBoardRemapper::setPids(const PidControlTypeEnum& pidtype, const Pid *ps)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(ps, allJointsBuffers.m_fullBufferForSubControlBoardPids, remappedControlBoards);
+
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoardPids[ctrlBrd];
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = true;
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
+        if (!p->pid)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->pid)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->pid->setPid(pidtype, off, ps[l]);
-            ret=ret&&ok;
+            ok = p->pid->setPids(pidtype, values.data());
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->pid->setPid(pidtype, off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
+
     return ret;
 }
 
@@ -586,29 +593,36 @@ bool ControlBoardRemapper::setPidReference(const PidControlTypeEnum& pidtype, in
 bool ControlBoardRemapper::setPidReferences(const PidControlTypeEnum& pidtype, const double *refs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
+
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(refs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd];
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = true;
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
+        if (!p->pid)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->pid)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->pid->setPidReference(pidtype, off, refs[l]);
-            ret=ret&&ok;
+            ok = p->pid->setPidReferences(pidtype, values.data());
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->pid->setPidReference(pidtype, off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
+
     return ret;
 }
 
@@ -634,29 +648,36 @@ bool ControlBoardRemapper::setPidErrorLimit(const PidControlTypeEnum& pidtype, i
 bool ControlBoardRemapper::setPidErrorLimits(const PidControlTypeEnum& pidtype, const double *limits)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(limits, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd];
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = true;
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
+        if (!p->pid)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->pid)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->pid->setPidErrorLimit(pidtype, off, limits[l]);
-            ret=ret&&ok;
+            ok = p->pid->setPidErrorLimits(pidtype, values.data());
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->pid->setPidErrorLimit(pidtype, off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
+
     return ret;
 }
 
@@ -683,28 +704,18 @@ bool ControlBoardRemapper::getPidError(const PidControlTypeEnum& pidtype, int j,
 bool ControlBoardRemapper::getPidErrors(const PidControlTypeEnum& pidtype, double *errs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->pid)
-        {
-            bool ok = p->pid->getPidError(pidtype, off, errs+l);
-            ret=ret&&ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->pid ? p->pid->getPidErrors(pidtype, allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
+
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(errs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -730,28 +741,18 @@ bool ControlBoardRemapper::getPidOutput(const PidControlTypeEnum& pidtype, int j
 bool ControlBoardRemapper::getPidOutputs(const PidControlTypeEnum& pidtype, double *outs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = p->pid ? p->pid->getPidOutputs(pidtype, allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(outs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->pid)
-        {
-            ret=ret&&p->pid->getPidOutput(pidtype, off, outs+l);
-        }
-        else
-        {
-            ret=false;
-        }
-    }
     return ret;
 }
 
@@ -796,29 +797,18 @@ bool ControlBoardRemapper::getPid(const PidControlTypeEnum& pidtype, int j, Pid
 bool ControlBoardRemapper::getPids(const PidControlTypeEnum& pidtype, Pid *pids)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->pid)
-        {
-            bool ok = p->pid->getPid(pidtype, off, pids+l);
-            ret = ok && ret;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->pid ? p->pid->getPids(pidtype, allJointsBuffers.m_fullBufferForSubControlBoardPids[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(pids, allJointsBuffers.m_fullBufferForSubControlBoardPids, remappedControlBoards);
+
     return ret;
 }
 
@@ -844,29 +834,18 @@ bool ControlBoardRemapper::getPidReference(const PidControlTypeEnum& pidtype, in
 bool ControlBoardRemapper::getPidReferences(const PidControlTypeEnum& pidtype, double *refs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = p->pid ? p->pid->getPidReferences(pidtype, allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(refs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->pid)
-        {
-            bool ok = p->pid->getPidReference(pidtype, off, refs+l);
-            ret=ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
-    }
     return ret;
 }
 
@@ -892,30 +871,18 @@ bool ControlBoardRemapper::getPidErrorLimit(const PidControlTypeEnum& pidtype, i
 bool ControlBoardRemapper::getPidErrorLimits(const PidControlTypeEnum& pidtype, double *limits)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        bool ok = p->pid ? p->pid->getPidErrorLimits(pidtype, allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(limits, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (!p)
-        {
-            return false;
-        }
-
-        if (p->pid)
-        {
-            bool ok = p->pid->getPidErrorLimit(pidtype, off, limits+l);
-            ret=ret&&ok;
-        }
-        else
-        {
-            ret=false;
-        }
-    }
     return ret;
 }
 
@@ -1024,7 +991,7 @@ bool ControlBoardRemapper::positionMove(int j, double ref)
 bool ControlBoardRemapper::positionMove(const double *refs)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(refs,remappedControlBoards);
 
@@ -1044,7 +1011,7 @@ bool ControlBoardRemapper::positionMove(const double *refs)
 bool ControlBoardRemapper::positionMove(const int n_joints, const int *joints, const double *refs)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(refs,n_joints,joints,remappedControlBoards);
 
@@ -1085,7 +1052,7 @@ bool ControlBoardRemapper::getTargetPosition(const int j, double* ref)
 bool ControlBoardRemapper::getTargetPositions(double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -1116,7 +1083,7 @@ bool ControlBoardRemapper::getTargetPositions(double *spds)
 bool ControlBoardRemapper::getTargetPositions(const int n_joints, const int *joints, double *targets)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -1169,7 +1136,7 @@ bool ControlBoardRemapper::relativeMove(int j, double delta)
 bool ControlBoardRemapper::relativeMove(const double *deltas)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(deltas,remappedControlBoards);
 
@@ -1189,7 +1156,7 @@ bool ControlBoardRemapper::relativeMove(const double *deltas)
 bool ControlBoardRemapper::relativeMove(const int n_joints, const int *joints, const double *deltas)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(deltas,n_joints,joints,remappedControlBoards);
 
@@ -1231,24 +1198,18 @@ bool ControlBoardRemapper::checkMotionDone(bool *flag)
     bool ret=true;
     *flag=true;
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
         if (p->pos)
         {
-            bool singleJointMotionDone =false;
-            bool ok = p->pos->checkMotionDone(off, &singleJointMotionDone);
+            bool subControlBoardMotionDone = false;
+            bool ok = p->pos->checkMotionDone(allJointsBuffers.m_nJointsInSubControlBoard[ctrlBrd],
+                                              allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd].data(),
+                                              &subControlBoardMotionDone);
             ret = ret && ok;
-            *flag = *flag  && singleJointMotionDone;
+            *flag = *flag && subControlBoardMotionDone;
         }
         else
         {
@@ -1262,27 +1223,28 @@ bool ControlBoardRemapper::checkMotionDone(const int n_joints, const int *joints
 {
     bool ret=true;
     *flag=true;
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard buffersGuard(buffers.mutex);
 
-    for(int j=0;j<n_joints;j++)
-    {
-        int l = joints[j];
-
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+    selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(buffers.dummyBuffer.data(),n_joints,joints,remappedControlBoards);
 
-        if (!p)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
+    {
+        if (selectedJointsBuffers.m_nJointsInSubControlBoard[ctrlBrd] == 0)
         {
-            return false;
+            continue;
         }
 
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+
         if (p->pos)
         {
-            bool singleJointMotionDone =false;
-            bool ok = p->pos->checkMotionDone(off, &singleJointMotionDone);
+            bool subControlBoardMotionDone = false;
+            bool ok = p->pos->checkMotionDone(selectedJointsBuffers.m_nJointsInSubControlBoard[ctrlBrd],
+                                              selectedJointsBuffers.m_jointsInSubControlBoard[ctrlBrd].data(),
+                                              &subControlBoardMotionDone);
             ret = ret && ok;
-            *flag = *flag  && singleJointMotionDone;
+            *flag = *flag && subControlBoardMotionDone;
         }
         else
         {
@@ -1316,7 +1278,7 @@ bool ControlBoardRemapper::setRefSpeed(int j, double sp)
 bool ControlBoardRemapper::setRefSpeeds(const double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(spds,remappedControlBoards);
 
@@ -1336,7 +1298,7 @@ bool ControlBoardRemapper::setRefSpeeds(const double *spds)
 bool ControlBoardRemapper::setRefSpeeds(const int n_joints, const int *joints, const double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(spds,n_joints,joints,remappedControlBoards);
 
@@ -1376,7 +1338,7 @@ bool ControlBoardRemapper::setRefAcceleration(int j, double acc)
 bool ControlBoardRemapper::setRefAccelerations(const double *accs)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(accs,remappedControlBoards);
 
@@ -1396,7 +1358,7 @@ bool ControlBoardRemapper::setRefAccelerations(const double *accs)
 bool ControlBoardRemapper::setRefAccelerations(const int n_joints, const int *joints, const double *accs)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(accs,n_joints,joints,remappedControlBoards);
 
@@ -1436,7 +1398,7 @@ bool ControlBoardRemapper::getRefSpeed(int j, double *ref)
 bool ControlBoardRemapper::getRefSpeeds(double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -1467,7 +1429,7 @@ bool ControlBoardRemapper::getRefSpeeds(double *spds)
 bool ControlBoardRemapper::getRefSpeeds(const int n_joints, const int *joints, double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -1520,7 +1482,7 @@ bool ControlBoardRemapper::getRefAcceleration(int j, double *acc)
 bool ControlBoardRemapper::getRefAccelerations(double *accs)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -1550,7 +1512,7 @@ bool ControlBoardRemapper::getRefAccelerations(double *accs)
 bool ControlBoardRemapper::getRefAccelerations(const int n_joints, const int *joints, double *accs)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -1603,7 +1565,7 @@ bool ControlBoardRemapper::stop(int j)
 bool ControlBoardRemapper::stop()
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -1623,8 +1585,8 @@ bool ControlBoardRemapper::stop()
 bool ControlBoardRemapper::stop(const int n_joints, const int *joints)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
-    yarp::os::LockGuard(buffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard buffersGuard(buffers.mutex);
 
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(buffers.dummyBuffer.data(),n_joints,joints,remappedControlBoards);
@@ -1667,7 +1629,7 @@ bool ControlBoardRemapper::velocityMove(int j, double v)
 bool ControlBoardRemapper::velocityMove(const double *v)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(v,remappedControlBoards);
 
@@ -1708,27 +1670,31 @@ bool ControlBoardRemapper::resetEncoders()
 {
     bool ret=true;
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
+        bool ok = true;
+
+        if (!p->iJntEnc)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->iJntEnc)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->iJntEnc->resetEncoder(off);
-            ret = ret && ok;
+            ok = p->iJntEnc->resetEncoders();
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->iJntEnc->resetEncoder(off) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
+
     return ret;
 }
 
@@ -1755,29 +1721,36 @@ bool ControlBoardRemapper::setEncoder(int j, double val)
 bool ControlBoardRemapper::setEncoders(const double *vals)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
+
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(vals, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off = (int) remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex = remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd];
 
-        yarp::dev::RemappedSubControlBoard *p = remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = true;
 
-        if (!p)
+        if (!p->iJntEnc)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->iJntEnc)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->iJntEnc->setEncoder(off, vals[l]);
-            ret = ret && ok;
+            ok = p->iJntEnc->setEncoders(values.data());
         }
         else
         {
-            ret = false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->iJntEnc->setEncoder(off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
+
     return ret;
 }
 
@@ -1804,58 +1777,38 @@ bool ControlBoardRemapper::getEncoder(int j, double *v)
 bool ControlBoardRemapper::getEncoders(double *encs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iJntEnc ? p->iJntEnc->getEncoders(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(encs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iJntEnc)
-        {
-            bool ok = p->iJntEnc->getEncoder(off, encs+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
 bool ControlBoardRemapper::getEncodersTimed(double *encs, double *t)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iJntEnc ? p->iJntEnc->getEncodersTimed(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data(),
+                                                            allJointsBuffers.m_fullAuxBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(encs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(t, allJointsBuffers.m_fullAuxBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iJntEnc)
-        {
-            bool ok = p->iJntEnc->getEncoderTimed(off, encs+l, t+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -1902,29 +1855,18 @@ bool ControlBoardRemapper::getEncoderSpeed(int j, double *sp)
 bool ControlBoardRemapper::getEncoderSpeeds(double *spds)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iJntEnc ? p->iJntEnc->getEncoderSpeeds(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(spds, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iJntEnc)
-        {
-            bool ok = p->iJntEnc->getEncoderSpeed(off, spds+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -1951,29 +1893,18 @@ bool ControlBoardRemapper::getEncoderAcceleration(int j, double *acc)
 bool ControlBoardRemapper::getEncoderAccelerations(double *accs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iJntEnc ? p->iJntEnc->getEncoderAccelerations(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(accs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iJntEnc)
-        {
-            bool ok = p->iJntEnc->getEncoderAcceleration(off, accs+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -2007,26 +1938,18 @@ bool ControlBoardRemapper::getTemperature(int m, double* val)
 bool ControlBoardRemapper::getTemperatures(double *vals)
 {
     bool ret=true;
-    for(int l=0;l<controlledJoints;l++)
-    {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-        {
-            return false;
-        }
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
+    {
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->imotor)
-        {
-            ret=ret&&p->imotor->getTemperature(off, vals+l);
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->imotor ? p->imotor->getTemperatures(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
+
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(vals, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -2224,26 +2147,29 @@ bool ControlBoardRemapper::resetMotorEncoders()
 {
     bool ret=true;
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
+        bool ok = true;
+
+        if (!p->iMotEnc)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->iMotEnc)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->iMotEnc->resetMotorEncoder(off);
-            ret= ret && ok;
+            ok = p->iMotEnc->resetMotorEncoders();
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->iMotEnc->resetMotorEncoder(off) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
 
     return ret;
@@ -2272,28 +2198,34 @@ bool ControlBoardRemapper::setMotorEncoder(int m, const double val)
 bool ControlBoardRemapper::setMotorEncoders(const double *vals)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(vals, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd];
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = true;
 
-        if (!p)
+        if (!p->iMotEnc)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->iMotEnc)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->iMotEnc->setMotorEncoder(off, vals[l]);
-            ret = ret && ok;
+            ok = p->iMotEnc->setMotorEncoders(values.data());
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->iMotEnc->setMotorEncoder(off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
 
     return ret;
@@ -2362,52 +2294,38 @@ bool ControlBoardRemapper::getMotorEncoder(int m, double *v)
 bool ControlBoardRemapper::getMotorEncoders(double *encs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-        if (!p)
-            return false;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iMotEnc)
-        {
-            ret=ret&&p->iMotEnc->getMotorEncoder(off, encs+l);
-        }
-        else
-            ret=false;
+        bool ok = p->iMotEnc ? p->iMotEnc->getMotorEncoders(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
+
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(encs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
 bool ControlBoardRemapper::getMotorEncodersTimed(double *encs, double *t)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iMotEnc ? p->iMotEnc->getMotorEncodersTimed(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data(),
+                                                                 allJointsBuffers.m_fullAuxBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(encs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(t, allJointsBuffers.m_fullAuxBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iMotEnc)
-        {
-            bool ok = p->iMotEnc->getMotorEncoderTimed(off, encs, t);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -2454,29 +2372,18 @@ bool ControlBoardRemapper::getMotorEncoderSpeed(int m, double *sp)
 bool ControlBoardRemapper::getMotorEncoderSpeeds(double *spds)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off = (int) remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex = remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p = remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iMotEnc ? p->iMotEnc->getMotorEncoderSpeeds(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(spds, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iMotEnc)
-        {
-            bool ok = p->iMotEnc->getMotorEncoderSpeed(off, spds + l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -2503,30 +2410,18 @@ bool ControlBoardRemapper::getMotorEncoderAcceleration(int m, double *acc)
 bool ControlBoardRemapper::getMotorEncoderAccelerations(double *accs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iMotEnc)
-        {
-            bool ok = p->iMotEnc->getMotorEncoderAcceleration(off, accs+l);
-            ret=ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iMotEnc ? p->iMotEnc->getMotorEncoderAccelerations(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(accs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -2566,30 +2461,18 @@ bool ControlBoardRemapper::disableAmp(int j)
 bool ControlBoardRemapper::getAmpStatus(int *st)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->amp)
-        {
-            bool ok = p->amp->getAmpStatus(off, st+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->amp ? p->amp->getAmpStatus(allJointsBuffers.m_fullBufferForSubControlBoardInts[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(st, allJointsBuffers.m_fullBufferForSubControlBoardInts, remappedControlBoards);
+
     return ret;
 }
 
@@ -3210,29 +3093,18 @@ bool ControlBoardRemapper::getJointType(int j, yarp::dev::JointTypeEnum& type)
 bool ControlBoardRemapper::getRefTorques(double *refs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iTorque ? p->iTorque->getRefTorques(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(refs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iTorque)
-        {
-            bool ok = p->iTorque->getRefTorque(off, refs+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret = false;
-        }
-    }
     return ret;
 }
 
@@ -3258,7 +3130,7 @@ bool ControlBoardRemapper::getRefTorque(int j, double *t)
 bool ControlBoardRemapper::setRefTorques(const double *t)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(t,remappedControlBoards);
 
@@ -3306,7 +3178,7 @@ bool ControlBoardRemapper::setRefTorque(int j, double t)
 bool ControlBoardRemapper::setRefTorques(const int n_joints, const int *joints, const double *t)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(t,n_joints,joints,remappedControlBoards);
 
@@ -3426,32 +3298,20 @@ bool ControlBoardRemapper::getTorque(int j, double *t)
 bool ControlBoardRemapper::getTorques(double *t)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iTorque)
-        {
-            bool ok = p->iTorque->getTorque(off, t+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iTorque ? p->iTorque->getTorques(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(t, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
- }
+}
 
 bool ControlBoardRemapper::getTorqueRange(int j, double *min, double *max)
 {
@@ -3476,31 +3336,22 @@ bool ControlBoardRemapper::getTorqueRange(int j, double *min, double *max)
 bool ControlBoardRemapper::getTorqueRanges(double *min, double *max)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = p->iTorque ? p->iTorque->getTorqueRanges(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data(),
+                                                           allJointsBuffers.m_fullAuxBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
+    }
 
-        if (!p)
-        {
-            return false;
-        }
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(min, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(max, allJointsBuffers.m_fullAuxBufferForSubControlBoard, remappedControlBoards);
 
-        if (p->iTorque)
-        {
-            bool ok = p->iTorque->getTorqueRange(off, min+l, max+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
-    }
     return ret;
- }
+}
 
 bool ControlBoardRemapper::getImpedance(int j, double* stiff, double* damp)
 {
@@ -3578,7 +3429,7 @@ bool ControlBoardRemapper::getControlMode(int j, int *mode)
 bool ControlBoardRemapper::getControlModes(int *modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -3609,7 +3460,7 @@ bool ControlBoardRemapper::getControlModes(int *modes)
 bool ControlBoardRemapper::getControlModes(const int n_joints, const int *joints, int *modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -3661,7 +3512,7 @@ bool ControlBoardRemapper::setControlMode(const int j, const int mode)
 bool ControlBoardRemapper::setControlModes(const int n_joints, const int *joints, int *modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(modes,n_joints,joints,remappedControlBoards);
 
@@ -3681,7 +3532,7 @@ bool ControlBoardRemapper::setControlModes(const int n_joints, const int *joints
 bool ControlBoardRemapper::setControlModes(int *modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(modes,remappedControlBoards);
 
@@ -3721,7 +3572,7 @@ bool ControlBoardRemapper::setPosition(int j, double ref)
 bool ControlBoardRemapper::setPositions(const int n_joints, const int *joints, const double *dpos)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(dpos,n_joints,joints,remappedControlBoards);
 
@@ -3741,7 +3592,7 @@ bool ControlBoardRemapper::setPositions(const int n_joints, const int *joints, c
 bool ControlBoardRemapper::setPositions(const double *refs)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(refs,remappedControlBoards);
 
@@ -3763,26 +3614,22 @@ yarp::os::Stamp ControlBoardRemapper::getLastInputStamp()
     double averageTimestamp = 0.0;
     int collectedTimestamps = 0;
 
-    for(int l=0;l<controlledJoints;l++)
+    // Each SubControlBoard is queried once, its timestamp is weighted
+    // by the number of remapped axes it contains
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return Stamp();
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        int nJoints = allJointsBuffers.m_nJointsInSubControlBoard[ctrlBrd];
 
-        if(p->iTimed)
+        if(p->iTimed && nJoints > 0)
         {
-            averageTimestamp = averageTimestamp + p->iTimed->getLastInputStamp().getTime();
-            collectedTimestamps++;
+            averageTimestamp = averageTimestamp + nJoints*p->iTimed->getLastInputStamp().getTime();
+            collectedTimestamps += nJoints;
         }
     }
 
 
-    yarp::os::LockGuard(buffers.mutex);
+    yarp::os::LockGuard buffersGuard(buffers.mutex);
 
     if( collectedTimestamps > 0 )
     {
@@ -3820,7 +3667,7 @@ bool ControlBoardRemapper::getRefPosition(const int j, double* ref)
 bool ControlBoardRemapper::getRefPositions(double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -3851,7 +3698,7 @@ bool ControlBoardRemapper::getRefPositions(double *spds)
 bool ControlBoardRemapper::getRefPositions(const int n_joints, const int *joints, double *targets)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -3888,7 +3735,7 @@ bool ControlBoardRemapper::getRefPositions(const int n_joints, const int *joints
 bool ControlBoardRemapper::velocityMove(const int n_joints, const int *joints, const double *spds)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(spds,n_joints,joints,remappedControlBoards);
 
@@ -3930,7 +3777,7 @@ bool ControlBoardRemapper::getRefVelocity(const int j, double* vel)
 bool ControlBoardRemapper::getRefVelocities(double* vels)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -3960,7 +3807,7 @@ bool ControlBoardRemapper::getRefVelocities(double* vels)
 bool ControlBoardRemapper::getRefVelocities(const int n_joints, const int* joints, double* vels)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -4013,7 +3860,7 @@ bool ControlBoardRemapper::getInteractionMode(int j, yarp::dev::InteractionModeE
 bool ControlBoardRemapper::getInteractionModes(int n_joints, int *joints, yarp::dev::InteractionModeEnum* modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     // Resize the input buffers
     selectedJointsBuffers.resizeSubControlBoardBuffers(n_joints,joints,remappedControlBoards);
@@ -4046,7 +3893,7 @@ bool ControlBoardRemapper::getInteractionModes(int n_joints, int *joints, yarp::
 bool ControlBoardRemapper::getInteractionModes(yarp::dev::InteractionModeEnum* modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
@@ -4096,7 +3943,7 @@ bool ControlBoardRemapper::setInteractionMode(int j, yarp::dev::InteractionModeE
 bool ControlBoardRemapper::setInteractionModes(int n_joints, int *joints, yarp::dev::InteractionModeEnum* modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(modes,n_joints,joints,remappedControlBoards);
 
@@ -4116,7 +3963,7 @@ bool ControlBoardRemapper::setInteractionModes(int n_joints, int *joints, yarp::
 bool ControlBoardRemapper::setInteractionModes(yarp::dev::InteractionModeEnum* modes)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(modes,remappedControlBoards);
 
@@ -4153,28 +4000,34 @@ bool ControlBoardRemapper::setRefDutyCycle(int m, double ref)
 bool ControlBoardRemapper::setRefDutyCycles(const double* refs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
+
+    allJointsBuffers.fillSubControlBoardFullBuffersFromCompleteJointVector(refs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
+        const auto& values = allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd];
 
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
+        bool ok = true;
 
-        if (!p)
+        if (!p->iPwm)
         {
-            return false;
+            ok = false;
         }
-
-        if (p->iPwm)
+        else if (allJointsBuffers.m_allAxesOfSubControlBoardRemapped[ctrlBrd])
         {
-            bool ok = p->iPwm->setRefDutyCycle(off, refs[l]);
-            ret = ret && ok;
+            ok = p->iPwm->setRefDutyCycles(values.data());
         }
         else
         {
-            ret=false;
+            for(int off : allJointsBuffers.m_jointsInSubControlBoard[ctrlBrd])
+            {
+                ok = p->iPwm->setRefDutyCycle(off, values[off]) && ok;
+            }
         }
+
+        ret = ret && ok;
     }
 
     return ret;
@@ -4200,30 +4053,18 @@ bool ControlBoardRemapper::getRefDutyCycle(int m, double* ref)
 bool ControlBoardRemapper::getRefDutyCycles(double* refs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iPwm)
-        {
-            bool ok = p->iPwm->getRefDutyCycle(off, refs+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iPwm ? p->iPwm->getRefDutyCycles(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(refs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -4247,30 +4088,18 @@ bool ControlBoardRemapper::getDutyCycle(int m, double* val)
 bool ControlBoardRemapper::getDutyCycles(double* vals)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iPwm)
-        {
-            bool ok = p->iPwm->getDutyCycle(off, vals+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iPwm ? p->iPwm->getDutyCycles(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(vals, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -4294,30 +4123,18 @@ bool ControlBoardRemapper::getCurrent(int j, double *val)
 bool ControlBoardRemapper::getCurrents(double *vals)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iCurr)
-        {
-            bool ok = p->iCurr->getCurrent(off, vals+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iCurr ? p->iCurr->getCurrents(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(vals, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -4341,30 +4158,20 @@ bool ControlBoardRemapper::getCurrentRange(int m, double* min, double* max)
 bool ControlBoardRemapper::getCurrentRanges(double* min, double* max)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iCurr)
-        {
-            bool ok = p->iCurr->getCurrentRange(off, min+l, max+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iCurr ? p->iCurr->getCurrentRanges(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data(),
+                                                        allJointsBuffers.m_fullAuxBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(min, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(max, allJointsBuffers.m_fullAuxBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
@@ -4388,7 +4195,7 @@ bool ControlBoardRemapper::setRefCurrent(int m, double curr)
 bool ControlBoardRemapper::setRefCurrents(const int n_motor, const int* motors, const double* currs)
 {
     bool ret=true;
-    yarp::os::LockGuard(selectedJointsBuffers.mutex);
+    yarp::os::LockGuard guard(selectedJointsBuffers.mutex);
 
     selectedJointsBuffers.fillSubControlBoardBuffersFromArbitraryJointVector(currs,n_motor,motors,remappedControlBoards);
 
@@ -4414,7 +4221,7 @@ bool ControlBoardRemapper::setRefCurrents(const int n_motor, const int* motors,
 bool ControlBoardRemapper::setRefCurrents(const double* currs)
 {
     bool ret=true;
-    yarp::os::LockGuard(allJointsBuffers.mutex);
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
     allJointsBuffers.fillSubControlBoardBuffersFromCompleteJointVector(currs,remappedControlBoards);
 
@@ -4451,30 +4258,18 @@ bool ControlBoardRemapper::getRefCurrent(int m, double* curr)
 bool ControlBoardRemapper::getRefCurrents(double* currs)
 {
     bool ret=true;
+    yarp::os::LockGuard guard(allJointsBuffers.mutex);
 
-    for(int l=0;l<controlledJoints;l++)
+    for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        int off=(int)remappedControlBoards.lut[l].axisIndexInSubControlBoard;
-        size_t subIndex=remappedControlBoards.lut[l].subControlBoardIndex;
-
-        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(subIndex);
-
-        if (!p)
-        {
-            return false;
-        }
+        yarp::dev::RemappedSubControlBoard *p=remappedControlBoards.getSubControlBoard(ctrlBrd);
 
-        if (p->iCurr)
-        {
-            bool ok = p->iCurr->getRefCurrent(off, currs+l);
-            ret = ret && ok;
-        }
-        else
-        {
-            ret=false;
-        }
+        bool ok = p->iCurr ? p->iCurr->getRefCurrents(allJointsBuffers.m_fullBufferForSubControlBoard[ctrlBrd].data()) : false;
+        ret = ret && ok;
     }
 
+    allJointsBuffers.fillCompleteJointVectorFromSubControlBoardFullBuffers(currs, allJointsBuffers.m_fullBufferForSubControlBoard, remappedControlBoards);
+
     return ret;
 }
 
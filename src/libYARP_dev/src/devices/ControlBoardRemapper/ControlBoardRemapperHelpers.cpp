@@ -10,6 +10,7 @@
 #include <iostream>
 #include <yarp/os/Log.h>
 #include <yarp/os/LogStream.h>
+#include <algorithm>
 #include <cassert>
 
 using namespace yarp::os;
@@ -248,16 +249,67 @@ bool ControlBoardSubControlBoardAxesDecomposition::configure(const RemappedContr
         m_jointsInSubControlBoard[subIndex].push_back(off);
     }
 
-    // Reserve enough space in buffers
+    // Allocate the buffers, their size does not change after configuration
     for(size_t ctrlBrd=0; ctrlBrd < nrOfSubControlBoards; ctrlBrd++)
     {
-        m_bufferForSubControlBoard[ctrlBrd].reserve(m_nJointsInSubControlBoard[ctrlBrd]);
-        m_bufferForSubControlBoardControlModes[ctrlBrd].reserve(m_nJointsInSubControlBoard[ctrlBrd]);
-        m_bufferForSubControlBoardInteractionModes[ctrlBrd].reserve(m_nJointsInSubControlBoard[ctrlBrd]);
+        m_bufferForSubControlBoard[ctrlBrd].resize(m_nJointsInSubControlBoard[ctrlBrd]);
+        m_bufferForSubControlBoardControlModes[ctrlBrd].resize(m_nJointsInSubControlBoard[ctrlBrd]);
+        m_bufferForSubControlBoardInteractionModes[ctrlBrd].resize(m_nJointsInSubControlBoard[ctrlBrd]);
 
         m_counterForControlBoard[ctrlBrd] = 0;
     }
 
+    // Whole-device buffers
+    m_nAxesInSubControlBoard.assign(nrOfSubControlBoards,0);
+    m_allAxesOfSubControlBoardRemapped.assign(nrOfSubControlBoards,false);
+    m_fullBufferForSubControlBoard.resize(nrOfSubControlBoards);
+    m_fullAuxBufferForSubControlBoard.resize(nrOfSubControlBoards);
+    m_fullBufferForSubControlBoardInts.resize(nrOfSubControlBoards);
+    m_fullBufferForSubControlBoardPids.resize(nrOfSubControlBoards);
+
+    for(size_t ctrlBrd=0; ctrlBrd < nrOfSubControlBoards; ctrlBrd++)
+    {
+        const RemappedSubControlBoard & sub = remappedControlBoards.subdevices[ctrlBrd];
+
+        int nAxes = 0;
+        if (sub.pos)
+        {
+            sub.pos->getAxes(&nAxes);
+        }
+
+        // Count the axes that are remapped exactly once
+        std::vector<int> timesRemapped(nAxes,0);
+        int nAxesRemappedOnce = 0;
+        for(int off : m_jointsInSubControlBoard[ctrlBrd])
+        {
+            if (off < nAxes && ++timesRemapped[off] == 1)
+            {
+                nAxesRemappedOnce++;
+            }
+        }
+        m_allAxesOfSubControlBoardRemapped[ctrlBrd] = (nAxes > 0) &&
+                                                      (nAxesRemappedOnce == nAxes) &&
+                                                      (m_nJointsInSubControlBoard[ctrlBrd] == nAxes);
+
+        // The buffers must also fit the motor encoders and the remapped axes
+        int nBuffer = nAxes;
+        int nMotorEncoders = 0;
+        if (sub.iMotEnc && sub.iMotEnc->getNumberOfMotorEncoders(&nMotorEncoders))
+        {
+            nBuffer = std::max(nBuffer, nMotorEncoders);
+        }
+        for(int off : m_jointsInSubControlBoard[ctrlBrd])
+        {
+            nBuffer = std::max(nBuffer, off+1);
+        }
+
+        m_nAxesInSubControlBoard[ctrlBrd] = nAxes;
+        m_fullBufferForSubControlBoard[ctrlBrd].assign(nBuffer,0.0);
+        m_fullAuxBufferForSubControlBoard[ctrlBrd].assign(nBuffer,0.0);
+        m_fullBufferForSubControlBoardInts[ctrlBrd].assign(nBuffer,0);
+        m_fullBufferForSubControlBoardPids[ctrlBrd].assign(nBuffer,Pid());
+    }
+
     return true;
 }
 
@@ -267,14 +319,15 @@ void ControlBoardSubControlBoardAxesDecomposition::fillSubControlBoardBuffersFro
 {
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        m_bufferForSubControlBoard[ctrlBrd].clear();
+        m_counterForControlBoard[ctrlBrd] = 0;
     }
 
     for(int j=0; j < m_nrOfControlledAxesInRemappedCtrlBrd; j++)
     {
         size_t subIndex=remappedControlBoards.lut[j].subControlBoardIndex;
 
-        m_bufferForSubControlBoard[subIndex].push_back(full[j]);
+        m_bufferForSubControlBoard[subIndex][m_counterForControlBoard[subIndex]] = full[j];
+        m_counterForControlBoard[subIndex]++;
     }
 }
 
@@ -297,14 +350,15 @@ void ControlBoardSubControlBoardAxesDecomposition::fillSubControlBoardBuffersFro
 {
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        m_bufferForSubControlBoardControlModes[ctrlBrd].clear();
+        m_counterForControlBoard[ctrlBrd] = 0;
     }
 
     for(int j=0; j < m_nrOfControlledAxesInRemappedCtrlBrd; j++)
     {
         size_t subIndex=remappedControlBoards.lut[j].subControlBoardIndex;
 
-        m_bufferForSubControlBoardControlModes[subIndex].push_back(full[j]);
+        m_bufferForSubControlBoardControlModes[subIndex][m_counterForControlBoard[subIndex]] = full[j];
+        m_counterForControlBoard[subIndex]++;
     }
 }
 
@@ -327,14 +381,15 @@ void ControlBoardSubControlBoardAxesDecomposition::fillSubControlBoardBuffersFro
 {
     for(size_t ctrlBrd=0; ctrlBrd < remappedControlBoards.getNrOfSubControlBoards(); ctrlBrd++)
     {
-        m_bufferForSubControlBoardInteractionModes[ctrlBrd].clear();
+        m_counterForControlBoard[ctrlBrd] = 0;
     }
 
     for(int j=0; j < m_nrOfControlledAxesInRemappedCtrlBrd; j++)
     {
         size_t subIndex=remappedControlBoards.lut[j].subControlBoardIndex;
 
-        m_bufferForSubControlBoardInteractionModes[subIndex].push_back(full[j]);
+        m_bufferForSubControlBoardInteractionModes[subIndex][m_counterForControlBoard[subIndex]] = full[j];
+        m_counterForControlBoard[subIndex]++;
     }
 }
 
@@ -219,6 +219,42 @@ public:
     void fillCompleteJointVectorFromSubControlBoardBuffers(InteractionModeEnum * full,
                                                            const RemappedControlBoards & remappedControlBoards);
 
+    /**
+     * Fill the whole-device buffers of the SubControlBoard from
+     * a vector of joints of the RemappedControlBoards.
+     *
+     * The whole-device buffers have one element for each axis of the
+     * SubControlBoard, the elements of the axes that are not remapped
+     * are left untouched.
+     */
+    template <typename T>
+    void fillSubControlBoardFullBuffersFromCompleteJointVector(const T * full,
+                                                               std::vector< std::vector<T> > & fullBuffers,
+                                                               const RemappedControlBoards & remappedControlBoards) const
+    {
+        for(int j=0; j < m_nrOfControlledAxesInRemappedCtrlBrd; j++)
+        {
+            const RemappedAxis & axis = remappedControlBoards.lut[j];
+            fullBuffers[axis.subControlBoardIndex][axis.axisIndexInSubControlBoard] = full[j];
+        }
+    }
+
+    /**
+     * Fill a vector of joints of the ControlBoardRemapper from
+     * the whole-device buffers of the SubControlBoard.
+     */
+    template <typename T>
+    void fillCompleteJointVectorFromSubControlBoardFullBuffers(T * full,
+                                                               const std::vector< std::vector<T> > & fullBuffers,
+                                                               const RemappedControlBoards & remappedControlBoards) const
+    {
+        for(int j=0; j < m_nrOfControlledAxesInRemappedCtrlBrd; j++)
+        {
+            const RemappedAxis & axis = remappedControlBoards.lut[j];
+            full[j] = fullBuffers[axis.subControlBoardIndex][axis.axisIndexInSubControlBoard];
+        }
+    }
+
 
     /**
      * Mutex to grab to use this class.
@@ -236,6 +272,22 @@ public:
     std::vector< std::vector<InteractionModeEnum>  > m_bufferForSubControlBoardInteractionModes;
 
     std::vector<int> m_counterForControlBoard;
+
+    // Number of axes of each SubControlBoard, including the ones not remapped
+    std::vector<int> m_nAxesInSubControlBoard;
+
+    // True if every axis of the SubControlBoard is remapped, so that the
+    // methods writing all the axes of the SubControlBoard can be used
+    std::vector<bool> m_allAxesOfSubControlBoardRemapped;
+
+    // Whole-device buffers (of size m_nAxesInSubControlBoard[ctrlBoard]),
+    // used with the methods that read or write all the axes of a
+    // SubControlBoard with a single call. The auxiliary buffer stores
+    // the timestamps or the upper bounds of the ranges.
+    std::vector< std::vector<double> > m_fullBufferForSubControlBoard;
+    std::vector< std::vector<double> > m_fullAuxBufferForSubControlBoard;
+    std::vector< std::vector<int>    > m_fullBufferForSubControlBoardInts;
+    std::vector< std::vector<Pid>    > m_fullBufferForSubControlBoardPids;
 };
 
 /**
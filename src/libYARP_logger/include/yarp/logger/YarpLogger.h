@@ -20,9 +20,11 @@
 #include <yarp/os/PeriodicThread.h>
 #include <yarp/os/Mutex.h>
 
+#include <functional>
 #include <list>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <ctime>
 
 namespace yarp
@@ -134,7 +136,7 @@ class yarp::yarpLogger::LogEntryInfo
     std::string   process_pid;
     std::string   ip_address;
     std::time_t   last_update;
-    unsigned int  logsize;
+    unsigned int  logsize;        // messages stored, at most the maximum size of the log
 
     LogEntryInfo  ()  {clear();}
     void          clear ();
@@ -156,21 +158,45 @@ class yarp::yarpLogger::LogEntry
     unsigned int                  entry_list_max_size;
     bool                          entry_list_max_size_enabled;
 
+    // Messages are stored in a ring: entry_list[entry_list_head] is the
+    // oldest one, and has sequence number first_message. When the maximum
+    // size is reached, the oldest message is overwritten.
+    std::vector<MessageEntry>     entry_list;
+    size_t                        entry_list_head;
+    long long                     first_message;
+
     public:
     bool                          logging_enabled;
-    std::vector<MessageEntry>     entry_list;
-    int                           last_read_message;
+    long long                     last_read_message;
     void                          clear_logEntries();
     bool                          append_logEntry(MessageEntry entry);
 
+    /**
+     * Sequence numbers of the oldest message stored and of the next
+     * message that will be received.
+     */
+    long long                     first_sequence () const {return first_message;}
+    long long                     end_sequence   () const {return first_message + (long long)entry_list.size();}
+    const MessageEntry&           get_message    (long long sequence) const
+    {
+        return entry_list[(entry_list_head + (size_t)(sequence - first_message)) % entry_list.size()];
+    }
+
+    /**
+     * Copy of the messages stored, from the oldest one. This replaces the
+     * entry_list member, that is no longer public.
+     */
+    std::vector<MessageEntry>     get_entry_list () const;
+
     public:
     LogEntry(int _entry_list_max_size=10000) :
         entry_list_max_size(_entry_list_max_size),
         entry_list_max_size_enabled(true),
+        entry_list_head(0),
+        first_message(0),
         logging_enabled(true),
         last_read_message(-1)
     {
-        entry_list.reserve(entry_list_max_size);
     }
 
     int  getLogEntryMaxSize        ()          {return entry_list_max_size;}
@@ -198,6 +224,18 @@ class yarp::yarpLogger::LoggerEngine
         std::string          logger_portName;
         int                  unknown_format_received;
 
+        // Index of log_list, by port_complete and by the first entry found
+        // for each port_prefix, process_name and process_pid
+        std::unordered_map<std::string, LogEntry*> index_by_port_complete;
+        std::unordered_map<std::string, LogEntry*> index_by_port_prefix;
+        std::unordered_map<std::string, LogEntry*> index_by_process;
+        std::unordered_map<std::string, LogEntry*> index_by_pid;
+
+        LogEntry*   find_entry(const std::unordered_map<std::string, LogEntry*>& index, const std::string& key);
+        LogEntry*   add_entry(const LogEntry& entry);
+        void        clear_entries();
+        void        index_entry(LogEntry* entry);
+
         public:
         std::string getPortName();
         void        run() override;
@@ -260,6 +298,21 @@ class yarp::yarpLogger::LoggerEngine
     void get_log_list_max_size           (bool& enabled, int& current_size);
 
     std::list<MessageEntry> filter_by_level (int level, const std::list<MessageEntry>& messages);
+
+    /**
+     * Visit the messages of a port that were received after cursor, without
+     * copying them. Only the messages whose level is in level_mask (a bit
+     * for each loglLevelEnum value, e.g. 1<<LOGLEVEL_ERROR) and whose text
+     * contains text are visited. cursor is then moved past the last message
+     * received, so that the next call only visits the new messages; a
+     * negative cursor starts from the oldest message stored.
+     * @return the number of messages visited
+     */
+    size_t visit_messages_by_port_complete (const std::string& port,
+                                            long long& cursor,
+                                            const std::function<void(const MessageEntry&)>& visitor,
+                                            unsigned int level_mask = ~0u,
+                                            const std::string& text = std::string());
 };
 
 #endif
@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <fstream>
 #include <iterator>
+#include <algorithm>
 #include <yarp/os/RpcClient.h>
 #include <yarp/os/SystemClock.h>
 #include <yarp/logger/YarpLogger.h>
@@ -32,7 +33,9 @@ const std::string YELLOW_WARNING = YELLOW+"WARNING"+CLEAR;
 */
 void LogEntry::clear_logEntries()
 {
+    first_message += entry_list.size();
     entry_list.clear();
+    entry_list_head=0;
     logInfo.clear();
     last_read_message=-1;
 }
@@ -40,7 +43,6 @@ void LogEntry::clear_logEntries()
 void LogEntry::setLogEntryMaxSize(int size)
 {
     entry_list_max_size = size;
-    entry_list.reserve(entry_list_max_size);
     clear_logEntries();
 }
 
@@ -51,16 +53,45 @@ void LogEntry::setLogEntryMaxSizeEnabled (bool enable)
 
 bool LogEntry::append_logEntry(MessageEntry entry)
 {
-    if (logInfo.logsize >= entry_list_max_size && entry_list_max_size_enabled)
+    if (entry_list_max_size_enabled && entry_list.size() >= entry_list_max_size)
     {
-        //printf("WARNING: exceeded entry_list_max_size=%d\n",entry_list_max_size);
-        return false;
+        if (entry_list_max_size == 0) return false;
+        if (entry_list.size() > entry_list_max_size)
+        {
+            // the limit was enabled when the log was already longer
+            std::rotate(entry_list.begin(), entry_list.begin() + entry_list_head, entry_list.end());
+            entry_list_head = 0;
+            size_t excess = entry_list.size() - entry_list_max_size;
+            entry_list.erase(entry_list.begin(), entry_list.begin() + excess);
+            first_message += excess;
+        }
+        // overwrite the oldest message
+        entry_list[entry_list_head] = std::move(entry);
+        entry_list_head = (entry_list_head + 1) % entry_list.size();
+        first_message++;
+    }
+    else
+    {
+        if (entry_list_head != 0)
+        {
+            std::rotate(entry_list.begin(), entry_list.begin() + entry_list_head, entry_list.end());
+            entry_list_head = 0;
+        }
+        entry_list.push_back(std::move(entry));
     }
-    entry_list.push_back(entry);
-    logInfo.logsize++;
+    logInfo.logsize = entry_list.size();
     return true;
 }
 
+std::vector<MessageEntry> LogEntry::get_entry_list() const
+{
+    std::vector<MessageEntry> list;
+    list.reserve(entry_list.size());
+    list.insert(list.end(), entry_list.begin() + entry_list_head, entry_list.end());
+    list.insert(list.end(), entry_list.begin(), entry_list.begin() + entry_list_head);
+    return list;
+}
+
 void LogEntryInfo::clear()
 {
     logsize=0;
@@ -158,19 +189,10 @@ void LoggerEngine::discover  (std::list<std::string>& ports)
         getline(iss, token, '/'); entry.logInfo.process_name = token;
         getline(iss, token, '/'); entry.logInfo.process_pid  = token;
 
-        std::list<LogEntry>::iterator it;
         this->log_updater->mutex.lock();
-        bool found = false;
-        for (it = this->log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
-        {
-            if (it->logInfo.port_complete==entry.logInfo.port_complete)
-            {
-                found=true; break;
-            }
-        }
-        if (found==false)
+        if (log_updater->find_entry(log_updater->index_by_port_complete, entry.logInfo.port_complete) == nullptr)
         {
-            log_updater->log_list.push_back(entry);
+            log_updater->add_entry(entry);
         }
         this->log_updater->mutex.unlock();
     }
@@ -218,172 +240,186 @@ LoggerEngine::logger_thread::logger_thread (std::string _portname, double _perio
         unknown_format_received      = 0;
 }
 
-void LoggerEngine::logger_thread::run()
+LogEntry* LoggerEngine::logger_thread::find_entry(const std::unordered_map<std::string, LogEntry*>& index, const std::string& key)
+{
+    std::unordered_map<std::string, LogEntry*>::const_iterator it = index.find(key);
+    if (it == index.end()) return nullptr;
+    return it->second;
+}
+
+void LoggerEngine::logger_thread::index_entry(LogEntry* entry)
 {
-    //if (is_discovering()==true)
+    // emplace does not replace existing keys, so that the lookups by prefix,
+    // process and pid keep returning the first entry found, as a linear
+    // search would do
+    index_by_port_complete.emplace(entry->logInfo.port_complete, entry);
+    index_by_port_prefix.emplace(entry->logInfo.port_prefix, entry);
+    index_by_process.emplace(entry->logInfo.process_name, entry);
+    index_by_pid.emplace(entry->logInfo.process_pid, entry);
+}
+
+LogEntry* LoggerEngine::logger_thread::add_entry(const LogEntry& entry)
+{
+    log_list.push_back(entry);
+    LogEntry* added = &log_list.back();
+    index_entry(added);
+    return added;
+}
+
+void LoggerEngine::logger_thread::clear_entries()
+{
+    log_list.clear();
+    index_by_port_complete.clear();
+    index_by_port_prefix.clear();
+    index_by_process.clear();
+    index_by_pid.clear();
+}
+
+static LogLevel parse_level(const std::string& s, size_t& text_start)
+{
+    text_start = 0;
+    if (s.empty() || s[0] != '[') return LOGLEVEL_UNDEFINED;
+    size_t end = s.find(']', 1);
+    if (end == std::string::npos) return LOGLEVEL_UNDEFINED;
+    text_start = end+1;
+
+    static const struct { const char* name; size_t len; loglLevelEnum level; } levels[] = {
+        { "TRACE",   5, LOGLEVEL_TRACE   },
+        { "DEBUG",   5, LOGLEVEL_DEBUG   },
+        { "INFO",    4, LOGLEVEL_INFO    },
+        { "WARNING", 7, LOGLEVEL_WARNING },
+        { "ERROR",   5, LOGLEVEL_ERROR   },
+        { "FATAL",   5, LOGLEVEL_FATAL   }
+    };
+    const char* level = s.c_str() + 1;
+    size_t size = end - 1;
+    for (const auto& l : levels)
     {
-        //yarp::os::Network::
+        for (size_t i = 0; i + l.len <= size; i++)
+        {
+            if (level[i] == l.name[0] && strncmp(level + i, l.name, l.len) == 0) return l.level;
+        }
     }
+    return LOGLEVEL_UNDEFINED;
+}
 
-    //yarp::os::SystemClock::delaySystem(0.001);
-    //if (logger_port.getInputCount()>0)
+void LoggerEngine::logger_thread::run()
+{
+    struct received_message
     {
-        int bufferport_size = logger_port.getPendingReads();
+        std::string  header;
+        MessageEntry body;
+    };
 
-        while (bufferport_size>0)
-        {
-            std::time_t machine_current_time = std::time(nullptr);
-            char machine_current_time_c [50];
-            //strftime(machine_current_time_s, 20, "%Y-%m-%d %H:%M:%S", localtime(&machine_current_time));
-            static double d_time_i = yarp::os::SystemClock::nowSystem();
-            double d_time = yarp::os::SystemClock::nowSystem() - d_time_i;
-            sprintf(machine_current_time_c,"%f",d_time);
-            string machine_current_time_s = string(machine_current_time_c);
-
-            Bottle *b = logger_port.read(); //this is blocking
-            bufferport_size = logger_port.getPendingReads();
-
-            if (b==nullptr)
-            {
-                fprintf (stderr, "ERROR: something strange happened here, bufferport_size = %d!\n",bufferport_size);
-                return;
-            }
+    // Messages are parsed without holding the mutex, and then stored all
+    // together, so that readers are blocked once for each batch
+    std::vector<received_message> received;
+    std::time_t machine_current_time = std::time(nullptr);
 
-            if (b->size()!=2)
-            {
-                fprintf (stderr, "ERROR: unknown log format!\n");
-                unknown_format_received++;
-                continue;
-            }
+    int bufferport_size = logger_port.getPendingReads();
+    while (bufferport_size>0)
+    {
+        char machine_current_time_c [50];
+        static double d_time_i = yarp::os::SystemClock::nowSystem();
+        double d_time = yarp::os::SystemClock::nowSystem() - d_time_i;
+        sprintf(machine_current_time_c,"%f",d_time);
 
-            std::string bottlestring = b->toString();
-            std::string header;
+        Bottle *b = logger_port.read(); //this is blocking
+        bufferport_size = logger_port.getPendingReads();
 
-            if (b->get(0).isString())
-            {
-                header = b->get(0).asString();
-            }
-            else
-            {
-                fprintf(stderr, "ERROR: unknown log format!\n");
-                unknown_format_received++;
-                continue;
-            }
+        if (b==nullptr)
+        {
+            fprintf (stderr, "ERROR: something strange happened here, bufferport_size = %d!\n",bufferport_size);
+            break;
+        }
 
-            MessageEntry body;
-            std::string s;
+        if (b->size()!=2 || !b->get(0).isString() || !b->get(1).isString())
+        {
+            fprintf (stderr, "ERROR: unknown log format!\n");
+            unknown_format_received++;
+            continue;
+        }
 
-            if (b->get(1).isString())
-            {
-                s = b->get(1).asString();
-            }
-            else
-            {
-                fprintf(stderr, "ERROR: unknown log format!\n");
-                unknown_format_received++;
-                continue;
-            }
+        const std::string& header = b->get(0).asString();
+        const std::string& s = b->get(1).asString();
+        if (header.size() < 2)
+        {
+            fprintf (stderr, "ERROR: unknown log format!\n");
+            unknown_format_received++;
+            continue;
+        }
 
-            body.text = s;
-            char ttstr [20];
-            static int count=0;
-            sprintf(ttstr,"%d",count++);
-            body.yarprun_timestamp = string(ttstr);
-            body.local_timestamp   = machine_current_time_s;
-            body.level = LOGLEVEL_UNDEFINED;
-
-            size_t str = s.find('[',0);
-            size_t end = s.find(']',0);
-            if (str==std::string::npos || end==std::string::npos )
-            {
-                body.level = LOGLEVEL_UNDEFINED;
-            }
-            else if (str==0)
-            {
-                std::string level = s.substr(str,end+1);
-                body.level = LOGLEVEL_UNDEFINED;
-                if      (level.find("TRACE")!=std::string::npos)   body.level = LOGLEVEL_TRACE;
-                else if (level.find("DEBUG")!=std::string::npos)   body.level = LOGLEVEL_DEBUG;
-                else if (level.find("INFO")!=std::string::npos)    body.level = LOGLEVEL_INFO;
-                else if (level.find("WARNING")!=std::string::npos) body.level = LOGLEVEL_WARNING;
-                else if (level.find("ERROR")!=std::string::npos)   body.level = LOGLEVEL_ERROR;
-                else if (level.find("FATAL")!=std::string::npos)   body.level = LOGLEVEL_FATAL;
-                body.text = s.substr(end+1);
-            }
-            else
-            {
-                body.level = LOGLEVEL_UNDEFINED;
-            }
+        received_message msg;
+        char ttstr [20];
+        static int count=0;
+        sprintf(ttstr,"%d",count++);
+        msg.body.yarprun_timestamp = ttstr;
+        msg.body.local_timestamp   = machine_current_time_c;
+
+        size_t text_start;
+        msg.body.level = parse_level(s, text_start);
+        msg.body.text = (text_start == 0) ? s : s.substr(text_start);
+
+        int level = msg.body.level.toInt();
+        if (level == LOGLEVEL_UNDEFINED && listen_to_LOGLEVEL_UNDEFINED == false) {continue;}
+        if (level == LOGLEVEL_TRACE     && listen_to_LOGLEVEL_TRACE     == false) {continue;}
+        if (level == LOGLEVEL_DEBUG     && listen_to_LOGLEVEL_DEBUG     == false) {continue;}
+        if (level == LOGLEVEL_INFO      && listen_to_LOGLEVEL_INFO      == false) {continue;}
+        if (level == LOGLEVEL_WARNING   && listen_to_LOGLEVEL_WARNING   == false) {continue;}
+        if (level == LOGLEVEL_ERROR     && listen_to_LOGLEVEL_ERROR     == false) {continue;}
+        if (level == LOGLEVEL_FATAL     && listen_to_LOGLEVEL_FATAL     == false) {continue;}
+
+        msg.header = header;
+        received.push_back(std::move(msg));
+    }
 
-            if (body.level == LOGLEVEL_UNDEFINED && listen_to_LOGLEVEL_UNDEFINED == false) {continue;}
-            if (body.level == LOGLEVEL_TRACE     && listen_to_LOGLEVEL_TRACE     == false) {continue;}
-            if (body.level == LOGLEVEL_DEBUG     && listen_to_LOGLEVEL_DEBUG     == false) {continue;}
-            if (body.level == LOGLEVEL_INFO      && listen_to_LOGLEVEL_INFO      == false) {continue;}
-            if (body.level == LOGLEVEL_WARNING   && listen_to_LOGLEVEL_WARNING   == false) {continue;}
-            if (body.level == LOGLEVEL_ERROR     && listen_to_LOGLEVEL_ERROR     == false) {continue;}
-            if (body.level == LOGLEVEL_FATAL     && listen_to_LOGLEVEL_FATAL     == false) {continue;}
+    if (received.empty()) return;
 
-            this->mutex.lock();
+    this->mutex.lock();
+    std::string port_complete;
+    for (auto& msg : received)
+    {
+        port_complete.assign(msg.header, 1, msg.header.size()-2);
+        LogEntry* found = find_entry(index_by_port_complete, port_complete);
+        if (found == nullptr)
+        {
+            // first message from this port: split the name only once
             LogEntry entry;
-            entry.logInfo.port_complete = header;
-            entry.logInfo.port_complete.erase(0,1);
-            entry.logInfo.port_complete.erase(entry.logInfo.port_complete.size()-1);
-            std::istringstream iss(header);
+            entry.logInfo.port_complete = port_complete;
+            std::istringstream iss(msg.header);
             std::string token;
             getline(iss, token, '/');
             getline(iss, token, '/'); entry.logInfo.port_system  = token;
             getline(iss, token, '/'); entry.logInfo.port_prefix  = "/"+ token;
             getline(iss, token, '/'); entry.logInfo.process_name = token;
-            getline(iss, token, '/'); entry.logInfo.process_pid  = token.erase(token.size()-1);
+            getline(iss, token, '/'); if (!token.empty()) token.erase(token.size()-1);
+            entry.logInfo.process_pid = token;
             if (entry.logInfo.port_system == "log" && listen_to_YARP_MESSAGES==false)    continue;
             if (entry.logInfo.port_system == "yarprunlog" && listen_to_YARPRUN_MESSAGES==false) continue;
+            if (log_list.size() >= log_list_max_size && log_list_max_size_enabled==true) continue;
 
-            std::list<LogEntry>::iterator it;
-            for (it = log_list.begin(); it != log_list.end(); it++)
+            yarp::os::Contact contact = yarp::os::Network::queryName(entry.logInfo.port_complete);
+            if (contact.isValid())
             {
-                if (it->logInfo.port_complete==entry.logInfo.port_complete)
-                {
-                    if (it->logging_enabled)
-                    {
-                        it->logInfo.setNewError(body.level);
-                        it->logInfo.last_update=machine_current_time;
-                        it->append_logEntry(body);
-                    }
-                    else
-                    {
-                        //just skipping this message
-                    }
-                    break;
-                }
+                entry.logInfo.ip_address = contact.getHost();
             }
-            if (it == log_list.end())
+            else
             {
-                if (log_list.size() < log_list_max_size || log_list_max_size_enabled==false )
-                {
-                    yarp::os::Contact contact = yarp::os::Network::queryName(entry.logInfo.port_complete);
-                    if (contact.isValid())
-                    {
-                        entry.logInfo.setNewError(body.level);
-                        entry.logInfo.ip_address = contact.getHost();
-                    }
-                    else
-                    {
-                        printf("ERROR: invalid contact: %s\n", entry.logInfo.port_complete.c_str());
-                    };
-                    entry.append_logEntry(body);
-                    entry.logInfo.last_update=machine_current_time;
-                    log_list.push_back(entry);
-                }
-                //else
-                //{
-                //    printf("WARNING: exceeded log_list_max_size=%d\n",log_list_max_size);
-                //}
-            }
-
-            this->mutex.unlock();
+                printf("ERROR: invalid contact: %s\n", entry.logInfo.port_complete.c_str());
+            };
+            found = add_entry(entry);
+        }
+        else
+        {
+            if (found->logInfo.port_system == "log" && listen_to_YARP_MESSAGES==false)    continue;
+            if (found->logInfo.port_system == "yarprunlog" && listen_to_YARPRUN_MESSAGES==false) continue;
+            if (!found->logging_enabled) continue;
         }
+        found->logInfo.setNewError(msg.body.level);
+        found->logInfo.last_update=machine_current_time;
+        found->append_logEntry(std::move(msg.body));
     }
-
+    this->mutex.unlock();
 }
 
 //public methods
@@ -490,39 +526,41 @@ void LoggerEngine::get_messages (std::list<MessageEntry>& messages)
     std::list<LogEntry>::iterator it;
     for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
     {
-        messages.insert(messages.end(), it->entry_list.begin(), it->entry_list.end());
+        for (long long i = it->first_sequence(); i < it->end_sequence(); i++)
+        {
+            messages.push_back(it->get_message(i));
+        }
     }
     log_updater->mutex.unlock();
 }
 
+// Copies the messages not read yet, or all of them if from_beginning is set
+static void read_new_messages (LogEntry* entry, std::list<MessageEntry>& messages, bool from_beginning)
+{
+    if (entry == nullptr) return;
+    if (entry->last_read_message==-1)
+    {
+        from_beginning=true;
+    }
+    long long i = entry->first_sequence();
+    if (from_beginning==false && entry->last_read_message > i)
+    {
+        i = entry->last_read_message;
+    }
+    long long end = entry->end_sequence();
+    for (; i<end; i++)
+    {
+        messages.push_back(entry->get_message(i));
+    }
+    entry->last_read_message=end;
+}
+
 void LoggerEngine::get_messages_by_port_prefix    (std::string  port,  std::list<MessageEntry>& messages,  bool from_beginning)
 {
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
-    {
-        if (it->logInfo.port_prefix == port)
-        {
-            //messages = (it->entry_list);
-            if (it->last_read_message==-1)
-            {
-                from_beginning=true;
-            }
-            if (from_beginning==true)
-            {
-                it->last_read_message = 0;
-            }
-            int i=it->last_read_message;
-            for (; i<(int)it->entry_list.size(); i++)
-            {
-                messages.push_back(it->entry_list[i]);
-            }
-            it->last_read_message=i;
-            break;
-        }
-    }
+    read_new_messages(log_updater->find_entry(log_updater->index_by_port_prefix, port), messages, from_beginning);
     log_updater->mutex.unlock();
 }
 
@@ -531,14 +569,10 @@ void LoggerEngine::clear_messages_by_port_complete    (std::string  port)
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
+    LogEntry* entry = log_updater->find_entry(log_updater->index_by_port_complete, port);
+    if (entry != nullptr)
     {
-        if (it->logInfo.port_complete == port)
-           {
-               it->clear_logEntries();
-               break;
-           }
+        entry->clear_logEntries();
     }
     log_updater->mutex.unlock();
 }
@@ -548,30 +582,7 @@ void LoggerEngine::get_messages_by_port_complete    (std::string  port,  std::li
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
-    {
-        if (it->logInfo.port_complete == port)
-        {
-            //messages = (it->entry_list);
-            if (it->last_read_message==-1)
-            {
-                from_beginning=true;
-            }
-            if (from_beginning==true)
-            {
-                it->last_read_message = 0;
-            }
-            int i=it->last_read_message;
-            int size = (int)it->entry_list.size();
-            for (; i<size; i++)
-            {
-                messages.push_back(it->entry_list[i]);
-            }
-            it->last_read_message=i;
-            break;
-        }
-    }
+    read_new_messages(log_updater->find_entry(log_updater->index_by_port_complete, port), messages, from_beginning);
     log_updater->mutex.unlock();
 }
 
@@ -580,29 +591,7 @@ void LoggerEngine::get_messages_by_process (std::string  process,  std::list<Mes
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
-    {
-        if (it->logInfo.process_name == process)
-        {
-            //messages = (it->entry_list);
-            if (it->last_read_message==-1)
-            {
-                from_beginning=true;
-            }
-            if (from_beginning==true)
-            {
-                it->last_read_message = 0;
-            }
-            int i=it->last_read_message;
-            for (; i<(int)it->entry_list.size(); i++)
-            {
-                messages.push_back(it->entry_list[i]);
-            }
-            it->last_read_message=i;
-            break;
-        }
-    }
+    read_new_messages(log_updater->find_entry(log_updater->index_by_process, process), messages, from_beginning);
     log_updater->mutex.unlock();
 }
 
@@ -611,33 +600,42 @@ void LoggerEngine::get_messages_by_pid     (std::string pid, std::list<MessageEn
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
+    read_new_messages(log_updater->find_entry(log_updater->index_by_pid, pid), messages, from_beginning);
+    log_updater->mutex.unlock();
+}
+
+size_t LoggerEngine::visit_messages_by_port_complete (const std::string& port,
+                                                      long long& cursor,
+                                                      const std::function<void(const MessageEntry&)>& visitor,
+                                                      unsigned int level_mask,
+                                                      const std::string& text)
+{
+    if (log_updater == nullptr) return 0;
+
+    size_t visited = 0;
+    log_updater->mutex.lock();
+    LogEntry* entry = log_updater->find_entry(log_updater->index_by_port_complete, port);
+    if (entry != nullptr)
     {
-        if (it->logInfo.process_pid == pid)
+        // messages older than the cursor may have been overwritten already
+        long long i = std::max(cursor, entry->first_sequence());
+        long long end = entry->end_sequence();
+        for (; i<end; i++)
         {
-            //messages = (it->entry_list);
-            if (it->last_read_message==-1)
-            {
-                from_beginning=true;
-            }
-            if (from_beginning==true)
-            {
-                it->last_read_message = 0;
-            }
-            int i=it->last_read_message;
-            for (; i<(int)it->entry_list.size(); i++)
-            {
-                messages.push_back(it->entry_list[i]);
-            }
-            it->last_read_message=i;
-            break;
+            const MessageEntry& message = entry->get_message(i);
+            LogLevel level = message.level;
+            if ((level_mask & (1u << level.toInt())) == 0) continue;
+            if (!text.empty() && message.text.find(text) == std::string::npos) continue;
+            visitor(message);
+            visited++;
         }
+        cursor = end;
     }
     log_updater->mutex.unlock();
+    return visited;
 }
 
-const std::list<MessageEntry> filter_by_level (int level, const std::list<MessageEntry>& messages)
+std::list<MessageEntry> LoggerEngine::filter_by_level (int level, const std::list<MessageEntry>& messages)
 {
     std::list<MessageEntry> ret;
     std::list<MessageEntry>::const_iterator it;
@@ -720,10 +718,10 @@ bool LoggerEngine::export_log_to_text_file   (std::string  filename, std::string
             ofstream file1;
             file1.open(filename.c_str());
             if (file1.is_open() == false) {log_updater->mutex.unlock(); return false;}
-            std::vector<MessageEntry>::iterator it1;
-            for (it1 = it->entry_list.begin(); it1 != it->entry_list.end(); it1++)
+            for (long long i = it->first_sequence(); i < it->end_sequence(); i++)
             {
-                file1 << it1->yarprun_timestamp << " " << it1->local_timestamp << " " << it1->level.toString() << " " << it1->text << " " << std::endl;
+                const MessageEntry& m = it->get_message(i);
+                file1 << m.yarprun_timestamp << " " << m.local_timestamp << " " << m.level.toString() << " " << m.text << " " << std::endl;
             }
             file1.close();
         }
@@ -766,15 +764,16 @@ bool LoggerEngine::save_all_logs_to_file   (std::string  filename)
         file1 << it->logInfo.get_number_of_errors() << std::endl;
         file1 << it->logInfo.get_number_of_fatals() << std::endl;
         file1 << it->logInfo.logsize << std::endl;
-        file1 << it->entry_list.size() << std::endl;
-        std::vector<MessageEntry>::iterator it1;
-        for (it1 = it->entry_list.begin(); it1 != it->entry_list.end(); it1++)
+        file1 << it->end_sequence() - it->first_sequence() << std::endl;
+        for (long long i = it->first_sequence(); i < it->end_sequence(); i++)
         {
-            file1 << it1->yarprun_timestamp << std::endl;
-            file1 << it1->local_timestamp << std::endl;
-            file1 << it1->level.toInt() << std::endl;
+            const MessageEntry& m = it->get_message(i);
+            LogLevel level = m.level;
+            file1 << m.yarprun_timestamp << std::endl;
+            file1 << m.local_timestamp << std::endl;
+            file1 << level.toInt() << std::endl;
             file1 << start_string;
-            for (unsigned int s=0; s< it1->text.size(); s++) file1.put(it1->text[s]);
+            file1.write(m.text.data(), m.text.size());
             file1 << end_string <<endl;
         }
     }
@@ -829,7 +828,7 @@ bool LoggerEngine::load_all_logs_from_file   (std::string  filename)
     {
         int size_log_list;
         file1 >> size_log_list;
-        log_updater->log_list.clear();
+        log_updater->clear_entries();
         for (int i=0; i< size_log_list; i++)
         {
             LogEntry l_tmp;
@@ -875,9 +874,9 @@ bool LoggerEngine::load_all_logs_from_file   (std::string  filename)
                 file1.seekg(end_p+end_string_size);
                 m_tmp.text=buff;
                 delete [] buff;
-                l_tmp.entry_list.push_back(m_tmp);
+                l_tmp.append_logEntry(m_tmp);
             }
-            log_updater->log_list.push_back(l_tmp);
+            log_updater->add_entry(l_tmp);
         }
     }
     file1.close();
@@ -934,7 +933,7 @@ bool LoggerEngine::clear()
 {
     if (log_updater == nullptr) return false;
     log_updater->mutex.lock();
-    log_updater->log_list.clear();
+    log_updater->clear_entries();
     log_updater->mutex.unlock();
     return true;
 }
@@ -944,14 +943,10 @@ void LoggerEngine::set_log_enable_by_port_complete (std::string  port, bool enab
     if (log_updater == nullptr) return;
 
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
+    LogEntry* entry = log_updater->find_entry(log_updater->index_by_port_complete, port);
+    if (entry != nullptr)
     {
-        if (it->logInfo.port_complete == port)
-           {
-               it->logging_enabled=enable;
-               break;
-           }
+        entry->logging_enabled=enable;
     }
     log_updater->mutex.unlock();
 }
@@ -962,14 +957,10 @@ bool  LoggerEngine::get_log_enable_by_port_complete (std::string  port)
 
     bool enabled=false;
     log_updater->mutex.lock();
-    std::list<LogEntry>::iterator it;
-    for (it = log_updater->log_list.begin(); it != log_updater->log_list.end(); it++)
+    LogEntry* entry = log_updater->find_entry(log_updater->index_by_port_complete, port);
+    if (entry != nullptr)
     {
-        if (it->logInfo.port_complete == port)
-           {
-               enabled=it->logging_enabled;
-               break;
-           }
+        enabled=entry->logging_enabled;
     }
     log_updater->mutex.unlock();
     return enabled;
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_MANAGER_LAUNCHGRAPH
+#define YARP_MANAGER_LAUNCHGRAPH
+
+#include <yarp/manager/ymm-types.h>
+#include <yarp/manager/application.h>
+#include <yarp/manager/executable.h>
+#include <yarp/manager/utility.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace yarp {
+namespace manager {
+
+/**
+ * Class LaunchGraph
+ *
+ * The executables of an application, each one with the executables
+ * opening the ports it waits for before being started.
+ */
+class LaunchGraph
+{
+public:
+    /**
+     * An executable in the launch graph of the application
+     */
+    struct Node
+    {
+        std::vector<size_t> parents;        // executables opening the ports this one waits for
+        std::vector<std::string> ports;     // the ports, one for each parent
+        bool started;
+        bool starting;                      // seen in the READY state
+        bool done;
+        bool failed;
+        double startTime;
+        double doneTime;
+        Node() : started(false), starting(false), done(false),
+                 failed(false), startTime(0.0), doneTime(0.0) {}
+    };
+
+    /**
+     * Builds the graph of the executables: a module waits for the modules
+     * opening its resources, and the receiver of a connection with
+     * priority for the sender. The dependencies closing a cycle are
+     * dropped and reported to the logger.
+     */
+    void build(ExecutablePContainer& runnables, CnnContainer& connections,
+               ErrorLogger* logger);
+
+    /**
+     * True if the executable can be started: the parents that did not
+     * fail are running and have opened their ports, or they are running
+     * since more than timeout seconds.
+     */
+    bool launchable(size_t id, double now, double timeout,
+                    const std::function<bool(const std::string&)>& exists);
+
+    size_t size() const { return nodes.size(); }
+    Node& operator[](size_t id) { return nodes[id]; }
+
+private:
+    std::vector<Node> nodes;
+
+    void breakCycles(ExecutablePContainer& runnables, size_t id,
+                     std::vector<int>& marks, ErrorLogger* logger);
+};
+
+} // namespace manager
+} // namespace yarp
+
+
+#endif // YARP_MANAGER_LAUNCHGRAPH
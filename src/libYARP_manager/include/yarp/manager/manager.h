@@ -14,6 +14,7 @@
 #include <yarp/manager/utility.h>
 #include <yarp/manager/executable.h>
 #include <yarp/manager/yarpbroker.h>
+#include <yarp/manager/launchgraph.h>
 
 namespace yarp {
 namespace manager {
@@ -100,6 +101,8 @@ public:
     void disableAutoDependency(void) { bAutoDependancy = false; }
     void enableWatchDog(void) { bWithWatchDog = true; }
     void disableWatchod(void) { bWithWatchDog = false; }
+    void setMaxParallelStarts(unsigned int n) { nMaxParallelStarts = n; }
+    unsigned int getMaxParallelStarts(void) { return nMaxParallelStarts; }
     bool exportDependencyGraph(const char* szFileName) {
         return knowledge.exportAppGraph(szFileName);
     }
@@ -120,6 +123,7 @@ protected:
 
 private:
     bool bWithWatchDog;
+    unsigned int nMaxParallelStarts;
     bool bAutoDependancy;
     bool bAutoConnect;
     bool bRestricted;
@@ -147,6 +151,7 @@ private:
     bool timeout(double base, double t);
     bool updateResource(GenericResource* resource);
     Broker* createBroker(Module* module);
+    void reportCriticalPath(LaunchGraph& graph, double base);
     bool removeBroker(Executable* exe);
 };
 
@@ -87,6 +87,12 @@ bool compareString(const char* szFirst, const char* szSecond);
 void trimString(std::string& str);
 OS strToOS(const char* szOS);
 
+/**
+ * Sleeps before probing again a condition which is waited since base.
+ * Probes are frequent at the beginning and back off to one per second.
+ */
+void probeDelay(double base);
+
 class Graph;
 bool exportDotGraph(Graph& graph, const char* szFileName);
 
@@ -51,6 +51,8 @@ public:
                         const char* carrier, bool persist=false) override;
      bool disconnect(const char* from, const char* to, const char* carrier) override;
      bool rmconnect(const char* from, const char* to);
+     bool connectMany(std::vector<yarp::os::NetworkBase::ConnectionRequest>& requests);
+     bool disconnectMany(std::vector<yarp::os::NetworkBase::ConnectionRequest>& requests);
      int running(void) override;
      bool exists(const char* port) override;
      const char* requestRpc(const char* szport, const char* request, double timeout) override;
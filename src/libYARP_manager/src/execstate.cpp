@@ -167,7 +167,7 @@ bool Ready::checkResources(bool silent)
 
 bool Ready::timeout(double base, double timeout)
 {
-    yarp::os::SystemClock::delaySystem(1.0);
+    probeDelay(base);
     if((yarp::os::SystemClock::nowSystem()-base) > timeout)
         return true;
     return false;
@@ -182,9 +182,10 @@ void Ready::startModule()
     if(executable->autoConnect())
     {
         bAborted = false;
+        double base = yarp::os::SystemClock::nowSystem();
         while(!checkPriorityPorts())
         {
-            yarp::os::SystemClock::delaySystem(1.0);
+            probeDelay(base);
             if(bAborted) return;
         }
     }
@@ -288,9 +289,10 @@ void Connecting::connectAllPorts()
          *  wait for required ports if auto connecte is enabled
          */
         bAborted = false;
+        double base = yarp::os::SystemClock::nowSystem();
         while(!checkNormalPorts())
         {
-            yarp::os::SystemClock::delaySystem(1.0);
+            probeDelay(base);
             if(bAborted) return;
         }
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/manager/launchgraph.h>
+
+#include <map>
+
+
+using namespace yarp::manager;
+using namespace std;
+
+
+void LaunchGraph::build(ExecutablePContainer& runnables, CnnContainer& connections,
+                        ErrorLogger* logger)
+{
+    nodes.assign(runnables.size(), Node());
+
+    // ports opened by each module, under its prefix
+    std::map<string, size_t> owners;
+    for(size_t i=0; i<runnables.size(); i++)
+    {
+        Module* module = runnables[i]->getModule();
+        if(!module)
+            continue;
+        string prefix = module->getPrefix();
+        for(int j=0; j<module->outputCount(); j++)
+            owners.insert(std::make_pair(prefix + module->getOutputAt(j).getPort(), i));
+        for(int j=0; j<module->inputCount(); j++)
+            owners.insert(std::make_pair(prefix + module->getInputAt(j).getPort(), i));
+    }
+
+    auto addDependency = [&](size_t id, const string& port) {
+        std::map<string, size_t>::iterator owner = owners.find(port);
+        if((owner == owners.end()) || (owner->second == id))
+            return;
+        nodes[id].parents.push_back(owner->second);
+        nodes[id].ports.push_back(port);
+    };
+
+    // resources of a module opened by another one
+    for(size_t i=0; i<runnables.size(); i++)
+    {
+        ResourceIterator itr;
+        for(itr=runnables[i]->getResources().begin();
+            itr!=runnables[i]->getResources().end(); itr++)
+            addDependency(i, (*itr).getPort());
+    }
+
+    // the receiver of a connection with priority waits for the sender
+    CnnIterator cnn;
+    for(cnn=connections.begin(); cnn!=connections.end(); cnn++)
+    {
+        if(!(*cnn).withPriority())
+            continue;
+        std::map<string, size_t>::iterator receiver = owners.find((*cnn).to());
+        if(receiver != owners.end())
+            addDependency(receiver->second, (*cnn).from());
+    }
+
+    std::vector<int> marks(nodes.size(), 0);
+    for(size_t i=0; i<nodes.size(); i++)
+        if(marks[i] == 0)
+            breakCycles(runnables, i, marks, logger);
+}
+
+void LaunchGraph::breakCycles(ExecutablePContainer& runnables, size_t id,
+                              std::vector<int>& marks, ErrorLogger* logger)
+{
+    // depth-first visit: a parent still being visited closes a cycle
+    marks[id] = 1;
+    Node& node = nodes[id];
+    for(size_t i=0; i<node.parents.size(); )
+    {
+        size_t parent = node.parents[i];
+        if(marks[parent] == 1)
+        {
+            OSTRINGSTREAM msg;
+            msg<<runnables[id]->getCommand()<<" and "<<runnables[parent]->getCommand();
+            msg<<" wait for each other; "<<node.ports[i]<<" is ignored while starting them.";
+            logger->addWarning(msg);
+            node.parents.erase(node.parents.begin() + i);
+            node.ports.erase(node.ports.begin() + i);
+            continue;
+        }
+        if(marks[parent] == 0)
+            breakCycles(runnables, parent, marks, logger);
+        i++;
+    }
+    marks[id] = 2;
+}
+
+bool LaunchGraph::launchable(size_t id, double now, double timeout,
+                             const std::function<bool(const std::string&)>& exists)
+{
+    Node& node = nodes[id];
+    double since = 0.0;
+    for(size_t i=0; i<node.parents.size(); i++)
+    {
+        Node& parent = nodes[node.parents[i]];
+        if(!parent.done)
+            return false;
+        // the module will report by itself the ports of a failed parent
+        if(parent.failed)
+            continue;
+        since = (since > parent.doneTime) ? since : parent.doneTime;
+    }
+
+    // the parents are running, but may not have opened their ports yet
+    if(now - since > timeout)
+        return true;
+    for(size_t i=0; i<node.ports.size(); i++)
+        if(!nodes[node.parents[i]].failed && !exists(node.ports[i]))
+            return false;
+    return true;
+}
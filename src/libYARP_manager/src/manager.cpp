@@ -21,10 +21,14 @@
 
 #include <yarp/os/impl/NameClient.h>
 
+#include <iomanip>
+#include <map>
+
 
 #define RUN_TIMEOUT             10      // Run timeout in seconds
 #define STOP_TIMEOUT            30      // Stop timeout in seconds
 #define KILL_TIMEOUT            10      // kill timeout in seconds
+#define PARALLEL_STARTS         8       // modules being started at once on each host
 
 #define BROKER_LOCAL            "local"
 #define BROKER_YARPRUN          "yarprun"
@@ -43,6 +47,7 @@ Manager::Manager(bool withWatchDog) : MEvent()
 {
     logger  = ErrorLogger::Instance();
     bWithWatchDog = withWatchDog;
+    nMaxParallelStarts = PARALLEL_STARTS;
     bAutoDependancy = false;
     bAutoConnect = false;
     bRestricted = false;
@@ -56,6 +61,7 @@ Manager::Manager(const char* szModPath, const char* szAppPath,
 {
     logger  = ErrorLogger::Instance();
     bWithWatchDog = withWatchDog;
+    nMaxParallelStarts = PARALLEL_STARTS;
     bAutoDependancy = false;
     bAutoConnect = false;
     bRestricted = false;
@@ -801,25 +807,78 @@ bool Manager::run()
             logger->addWarning("Some of external ports dependency are not satisfied.");
     }
 
-    ExecutablePIterator itr;
-    double wait = 0.0;
-    for(itr=runnables.begin(); itr!=runnables.end(); itr++)
-    {
-        if(bAutoConnect)
-            (*itr)->enableAutoConnect();
-        else
-            (*itr)->disableAutoConnect();
-        (*itr)->start();
-        yarp::os::SystemClock::delaySystem(0.2);
-        wait = (wait > (*itr)->getPostExecWait()) ? wait : (*itr)->getPostExecWait();
-    }
+    /**
+     * Modules are started as soon as the ports they wait for exist,
+     * and at most nMaxParallelStarts of them are being started on
+     * each host at the same time.
+     */
+    LaunchGraph graph;
+    graph.build(runnables, connections, logger);
+    auto exists = [this](const string& port) { return connector.exists(port.c_str()); };
 
-    // waiting for running
+    std::map<string, unsigned int> starting;
+    size_t done = 0;
     double base = yarp::os::SystemClock::nowSystem();
-    while(!timeout(base, wait + RUN_TIMEOUT))
-        if(allRunning()) break;
+    double probe = base;
+    while(done < runnables.size())
+    {
+        double now = yarp::os::SystemClock::nowSystem();
+        for(size_t i=0; i<runnables.size(); i++)
+        {
+            LaunchGraph::Node& node = graph[i];
+            string host = runnables[i]->getHost();
+            if(node.started ||
+               (nMaxParallelStarts && (starting[host] >= nMaxParallelStarts)) ||
+               !graph.launchable(i, now, RUN_TIMEOUT, exists))
+                continue;
+
+            if(bAutoConnect)
+                runnables[i]->enableAutoConnect();
+            else
+                runnables[i]->disableAutoConnect();
+            node.started = true;
+            node.startTime = now;
+            if(runnables[i]->start())
+                starting[host]++;
+            else
+            {
+                node.done = node.failed = true;
+                node.doneTime = now;
+                done++;
+            }
+            probe = now;
+        }
+
+        probeDelay(probe);
+
+        for(size_t i=0; i<runnables.size(); i++)
+        {
+            LaunchGraph::Node& node = graph[i];
+            if(!node.started || node.done)
+                continue;
+            RSTATE st = runnables[i]->state();
+            now = yarp::os::SystemClock::nowSystem();
+            if(st == READY)
+                node.starting = true;
+            bool up = (st == RUNNING) || (st == CONNECTING);
+            // a module found dead before being started is still in its previous run
+            bool failed = (st == DEAD && node.starting) ||
+                          (now - node.startTime > runnables[i]->getPostExecWait() + RUN_TIMEOUT);
+            if(up || failed)
+            {
+                node.done = true;
+                node.failed = !up;
+                node.doneTime = now;
+                starting[runnables[i]->getHost()]--;
+                done++;
+                probe = now;
+            }
+        }
+    }
+    reportCriticalPath(graph, base);
 
     // starting the watchdog if needed
+    ExecutablePIterator itr;
     if(bWithWatchDog) {
         for(itr=runnables.begin(); itr!=runnables.end(); itr++)
             (*itr)->startWatchDog();
@@ -858,6 +917,44 @@ bool Manager::run()
     return true;
 }
 
+void Manager::reportCriticalPath(LaunchGraph& graph, double base)
+{
+    // the last module to run, and the chain of modules it waited for
+    size_t last = graph.size();
+    for(size_t i=0; i<graph.size(); i++)
+        if(!graph[i].failed && ((last == graph.size()) || (graph[i].doneTime > graph[last].doneTime)))
+            last = i;
+    if(last == graph.size())
+        return;
+
+    std::vector<size_t> path;
+    size_t id = last;
+    while(true)
+    {
+        path.push_back(id);
+        LaunchGraph::Node& node = graph[id];
+        size_t next = graph.size();
+        for(size_t i=0; i<node.parents.size(); i++)
+            if((next == graph.size()) || (graph[node.parents[i]].doneTime > graph[next].doneTime))
+                next = node.parents[i];
+        if(next == graph.size())
+            break;
+        id = next;
+    }
+
+    OSTRINGSTREAM msg;
+    msg<<std::fixed<<std::setprecision(1);
+    msg<<"Application started in "<<graph[last].doneTime - base<<" s. Critical path:";
+    for(size_t i=path.size(); i>0; i--)
+    {
+        LaunchGraph::Node& node = graph[path[i-1]];
+        msg<<((i == path.size()) ? " " : " -> ");
+        msg<<runnables[path[i-1]]->getCommand()<<" on "<<runnables[path[i-1]]->getHost();
+        msg<<" ("<<node.startTime - base<<" - "<<node.doneTime - base<<" s)";
+    }
+    yInfo()<<msg.str();
+}
+
 bool Manager::stop(unsigned int id, bool async)
 {
     if(runnables.empty())
@@ -889,10 +986,7 @@ bool Manager::stop()
 
     ExecutablePIterator itr;
     for(itr=runnables.begin(); itr!=runnables.end(); itr++)
-    {
         (*itr)->stop();
-        yarp::os::SystemClock::delaySystem(0.2);
-    }
 
     double base = yarp::os::SystemClock::nowSystem();
     while(!timeout(base, STOP_TIMEOUT))
@@ -947,10 +1041,7 @@ bool Manager::kill()
 
     ExecutablePIterator itr;
     for(itr=runnables.begin(); itr!=runnables.end(); itr++)
-    {
         (*itr)->kill();
-        yarp::os::SystemClock::delaySystem(0.2);
-    }
 
     double base = yarp::os::SystemClock::nowSystem();
     while(!timeout(base, KILL_TIMEOUT))
@@ -1021,17 +1112,39 @@ bool Manager::connect()
 {
     //YarpBroker connector;
     //connector.init();
+    std::vector<yarp::os::NetworkBase::ConnectionRequest> requests;
     CnnIterator cnn;
     for(cnn=connections.begin(); cnn!=connections.end(); cnn++) {
-        if( !connector.connect((*cnn).from(), (*cnn).to(),
-                               (*cnn).carrier(), (*cnn).isPersistent()) )
+        // persistent connections are made through the name server
+        if(!(*cnn).isPersistent())
+            requests.push_back(yarp::os::NetworkBase::ConnectionRequest((*cnn).from(),
+                                                                        (*cnn).to(),
+                                                                        (*cnn).carrier()));
+        else if( !connector.connect((*cnn).from(), (*cnn).to(),
+                                    (*cnn).carrier(), true) )
             {
                 logger->addError(connector.error());
                 //cout<<connector.error()<<endl;
                 if(bRestricted)
                     return false;
             }
+    }
 
+    // connections which were already there are not an error
+    bool ret = connector.connectMany(requests);
+    for(size_t i=0; !ret && i<requests.size(); i++)
+        if(!requests[i].ok && !connector.connected(requests[i].src.c_str(),
+                                                   requests[i].dest.c_str(),
+                                                   requests[i].carrier.c_str()))
+        {
+            OSTRINGSTREAM msg;
+            msg<<"cannot connect "<<requests[i].src<<" to "<<requests[i].dest;
+            logger->addError(msg);
+            if(bRestricted)
+                return false;
+        }
+
+    for(cnn=connections.begin(); cnn!=connections.end(); cnn++) {
         // setting the connection Qos if specified
         if(! connector.setQos((*cnn).from(), (*cnn).to(),
                          (*cnn).qosFrom(), (*cnn).qosTo())) {
@@ -1069,15 +1182,28 @@ bool Manager::disconnect()
 {
     //YarpBroker connector;
     //connector.init();
+    std::vector<yarp::os::NetworkBase::ConnectionRequest> requests;
     CnnIterator cnn;
     for(cnn=connections.begin(); cnn!=connections.end(); cnn++)
-        if( !connector.disconnect((*cnn).from(), (*cnn).to(), (*cnn).carrier()) )
-            {
-                logger->addError(connector.error());
-                //cout<<connector.error()<<endl;
-                return false;
-            }
-    return true;
+        requests.push_back(yarp::os::NetworkBase::ConnectionRequest((*cnn).from(),
+                                                                    (*cnn).to(),
+                                                                    (*cnn).carrier()));
+    if(connector.disconnectMany(requests))
+        return true;
+
+    // connections which did not exist are not an error
+    bool ret = true;
+    for(size_t i=0; i<requests.size(); i++)
+        if(!requests[i].ok && connector.connected(requests[i].src.c_str(),
+                                                  requests[i].dest.c_str(),
+                                                  requests[i].carrier.c_str()))
+        {
+            OSTRINGSTREAM msg;
+            msg<<"cannot disconnect "<<requests[i].src<<" from "<<requests[i].dest;
+            logger->addError(msg);
+            ret = false;
+        }
+    return ret;
 }
 
 
@@ -1167,21 +1293,28 @@ bool Manager::connectExtraPorts()
         if(checkPortsAvailable(&connector))
             break;
 
+    std::vector<yarp::os::NetworkBase::ConnectionRequest> requests;
     CnnIterator cnn;
     for(cnn=connections.begin(); cnn!=connections.end(); cnn++)
-    {
-        //if(!(*cnn).owner() )
-        //{
-            if( !connector.connect((*cnn).from(), (*cnn).to(),
-                                   (*cnn).carrier()) )
-            {
-                logger->addError(connector.error());
-                //cout<<connector.error()<<endl;
-                return false;
-            }
-       //}
-    }
-    return true;
+        requests.push_back(yarp::os::NetworkBase::ConnectionRequest((*cnn).from(),
+                                                                    (*cnn).to(),
+                                                                    (*cnn).carrier()));
+    if(connector.connectMany(requests))
+        return true;
+
+    // connections which were already there are not an error
+    bool ret = true;
+    for(size_t i=0; i<requests.size(); i++)
+        if(!requests[i].ok && !connector.connected(requests[i].src.c_str(),
+                                                   requests[i].dest.c_str(),
+                                                   requests[i].carrier.c_str()))
+        {
+            OSTRINGSTREAM msg;
+            msg<<"cannot connect "<<requests[i].src<<" to "<<requests[i].dest;
+            logger->addError(msg);
+            ret = false;
+        }
+    return ret;
 }
 
 bool Manager::running(unsigned int id)
@@ -1278,7 +1411,7 @@ bool Manager::detachStdout(unsigned int id)
 
 bool Manager::timeout(double base, double t)
 {
-    yarp::os::SystemClock::delaySystem(1.0);
+    probeDelay(base);
     if((yarp::os::SystemClock::nowSystem()-base) > t)
         return true;
     return false;
@@ -12,6 +12,8 @@
 #include <yarp/manager/application.h>
 #include <yarp/manager/resource.h>
 
+#include <yarp/os/SystemClock.h>
+
 #include <cstdio>
 #include <fstream>
 
@@ -320,6 +322,17 @@ bool yarp::manager::compareString(const char* szFirst, const char* szSecond)
     return false;
 }
 
+void yarp::manager::probeDelay(double base)
+{
+    double elapsed = yarp::os::SystemClock::nowSystem() - base;
+    double delay = elapsed / 4.0;
+    if(delay < 0.05)
+        delay = 0.05;
+    if(delay > 1.0)
+        delay = 1.0;
+    yarp::os::SystemClock::delaySystem(delay);
+}
+
 void yarp::manager::trimString(string& str)
 {
     string::size_type pos = str.find_last_not_of(' ');
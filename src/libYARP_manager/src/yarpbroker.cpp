@@ -505,6 +505,22 @@ bool YarpBroker::disconnect(const char* from, const char* to, const char* carrie
 
 }
 
+bool YarpBroker::connectMany(std::vector<NetworkBase::ConnectionRequest>& requests)
+{
+    ContactStyle style;
+    style.quiet = true;
+    style.timeout = CONNECTION_TIMEOUT;
+    return NetworkBase::connectMany(requests, style);
+}
+
+bool YarpBroker::disconnectMany(std::vector<NetworkBase::ConnectionRequest>& requests)
+{
+    ContactStyle style;
+    style.quiet = true;
+    style.timeout = CONNECTION_TIMEOUT;
+    return NetworkBase::disconnectMany(requests, style);
+}
+
 bool YarpBroker::exists(const char* szport)
 {
     ContactStyle style;
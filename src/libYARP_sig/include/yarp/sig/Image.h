@@ -86,6 +86,15 @@ class YARP_sig_API yarp::sig::Image : public yarp::os::Portable {
 
 public:
 
+    /**
+     * Filters available for scaled copies.
+     */
+    enum ScaleFilter {
+        SCALE_NEAREST,  ///< nearest pixel, fast but low quality
+        SCALE_BILINEAR, ///< linear interpolation of the 4 nearest pixels
+        SCALE_AREA      ///< average of the pixels covered, best for shrinking
+    };
+
     /**
      * Default constructor.
      * Creates an empty image.
@@ -131,6 +140,20 @@ public:
     bool copy(const Image& alt, size_t w, size_t h);
 
 
+    /**
+     * Scaled copy with a given filter.
+     * Clones the content of another image, resized with the filter
+     * given.  If the pixel codes differ, the conversion is done while
+     * scaling.  Filters other than SCALE_NEAREST are only applied to
+     * pixels made of channels, Bayer and YUV images use the nearest pixel.
+     * @param alt the image to copy
+     * @param w target width for image
+     * @param h target height for image
+     * @param filter the filter used to compute the pixels
+     */
+    bool copy(const Image& alt, size_t w, size_t h, ScaleFilter filter);
+
+
     /**
      * Gets width of image in pixels.
      * @return the width of the image in pixels (0 if no image present)
@@ -46,6 +46,16 @@ namespace yarp {
             bool YARP_sig_API write(const ImageOf<PixelMono>& src,  const std::string& dest, image_fileformat format = FORMAT_PGM);
             bool YARP_sig_API write(const ImageOf<PixelFloat>& src, const std::string& dest, image_fileformat format = FORMAT_NUMERIC);
             bool YARP_sig_API write(const Image& src,               const std::string& dest, image_fileformat format = FORMAT_PPM);
+
+            /**
+             * Hint that the given file is going to be read soon, so that
+             * the operating system can start loading it in background.
+             * Useful when reading sequences of images, e.g. prefetching
+             * the next frame while the current one is being processed.
+             * It does nothing on systems that do not support read-ahead
+             * hints.
+             */
+            void YARP_sig_API prefetch(const std::string& src);
         }
     }
 }
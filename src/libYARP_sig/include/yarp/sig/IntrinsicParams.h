@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_SIG_INTRINSICPARAMS_H
+#define YARP_SIG_INTRINSICPARAMS_H
+
+#include <yarp/os/Property.h>
+#include <yarp/os/Searchable.h>
+#include <yarp/sig/api.h>
+
+namespace yarp {
+namespace sig {
+
+/**
+ * \ingroup sig_class
+ *
+ * @brief The IntrinsicParams struct to handle the intrinsic parameter of
+ * cameras (RGB and RGBD either).
+ *
+ * Only the pinhole model is used for projections, the distortion
+ * coefficients are carried along untouched.
+ */
+struct YARP_sig_API IntrinsicParams
+{
+    double physFocalLength;  ///< Physical focal length of the lens (m)
+    double principalPointX;  ///< Horizontal coordinate of the principal point of the image, as a pixel offset from the left edge
+    double principalPointY;  ///< Vertical coordinate of the principal point of the image, as a pixel offset from the top edge
+    double focalLengthX;     ///< Result of the product of the physical focal length(mm) and the size sx of the individual imager elements (pixels per mm)
+    double focalLengthY;     ///< Result of the product of the physical focal length(mm) and the size sy of the individual imager elements (pixels per mm)
+    double k1;               ///< Radial distortion coefficient of the lens
+    double k2;               ///< Radial distortion coefficient of the lens
+    double t1;               ///< Tangential distortion of the lens
+    double t2;               ///< Tangential distortion of the lens
+    double k3;               ///< Radial distortion coefficient of the lens
+
+    /**
+     * @brief IntrinsicParams, default constructor.
+     */
+    IntrinsicParams();
+
+    /**
+     * @brief IntrinsicParams, construct from the property returned by
+     * yarp::dev::IRGBDSensor::getDepthIntrinsicParam() and friends.
+     * @param intrinsic the property to read from.
+     */
+    IntrinsicParams(const yarp::os::Searchable& intrinsic);
+
+    /**
+     * @brief toProperty, convert the struct to a property.
+     * @param intrinsic[out] the property to fill.
+     */
+    void toProperty(yarp::os::Property& intrinsic) const;
+
+    /**
+     * @brief fromProperty, fill the struct using the data stored in a
+     * Searchable. Keys that are missing are left untouched.
+     * @param intrinsic[in] the Searchable to read from.
+     */
+    void fromProperty(const yarp::os::Searchable& intrinsic);
+};
+
+} // namespace sig
+} // namespace yarp
+
+#endif // YARP_SIG_INTRINSICPARAMS_H
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_SIG_POINTCLOUDUTILS_H
+#define YARP_SIG_POINTCLOUDUTILS_H
+
+#include <yarp/sig/Image.h>
+#include <yarp/sig/IntrinsicParams.h>
+#include <yarp/sig/PointCloud.h>
+
+namespace yarp {
+namespace sig {
+namespace utils {
+
+/**
+ * @brief The PCL_ROI struct, region of interest of a depth image.
+ * max_x and max_y are exclusive, a value of 0 means "up to the image
+ * border".
+ */
+struct YARP_sig_API PCL_ROI
+{
+    size_t min_x;
+    size_t max_x;
+    size_t min_y;
+    size_t max_y;
+
+    PCL_ROI() :
+            min_x(0),
+            max_x(0),
+            min_y(0),
+            max_y(0)
+    {
+    }
+
+    PCL_ROI(size_t _min_x, size_t _max_x, size_t _min_y, size_t _max_y) :
+            min_x(_min_x),
+            max_x(_max_x),
+            min_y(_min_y),
+            max_y(_max_y)
+    {
+    }
+};
+
+/**
+ * @brief depthToPC, compute the point cloud given the depth image and the
+ * intrinsic parameters of the camera.
+ *
+ * The output cloud is organized, with one point every step_x columns and
+ * step_y rows of the region of interest. Its memory is reused across calls,
+ * so keeping the same cloud object around avoids reallocations.
+ * The projections (u - cx) / fx and (v - cy) / fy are computed once per
+ * column and per row, so the inner loop is a plain multiplication that the
+ * compiler can vectorize. Pixels with no depth produce a (0, 0, 0) point.
+ *
+ * @param[in] depth, the input depth image (in meters).
+ * @param[in] intrinsic, the intrinsic parameters of the depth camera.
+ * @param[out] cloud, the point cloud to fill.
+ * @param[in] roi, the region of interest of the depth image to convert.
+ * @param[in] step_x, the horizontal decimation.
+ * @param[in] step_y, the vertical decimation.
+ * @param[in] threads, the number of threads the rows are split across.
+ * @return true on success, false if the parameters are not consistent.
+ */
+YARP_sig_API bool depthToPC(const yarp::sig::ImageOf<yarp::sig::PixelFloat>& depth,
+                            const yarp::sig::IntrinsicParams& intrinsic,
+                            yarp::sig::PointCloud<yarp::sig::DataXYZ>& cloud,
+                            const PCL_ROI& roi = PCL_ROI(),
+                            size_t step_x = 1,
+                            size_t step_y = 1,
+                            size_t threads = 1);
+
+/**
+ * @brief depthRgbToPC, compute the colored point cloud given the depth
+ * image, the color image registered on it and the intrinsic parameters of
+ * the depth camera.
+ *
+ * The two images must have the same size. See depthToPC() for the meaning
+ * of the other parameters.
+ *
+ * @param[in] depth, the input depth image (in meters).
+ * @param[in] color, the input color image, registered on the depth one.
+ * @param[in] intrinsic, the intrinsic parameters of the depth camera.
+ * @param[out] cloud, the point cloud to fill.
+ * @param[in] roi, the region of interest of the depth image to convert.
+ * @param[in] step_x, the horizontal decimation.
+ * @param[in] step_y, the vertical decimation.
+ * @param[in] threads, the number of threads the rows are split across.
+ * @return true on success, false if the parameters are not consistent.
+ */
+YARP_sig_API bool depthRgbToPC(const yarp::sig::ImageOf<yarp::sig::PixelFloat>& depth,
+                               const yarp::sig::ImageOf<yarp::sig::PixelRgb>& color,
+                               const yarp::sig::IntrinsicParams& intrinsic,
+                               yarp::sig::PointCloud<yarp::sig::DataXYZRGBA>& cloud,
+                               const PCL_ROI& roi = PCL_ROI(),
+                               size_t step_x = 1,
+                               size_t step_y = 1,
+                               size_t threads = 1);
+
+/**
+ * @brief depthToPC, convenience overload returning a new point cloud.
+ * @param[in] depth, the input depth image (in meters).
+ * @param[in] intrinsic, the intrinsic parameters of the depth camera.
+ * @return the point cloud, empty if the parameters are not consistent.
+ */
+YARP_sig_API yarp::sig::PointCloud<yarp::sig::DataXYZ> depthToPC(const yarp::sig::ImageOf<yarp::sig::PixelFloat>& depth,
+                                                                 const yarp::sig::IntrinsicParams& intrinsic);
+
+} // namespace utils
+} // namespace sig
+} // namespace yarp
+
+#endif // YARP_SIG_POINTCLOUDUTILS_H
@@ -14,6 +14,8 @@
 #include <yarp/conf/numeric.h>
 #include <yarp/sig/api.h>
 
+#include <cstdint>
+
 namespace yarp {
     namespace sig {
         class Sound;
@@ -23,7 +25,11 @@ namespace yarp {
 /**
  * \ingroup sig_class
  *
- * Class for storing sounds
+ * Class for storing sounds.
+ *
+ * The samples can be split in several chunks, that are shared between
+ * copies, appended sounds and sub-sounds, and are copied only when a sound
+ * sharing them is modified.
  */
 class YARP_sig_API yarp::sig::Sound : public yarp::os::Portable {
 public:
@@ -47,13 +53,13 @@ public:
 
      /**
      * Addition assignment operator.
-     * Appends a sound to another sound (internal memory reallocation)
+     * Appends a sound to another sound (the samples are not copied)
      * @param alt the sound to append
      */
     Sound& operator+=(const Sound& alt);
 
      /**
-     * Returns a subpart of the sound
+     * Returns a subpart of the sound (the samples are not copied)
      * @param first_sample the starting sample number
      * @param last_sample the ending sample number
      */
@@ -64,6 +70,32 @@ public:
     int get(size_t sample, size_t channel = 0) const;
     void set(int value, size_t sample, size_t channel = 0);
 
+    /**
+     * Replaces the content of the sound with interleaved samples
+     * (all the channels of the first sample, then all the channels of the
+     * second one, and so on)
+     * @param data the interleaved samples
+     * @param samples the number of samples
+     * @param channels the number of channels
+     */
+    void setInterleaved(const std::int16_t* data, size_t samples, size_t channels);
+
+    /**
+     * Appends interleaved samples to the sound. The memory grows
+     * geometrically, so that a sound can be accumulated in small blocks.
+     * @param data the interleaved samples, with getChannels() channels
+     * @param samples the number of samples
+     */
+    void appendInterleaved(const std::int16_t* data, size_t samples);
+
+    /**
+     * Copies some samples of the sound as interleaved samples
+     * @param data the destination, with room for samples*getChannels() values
+     * @param first_sample the first sample to copy
+     * @param samples the number of samples to copy
+     */
+    void getInterleaved(std::int16_t* data, size_t first_sample, size_t samples) const;
+
     int getSafe(size_t sample, size_t channel = 0) {
         if (isSample(sample,channel)) {
             return get(sample,channel);
@@ -106,6 +138,12 @@ public:
 
     virtual bool write(yarp::os::ConnectionWriter& connection) const override;
 
+    /**
+     * Returns the samples, one channel after the other. The chunks of the
+     * sound are merged first, under a lock, so that a const sound can be
+     * read from several threads. The pointer is valid until the sound is
+     * modified, copied or appended to another sound.
+     */
     unsigned char *getRawData() const;
 
     size_t getRawDataSize() const;
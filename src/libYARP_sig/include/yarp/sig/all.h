@@ -20,5 +20,7 @@
 #include <yarp/sig/Vector.h>
 #include <yarp/sig/Matrix.h>
 #include <yarp/sig/PointCloud.h>
+#include <yarp/sig/PointCloudUtils.h>
+#include <yarp/sig/IntrinsicParams.h>
 
 #endif // YARP_SIG_ALL_H
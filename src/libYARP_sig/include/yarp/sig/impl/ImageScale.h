@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef YARP_SIG_IMPL_IMAGESCALE_H
+#define YARP_SIG_IMPL_IMAGESCALE_H
+
+#include <yarp/sig/Image.h>
+
+#include <functional>
+#include <vector>
+
+namespace yarp {
+namespace sig {
+namespace impl {
+
+/**
+ * Scales images of a given size and pixel code to another size.
+ *
+ * The filter coefficients are computed once for each axis.  Rows of the
+ * result are independent, large images are split in bands of rows that
+ * are scaled in parallel.  Filters other than nearest need pixels made
+ * of channels (mono, rgb, float, ...): for other pixel codes (bayer,
+ * yuv) the nearest pixel is used.
+ */
+class ImageScaler
+{
+public:
+    /**
+     * Called with each row of the result, in the pixel code of the
+     * source, to write it into an image of another pixel code.
+     */
+    typedef std::function<void(size_t y, const unsigned char* row)> RowConverter;
+
+    ImageScaler(int pixelCode, size_t pixelSize,
+                size_t srcWidth, size_t srcHeight,
+                size_t width, size_t height,
+                Image::ScaleFilter filter);
+
+    /**
+     * Scale an image.
+     * @param src the image to scale, of the size and pixel code given
+     *        to the constructor
+     * @param dest the result, already of the right size; if convert is
+     *        not set it must have the pixel code of the source
+     * @param convert if set, receives the rows instead of dest
+     */
+    void scale(const Image& src, Image& dest, const RowConverter& convert = RowConverter()) const;
+
+private:
+    enum Component { NONE, UINT8, INT8, UINT16, INT32, FLOAT32 };
+
+    template <typename T, typename Acc>
+    void filterRows(const Image& src, Image& dest, const RowConverter& convert,
+                    size_t first, size_t last) const;
+    void nearestRows(const Image& src, Image& dest, const RowConverter& convert,
+                     size_t first, size_t last) const;
+
+    size_t pixelSize;
+    size_t channels;
+    Component component;
+    size_t srcWidth, srcHeight;
+    size_t width, height;
+    Image::ScaleFilter filter;
+
+    // nearest: byte offset of the source pixel, and source row
+    std::vector<size_t> nearestX;
+    std::vector<size_t> nearestY;
+
+    // other filters: tapsY source rows with their weights for each row of
+    // the result, tapsX source components for each component of a row
+    size_t tapsX, tapsY;
+    std::vector<size_t> indexX, indexY;
+    std::vector<float> weightX, weightY;
+};
+
+} // namespace impl
+} // namespace sig
+} // namespace yarp
+
+#endif // YARP_SIG_IMPL_IMAGESCALE_H
@@ -23,6 +23,7 @@
 #include <yarp/sig/ImageNetworkHeader.h>
 #include <yarp/sig/impl/IplImage.h>
 #include <yarp/sig/impl/DeBayer.h>
+#include <yarp/sig/impl/ImageScale.h>
 
 #include <cstdio>
 #include <cstring>
@@ -853,45 +854,38 @@ void Image::setExternal(const void *data, size_t imgWidth, size_t imgHeight) {
 
 
 bool Image::copy(const Image& alt, size_t w, size_t h) {
+    return copy(alt, w, h, SCALE_NEAREST);
+}
+
+
+bool Image::copy(const Image& alt, size_t w, size_t h, ScaleFilter filter) {
     if (getPixelCode()==0) {
         setPixelCode(alt.getPixelCode());
         setQuantum(alt.getQuantum());
     }
     if (&alt==this) {
-        FlexImage img;
-        img.copy(alt);
-        return copy(img,w,h);
-    }
-
-    if (getPixelCode()!=alt.getPixelCode()) {
         FlexImage img;
         img.setPixelCode(getPixelCode());
         img.setQuantum(getQuantum());
-        img.copy(alt);
-        return copy(img,w,h);
+        img.copy(alt,w,h,filter);
+        return copy(img);
     }
 
     resize(w,h);
-    size_t d = getPixelSize();
+    impl::ImageScaler scaler(alt.getPixelCode(), alt.getPixelSize(),
+                             alt.width(), alt.height(), w, h, filter);
 
-    size_t nw = w;
-    size_t nh = h;
-    w = alt.width();
-    h = alt.height();
-
-    float di = ((float)h)/nh;
-    float dj = ((float)w)/nw;
+    if (getPixelCode()==alt.getPixelCode()) {
+        scaler.scale(alt, *this);
+        return true;
+    }
 
-    for (size_t i=0; i<nh; i++)
-        {
-            size_t i0 = (size_t)(di*i);
-            for (size_t j=0; j<nw; j++)
-                {
-                    size_t j0 = (size_t)(dj*j);
-                    memcpy(getPixelAddress(j,i),
-                           alt.getPixelAddress(j0,i0),
-                           d);
-                }
-        }
+    // rows are scaled in the pixel code of the source, then converted
+    int from = alt.getPixelCode();
+    int to = getPixelCode();
+    size_t rowSize = w*getPixelSize();
+    scaler.scale(alt, *this, [&](size_t y, const unsigned char* row) {
+        copyPixels(row, from, getRow(y), to, w, 1, rowSize, 1, 1, true, true);
+    });
     return true;
 }
@@ -11,8 +11,19 @@
 #include <yarp/os/Log.h>
 #include <yarp/os/LogStream.h>
 
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #if YARP_HAS_JPEG_C
 #include "jpeglib.h"
@@ -26,223 +37,321 @@ using namespace yarp::sig;
 // private read methods
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static bool ReadHeader(FILE *fp, int *height, int *width, int *color)
-{
-    char ch;
-    int  maxval;
+namespace {
 
-    *color = 0;
+/**
+ * Read-only view of a whole file.
+ * On POSIX systems the file is memory mapped, so that pixels are copied
+ * straight from the page cache into the image storage, elsewhere it is
+ * read in a single call.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* filename) :
+            m_data(nullptr),
+            m_size(0)
+    {
+#if defined(_WIN32)
+        FILE* fp = fopen(filename, "rb");
+        if (fp == nullptr) {
+            return;
+        }
+        if (fseek(fp, 0, SEEK_END) == 0) {
+            long len = ftell(fp);
+            if (len > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+                m_buffer.resize(static_cast<size_t>(len));
+                if (fread(m_buffer.data(), 1, m_buffer.size(), fp) == m_buffer.size()) {
+                    m_data = m_buffer.data();
+                    m_size = m_buffer.size();
+                }
+            }
+        }
+        fclose(fp);
+#else
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                m_data = static_cast<const unsigned char*>(addr);
+                m_size = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
 
-    //// LATER: replace fscanf (said to be non portable) with getc style functions.
-    if (fscanf(fp, "P%c\n", &ch) != 1 || (ch!='6'&&ch!='5'))
+    ~MappedFile()
     {
-        yWarning("file is not in pgm/ppm raw format; cannot read");
-        return false;
+#if !defined(_WIN32)
+        if (m_data != nullptr) {
+            munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+#endif
     }
 
-    if (ch=='6') *color = 1;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
 
-    // skip comments
-    ch = fgetc(fp);
-    while (ch == '#')
-    {
-        do
-        {
-            ch = fgetc(fp);
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+#if defined(_WIN32)
+    std::vector<unsigned char> m_buffer;
+#endif
+};
+
+struct PnmHeader
+{
+    size_t width;
+    size_t height;
+    bool color;
+    size_t offset; // first byte of the pixel data
+};
+
+// Skip whitespaces and comments, that can appear anywhere before the maxval.
+void skipSeparators(const MappedFile& file, size_t& pos)
+{
+    while (pos < file.size()) {
+        unsigned char ch = file.data()[pos];
+        if (ch == '#') {
+            while (pos < file.size() && file.data()[pos] != '\n') {
+                pos++;
+            }
+        } else if (isspace(ch)) {
+            pos++;
+        } else {
+            return;
         }
-        while (ch != '\n');
-        ch = fgetc(fp);
     }
-    ungetc(ch, fp);
+}
+
+bool parseNumber(const MappedFile& file, size_t& pos, size_t& value)
+{
+    skipSeparators(file, pos);
+    size_t start = pos;
+    value = 0;
+    while (pos < file.size() && isdigit(file.data()[pos])) {
+        size_t digit = file.data()[pos] - '0';
+        if (value > (std::numeric_limits<size_t>::max() - digit) / 10) {
+            yWarning("number too large in the header; read failed");
+            return false;
+        }
+        value = value * 10 + digit;
+        pos++;
+    }
+    return pos != start;
+}
 
-    /// LATER: not portable?
-    int n=fscanf(fp, "%d%d%d", width, height, &maxval);
-    if (n!=3)
+bool ReadHeader(const MappedFile& file, PnmHeader& header)
+{
+    if (file.size() < 2 || file.data()[0] != 'P' || (file.data()[1] != '6' && file.data()[1] != '5'))
+    {
+        yWarning("file is not in pgm/ppm raw format; cannot read");
         return false;
+    }
+    header.color = (file.data()[1] == '6');
+
+    size_t pos = 2;
+    size_t maxval = 0;
+    if (!parseNumber(file, pos, header.width) ||
+        !parseNumber(file, pos, header.height) ||
+        !parseNumber(file, pos, maxval)) {
+        return false;
+    }
 
-    fgetc(fp);
     if (maxval != 255)
     {
-        //die("image is not true-color (24 bit); read failed");
         yWarning("image is not true-color (24 bit); read failed");
         return false;
     }
 
+    // a single whitespace separates the header from the pixels
+    header.offset = pos + 1;
+    size_t channels = header.color ? 3 : 1;
+    // without overflows, in case of a crafted header
+    if (header.offset > file.size() ||
+        (header.width > 0 && header.height > 0 &&
+         header.width > (file.size() - header.offset) / channels / header.height))
+    {
+        yWarning("file is truncated; read failed");
+        return false;
+    }
+
     return true;
 }
 
-
-static bool ImageReadRGB(ImageOf<PixelRgb> &img, const char *filename)
+bool OpenPnm(const char* filename, MappedFile& file, PnmHeader& header)
 {
-    int width, height, color, num;
-    FILE *fp=nullptr;
-    fp = fopen(filename, "rb");
-
-    if(fp==nullptr)
+    if (!file.isOpen())
     {
         yError("Error opening %s, check if file exists.\n", filename);
         return false;
     }
 
-    if (!ReadHeader(fp, &height, &width, &color))
+    if (!ReadHeader(file, header))
     {
-        fclose (fp);
         yError("Error reading header, is file a valid ppm/pgm?\n");
         return false;
     }
 
-    if (!color)
+    return true;
+}
+
+// Copy the pixels row by row in the image storage, honouring its padding.
+void CopyRows(Image& img, const unsigned char* src, size_t srcRowSize)
+{
+    for (size_t r = 0; r < img.height(); r++)
     {
-        ImageOf<PixelMono> tmp;
-        tmp.resize(width,height);
+        memcpy(img.getRow(r), src, srcRowSize);
+        src += srcRowSize;
+    }
+}
 
-        const int w = tmp.width() * tmp.getPixelSize();
-        const int h = tmp.height();
-        const int pad = tmp.getRowSize();
-        unsigned char *dst = tmp.getRawImage ();
+} // namespace
 
-        num = 0;
-        for (int i = 0; i < h; i++)
+
+static bool ImageReadRGB(ImageOf<PixelRgb> &img, const char *filename)
+{
+    MappedFile file(filename);
+    PnmHeader header;
+    if (!OpenPnm(filename, file, header))
+    {
+        return false;
+    }
+
+    img.resize(header.width, header.height);
+    const unsigned char* src = file.data() + header.offset;
+
+    if (!header.color)
+    {
+        // expand grayscale straight into the destination, no temporaries
+        for (size_t r = 0; r < img.height(); r++)
+        {
+            PixelRgb* dst = reinterpret_cast<PixelRgb*>(img.getRow(r));
+            for (size_t c = 0; c < img.width(); c++)
             {
-                num += (int)fread((void *) dst, 1, (size_t) w, fp);
-                dst += pad;
+                dst[c].r = dst[c].g = dst[c].b = src[c];
             }
-        fclose(fp);
-        img.copy(tmp);
+            src += header.width;
+        }
         return true;
     }
 
-    img.resize(width,height);
-
-    const int w = img.width() * img.getPixelSize();
-    const int h = img.height();
-    const int pad = img.getRowSize();
-    unsigned char *dst = img.getRawImage ();
+    CopyRows(img, src, header.width * 3);
+    return true;
+}
 
-    num = 0;
-    for (int i = 0; i < h; i++)
+static bool ImageReadRGBA(ImageOf<PixelRgba> &img, const char *filename)
+{
+    MappedFile file(filename);
+    PnmHeader header;
+    if (!OpenPnm(filename, file, header))
     {
-        num += (int)fread((void *) dst, 1, (size_t) w, fp);
-        dst += pad;
+        return false;
     }
 
-    fclose(fp);
-
+    img.resize(header.width, header.height);
+    const unsigned char* src = file.data() + header.offset;
+    const size_t channels = header.color ? 3 : 1;
+    for (size_t r = 0; r < img.height(); r++)
+    {
+        PixelRgba* dst = reinterpret_cast<PixelRgba*>(img.getRow(r));
+        for (size_t c = 0; c < img.width(); c++)
+        {
+            const unsigned char* px = src + c * channels;
+            dst[c].r = px[0];
+            dst[c].g = px[header.color ? 1 : 0];
+            dst[c].b = px[header.color ? 2 : 0];
+            dst[c].a = 255;
+        }
+        src += header.width * channels;
+    }
     return true;
 }
 
 static bool ImageReadFloat(ImageOf<PixelFloat>& dest, const std::string& filename)
 {
-    FILE *fp = fopen(filename.c_str(), "rb");
-    if (fp == nullptr) {
+    MappedFile file(filename.c_str());
+    if (!file.isOpen()) {
         return false;
     }
 
-    size_t br = 0;
-    size_t size_ = sizeof(float);
-    size_t count_ = 0;
-
     size_t dims[2];
-    if (fread(dims, sizeof(dims), 1, fp) > 0)
-    {
-        count_ = (size_t)(dims[0] * dims[1]);
-        dest.resize(dims[0], dims[1]);
-        br = fread(&dest(0, 0), size_, count_, fp);
+    if (file.size() < sizeof(dims)) {
+        return false;
     }
+    memcpy(dims, file.data(), sizeof(dims));
 
-    fclose(fp);
-    return (br > 0);
+    if (dims[0] == 0 || dims[1] == 0 ||
+        dims[0] > (file.size() - sizeof(dims)) / sizeof(float) / dims[1]) {
+        return false;
+    }
+    const size_t rowSize = dims[0] * sizeof(float);
+
+    dest.resize(dims[0], dims[1]);
+    CopyRows(dest, file.data() + sizeof(dims), rowSize);
+    return true;
 }
 
 static bool ImageReadBGR(ImageOf<PixelBgr> &img, const char *filename)
 {
-    int width, height, color, num;
-    FILE *fp=nullptr;
-    fp = fopen(filename, "rb");
-
-    if(fp==nullptr)
-    {
-        yError("Error opening %s, check if file exists.\n", filename);
-        return false;
-    }
-
-    if (!ReadHeader(fp, &height, &width, &color))
+    MappedFile file(filename);
+    PnmHeader header;
+    if (!OpenPnm(filename, file, header))
     {
-        fclose (fp);
-        yError("Error reading header, is file a valid ppm/pgm?\n");
         return false;
     }
 
-    if (!color)
+    if (!header.color)
     {
-        fclose(fp);
         yError("File is grayscale, conversion not yet supported\n");
         return false;
     }
 
-    ImageOf<PixelRgb> tmpImg;
-    tmpImg.resize(width, height);
-
-    const int w = tmpImg.width() * img.getPixelSize();
-    const int h = tmpImg.height();
-    const int pad = tmpImg.getRowSize();
-    unsigned char *dst = tmpImg.getRawImage ();
-
-    num = 0;
-    for (int i = 0; i < h; i++)
+    img.resize(header.width, header.height);
+    const unsigned char* src = file.data() + header.offset;
+    for (size_t r = 0; r < img.height(); r++)
     {
-        num += (int)fread((void *) dst, 1, (size_t) w, fp);
-        dst += pad;
+        PixelBgr* dst = reinterpret_cast<PixelBgr*>(img.getRow(r));
+        for (size_t c = 0; c < img.width(); c++)
+        {
+            dst[c].r = src[3 * c];
+            dst[c].g = src[3 * c + 1];
+            dst[c].b = src[3 * c + 2];
+        }
+        src += header.width * 3;
     }
-
-    fclose(fp);
-
-    return img.copy(tmpImg);
+    return true;
 }
 
 
 static bool ImageReadMono(ImageOf<PixelMono> &img, const char *filename)
 {
-    int width, height, color, num;
-    FILE *fp=nullptr;
-    fp = fopen(filename, "rb");
-
-    if(fp==nullptr)
+    MappedFile file(filename);
+    PnmHeader header;
+    if (!OpenPnm(filename, file, header))
     {
-        yError("Error opening %s, check if file exists.\n", filename);
         return false;
     }
 
-    if (!ReadHeader(fp, &height, &width, &color))
+    if (header.color)
     {
-        fclose (fp);
-        yError("Error reading header, is file a valid ppm/pgm?\n");
-        return false;
-    }
-
-    if (color)
-    {
-        fclose(fp);
         yError("File is color, conversion not yet supported\n");
         return false;
     }
 
-    img.resize(width,height);
-
-    const int w = img.width() * img.getPixelSize();
-    const int h = img.height();
-    const int pad = img.getRowSize();
-    unsigned char *dst = img.getRawImage ();
-
-    num = 0;
-    for (int i = 0; i < h; i++)
-        {
-            num += (int)fread((void *) dst, 1, (size_t) w, fp);
-            dst += pad;
-        }
-
-    fclose(fp);
-
+    img.resize(header.width, header.height);
+    CopyRows(img, file.data() + header.offset, header.width);
     return true;
 }
 
@@ -257,8 +366,6 @@ static bool SaveJPG(char *src, const char *filename, int h, int w, int rowSize)
     struct jpeg_compress_struct cinfo;
     struct jpeg_error_mgr jerr;
     FILE * outfile;
-    JSAMPROW row_pointer[1];
-    int row_stride;
 
     cinfo.err = jpeg_std_error(&jerr);
     jpeg_create_compress(&cinfo);
@@ -277,14 +384,19 @@ static bool SaveJPG(char *src, const char *filename, int h, int w, int rowSize)
     jpeg_set_defaults(&cinfo);
     jpeg_set_quality(&cinfo, quality, TRUE);
 
-    jpeg_start_compress(&cinfo, TRUE);
+    // hand all the rows (honouring the image padding) to libjpeg at once,
+    // instead of calling jpeg_write_scanlines once per row
+    std::vector<JSAMPROW> row_pointers(h);
+    for (int i = 0; i < h; i++)
+    {
+        row_pointers[i] = (JSAMPROW)&src[i * rowSize];
+    }
 
-    row_stride = w * 3;
+    jpeg_start_compress(&cinfo, TRUE);
 
     while (cinfo.next_scanline < cinfo.image_height)
     {
-        row_pointer[0] = (JSAMPROW)&src[cinfo.next_scanline * row_stride];
-        (void)jpeg_write_scanlines(&cinfo, row_pointer, 1);
+        (void)jpeg_write_scanlines(&cinfo, &row_pointers[cinfo.next_scanline], cinfo.image_height - cinfo.next_scanline);
     }
 
     jpeg_finish_compress(&cinfo);
@@ -378,12 +490,15 @@ static bool ImageWriteFloat(ImageOf<PixelFloat>& img, const char *filename)
     size_t size_ = sizeof(float);
     size_t count_ = (size_t)(dims[0] * dims[1]);
 
+    // rows are written one by one, skipping the padding of the image
     if (fwrite(dims, sizeof(dims), 1, fp) > 0) {
-        bw = fwrite(&img(0, 0), size_, count_, fp);
+        for (size_t r = 0; r < img.height(); r++) {
+            bw += fwrite(img.getRow(r), size_, dims[0], fp);
+        }
     }
 
     fclose(fp);
-    return (bw > 0);
+    return (bw == count_ && bw > 0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -404,13 +519,7 @@ bool file::read(ImageOf<PixelBgr> & dest, const std::string& src, image_fileform
 
 bool file::read(ImageOf<PixelRgba> & dest, const std::string& src, image_fileformat format)
 {
-    ImageOf<PixelRgb> img2;
-    bool ok = ImageReadRGB(img2,src.c_str());
-    if (ok)
-    {
-        dest.copy(img2);
-    }
-    return ok;
+    return ImageReadRGBA(dest, src.c_str());
 }
 
 bool file::read(ImageOf<PixelMono> & dest, const std::string& src, image_fileformat format)
@@ -423,6 +532,20 @@ bool file::read(ImageOf<PixelFloat>& dest, const std::string& src, image_filefor
     return ImageReadFloat(dest, src.c_str());
 }
 
+void file::prefetch(const std::string& src)
+{
+#if defined(__linux__)
+    int fd = ::open(src.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    ::close(fd);
+#else
+    YARP_UNUSED(src);
+#endif
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////write methods
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/sig/impl/ImageScale.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+
+using yarp::sig::Image;
+using yarp::sig::impl::ImageScaler;
+
+namespace {
+
+// Number of samples (pixels of the result times filter taps) worth
+// starting a thread for, and most threads used for one image.
+const size_t minWorkPerThread = 1 << 18;
+const size_t maxThreads = 8;
+
+// Run f on bands of rows, in parallel if there is enough work.
+void forEachBand(size_t rows, size_t work, const std::function<void(size_t, size_t)>& f)
+{
+    size_t threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, maxThreads);
+    threads = std::min(threads, work / minWorkPerThread);
+    threads = std::min(threads, rows);
+    if (threads <= 1) {
+        f(0, rows);
+        return;
+    }
+    size_t band = (rows + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (size_t first = band; first < rows; first += band) {
+        workers.emplace_back(f, first, std::min(first + band, rows));
+    }
+    f(0, band);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Source samples and weights along one axis.  Every sample of the result
+// uses the same number of taps, unused taps have weight 0.
+void makeTaps(size_t src, size_t dst, Image::ScaleFilter filter,
+              size_t& taps, std::vector<size_t>& index, std::vector<float>& weight)
+{
+    double scale = static_cast<double>(src) / dst;
+    if (filter == Image::SCALE_AREA && scale > 1.0) {
+        // average of the source samples covered, weighted by coverage
+        taps = 0;
+        for (size_t o = 0; o < dst; o++) {
+            size_t first = static_cast<size_t>(o * scale);
+            size_t last = std::min(static_cast<size_t>(std::ceil((o + 1) * scale)), src);
+            taps = std::max(taps, last - first);
+        }
+        index.assign(dst * taps, 0);
+        weight.assign(dst * taps, 0.0f);
+        for (size_t o = 0; o < dst; o++) {
+            double start = o * scale;
+            double end = std::min((o + 1) * scale, static_cast<double>(src));
+            size_t first = static_cast<size_t>(start);
+            for (size_t k = 0; k < taps; k++) {
+                size_t i = first + k;
+                index[o * taps + k] = first;
+                if (i >= src || i >= end) {
+                    continue;
+                }
+                double cover = std::min(i + 1.0, end) - std::max(static_cast<double>(i), start);
+                index[o * taps + k] = i;
+                weight[o * taps + k] = static_cast<float>(cover / (end - start));
+            }
+        }
+        return;
+    }
+
+    // linear interpolation between the two nearest samples, with the
+    // centers of the samples aligned (also used by area when enlarging)
+    taps = 2;
+    index.resize(dst * taps);
+    weight.resize(dst * taps);
+    for (size_t o = 0; o < dst; o++) {
+        double f = std::max((o + 0.5) * scale - 0.5, 0.0);
+        size_t i0 = static_cast<size_t>(f);
+        double a = f - i0;
+        if (i0 >= src - 1) {
+            i0 = src - 1;
+            a = 0;
+        }
+        index[o * taps] = i0;
+        index[o * taps + 1] = std::min(i0 + 1, src - 1);
+        weight[o * taps] = static_cast<float>(1 - a);
+        weight[o * taps + 1] = static_cast<float>(a);
+    }
+}
+
+template <typename T, typename Acc>
+inline T saturate(Acc v, std::true_type /*floating point*/)
+{
+    return static_cast<T>(v);
+}
+
+template <typename T, typename Acc>
+inline T saturate(Acc v, std::false_type /*floating point*/)
+{
+    v = (v < 0) ? v - Acc(0.5) : v + Acc(0.5);
+    if (v <= static_cast<Acc>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if (v >= static_cast<Acc>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(v);
+}
+
+template <size_t N>
+inline void copyNearest(const unsigned char* src, unsigned char* dest,
+                        const size_t* offsets, size_t width)
+{
+    for (size_t x = 0; x < width; x++) {
+        const unsigned char* p = src + offsets[x];
+        for (size_t b = 0; b < N; b++) {
+            dest[b] = p[b];
+        }
+        dest += N;
+    }
+}
+
+} // namespace
+
+
+ImageScaler::ImageScaler(int pixelCode, size_t pixelSize,
+                         size_t srcWidth, size_t srcHeight,
+                         size_t width, size_t height,
+                         Image::ScaleFilter filter) :
+        pixelSize(pixelSize),
+        channels(1),
+        component(NONE),
+        srcWidth(srcWidth),
+        srcHeight(srcHeight),
+        width(width),
+        height(height),
+        filter(filter),
+        tapsX(0),
+        tapsY(0)
+{
+    switch (pixelCode) {
+    case VOCAB_PIXEL_MONO:
+    case VOCAB_PIXEL_RGB:
+    case VOCAB_PIXEL_RGBA:
+    case VOCAB_PIXEL_BGRA:
+    case VOCAB_PIXEL_BGR:
+    case VOCAB_PIXEL_HSV:
+        component = UINT8;
+        channels = pixelSize;
+        break;
+    case VOCAB_PIXEL_MONO_SIGNED:
+    case VOCAB_PIXEL_RGB_SIGNED:
+        component = INT8;
+        channels = pixelSize;
+        break;
+    case VOCAB_PIXEL_MONO16:
+        component = UINT16;
+        channels = pixelSize / sizeof(std::uint16_t);
+        break;
+    case VOCAB_PIXEL_INT:
+    case VOCAB_PIXEL_RGB_INT:
+        component = INT32;
+        channels = pixelSize / sizeof(std::int32_t);
+        break;
+    case VOCAB_PIXEL_MONO_FLOAT:
+    case VOCAB_PIXEL_RGB_FLOAT:
+    case VOCAB_PIXEL_HSV_FLOAT:
+        component = FLOAT32;
+        channels = pixelSize / sizeof(float);
+        break;
+    default:
+        break;
+    }
+
+    if (srcWidth == 0 || srcHeight == 0) {
+        return;
+    }
+
+    if (component == NONE || filter == Image::SCALE_NEAREST) {
+        this->filter = Image::SCALE_NEAREST;
+        // same sampling as the historical Image::copy(alt, w, h)
+        float di = static_cast<float>(srcHeight) / height;
+        float dj = static_cast<float>(srcWidth) / width;
+        nearestX.resize(width);
+        nearestY.resize(height);
+        for (size_t j = 0; j < width; j++) {
+            nearestX[j] = static_cast<size_t>(dj * j) * pixelSize;
+        }
+        for (size_t i = 0; i < height; i++) {
+            nearestY[i] = static_cast<size_t>(di * i);
+        }
+        return;
+    }
+
+    makeTaps(srcWidth, width, filter, tapsX, indexX, weightX);
+    makeTaps(srcHeight, height, filter, tapsY, indexY, weightY);
+
+    // one set of taps for each component of a row, so that the horizontal
+    // pass is a single loop whatever the number of channels
+    std::vector<size_t> index(width * channels * tapsX);
+    std::vector<float> weight(width * channels * tapsX);
+    for (size_t x = 0; x < width; x++) {
+        for (size_t c = 0; c < channels; c++) {
+            for (size_t k = 0; k < tapsX; k++) {
+                index[(x * channels + c) * tapsX + k] = indexX[x * tapsX + k] * channels + c;
+                weight[(x * channels + c) * tapsX + k] = weightX[x * tapsX + k];
+            }
+        }
+    }
+    indexX.swap(index);
+    weightX.swap(weight);
+}
+
+
+void ImageScaler::nearestRows(const Image& src, Image& dest, const RowConverter& convert,
+                              size_t first, size_t last) const
+{
+    std::vector<unsigned char> scratch(convert ? width * pixelSize : 0);
+    for (size_t y = first; y < last; y++) {
+        const unsigned char* in = src.getRow(nearestY[y]);
+        unsigned char* out = convert ? scratch.data() : dest.getRow(y);
+        switch (pixelSize) {
+        case 1: copyNearest<1>(in, out, nearestX.data(), width); break;
+        case 2: copyNearest<2>(in, out, nearestX.data(), width); break;
+        case 3: copyNearest<3>(in, out, nearestX.data(), width); break;
+        case 4: copyNearest<4>(in, out, nearestX.data(), width); break;
+        case 8: copyNearest<8>(in, out, nearestX.data(), width); break;
+        case 12: copyNearest<12>(in, out, nearestX.data(), width); break;
+        default:
+            for (size_t x = 0; x < width; x++) {
+                memcpy(out + x * pixelSize, in + nearestX[x], pixelSize);
+            }
+            break;
+        }
+        if (convert) {
+            convert(y, out);
+        }
+    }
+}
+
+
+template <typename T, typename Acc>
+void ImageScaler::filterRows(const Image& src, Image& dest, const RowConverter& convert,
+                             size_t first, size_t last) const
+{
+    const size_t n = width * channels;
+    const size_t srcN = srcWidth * channels;
+    std::vector<unsigned char> scratch(convert ? n * sizeof(T) : 0);
+
+    // The vertical pass comes first: it runs on whole rows and is cheap,
+    // the horizontal pass picks components and is then done only once for
+    // each row of the result.
+    std::vector<Acc> column(srcN);
+
+    for (size_t y = first; y < last; y++) {
+        std::fill(column.begin(), column.end(), Acc(0));
+        for (size_t ky = 0; ky < tapsY; ky++) {
+            const Acc wy = weightY[y * tapsY + ky];
+            if (wy == 0) {
+                continue;
+            }
+            const T* in = reinterpret_cast<const T*>(src.getRow(indexY[y * tapsY + ky]));
+            for (size_t i = 0; i < srcN; i++) {
+                column[i] += wy * static_cast<Acc>(in[i]);
+            }
+        }
+
+        unsigned char* row = convert ? scratch.data() : dest.getRow(y);
+        T* out = reinterpret_cast<T*>(row);
+        const Acc* c = column.data();
+        const size_t* ix = indexX.data();
+        const float* wx = weightX.data();
+        if (tapsX == 2) {
+            for (size_t i = 0; i < n; i++, ix += 2, wx += 2) {
+                out[i] = saturate<T>(wx[0] * c[ix[0]] + wx[1] * c[ix[1]], std::is_floating_point<T>());
+            }
+        } else {
+            for (size_t i = 0; i < n; i++, ix += tapsX, wx += tapsX) {
+                Acc v = 0;
+                for (size_t kx = 0; kx < tapsX; kx++) {
+                    v += wx[kx] * c[ix[kx]];
+                }
+                out[i] = saturate<T>(v, std::is_floating_point<T>());
+            }
+        }
+        if (convert) {
+            convert(y, row);
+        }
+    }
+}
+
+
+void ImageScaler::scale(const Image& src, Image& dest, const RowConverter& convert) const
+{
+    if (width == 0 || height == 0 || srcWidth == 0 || srcHeight == 0) {
+        return;
+    }
+
+    std::function<void(size_t, size_t)> band;
+    size_t work = width * height;
+    if (filter == Image::SCALE_NEAREST) {
+        band = [&](size_t first, size_t last) { nearestRows(src, dest, convert, first, last); };
+    } else {
+        work *= tapsX * channels;
+        switch (component) {
+        case UINT8:
+            band = [&](size_t first, size_t last) { filterRows<std::uint8_t, float>(src, dest, convert, first, last); };
+            break;
+        case INT8:
+            band = [&](size_t first, size_t last) { filterRows<std::int8_t, float>(src, dest, convert, first, last); };
+            break;
+        case UINT16:
+            band = [&](size_t first, size_t last) { filterRows<std::uint16_t, float>(src, dest, convert, first, last); };
+            break;
+        case INT32:
+            band = [&](size_t first, size_t last) { filterRows<std::int32_t, double>(src, dest, convert, first, last); };
+            break;
+        case FLOAT32:
+        default:
+            band = [&](size_t first, size_t last) { filterRows<float, float>(src, dest, convert, first, last); };
+            break;
+        }
+    }
+    forEachBand(height, work, band);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/sig/IntrinsicParams.h>
+
+using namespace yarp::sig;
+
+IntrinsicParams::IntrinsicParams() :
+        physFocalLength(0.0),
+        principalPointX(0.0),
+        principalPointY(0.0),
+        focalLengthX(0.0),
+        focalLengthY(0.0),
+        k1(0.0),
+        k2(0.0),
+        t1(0.0),
+        t2(0.0),
+        k3(0.0)
+{
+}
+
+IntrinsicParams::IntrinsicParams(const yarp::os::Searchable& intrinsic) :
+        IntrinsicParams()
+{
+    fromProperty(intrinsic);
+}
+
+void IntrinsicParams::toProperty(yarp::os::Property& intrinsic) const
+{
+    intrinsic.put("physFocalLength", physFocalLength);
+    intrinsic.put("focalLengthX", focalLengthX);
+    intrinsic.put("focalLengthY", focalLengthY);
+    intrinsic.put("principalPointX", principalPointX);
+    intrinsic.put("principalPointY", principalPointY);
+    intrinsic.put("distortionModel", "plumb_bob");
+    intrinsic.put("k1", k1);
+    intrinsic.put("k2", k2);
+    intrinsic.put("t1", t1);
+    intrinsic.put("t2", t2);
+    intrinsic.put("k3", k3);
+}
+
+void IntrinsicParams::fromProperty(const yarp::os::Searchable& intrinsic)
+{
+    physFocalLength = intrinsic.check("physFocalLength", yarp::os::Value(physFocalLength)).asFloat64();
+    focalLengthX = intrinsic.check("focalLengthX", yarp::os::Value(focalLengthX)).asFloat64();
+    focalLengthY = intrinsic.check("focalLengthY", yarp::os::Value(focalLengthY)).asFloat64();
+    principalPointX = intrinsic.check("principalPointX", yarp::os::Value(principalPointX)).asFloat64();
+    principalPointY = intrinsic.check("principalPointY", yarp::os::Value(principalPointY)).asFloat64();
+    k1 = intrinsic.check("k1", yarp::os::Value(k1)).asFloat64();
+    k2 = intrinsic.check("k2", yarp::os::Value(k2)).asFloat64();
+    t1 = intrinsic.check("t1", yarp::os::Value(t1)).asFloat64();
+    t2 = intrinsic.check("t2", yarp::os::Value(t2)).asFloat64();
+    k3 = intrinsic.check("k3", yarp::os::Value(k3)).asFloat64();
+}
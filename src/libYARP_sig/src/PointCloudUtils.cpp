@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/sig/PointCloudUtils.h>
+#include <yarp/os/Log.h>
+
+#include <thread>
+#include <vector>
+
+using namespace yarp::sig;
+using namespace yarp::sig::utils;
+
+namespace {
+
+struct ProjectionTables
+{
+    size_t min_x;
+    size_t min_y;
+    size_t step_x;
+    size_t step_y;
+    size_t width;
+    size_t height;
+    std::vector<float> xTable; // (u - cx) / fx, one entry per output column
+    std::vector<float> yTable; // (v - cy) / fy, one entry per output row
+};
+
+bool prepareTables(const ImageOf<PixelFloat>& depth,
+                   const IntrinsicParams& intrinsic,
+                   const PCL_ROI& roi,
+                   size_t step_x,
+                   size_t step_y,
+                   ProjectionTables& tables)
+{
+    if (intrinsic.focalLengthX == 0.0 || intrinsic.focalLengthY == 0.0) {
+        yError("depthToPC: invalid focal length");
+        return false;
+    }
+    if (step_x == 0 || step_y == 0) {
+        yError("depthToPC: the decimation steps must be greater than zero");
+        return false;
+    }
+
+    size_t max_x = (roi.max_x == 0) ? depth.width() : roi.max_x;
+    size_t max_y = (roi.max_y == 0) ? depth.height() : roi.max_y;
+    if (max_x > depth.width() || max_y > depth.height() || roi.min_x >= max_x || roi.min_y >= max_y) {
+        yError("depthToPC: the region of interest does not fit the %zux%zu depth image", depth.width(), depth.height());
+        return false;
+    }
+
+    tables.min_x = roi.min_x;
+    tables.min_y = roi.min_y;
+    tables.step_x = step_x;
+    tables.step_y = step_y;
+    tables.width = (max_x - roi.min_x + step_x - 1) / step_x;
+    tables.height = (max_y - roi.min_y + step_y - 1) / step_y;
+
+    tables.xTable.resize(tables.width);
+    tables.yTable.resize(tables.height);
+    for (size_t c = 0; c < tables.width; c++) {
+        double u = static_cast<double>(roi.min_x + c * step_x);
+        tables.xTable[c] = static_cast<float>((u - intrinsic.principalPointX) / intrinsic.focalLengthX);
+    }
+    for (size_t r = 0; r < tables.height; r++) {
+        double v = static_cast<double>(roi.min_y + r * step_y);
+        tables.yTable[r] = static_cast<float>((v - intrinsic.principalPointY) / intrinsic.focalLengthY);
+    }
+    return true;
+}
+
+void projectRows(const ImageOf<PixelFloat>& depth,
+                 const ProjectionTables& tables,
+                 DataXYZ* out,
+                 size_t firstRow,
+                 size_t lastRow)
+{
+    const float* xTable = tables.xTable.data();
+    for (size_t r = firstRow; r < lastRow; r++) {
+        const float* src = reinterpret_cast<const float*>(depth.getRow(tables.min_y + r * tables.step_y)) + tables.min_x;
+        const float yFactor = tables.yTable[r];
+        DataXYZ* dst = out + r * tables.width;
+        const size_t step = tables.step_x;
+        for (size_t c = 0; c < tables.width; c++) {
+            const float z = src[c * step];
+            dst[c].x = z * xTable[c];
+            dst[c].y = z * yFactor;
+            dst[c].z = z;
+        }
+    }
+}
+
+void projectRowsRgb(const ImageOf<PixelFloat>& depth,
+                    const ImageOf<PixelRgb>& color,
+                    const ProjectionTables& tables,
+                    DataXYZRGBA* out,
+                    size_t firstRow,
+                    size_t lastRow)
+{
+    const float* xTable = tables.xTable.data();
+    for (size_t r = firstRow; r < lastRow; r++) {
+        const size_t v = tables.min_y + r * tables.step_y;
+        const float* src = reinterpret_cast<const float*>(depth.getRow(v)) + tables.min_x;
+        const PixelRgb* rgb = reinterpret_cast<const PixelRgb*>(color.getRow(v)) + tables.min_x;
+        const float yFactor = tables.yTable[r];
+        DataXYZRGBA* dst = out + r * tables.width;
+        const size_t step = tables.step_x;
+        for (size_t c = 0; c < tables.width; c++) {
+            const float z = src[c * step];
+            dst[c].x = z * xTable[c];
+            dst[c].y = z * yFactor;
+            dst[c].z = z;
+        }
+        for (size_t c = 0; c < tables.width; c++) {
+            const PixelRgb& px = rgb[c * step];
+            dst[c].r = px.r;
+            dst[c].g = px.g;
+            dst[c].b = px.b;
+            dst[c].a = 255;
+        }
+    }
+}
+
+// Split the output rows in contiguous bands, one per thread. The calling
+// thread processes the last band.
+template <typename F>
+void runBands(size_t rows, size_t threads, F&& job)
+{
+    if (threads <= 1 || rows < 2 * threads) {
+        job(0, rows);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t band = (rows + threads - 1) / threads;
+    size_t first = 0;
+    for (size_t i = 0; i < threads - 1 && first + band < rows; i++, first += band) {
+        workers.emplace_back(job, first, first + band);
+    }
+    job(first, rows);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
+
+bool yarp::sig::utils::depthToPC(const ImageOf<PixelFloat>& depth,
+                                 const IntrinsicParams& intrinsic,
+                                 PointCloud<DataXYZ>& cloud,
+                                 const PCL_ROI& roi,
+                                 size_t step_x,
+                                 size_t step_y,
+                                 size_t threads)
+{
+    ProjectionTables tables;
+    if (!prepareTables(depth, intrinsic, roi, step_x, step_y, tables)) {
+        return false;
+    }
+
+    cloud.resize(tables.width, tables.height);
+    DataXYZ* out = &cloud(0);
+    runBands(tables.height, threads, [&](size_t first, size_t last) {
+        projectRows(depth, tables, out, first, last);
+    });
+    return true;
+}
+
+bool yarp::sig::utils::depthRgbToPC(const ImageOf<PixelFloat>& depth,
+                                    const ImageOf<PixelRgb>& color,
+                                    const IntrinsicParams& intrinsic,
+                                    PointCloud<DataXYZRGBA>& cloud,
+                                    const PCL_ROI& roi,
+                                    size_t step_x,
+                                    size_t step_y,
+                                    size_t threads)
+{
+    if (depth.width() != color.width() || depth.height() != color.height()) {
+        yError("depthRgbToPC: depth (%zux%zu) and color (%zux%zu) images must have the same size",
+               depth.width(), depth.height(), color.width(), color.height());
+        return false;
+    }
+
+    ProjectionTables tables;
+    if (!prepareTables(depth, intrinsic, roi, step_x, step_y, tables)) {
+        return false;
+    }
+
+    cloud.resize(tables.width, tables.height);
+    DataXYZRGBA* out = &cloud(0);
+    runBands(tables.height, threads, [&](size_t first, size_t last) {
+        projectRowsRgb(depth, color, tables, out, first, last);
+    });
+    return true;
+}
+
+PointCloud<DataXYZ> yarp::sig::utils::depthToPC(const ImageOf<PixelFloat>& depth,
+                                                const IntrinsicParams& intrinsic)
+{
+    PointCloud<DataXYZ> cloud;
+    depthToPC(depth, intrinsic, cloud);
+    return cloud;
+}
@@ -15,13 +15,204 @@
 #include <yarp/os/Time.h>
 #include <yarp/os/Value.h>
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using namespace yarp::sig;
 using namespace yarp::os;
 
-#define HELPER(x) (*((FlexImage*)(x)))
+namespace {
+
+/**
+ * A part of a sound: a window of samples of an image with one row per
+ * channel. Images are shared between sounds (copies, appended sounds and
+ * sub-sounds) and are copied only when a sound sharing them is modified.
+ */
+struct SoundChunk
+{
+    std::shared_ptr<FlexImage> image;
+    size_t first;       // first sample of the chunk in the image
+    size_t samples;     // number of samples of the chunk
+
+    unsigned char* address(size_t sample, size_t channel) const {
+        return image->getPixelAddress(first + sample, channel);
+    }
+};
+
+class SoundStorage
+{
+public:
+    std::vector<SoundChunk> chunks;
+    std::vector<size_t> starts;     // first sample of each chunk in the sound
+    size_t samples;
+    size_t channels;
+
+    // write() and getRawData() merge the chunks of a const sound, so the
+    // other accessors of const sounds hold this while reading the chunks.
+    mutable std::mutex mutex;
+
+    SoundStorage() : samples(0), channels(0) {}
+
+    SoundStorage& operator=(const SoundStorage& alt) {
+        if (&alt != this) {
+            std::lock_guard<std::mutex> lock(alt.mutex);
+            chunks = alt.chunks;
+            starts = alt.starts;
+            samples = alt.samples;
+            channels = alt.channels;
+        }
+        return *this;
+    }
+
+    static std::shared_ptr<FlexImage> createImage(size_t samples, size_t channels) {
+        std::shared_ptr<FlexImage> img = std::make_shared<FlexImage>();
+        img->setPixelCode(VOCAB_PIXEL_MONO16);
+        img->setQuantum(2);
+        img->resize(samples, channels);
+        return img;
+    }
+
+    void reset(const std::shared_ptr<FlexImage>& img, size_t samples, size_t channels) {
+        chunks.clear();
+        starts.clear();
+        SoundChunk chunk;
+        chunk.image = img;
+        chunk.first = 0;
+        chunk.samples = samples;
+        chunks.push_back(chunk);
+        starts.push_back(0);
+        this->samples = samples;
+        this->channels = channels;
+    }
+
+    void push(const SoundChunk& chunk) {
+        if (chunk.samples == 0) {
+            return;
+        }
+        chunks.push_back(chunk);
+        starts.push_back(samples);
+        samples += chunk.samples;
+    }
+
+    size_t find(size_t sample) const {
+        if (chunks.size() == 1) {
+            return 0;
+        }
+        return (std::upper_bound(starts.begin(), starts.end(), sample) - starts.begin()) - 1;
+    }
+
+    // true if the sound is a single image without unused samples, as the
+    // contiguous accessors require. If the samples will be modified, the
+    // image must also not be shared.
+    bool isCompact(bool writable = true) const {
+        return chunks.size() == 1 &&
+               chunks[0].first == 0 &&
+               chunks[0].image->width() == samples &&
+               (!writable || chunks[0].image.use_count() == 1);
+    }
+
+    // copy the samples of the chunks in a single image
+    void compact(bool writable = true) {
+        if (isCompact(writable)) {
+            return;
+        }
+        std::shared_ptr<FlexImage> img = createImage(samples, channels);
+        size_t at = 0;
+        for (size_t i = 0; i < chunks.size(); i++) {
+            const SoundChunk& chunk = chunks[i];
+            for (size_t ch = 0; ch < channels; ch++) {
+                memcpy(img->getPixelAddress(at, ch), chunk.address(0, ch), chunk.samples * 2);
+            }
+            at += chunk.samples;
+        }
+        reset(img, samples, channels);
+    }
+
+    // the address of a sample that can be modified
+    unsigned char* writableAddress(size_t sample, size_t channel) {
+        size_t k = find(sample);
+        SoundChunk& chunk = chunks[k];
+        if (chunk.image.use_count() > 1) {
+            std::shared_ptr<FlexImage> img = createImage(chunk.samples, channels);
+            for (size_t ch = 0; ch < channels; ch++) {
+                memcpy(img->getPixelAddress(0, ch), chunk.address(0, ch), chunk.samples * 2);
+            }
+            chunk.image = img;
+            chunk.first = 0;
+        }
+        return chunk.address(sample - starts[k], channel);
+    }
+
+    // room for the given number of samples at the end of the sound, in an
+    // image that grows geometrically
+    SoundChunk& reserveTail(size_t count) {
+        if (!chunks.empty()) {
+            SoundChunk& tail = chunks.back();
+            if (tail.image.use_count() == 1 &&
+                tail.first + tail.samples + count <= tail.image->width()) {
+                return tail;
+            }
+            if (tail.samples == 0) {
+                chunks.pop_back();
+                starts.pop_back();
+            }
+        }
+        size_t capacity = std::max(count, samples);
+        SoundChunk chunk;
+        chunk.image = createImage(capacity, channels);
+        chunk.first = 0;
+        chunk.samples = 0;
+        chunks.push_back(chunk);
+        starts.push_back(samples);
+        return chunks.back();
+    }
+};
+
+// Conversion between interleaved samples and the rows of a chunk. The
+// inner loops run on contiguous memory, so that they can be vectorized.
+void deinterleave(const std::int16_t* data, size_t samples, size_t channels,
+                  const SoundChunk& chunk, size_t at)
+{
+    for (size_t ch = 0; ch < channels; ch++) {
+        NetUint16* row = reinterpret_cast<NetUint16*>(chunk.address(at, ch));
+        const std::int16_t* in = data + ch;
+        if (channels == 1) {
+            for (size_t i = 0; i < samples; i++) {
+                row[i] = in[i];
+            }
+        } else {
+            for (size_t i = 0; i < samples; i++) {
+                row[i] = in[i * channels];
+            }
+        }
+    }
+}
+
+void interleave(const SoundChunk& chunk, size_t at, size_t samples, size_t channels,
+                std::int16_t* data)
+{
+    for (size_t ch = 0; ch < channels; ch++) {
+        const NetUint16* row = reinterpret_cast<const NetUint16*>(chunk.address(at, ch));
+        std::int16_t* out = data + ch;
+        if (channels == 1) {
+            for (size_t i = 0; i < samples; i++) {
+                out[i] = row[i];
+            }
+        } else {
+            for (size_t i = 0; i < samples; i++) {
+                out[i * channels] = row[i];
+            }
+        }
+    }
+}
+
+} // namespace
+
+#define HELPER(x) (*((SoundStorage*)(x)))
 
 Sound::Sound(int bytesPerSample) {
     init(bytesPerSample);
@@ -30,9 +221,7 @@ Sound::Sound(int bytesPerSample) {
 
 Sound::Sound(const Sound& alt) : yarp::os::Portable() {
     init(alt.getBytesPerSample());
-    FlexImage& img1 = HELPER(implementation);
-    FlexImage& img2 = HELPER(alt.implementation);
-    img1.copy(img2);
+    HELPER(implementation) = HELPER(alt.implementation);
     frequency = alt.frequency;
     synchronize();
 }
@@ -49,26 +238,16 @@ Sound& Sound::operator += (const Sound& alt) {
         return *this;
     }
 
-    Sound orig= *this;
-    this->resize(this->samples+alt.samples,channels);
-
-    unsigned char* p1    = orig.getRawData();
-    unsigned char* p2    = alt.getRawData();
-    unsigned char* pout  = this->getRawData();
-
-    for (size_t ch=0; ch<channels; ch++)
+    // the chunks of the other sound are shared, not copied
+    SoundStorage& storage = HELPER(implementation);
+    std::vector<SoundChunk> altChunks;
     {
-        size_t out1 = ch* this->getBytesPerSample() * this->samples;
-        size_t out2 = ch* this->getBytesPerSample() * this->samples + this->getBytesPerSample() * orig.samples;
-
-        size_t ori1 = ch * orig.getBytesPerSample() * orig.samples;
-        size_t s1   = orig.getBytesPerSample() * orig.samples;
-
-        size_t alt1 = ch * orig.getBytesPerSample() * alt.samples;
-        unsigned int s2 = alt.getBytesPerSample() * alt.samples;
-
-        memcpy((void *) &pout[out1], (void *) (p1+ori1), s1);
-        memcpy((void *) &pout[out2], (void *) (p2+alt1), s2);
+        const SoundStorage& altStorage = HELPER(alt.implementation);
+        std::lock_guard<std::mutex> lock(altStorage.mutex);
+        altChunks = altStorage.chunks;
+    }
+    for (size_t i = 0; i < altChunks.size(); i++) {
+        storage.push(altChunks[i]);
     }
 
     this->synchronize();
@@ -77,18 +256,18 @@ Sound& Sound::operator += (const Sound& alt) {
 
 const Sound& Sound::operator = (const Sound& alt) {
     yAssert(getBytesPerSample()==alt.getBytesPerSample());
-    FlexImage& img1 = HELPER(implementation);
-    FlexImage& img2 = HELPER(alt.implementation);
-    img1.copy(img2);
+    if (&alt != this) {
+        HELPER(implementation) = HELPER(alt.implementation);
+    }
     frequency = alt.frequency;
     synchronize();
     return *this;
 }
 
 void Sound::synchronize() {
-    FlexImage& img = HELPER(implementation);
-    samples = img.width();
-    channels = img.height();
+    SoundStorage& storage = HELPER(implementation);
+    samples = storage.samples;
+    channels = storage.channels;
 }
 
 Sound Sound::subSound(size_t first_sample, size_t last_sample)
@@ -101,28 +280,22 @@ Sound Sound::subSound(size_t first_sample, size_t last_sample)
         last_sample = first_sample;
 
     Sound s;
-
-    s.resize(last_sample-first_sample, this->channels);
     s.setFrequency(this->frequency);
 
-    /*
-    //faster implementation but currently not working
-    unsigned char* p1    = this->getRawData();
-    unsigned char* p2    = s.getRawData();
-    int j=0;
-    for (int i=first_sample; i<last_sample*2; i++)
-    {
-        p2[j++]=p1[i];
-    }
-    */
-
-    //safe implementation
-    size_t j=0;
-    for (size_t i=first_sample; i<last_sample; i++)
-    {
-        for (size_t c=0; c< this->channels; c++)
-            s.set(this->get(i,c),j,c);
-        j++;
+    // the sub-sound shares the samples of this sound
+    SoundStorage& storage = HELPER(implementation);
+    SoundStorage& sub = HELPER(s.implementation);
+    sub.channels = this->channels;
+    for (size_t k = 0; k < storage.chunks.size(); k++) {
+        size_t begin = std::max(first_sample, storage.starts[k]);
+        size_t end = std::min(last_sample, storage.starts[k] + storage.chunks[k].samples);
+        if (begin >= end) {
+            continue;
+        }
+        SoundChunk chunk = storage.chunks[k];
+        chunk.first += begin - storage.starts[k];
+        chunk.samples = end - begin;
+        sub.push(chunk);
     }
 
     s.synchronize();
@@ -131,12 +304,10 @@ Sound Sound::subSound(size_t first_sample, size_t last_sample)
 }
 
 void Sound::init(size_t bytesPerSample) {
-    implementation = new FlexImage();
+    implementation = new SoundStorage();
     yAssert(implementation!=nullptr);
 
     yAssert(bytesPerSample==2); // that's all that's implemented right now
-    HELPER(implementation).setPixelCode(VOCAB_PIXEL_MONO16);
-    HELPER(implementation).setQuantum(2);
 
     samples = 0;
     channels = 0;
@@ -151,14 +322,19 @@ Sound::~Sound() {
 }
 
 void Sound::resize(size_t samples, size_t channels) {
-    FlexImage& img = HELPER(implementation);
-    img.resize(samples,channels);
+    SoundStorage& storage = HELPER(implementation);
+    if (storage.isCompact() && storage.samples == samples && storage.channels == channels) {
+        return;
+    }
+    storage.reset(SoundStorage::createImage(samples, channels), samples, channels);
     synchronize();
 }
 
 int Sound::get(size_t location, size_t channel) const {
-    FlexImage& img = HELPER(implementation);
-    unsigned char *addr = img.getPixelAddress(location,channel);
+    const SoundStorage& storage = HELPER(implementation);
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    size_t k = storage.find(location);
+    unsigned char *addr = storage.chunks[k].address(location - storage.starts[k], channel);
     if (bytesPerSample==2) {
         return *(reinterpret_cast<NetUint16*>(addr));
     }
@@ -174,8 +350,7 @@ void Sound::clear()
 }
 
 void Sound::set(int value, size_t location, size_t channel) {
-    FlexImage& img = HELPER(implementation);
-    unsigned char *addr = img.getPixelAddress(location,channel);
+    unsigned char *addr = HELPER(implementation).writableAddress(location,channel);
     if (bytesPerSample==2) {
         *(reinterpret_cast<NetUint16*>(addr)) = value;
         return;
@@ -183,6 +358,39 @@ void Sound::set(int value, size_t location, size_t channel) {
     yInfo("sound only implemented for 16 bit samples");
 }
 
+void Sound::setInterleaved(const std::int16_t* data, size_t samples, size_t channels) {
+    resize(samples, channels);
+    SoundStorage& storage = HELPER(implementation);
+    deinterleave(data, samples, channels, storage.chunks[0], 0);
+}
+
+void Sound::appendInterleaved(const std::int16_t* data, size_t samples) {
+    if (samples == 0) {
+        return;
+    }
+    SoundStorage& storage = HELPER(implementation);
+    SoundChunk& tail = storage.reserveTail(samples);
+    deinterleave(data, samples, channels, tail, tail.samples);
+    tail.samples += samples;
+    storage.samples += samples;
+    synchronize();
+}
+
+void Sound::getInterleaved(std::int16_t* data, size_t first_sample, size_t samples) const {
+    const SoundStorage& storage = HELPER(implementation);
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    size_t last_sample = std::min(first_sample + samples, this->samples);
+    for (size_t k = 0; k < storage.chunks.size(); k++) {
+        size_t begin = std::max(first_sample, storage.starts[k]);
+        size_t end = std::min(last_sample, storage.starts[k] + storage.chunks[k].samples);
+        if (begin >= end) {
+            continue;
+        }
+        interleave(storage.chunks[k], begin - storage.starts[k], end - begin, channels,
+                   data + (begin - first_sample) * channels);
+    }
+}
+
 size_t Sound::getFrequency() const {
     return frequency;
 }
@@ -193,10 +401,11 @@ void Sound::setFrequency(size_t freq) {
 
 bool Sound::read(ConnectionReader& connection) {
     // lousy format - fix soon!
-    FlexImage& img = HELPER(implementation);
+    std::shared_ptr<FlexImage> img = SoundStorage::createImage(0, 0);
     Bottle bot;
-    bool ok = PortablePair<FlexImage,Bottle>::readPair(connection,img,bot);
+    bool ok = PortablePair<FlexImage,Bottle>::readPair(connection,*img,bot);
     frequency = bot.get(0).asInt32();
+    HELPER(implementation).reset(img, img->width(), img->height());
     synchronize();
     return ok;
 }
@@ -204,18 +413,21 @@ bool Sound::read(ConnectionReader& connection) {
 
 bool Sound::write(ConnectionWriter& connection) const {
     // lousy format - fix soon!
-    FlexImage& img = HELPER(implementation);
+    SoundStorage& storage = HELPER(implementation);
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    storage.compact(false);
     Bottle bot;
     bot.addInt32(frequency);
-    return PortablePair<FlexImage,Bottle>::writePair(connection,img,bot);
+    return PortablePair<FlexImage,Bottle>::writePair(connection,*storage.chunks[0].image,bot);
 }
 
 unsigned char *Sound::getRawData() const {
-    FlexImage& img = HELPER(implementation);
-    return img.getRawImage();
+    SoundStorage& storage = HELPER(implementation);
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    storage.compact();
+    return storage.chunks[0].image->getRawImage();
 }
 
 size_t Sound::getRawDataSize() const {
-    FlexImage& img = HELPER(implementation);
-    return img.getRawImageSize();
+    return samples * channels * bytesPerSample;
 }
@@ -342,6 +342,15 @@ bool yarpdataplayer_IDL::quit() {
   return ok?helper._return:_return;
 }
 
+// FNV-1a hash of the tag of a command, used to dispatch it
+static std::uint32_t yarpdataplayer_IDL_tagHash(const std::string& tag) {
+  std::uint32_t hash = 2166136261U;
+  for (char c : tag) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+  }
+  return hash;
+}
+
 bool yarpdataplayer_IDL::read(yarp::os::ConnectionReader& connection) {
   yarp::os::idl::WireReader reader(connection);
   reader.expectAccept();
@@ -350,135 +359,154 @@ bool yarpdataplayer_IDL::read(yarp::os::ConnectionReader& connection) {
   bool direct = (tag=="__direct__");
   if (direct) tag = reader.readTag();
   while (!reader.isError()) {
-    // TODO: use quick lookup, this is just a test
-    if (tag == "step") {
-      bool _return;
-      _return = step();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "setFrame") {
-      std::string name;
-      std::int32_t frameNum;
-      if (!reader.readString(name)) {
-        reader.fail();
-        return false;
-      }
-      if (!reader.readI32(frameNum)) {
-        reader.fail();
-        return false;
-      }
-      bool _return;
-      _return = setFrame(name,frameNum);
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "getFrame") {
-      std::string name;
-      if (!reader.readString(name)) {
-        reader.fail();
-        return false;
-      }
-      std::int32_t _return;
-      _return = getFrame(name);
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeI32(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "load") {
-      std::string path;
-      if (!reader.readString(path)) {
-        reader.fail();
-        return false;
+    switch (yarpdataplayer_IDL_tagHash(tag)) {
+    case 3343129103U:
+      if (tag == "step") {
+        bool _return;
+        _return = step();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      bool _return;
-      _return = load(path);
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 3970545608U:
+      if (tag == "setFrame") {
+        std::string name;
+        std::int32_t frameNum;
+        if (!reader.readString(name)) {
+          reader.fail();
+          return false;
+        }
+        if (!reader.readI32(frameNum)) {
+          reader.fail();
+          return false;
+        }
+        bool _return;
+        _return = setFrame(name,frameNum);
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "play") {
-      bool _return;
-      _return = play();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 2231471836U:
+      if (tag == "getFrame") {
+        std::string name;
+        if (!reader.readString(name)) {
+          reader.fail();
+          return false;
+        }
+        std::int32_t _return;
+        _return = getFrame(name);
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeI32(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "pause") {
-      bool _return;
-      _return = pause();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 3859241449U:
+      if (tag == "load") {
+        std::string path;
+        if (!reader.readString(path)) {
+          reader.fail();
+          return false;
+        }
+        bool _return;
+        _return = load(path);
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "stop") {
-      bool _return;
-      _return = stop();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 3268139107U:
+      if (tag == "play") {
+        bool _return;
+        _return = play();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "quit") {
-      bool _return;
-      _return = quit();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 1887753101U:
+      if (tag == "pause") {
+        bool _return;
+        _return = pause();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "help") {
-      std::string functionName;
-      if (!reader.readString(functionName)) {
-        functionName = "--all";
+      break;
+    case 3411225317U:
+      if (tag == "stop") {
+        bool _return;
+        _return = stop();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      std::vector<std::string> _return=help(functionName);
-      yarp::os::idl::WireWriter writer(reader);
+      break;
+    case 1200064310U:
+      if (tag == "quit") {
+        bool _return;
+        _return = quit();
+        yarp::os::idl::WireWriter writer(reader);
         if (!writer.isNull()) {
-          if (!writer.writeListHeader(2)) return false;
-          if (!writer.writeTag("many",1, 0)) return false;
-          if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
-          std::vector<std::string> ::iterator _iterHelp;
-          for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
-          {
-            if (!writer.writeString(*_iterHelp)) return false;
-           }
-          if (!writer.writeListEnd()) return false;
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
+      }
+      break;
+    case 946971642U:
+      if (tag == "help") {
+        std::string functionName;
+        if (!reader.readString(functionName)) {
+          functionName = "--all";
         }
-      reader.accept();
-      return true;
+        std::vector<std::string> _return=help(functionName);
+        yarp::os::idl::WireWriter writer(reader);
+          if (!writer.isNull()) {
+            if (!writer.writeListHeader(2)) return false;
+            if (!writer.writeTag("many",1, 0)) return false;
+            if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
+            std::vector<std::string> ::iterator _iterHelp;
+            for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
+            {
+              if (!writer.writeString(*_iterHelp)) return false;
+             }
+            if (!writer.writeListEnd()) return false;
+          }
+        reader.accept();
+        return true;
+      }
+      break;
     }
     if (reader.noMore()) { reader.fail(); return false; }
     std::string next_tag = reader.readTag();
@@ -171,6 +171,15 @@ int WorkerClass::sendImages(int part, int frame)
         code = Vocab::encode(tmp);
     }
     
+    // let the OS load the next frame while this one is decoded and sent
+    if (static_cast<size_t>(frame + 1) < utilities->partDetails[part].bot.size()) {
+        Bottle* next = utilities->partDetails[part].bot.get(frame + 1).asList();
+        if (next) {
+            int nameIndex = utilities->withExtraColumn ? 1 : 0;
+            prefetch(tmpPath + next->tail().tail().get(nameIndex).asString());
+        }
+    }
+
     tmpPath = tmpPath + tmpName;
     unique_ptr<Image> img_yarp = nullptr;
 
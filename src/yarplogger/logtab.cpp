@@ -27,6 +27,7 @@ LogTab::LogTab(yarp::yarpLogger::LoggerEngine*  _theLogger, MessageWidget* _syst
     portName(_portName),
     theLogger(_theLogger),
     system_message(_system_message),
+    lastMessage(-1),
     displayYarprunTimestamp_enabled(true),
     displayLocalTimestamp_enabled(true),
     displayErrorLevel_enabled(true),
@@ -156,29 +157,31 @@ void LogTab::updateLog(bool from_beginning)
     */
 
     mutex.lock();
-    std::list<yarp::yarpLogger::MessageEntry> messages;
-    this->theLogger->get_messages_by_port_complete(portName,messages, from_beginning);
-    std::list<yarp::yarpLogger::MessageEntry>::iterator it;
+    if (from_beginning)
+    {
+        lastMessage = -1;
+    }
     QStandardItem *rootNode = model_logs->invisibleRootItem();
-    for (it=messages.begin(); it!=messages.end(); it++)
+    this->theLogger->visit_messages_by_port_complete(portName, lastMessage, [&](const yarp::yarpLogger::MessageEntry& entry)
     {
+        yarp::yarpLogger::LogLevel level = entry.level;
         QList<QStandardItem *> rowItem;
         QColor rowbgcolor = QColor(Qt::white);
         QColor rowfgcolor = QColor(Qt::black);
         std:: string error_level;
-        if      (it->level==yarp::yarpLogger::LOGLEVEL_UNDEFINED) { rowbgcolor = QColor(Qt::white);  error_level="";     }
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_TRACE)     { rowbgcolor = QColor("#FF70FF");  error_level=TRACE_STRING;}
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_DEBUG)     { rowbgcolor = QColor("#7070FF");  error_level=DEBUG_STRING;}
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_INFO)      { rowbgcolor = QColor("#70FF70");  error_level=INFO_STRING; }
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_WARNING)   { rowbgcolor = QColor("#FFFF70");  error_level=WARNING_STRING; }
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_ERROR)     { rowbgcolor = QColor("#FF7070");  error_level=ERROR_STRING;}
-        else if (it->level==yarp::yarpLogger::LOGLEVEL_FATAL)     { rowbgcolor = QColor(Qt::black);  rowfgcolor = QColor(Qt::white);  error_level=FATAL_STRING;}
-        else                                                      { rowbgcolor = QColor(Qt::white);  error_level="";     }
-
-        std::string textWithoutNewLines = it->text;
+        if      (level==yarp::yarpLogger::LOGLEVEL_UNDEFINED) { rowbgcolor = QColor(Qt::white);  error_level="";     }
+        else if (level==yarp::yarpLogger::LOGLEVEL_TRACE)     { rowbgcolor = QColor("#FF70FF");  error_level=TRACE_STRING;}
+        else if (level==yarp::yarpLogger::LOGLEVEL_DEBUG)     { rowbgcolor = QColor("#7070FF");  error_level=DEBUG_STRING;}
+        else if (level==yarp::yarpLogger::LOGLEVEL_INFO)      { rowbgcolor = QColor("#70FF70");  error_level=INFO_STRING; }
+        else if (level==yarp::yarpLogger::LOGLEVEL_WARNING)   { rowbgcolor = QColor("#FFFF70");  error_level=WARNING_STRING; }
+        else if (level==yarp::yarpLogger::LOGLEVEL_ERROR)     { rowbgcolor = QColor("#FF7070");  error_level=ERROR_STRING;}
+        else if (level==yarp::yarpLogger::LOGLEVEL_FATAL)     { rowbgcolor = QColor(Qt::black);  rowfgcolor = QColor(Qt::white);  error_level=FATAL_STRING;}
+        else                                                  { rowbgcolor = QColor(Qt::white);  error_level="";     }
+
+        std::string textWithoutNewLines = entry.text;
         textWithoutNewLines.erase(textWithoutNewLines.find_last_not_of(" \n\r\t")+1);
         //using numbers seems not to work. Hence I'm using strings.
-        rowItem << new QStandardItem(it->yarprun_timestamp.c_str()) << new QStandardItem(it->local_timestamp.c_str()) << new QStandardItem(error_level.c_str()) << new QStandardItem(textWithoutNewLines.c_str());
+        rowItem << new QStandardItem(entry.yarprun_timestamp.c_str()) << new QStandardItem(entry.local_timestamp.c_str()) << new QStandardItem(error_level.c_str()) << new QStandardItem(textWithoutNewLines.c_str());
 
         if (displayColors_enabled)
         {
@@ -189,7 +192,7 @@ void LogTab::updateLog(bool from_beginning)
             }
         }
         rootNode->appendRow(rowItem);
-    }
+    });
     ui->listView->setColumnHidden(0,!displayYarprunTimestamp_enabled);
     ui->listView->setColumnHidden(1,!displayLocalTimestamp_enabled);
     ui->listView->setColumnHidden(2,!displayErrorLevel_enabled);
@@ -54,6 +54,7 @@ private:
     yarp::yarpLogger::LoggerEngine* theLogger;
     MessageWidget*                         system_message;
     QMutex                                 mutex;
+    long long                              lastMessage;
     bool                                   displayYarprunTimestamp_enabled;
     bool                                   displayLocalTimestamp_enabled;
     bool                                   displayErrorLevel_enabled;
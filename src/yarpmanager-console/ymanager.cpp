@@ -241,6 +241,9 @@ YConsoleManager::YConsoleManager(int argc, char* argv[]) : Manager()
     else
         disableAutoConnect();
 
+    if(config.check("max_parallel_starts"))
+        setMaxParallelStarts(config.find("max_parallel_starts").asInt32());
+
     if(!config.check("silent"))
     {
         cout<<endl<<OKGREEN<<LOGO_MESSAGE<<ENDC<<endl;
@@ -147,6 +147,12 @@ public:
         for (RobotInterface::ParamList::const_iterator it = p.begin(); it != p.end(); ++it) {
             const RobotInterface::Param &param = *it;
 
+            // "open-after" is used by yarprobotinterface to order the
+            // opening of the devices and it is not a device parameter
+            if (param.name() == "open-after") {
+                continue;
+            }
+
             // check if parentheses are balanced
             std::string stringFormatValue = param.value();
             int counter = 0;
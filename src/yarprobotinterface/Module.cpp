@@ -27,6 +27,8 @@
 #include <yarp/os/ResourceFinder.h>
 #include <yarp/os/RpcServer.h>
 
+#include <cstdlib>
+
 class RobotInterface::Module::Private
 {
 public:
@@ -88,6 +90,21 @@ bool RobotInterface::Module::configure(yarp::os::ResourceFinder &rf)
     mPriv->robot.setVerbose(verbosity);
     mPriv->robot.setAllowDeprecatedDevices(rf.check("allow-deprecated-devices"));
 
+    // The devices are opened one at a time, unless more parallel opens are
+    // allowed on the command line or by the "max-parallel-opens" parameter
+    // of the robot
+    int maxParallelOpens = 1;
+    if (rf.check("max-parallel-opens")) {
+        maxParallelOpens = rf.find("max-parallel-opens").asInt32();
+    } else if (RobotInterface::hasParam(mPriv->robot.params(), "max-parallel-opens")) {
+        maxParallelOpens = std::atoi(RobotInterface::findParam(mPriv->robot.params(), "max-parallel-opens").c_str());
+    }
+    if (maxParallelOpens < 1) {
+        yWarning() << "Invalid max-parallel-opens" << maxParallelOpens << ", opening the devices one at a time";
+        maxParallelOpens = 1;
+    }
+    mPriv->robot.setMaxParallelOpens(static_cast<unsigned int>(maxParallelOpens));
+
     std::string rpcPortName("/" + getName() + "/yarprobotinterface");
     mPriv->rpcPort.open(rpcPortName);
     attach(mPriv->rpcPort);
@@ -22,6 +22,7 @@
 #include "Param.h"
 
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
 
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/dev/PolyDriverList.h>
@@ -29,6 +30,13 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#define PARALLEL_OPENS  1
 
 
 std::ostringstream& operator<<(std::ostringstream &oss, const RobotInterface::Robot &t)
@@ -55,7 +63,8 @@ public:
     Private(Robot * /*parent*/) :
             build(0),
                 currentPhase(ActionPhaseUnknown),
-        currentLevel(0)
+        currentLevel(0),
+        maxParallelOpens(PARALLEL_OPENS)
     {
     }
 
@@ -65,6 +74,10 @@ public:
     // return the device with the given name or <fatal error> if not found
     Device* findDevice(const std::string &name);
 
+    // return, for each device, the indexes of the devices that must be
+    // opened before it
+    std::vector<std::set<size_t> > getOpenDependencies() const;
+
     // open all the devices and return true if all the open calls were successful
     bool openDevices();
 
@@ -106,6 +119,7 @@ public:
     DeviceList devices;
     RobotInterface::ActionPhase currentPhase;
     unsigned int currentLevel;
+    unsigned int maxParallelOpens;
 }; // class RobotInterface::Robot::Private
 
 bool RobotInterface::Robot::Private::hasDevice(const std::string &name) const
@@ -129,22 +143,175 @@ RobotInterface::Device* RobotInterface::Robot::Private::findDevice(const std::st
     return nullptr;
 }
 
+std::vector<std::set<size_t> > RobotInterface::Robot::Private::getOpenDependencies() const
+{
+    std::vector<std::set<size_t> > deps(devices.size());
+
+    std::map<std::string, size_t> index;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        index[devices[i].name()] = i;
+    }
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        const Device &device = devices[i];
+        std::vector<std::string> targets;
+
+        // Explicit dependencies
+        if (device.hasParam("open-after")) {
+            yarp::os::Value v;
+            v.fromString(device.findParam("open-after").c_str());
+            if (v.isList()) {
+                for (size_t j = 0; j < v.asList()->size(); ++j) {
+                    targets.push_back(v.asList()->get(j).toString());
+                }
+            } else {
+                targets.push_back(v.toString());
+            }
+        }
+
+        // Devices used by the actions of this device
+        for (ActionList::const_iterator ait = device.actions().begin(); ait != device.actions().end(); ++ait) {
+            const ParamList &params = ait->params();
+            switch (ait->type()) {
+            case ActionTypeAttach:
+                if (RobotInterface::hasParam(params, "all")) {
+                    for (size_t j = 0; j < devices.size(); ++j) {
+                        targets.push_back(devices[j].name());
+                    }
+                } else if (RobotInterface::hasParam(params, "device")) {
+                    targets.push_back(RobotInterface::findParam(params, "device"));
+                } else if (RobotInterface::hasParam(params, "networks")) {
+                    yarp::os::Value v;
+                    v.fromString(RobotInterface::findParam(params, "networks").c_str());
+                    if (v.isList()) {
+                        for (size_t j = 0; j < v.asList()->size(); ++j) {
+                            std::string network = v.asList()->get(j).toString();
+                            if (RobotInterface::hasParam(params, network)) {
+                                targets.push_back(RobotInterface::findParam(params, network));
+                            }
+                        }
+                    }
+                }
+                break;
+            case ActionTypeCalibrate:
+            case ActionTypePark:
+                if (RobotInterface::hasParam(params, "target")) {
+                    targets.push_back(RobotInterface::findParam(params, "target"));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Unknown devices are reported by the actions themselves
+        for (std::vector<std::string>::const_iterator tit = targets.begin(); tit != targets.end(); ++tit) {
+            std::map<std::string, size_t>::const_iterator it = index.find(*tit);
+            if (it != index.end() && it->second != i) {
+                deps[i].insert(it->second);
+            }
+        }
+    }
+
+    return deps;
+}
+
 bool RobotInterface::Robot::Private::openDevices()
 {
+    std::vector<std::set<size_t> > deps = getOpenDependencies();
+
+    // Devices are opened as soon as all the devices they depend on are
+    // open, by a pool of threads. When several devices can be opened, the
+    // ones declared first in the xml file are opened first.
+    std::vector<std::vector<size_t> > dependents(devices.size());
+    std::vector<size_t> pending(devices.size());
+    for (size_t i = 0; i < devices.size(); ++i) {
+        pending[i] = deps[i].size();
+        for (std::set<size_t>::const_iterator it = deps[i].begin(); it != deps[i].end(); ++it) {
+            dependents[*it].push_back(i);
+        }
+    }
+
+    std::set<size_t> ready;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (pending[i] == 0) {
+            ready.insert(i);
+        }
+    }
+
+    std::vector<bool> scheduled(devices.size(), false);
+    std::vector<double> openTimes(devices.size(), 0.0);
+    size_t remaining = devices.size();
+    size_t running = 0;
     bool ret = true;
-    for (RobotInterface::DeviceList::iterator it = devices.begin(); it != devices.end(); ++it) {
-        RobotInterface::Device &device = *it;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (remaining > 0) {
+            if (ready.empty()) {
+                if (running > 0) {
+                    changed.wait(lock);
+                    continue;
+                }
+                // Nothing is running and nothing can be opened: the
+                // dependencies contain a cycle, that is broken by opening
+                // the first device left.
+                size_t first = std::find(scheduled.begin(), scheduled.end(), false) - scheduled.begin();
+                yWarning() << "Circular dependency between devices involving" << devices[first].name() << ". Opening it anyway.";
+                ready.insert(first);
+            }
 
-        // yDebug() << device;
+            size_t id = *ready.begin();
+            ready.erase(ready.begin());
+            scheduled[id] = true;
+            ++running;
+            RobotInterface::Device &device = devices[id];
+
+            lock.unlock();
+            double start = yarp::os::Time::now();
+            bool ok = device.open();
+            double elapsed = yarp::os::Time::now() - start;
+            lock.lock();
+
+            openTimes[id] = elapsed;
+            if (ok) {
+                yInfo() << "Device" << device.name() << "opened in" << elapsed << "s";
+            } else {
+                yWarning() << "Cannot open device" << device.name();
+                ret = false;
+            }
 
-        if (!device.open()) {
-            yWarning() << "Cannot open device" << device.name();
-            ret = false;
+            for (std::vector<size_t>::const_iterator it = dependents[id].begin(); it != dependents[id].end(); ++it) {
+                if (--pending[*it] == 0 && !scheduled[*it]) {
+                    ready.insert(*it);
+                }
+            }
+            --running;
+            --remaining;
+            changed.notify_all();
         }
+    };
 
+    double start = yarp::os::Time::now();
+    size_t nThreads = std::min<size_t>(std::max(maxParallelOpens, 1u), devices.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it->join();
     }
+
+    double total = 0.0;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        total += openTimes[i];
+    }
+
     if (ret) {
-        // yDebug() << "All devices opened.";
+        yInfo() << "All devices opened in" << yarp::os::Time::now() - start << "s (" << total << "s if opened one at a time)";
     } else {
         yWarning() << "There was some problem opening one or more devices. Please check the log and your configuration";
     }
@@ -445,6 +612,11 @@ void RobotInterface::Robot::setVerbose(bool verbose)
     }
 }
 
+void RobotInterface::Robot::setMaxParallelOpens(unsigned int maxParallelOpens)
+{
+    mPriv->maxParallelOpens = maxParallelOpens;
+}
+
 void RobotInterface::Robot::setAllowDeprecatedDevices(bool allowDeprecatedDevices)
 {
     for (DeviceList::iterator dit = devices().begin(); dit != devices().end(); ++dit) {
@@ -40,6 +40,7 @@ public:
 
     void setVerbose(bool verbose);
     void setAllowDeprecatedDevices(bool allowDeprecatedDevices);
+    void setMaxParallelOpens(unsigned int maxParallelOpens);
 
     ParamList& params();
     DeviceList& devices();
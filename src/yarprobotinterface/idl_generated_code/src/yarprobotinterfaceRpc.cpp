@@ -291,6 +291,15 @@ std::string yarprobotinterfaceRpc::exit() {
   return ok?helper._return:_return;
 }
 
+// FNV-1a hash of the tag of a command, used to dispatch it
+static std::uint32_t yarprobotinterfaceRpc_tagHash(const std::string& tag) {
+  std::uint32_t hash = 2166136261U;
+  for (char c : tag) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+  }
+  return hash;
+}
+
 bool yarprobotinterfaceRpc::read(yarp::os::ConnectionReader& connection) {
   yarp::os::idl::WireReader reader(connection);
   reader.expectAccept();
@@ -299,104 +308,121 @@ bool yarprobotinterfaceRpc::read(yarp::os::ConnectionReader& connection) {
   bool direct = (tag=="__direct__");
   if (direct) tag = reader.readTag();
   while (!reader.isError()) {
-    // TODO: use quick lookup, this is just a test
-    if (tag == "get_phase") {
-      std::string _return;
-      _return = get_phase();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeString(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "get_level") {
-      std::int32_t _return;
-      _return = get_level();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeI32(_return)) return false;
-      }
-      reader.accept();
-      return true;
-    }
-    if (tag == "get_robot") {
-      std::string _return;
-      _return = get_robot();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeString(_return)) return false;
+    switch (yarprobotinterfaceRpc_tagHash(tag)) {
+    case 515933615U:
+      if (tag == "get_phase") {
+        std::string _return;
+        _return = get_phase();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeString(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "is_ready") {
-      bool _return;
-      _return = is_ready();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeBool(_return)) return false;
+      break;
+    case 2905890894U:
+      if (tag == "get_level") {
+        std::int32_t _return;
+        _return = get_level();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeI32(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "quit") {
-      std::string _return;
-      _return = quit();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeString(_return)) return false;
+      break;
+    case 1438409216U:
+      if (tag == "get_robot") {
+        std::string _return;
+        _return = get_robot();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeString(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "bye") {
-      std::string _return;
-      _return = bye();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeString(_return)) return false;
+      break;
+    case 4074759933U:
+      if (tag == "is_ready") {
+        bool _return;
+        _return = is_ready();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeBool(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "exit") {
-      std::string _return;
-      _return = exit();
-      yarp::os::idl::WireWriter writer(reader);
-      if (!writer.isNull()) {
-        if (!writer.writeListHeader(1)) return false;
-        if (!writer.writeString(_return)) return false;
+      break;
+    case 1200064310U:
+      if (tag == "quit") {
+        std::string _return;
+        _return = quit();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeString(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      reader.accept();
-      return true;
-    }
-    if (tag == "help") {
-      std::string functionName;
-      if (!reader.readString(functionName)) {
-        functionName = "--all";
+      break;
+    case 1911791459U:
+      if (tag == "bye") {
+        std::string _return;
+        _return = bye();
+        yarp::os::idl::WireWriter writer(reader);
+        if (!writer.isNull()) {
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeString(_return)) return false;
+        }
+        reader.accept();
+        return true;
       }
-      std::vector<std::string> _return=help(functionName);
-      yarp::os::idl::WireWriter writer(reader);
+      break;
+    case 3454868101U:
+      if (tag == "exit") {
+        std::string _return;
+        _return = exit();
+        yarp::os::idl::WireWriter writer(reader);
         if (!writer.isNull()) {
-          if (!writer.writeListHeader(2)) return false;
-          if (!writer.writeTag("many",1, 0)) return false;
-          if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
-          std::vector<std::string> ::iterator _iterHelp;
-          for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
-          {
-            if (!writer.writeString(*_iterHelp)) return false;
-           }
-          if (!writer.writeListEnd()) return false;
+          if (!writer.writeListHeader(1)) return false;
+          if (!writer.writeString(_return)) return false;
         }
-      reader.accept();
-      return true;
+        reader.accept();
+        return true;
+      }
+      break;
+    case 946971642U:
+      if (tag == "help") {
+        std::string functionName;
+        if (!reader.readString(functionName)) {
+          functionName = "--all";
+        }
+        std::vector<std::string> _return=help(functionName);
+        yarp::os::idl::WireWriter writer(reader);
+          if (!writer.isNull()) {
+            if (!writer.writeListHeader(2)) return false;
+            if (!writer.writeTag("many",1, 0)) return false;
+            if (!writer.writeListBegin(BOTTLE_TAG_INT32, static_cast<uint32_t>(_return.size()))) return false;
+            std::vector<std::string> ::iterator _iterHelp;
+            for (_iterHelp = _return.begin(); _iterHelp != _return.end(); ++_iterHelp)
+            {
+              if (!writer.writeString(*_iterHelp)) return false;
+             }
+            if (!writer.writeListEnd()) return false;
+          }
+        reader.accept();
+        return true;
+      }
+      break;
     }
     if (reader.noMore()) { reader.fail(); return false; }
     std::string next_tag = reader.readTag();
@@ -21,6 +21,8 @@
 #include "yarp/os/Stamp.h"
 #include <QDebug>
 
+#include <cmath>
+
 /*! \brief Constructor of the class.
  *
  *  \param title the title of the plotter
@@ -69,6 +71,7 @@ Plotter::Plotter(const QString &title, int gridx, int gridy, int hspan, int vspa
     textLabel->setText(title);
 
     connect(customPlot.xAxis, SIGNAL(rangeChanged(QCPRange)), customPlot.xAxis2, SLOT(setRange(QCPRange)));
+    connect(customPlot.xAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(onRangeChanged(QCPRange)));
     connect(customPlot.yAxis, SIGNAL(rangeChanged(QCPRange)), customPlot.yAxis2, SLOT(setRange(QCPRange)));
 
 }
@@ -79,6 +82,26 @@ void Plotter::onInteract()
     interact = true;
 }
 
+/*! \brief Redraws the graphs when the user pans or zooms the plotter */
+void Plotter::onRangeChanged(const QCPRange &range)
+{
+    Q_UNUSED(range);
+    if (interact) {
+        updateGraphs();
+    }
+}
+
+/*! \brief Updates the points drawn by the graphs, one group of samples for each pixel of the visible range */
+void Plotter::updateGraphs()
+{
+    QCPRange range = customPlot.xAxis->range();
+    int width = customPlot.axisRect()->width();
+    for (int j=0;j < graphList.count(); j++) {
+        Graph *graph = (Graph*)graphList.at(j);
+        graph->render(range.lower, range.upper, width);
+    }
+}
+
 
 
 Plotter::~Plotter()
@@ -175,46 +198,11 @@ void Plotter::onTimeout()
         return;
     }
 
+    // the samples received by the port threads since the last timeout
     int c = graphList.count();
     for (int j=0;j < c; j++) {
         Graph *graph = (Graph*)graphList.at(j);
-        yarp::os::Bottle *b;
-        if(graph->deleteConnection){
-            b = graph->curr_connection->localPort->read(false);
-        }else{
-            b = graph->curr_connection->localPort->lastRead();
-        }
-        if (!b) {
-//             qDebug("No data received. Using previous values.");
-            graph->appendPreviousValues();
-
-        } else {
-            if (b->size() == 1 && b->get(0).isList()) {
-                b = b->get(0).asList();
-            }
-            yarp::os::Stamp stmp;
-            graph->curr_connection->localPort->getEnvelope(stmp);
-
-            if (b->size() - 1 < (size_t) graph->index) {
-                qWarning() << "bottle size =" << b->size() << " requested index =" << graph->index;
-                continue;
-            }
-
-
-            double y = (float)(b->get(graph->index).asFloat64());
-
-            float t;
-            if (graph->curr_connection->realTime && stmp.isValid()) {
-                t = (float)(stmp.getTime() - graph->curr_connection->initialTime);
-            } else {
-                t = -1.0;
-            }
-
-            graph->appendValues(y,t);
-
-        }
-
-
+        graph->acquire();
     }
 
     // if the user did not interact with the plotter, it remains aligned to the right
@@ -226,6 +214,7 @@ void Plotter::onTimeout()
         }
     }
 
+    updateGraphs();
     customPlot.replot();
 
 }
@@ -257,6 +246,10 @@ Graph::Graph(int index, QString title, QString color, QString type, int size, do
     buffer_size(buffer_size),
     numberAcquiredData(0),
     lastIndex(0),
+    column(-1),
+    cursor(0),
+    // as many points as the data that used to be kept, 4 times the buffer size
+    points(buffer_size > 0 ? 4 * static_cast<size_t>(buffer_size) : 0),
     type(type),
     color(color),
     lineSize(size),
@@ -282,6 +275,9 @@ void Graph::init(QString remotePortName,
         curr_connection = new Connection(remotePortName, localPortName);
         curr_connection->connect(style);
     }
+    if (column < 0) {
+        column = curr_connection->samples.addColumn(index, cursor);
+    }
 }
 
 Graph::~Graph()
@@ -325,10 +321,54 @@ QString Graph::getColor()
     return color;
 }
 
+/*! \brief Append the values received since the last call.
+ *
+ *  The samples received between two refreshes are spread evenly between
+ *  the two refreshes on the x axis, the last one is at the current refresh.
+ *  If nothing was received, the previous value is repeated.
+ */
+void Graph::acquire()
+{
+    if (!curr_connection || column < 0) {
+        return;
+    }
+
+    double t = -1.0;
+    size_t n = curr_connection->samples.read(column, cursor, newValues, t);
+    if (n == 0) {
+//         qDebug("No data received. Using previous values.");
+        appendPreviousValues();
+        return;
+    }
+
+    bool found = false;
+    for (size_t i = 0; i < n; i++) {
+        if (std::isnan(newValues[i])) {
+            continue;
+        }
+        //apply the y scale factor
+        lastX = numberAcquiredData - 1 + (i + 1.0) / n;
+        lastY = newValues[i] * graph_y_scale;
+        points.append(lastX, lastY);
+        found = true;
+    }
+    if (!found) {
+        qWarning() << "requested index =" << index << "not available in the bottles received";
+        return;
+    }
+
+    lastX = numberAcquiredData;
+    lastT = (t == -1.0) ? lastX : t;
+    numberAcquiredData++;
+}
+
 /*! \brief Append the previous values acquired */
 void Graph::appendPreviousValues()
 {
-    appendValues(lastY,lastT);
+    // lastY is already scaled
+    lastX = numberAcquiredData;
+    points.append(lastX, lastY);
+    numberAcquiredData++;
 }
 
 /*! \brief Append the new values acquired */
@@ -346,14 +386,27 @@ void Graph::appendValues(float y, float t)
     lastY = y;
     lastT = _t;
 
-    if(customGraph && customGraphPoint){
-        customGraph->addData(lastX,lastY);
-        customGraphPoint->clearData();
-        customGraphPoint->addData(lastX,lastY);
-        customGraph->removeDataBefore(lastX - 4*buffer_size);
-        numberAcquiredData++;
+    points.append(lastX, lastY);
+    numberAcquiredData++;
+}
+
+/*! \brief Sets the points of the custom graphs for the visible range
+    \param from the first visible x
+    \param to the last visible x
+    \param width the width of the plot in pixels
+*/
+void Graph::render(double from, double to, int width)
+{
+    if(!customGraph || !customGraphPoint){
+        return;
     }
 
+    points.decimate(from, to, width, keys, values);
+    customGraph->setData(QVector<double>::fromStdVector(keys), QVector<double>::fromStdVector(values));
+    customGraphPoint->clearData();
+    if (points.size() > 0) {
+        customGraphPoint->addData(lastX,lastY);
+    }
 }
 
 /*! \brief Sets the Custom Graph from the QCustomPlot class to this graph
@@ -376,6 +429,7 @@ void Graph::setCustomGraphPoint(QCPGraph *g)
 /*! \brief Clears the custom graph datas */
 void Graph::clearData()
 {
+    points.clear();
     if(customGraph){
         customGraph->clearData();
     }
@@ -408,6 +462,9 @@ Connection::Connection(QString remotePortName,  QString localPortName, QObject *
 
     realTime = true;
     initialTime = yarp::os::Time::now();
+
+    // the values are stored by the port thread
+    localPort->useCallback(*this);
 }
 
 Connection::~Connection()
@@ -443,6 +500,18 @@ void Connection::connect(const yarp::os::ContactStyle &style) {
     }
 }
 
+/*! \brief Stores the values of a bottle, called by the port thread */
+void Connection::onRead(yarp::os::Bottle &b)
+{
+    yarp::os::Stamp stmp;
+    localPort->getEnvelope(stmp);
+    double t = -1.0;
+    if (realTime && stmp.isValid()) {
+        t = stmp.getTime() - initialTime;
+    }
+    samples.append(b, t);
+}
+
 void Connection::freeResources()
 {
     if(localPort)
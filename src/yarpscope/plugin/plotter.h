@@ -24,6 +24,7 @@
 #include <QTimer>
 #include <QVariant>
 #include "qcustomplot.h"
+#include "samplebuffer.h"
 
 #define GRAPH_TYPE_LINE     0
 #define GRAPH_TYPE_BARS     1
@@ -47,8 +48,10 @@ public:
                        QString carrier,
                        bool persistent);
 
+    void acquire();
     void appendPreviousValues();
     void appendValues(float y, float t);
+    void render(double from, double to, int width);
 
     void setCustomGraphPoint(QCPGraph*);
     void setCustomGraph(QCPGraph*);
@@ -80,9 +83,12 @@ private:
     int buffer_size;
     qint64 numberAcquiredData;
     int lastIndex;
-    QList<double> X;
-    QList<double> Y;
-    QList<double> T;
+    int column;
+    std::uint64_t cursor;
+    LodBuffer points;
+    std::vector<double> newValues;
+    std::vector<double> keys;
+    std::vector<double> values;
     QString type;
     QString color;
     int lineSize;
@@ -98,8 +104,12 @@ signals:
 
 /*! \class Connection
     \brief Class representing a Connection
+
+    The bottles are received by the port thread, and their values are
+    stored in the columns of the sample buffer read by the graphs.
 */
-class Connection : public QObject
+class Connection : public QObject,
+                   public yarp::os::TypedReaderCallback<yarp::os::Bottle>
 {
     Q_OBJECT
 public:
@@ -109,6 +119,9 @@ public:
     void connect(const yarp::os::ContactStyle &style);
     void freeResources();
 
+    using yarp::os::TypedReaderCallback<yarp::os::Bottle>::onRead;
+    void onRead(yarp::os::Bottle &b) override;
+
 public:
     QString remotePortName;
     QString localPortName;
@@ -118,6 +131,8 @@ public:
     double initialTime;
 
     yarp::os::ContactStyle style;
+
+    SampleBuffer samples;
 };
 
 /*! \class Plotter
@@ -143,6 +158,7 @@ public:
     Graph *addGraph(QString remotePort, QString localPort, int index, QString title, QString color, QString type, int size, double graph_y_scale=1.0);
     void clear();
     void rescale();
+    void updateGraphs();
     void setPaintGeometry(QRectF);
 
 public:
@@ -177,6 +193,7 @@ signals:
 public slots:
     void onInteract();
     void onTimeout();
+    void onRangeChanged(const QCPRange &range);
 
 };
 
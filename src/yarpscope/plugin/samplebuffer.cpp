@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "samplebuffer.h"
+
+#include <limits>
+
+/*! \brief Constructor of the class.
+ *
+ *  \param capacity the number of samples kept for each column
+ */
+SampleBuffer::SampleBuffer(size_t capacity) :
+    capacity(capacity),
+    count(0),
+    times(capacity, -1.0)
+{
+}
+
+/*! \brief Adds a column for a bottle index.
+ *
+ *  \param index the index of the value in the bottles received
+ *  \param cursor set to the position of the next sample of the column
+ *  \return the column
+ */
+int SampleBuffer::addColumn(int index, std::uint64_t &cursor)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    indices.push_back(index);
+    columns.emplace_back(capacity, std::numeric_limits<double>::quiet_NaN());
+    cursor = count;
+    return static_cast<int>(columns.size()) - 1;
+}
+
+/*! \brief Appends a bottle, called by the port thread.
+ *
+ *  A value missing in the bottle is stored as NaN.
+ *  \param b the bottle received
+ *  \param t the time of the bottle, or -1 if not available
+ */
+void SampleBuffer::append(const yarp::os::Bottle &b, double t)
+{
+    const yarp::os::Bottle *list = &b;
+    if (b.size() == 1 && b.get(0).isList()) {
+        list = b.get(0).asList();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t row = count % capacity;
+    for (size_t c = 0; c < columns.size(); c++) {
+        int index = indices[c];
+        if (index >= 0 && static_cast<size_t>(index) < list->size()) {
+            columns[c][row] = list->get(index).asFloat64();
+        } else {
+            columns[c][row] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    times[row] = t;
+    count++;
+}
+
+/*! \brief Reads the samples of a column received after the cursor.
+ *
+ *  If the reader is too slow, the oldest samples are lost.
+ *  \param column the column
+ *  \param cursor the position of the next sample to read, updated
+ *  \param values filled with the samples
+ *  \param lastTime set to the time of the last sample, if any
+ *  \return the number of samples read
+ */
+size_t SampleBuffer::read(int column, std::uint64_t &cursor, std::vector<double> &values, double &lastTime)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count - cursor > capacity) {
+        cursor = count - capacity;
+    }
+    size_t n = static_cast<size_t>(count - cursor);
+    values.resize(n);
+    const std::vector<double> &col = columns[column];
+    for (size_t i = 0; i < n; i++) {
+        values[i] = col[(cursor + i) % capacity];
+    }
+    if (n > 0) {
+        lastTime = times[(count - 1) % capacity];
+    }
+    cursor = count;
+    return n;
+}
+
+
+/***********************************************************/
+
+/*! \brief Constructor of the class.
+ *
+ *  \param capacity the number of points kept, rounded up to a power of two
+ */
+LodBuffer::LodBuffer(size_t capacity) :
+    capacity(2),
+    mask(0),
+    count(0)
+{
+    while (this->capacity < capacity) {
+        this->capacity <<= 1;
+    }
+    mask = this->capacity - 1;
+    X.resize(this->capacity);
+    Y.resize(this->capacity);
+    for (size_t groups = this->capacity >> 1; groups >= 2; groups >>= 1) {
+        levels.emplace_back(groups);
+    }
+}
+
+/*! \brief Appends a point, the keys must be increasing. */
+void LodBuffer::append(double x, double y)
+{
+    X[count & mask] = x;
+    Y[count & mask] = y;
+    for (size_t l = 0; l < levels.size(); l++) {
+        size_t level = l + 1;
+        std::uint32_t offset = static_cast<std::uint32_t>(count & ((std::uint64_t(1) << level) - 1));
+        std::vector<Bucket> &buckets = levels[l];
+        Bucket &bucket = buckets[(count >> level) & (buckets.size() - 1)];
+        if (offset == 0) {
+            bucket.min = bucket.max = y;
+            bucket.minOffset = bucket.maxOffset = 0;
+        } else if (y < bucket.min) {
+            bucket.min = y;
+            bucket.minOffset = offset;
+        } else if (y > bucket.max) {
+            bucket.max = y;
+            bucket.maxOffset = offset;
+        }
+    }
+    count++;
+}
+
+/*! \brief Removes all the points */
+void LodBuffer::clear()
+{
+    count = 0;
+}
+
+/*! \brief Returns the number of points stored */
+size_t LodBuffer::size() const
+{
+    return (count < capacity) ? static_cast<size_t>(count) : capacity;
+}
+
+/*! \brief Returns the first point with key not less than x, or the number of points appended */
+std::uint64_t LodBuffer::lowerBound(double x) const
+{
+    std::uint64_t first = count - size();
+    std::uint64_t last = count;
+    while (first < last) {
+        std::uint64_t mid = first + (last - first) / 2;
+        if (X[mid & mask] < x) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+/*! \brief Adds the minimum and the maximum of the points between first and last, in order */
+void LodBuffer::appendRange(std::uint64_t first, std::uint64_t last, std::vector<double> &keys, std::vector<double> &values) const
+{
+    std::uint64_t minAt = first;
+    std::uint64_t maxAt = first;
+    for (std::uint64_t i = first + 1; i <= last; i++) {
+        if (Y[i & mask] < Y[minAt & mask]) {
+            minAt = i;
+        } else if (Y[i & mask] > Y[maxAt & mask]) {
+            maxAt = i;
+        }
+    }
+    std::uint64_t a = (minAt < maxAt) ? minAt : maxAt;
+    std::uint64_t b = (minAt < maxAt) ? maxAt : minAt;
+    keys.push_back(X[a & mask]);
+    values.push_back(Y[a & mask]);
+    if (b != a) {
+        keys.push_back(X[b & mask]);
+        values.push_back(Y[b & mask]);
+    }
+}
+
+/*! \brief Returns the points to draw between two keys.
+ *
+ *  The points are grouped so that there are about as many groups as
+ *  requested, and the minimum and the maximum of each group are returned.
+ *  One point before and one after the range are included, so that the
+ *  lines reach the borders of the plot.
+ *  \param from the first key
+ *  \param to the last key
+ *  \param buckets the number of groups (usually the width of the plot in pixels)
+ *  \param keys filled with the keys of the points
+ *  \param values filled with the values of the points
+ */
+void LodBuffer::decimate(double from, double to, int buckets, std::vector<double> &keys, std::vector<double> &values) const
+{
+    keys.clear();
+    values.clear();
+    if (count == 0) {
+        return;
+    }
+
+    std::uint64_t oldest = count - size();
+    std::uint64_t first = lowerBound(from);
+    if (first > oldest) {
+        first--;
+    }
+    std::uint64_t last = lowerBound(to);
+    if (last >= count) {
+        last = count - 1;
+    }
+    if (last < first) {
+        return;
+    }
+
+    std::uint64_t n = last - first + 1;
+    size_t level = 0;
+    if (buckets < 1) {
+        buckets = 1;
+    }
+    while (level < levels.size() && (n >> level) > static_cast<std::uint64_t>(buckets)) {
+        level++;
+    }
+
+    if (level == 0) {
+        for (std::uint64_t i = first; i <= last; i++) {
+            keys.push_back(X[i & mask]);
+            values.push_back(Y[i & mask]);
+        }
+        return;
+    }
+
+    const std::vector<Bucket> &groups = levels[level - 1];
+    std::uint64_t groupSize = std::uint64_t(1) << level;
+    for (std::uint64_t g = first >> level; g <= (last >> level); g++) {
+        std::uint64_t start = g << level;
+        std::uint64_t end = start + groupSize - 1;
+        if (start < first || end > last) {
+            // partial group at the borders
+            appendRange((start < first) ? first : start, (end > last) ? last : end, keys, values);
+            continue;
+        }
+        const Bucket &bucket = groups[g & (groups.size() - 1)];
+        std::uint64_t minAt = start + bucket.minOffset;
+        std::uint64_t maxAt = start + bucket.maxOffset;
+        std::uint64_t a = (minAt < maxAt) ? minAt : maxAt;
+        std::uint64_t b = (minAt < maxAt) ? maxAt : minAt;
+        keys.push_back(X[a & mask]);
+        values.push_back(Y[a & mask]);
+        if (b != a) {
+            keys.push_back(X[b & mask]);
+            values.push_back(Y[b & mask]);
+        }
+    }
+}
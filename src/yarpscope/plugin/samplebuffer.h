@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAMPLEBUFFER_H
+#define SAMPLEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "yarp/os/Bottle.h"
+
+/*! \class SampleBuffer
+    \brief Columnar ring buffer of the samples received on a port
+
+    There is one column for each bottle index plotted. The samples are
+    appended by the port thread, and each graph reads its own column
+    using its own cursor.
+*/
+class SampleBuffer
+{
+public:
+    explicit SampleBuffer(size_t capacity = 65536);
+
+    int addColumn(int index, std::uint64_t &cursor);
+    void append(const yarp::os::Bottle &b, double t);
+    size_t read(int column, std::uint64_t &cursor, std::vector<double> &values, double &lastTime);
+
+private:
+    std::mutex mutex;
+    size_t capacity;
+    std::uint64_t count;
+    std::vector<int> indices;
+    std::vector<std::vector<double> > columns;
+    std::vector<double> times;
+};
+
+
+/*! \class LodBuffer
+    \brief Ring buffer of the points of a graph, with a min/max level of detail pyramid
+
+    The level L of the pyramid stores the minimum and the maximum of each
+    group of 2^L consecutive points, and it is updated when a point is
+    appended. A range of points is drawn using the level with about one
+    group for each pixel, so the drawing cost depends on the width of the
+    plot and not on the number of points.
+*/
+class LodBuffer
+{
+public:
+    explicit LodBuffer(size_t capacity);
+
+    void append(double x, double y);
+    void clear();
+    size_t size() const;
+    void decimate(double from, double to, int buckets, std::vector<double> &keys, std::vector<double> &values) const;
+
+private:
+    struct Bucket
+    {
+        double min;
+        double max;
+        std::uint32_t minOffset;
+        std::uint32_t maxOffset;
+    };
+
+    std::uint64_t lowerBound(double x) const;
+    void appendRange(std::uint64_t first, std::uint64_t last, std::vector<double> &keys, std::vector<double> &values) const;
+
+    size_t capacity;
+    size_t mask;
+    std::uint64_t count;
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<std::vector<Bucket> > levels;
+};
+
+#endif // SAMPLEBUFFER_H
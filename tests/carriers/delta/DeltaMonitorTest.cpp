@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/os/all.h>
+#include <yarp/os/DummyConnector.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <DeltaMonitor.h>
+#include <YarpBuildLocation.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+// The two sides of a connection, talking through serialized messages.
+class DeltaLink {
+public:
+    DeltaMonitorObject sender;
+    DeltaMonitorObject receiver;
+
+    DeltaLink(int keyframeInterval) {
+        Property senderOptions;
+        senderOptions.put("sender_side", 1);
+        sender.create(senderOptions);
+        Property params;
+        params.put("keyframe_interval", keyframeInterval);
+        params.put("element_size", 4);
+        sender.setparam(params);
+        receiver.create(Property());
+    }
+
+    // encode a message as the sending side of the connection
+    void encode(PortWriter& msg, Bottle& wire) {
+        Things thing;
+        thing.setPortWriter(&msg);
+        sender.accept(thing);
+        DummyConnector connector;
+        sender.update(thing).write(connector.getWriter());
+        wire.read(connector.getReader());
+    }
+
+    // decode it as the receiving side, false if it is dropped
+    bool decode(Bottle& wire, Bottle& result) {
+        Things thing;
+        thing.setPortWriter(&wire);
+        if (!receiver.accept(thing)) {
+            return false;
+        }
+        DummyConnector connector;
+        receiver.update(thing).write(connector.getWriter());
+        return result.read(connector.getReader());
+    }
+};
+
+class DeltaMonitorTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "DeltaMonitorTest"; }
+
+    static std::vector<unsigned char> makeData(size_t size, int seed) {
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < size; i++) {
+            // runs of repeated bytes mixed with noise
+            data[i] = ((i / 7) % 3 == 0) ? (unsigned char)seed
+                                         : (unsigned char)((i * 131 + seed * 17) >> 3);
+        }
+        return data;
+    }
+
+    static void makeMessage(Bottle& b, int t) {
+        b.clear();
+        for (int i = 0; i < 50; i++) {
+            b.addInt32((i < 10) ? i * t : i);
+        }
+        b.addFloat64(0.5 * t);
+        b.addString("state");
+    }
+
+    void checkCodec() {
+        report(0, "checking the codec");
+        bool shuffleOk = true;
+        bool rleOk = true;
+        size_t sizes[] = { 0, 1, 7, 8, 9, 64, 130, 131, 1000, 4099 };
+        size_t elementSizes[] = { 1, 2, 4, 8, 3 };
+        for (size_t size : sizes) {
+            std::vector<unsigned char> data = makeData(size, (int)size);
+            for (size_t elementSize : elementSizes) {
+                std::vector<unsigned char> shuffled(size), unshuffled(size);
+                DeltaMonitorObject::shuffle(data.data(), shuffled.data(), size, elementSize);
+                DeltaMonitorObject::unshuffle(shuffled.data(), unshuffled.data(), size, elementSize);
+                shuffleOk = shuffleOk && (unshuffled == data);
+            }
+
+            std::vector<unsigned char> encoded;
+            std::vector<unsigned char> decoded(size);
+            DeltaMonitorObject::rleEncode(data.data(), size, encoded);
+            rleOk = rleOk && DeltaMonitorObject::rleDecode(encoded.data(), encoded.size(), decoded.data(), size);
+            rleOk = rleOk && (decoded == data);
+        }
+        checkTrue(shuffleOk, "shuffle and unshuffle round trip");
+        checkTrue(rleOk, "run-length coding round trip");
+
+        // runs longer than a single token, and all the byte values
+        std::vector<unsigned char> data(1000, 0);
+        for (size_t i = 500; i < 756; i++) {
+            data[i] = (unsigned char)i;
+        }
+        std::vector<unsigned char> encoded;
+        std::vector<unsigned char> decoded(data.size());
+        DeltaMonitorObject::rleEncode(data.data(), data.size(), encoded);
+        checkTrue(encoded.size() < data.size() / 2, "runs compressed");
+        checkTrue(DeltaMonitorObject::rleDecode(encoded.data(), encoded.size(), decoded.data(), decoded.size()) &&
+                  decoded == data, "long runs decoded");
+
+        // corrupted data
+        checkFalse(DeltaMonitorObject::rleDecode(encoded.data(), encoded.size() - 1, decoded.data(), decoded.size()),
+                   "truncated data rejected");
+        checkFalse(DeltaMonitorObject::rleDecode(encoded.data(), encoded.size(), decoded.data(), decoded.size() - 1),
+                   "data longer than expected rejected");
+        checkFalse(DeltaMonitorObject::rleDecode(encoded.data(), encoded.size(), decoded.data(), decoded.size() + 1),
+                   "data shorter than expected rejected");
+    }
+
+    void checkMonitor() {
+        report(0, "checking the two sides of a connection");
+        DeltaLink link(5);
+        Bottle msg, wire, result;
+
+        bool same = true;
+        bool compressed = true;
+        for (int t = 0; t < 10; t++) {
+            makeMessage(msg, t);
+            link.encode(msg, wire);
+            compressed = compressed && (wire.get(0).asInt32() != DeltaMonitorObject::MODE_RAW);
+            same = same && link.decode(wire, result) && result == msg;
+        }
+        checkTrue(compressed, "messages compressed");
+        checkTrue(same, "messages rebuilt");
+
+        // a key frame every 5 messages: t = 10 and t = 15
+        Bottle wires[5];
+        for (int t = 10; t < 15; t++) {
+            makeMessage(msg, t);
+            link.encode(msg, wires[t - 10]);
+        }
+        checkEqual(wires[0].get(0).asInt32(), DeltaMonitorObject::MODE_KEY, "key frame sent periodically");
+        checkEqual(wires[1].get(0).asInt32(), DeltaMonitorObject::MODE_DELTA, "delta sent after the key frame");
+        checkTrue(link.decode(wires[0], result), "key frame decoded");
+        checkFalse(link.decode(wires[2], result), "delta after a lost message dropped");
+        checkFalse(link.decode(wires[1], result), "message out of order dropped");
+        checkFalse(link.decode(wires[3], result) || link.decode(wires[4], result),
+                   "no delta decoded until the next key frame");
+
+        makeMessage(msg, 15);
+        link.encode(msg, wire);
+        checkTrue(link.decode(wire, result) && result == msg, "decoding resumed at the next key frame");
+        makeMessage(msg, 16);
+        link.encode(msg, wire);
+        checkTrue(link.decode(wire, result) && result == msg, "delta decoded after the key frame");
+
+        // a message of a different size is sent as a key frame
+        msg.addInt32(42);
+        link.encode(msg, wire);
+        checkTrue(wire.get(0).asInt32() != DeltaMonitorObject::MODE_DELTA, "size change sent as a key frame");
+        checkTrue(link.decode(wire, result) && result == msg, "size change decoded");
+    }
+
+    void checkMalformed() {
+        report(0, "checking malformed messages");
+        DeltaMonitorObject receiver;
+        receiver.create(Property());
+        char data[16] = { 0 };
+
+        struct {
+            int mode, rawSize, elementSize;
+            size_t blobSize;
+            const char *what;
+        } cases[] = {
+            { DeltaMonitorObject::MODE_RAW, 10, 4, 4, "raw payload shorter than the message rejected" },
+            { DeltaMonitorObject::MODE_RAW, 10, 4, 16, "raw payload longer than the message rejected" },
+            { DeltaMonitorObject::MODE_KEY, -1, 4, 4, "negative size rejected" },
+            { DeltaMonitorObject::MODE_KEY, 8, 0, 4, "zero element size rejected" },
+            { DeltaMonitorObject::MODE_KEY, 100, 4, 1, "truncated encoding rejected" },
+            { 7, 4, 4, 4, "unknown mode rejected" },
+        };
+        for (auto& c : cases) {
+            Bottle wire;
+            wire.addInt32(c.mode);
+            wire.addInt32(0);
+            wire.addInt32(c.rawSize);
+            wire.addInt32(c.elementSize);
+            wire.add(Value(data, (int)c.blobSize));
+            Things thing;
+            thing.setPortWriter(&wire);
+            checkFalse(receiver.accept(thing), c.what);
+        }
+
+        Bottle wire("1 2 3");
+        Things thing;
+        thing.setPortWriter(&wire);
+        checkFalse(receiver.accept(thing), "wrong number of fields rejected");
+    }
+
+    void checkConnection() {
+        report(0, "checking a connection through the plugin");
+        // find the plugin in the build directory
+        std::string dirs = CMAKE_BINARY_DIR +
+                           Network::getDirectorySeparator() +
+                           "share" +
+                           Network::getDirectorySeparator() +
+                           "yarp";
+        saveEnvironment("YARP_DATA_DIRS");
+        Network::setEnvironment("YARP_DATA_DIRS", dirs);
+        bool localMode = Network::setLocalMode(true);
+
+        BufferedPort<Bottle> out;
+        BufferedPort<Bottle> in;
+        in.setStrict();
+        out.open("/delta/out");
+        in.open("/delta/in");
+        bool connected = Network::connect(out.getName(), in.getName(),
+                                          "tcp+send.portmonitor+file.delta+recv.portmonitor+file.delta+type.dll");
+        checkTrue(connected, "connected through the delta monitor");
+        if (connected) {
+            Network::sync(in.getName());
+
+            bool same = true;
+            for (int t = 0; t < 120; t++) {
+                Bottle& msg = out.prepare();
+                makeMessage(msg, t);
+                Bottle sent = msg;
+                out.write(true);
+                Bottle *got = in.read();
+                same = same && got != nullptr && *got == sent;
+            }
+            checkTrue(same, "messages received as they were sent");
+        }
+
+        out.close();
+        in.close();
+        Network::setLocalMode(localMode);
+        restoreEnvironment();
+    }
+
+    virtual void runTests() override {
+        checkCodec();
+        checkMonitor();
+        checkMalformed();
+        checkConnection();
+    }
+};
+
+static DeltaMonitorTest theDeltaMonitorTest;
+
+UnitTest& getPluginTest() {
+    return theDeltaMonitorTest;
+}
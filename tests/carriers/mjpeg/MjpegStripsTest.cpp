@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/os/all.h>
+#include <yarp/sig/all.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <MjpegCompression.h>
+#include <MjpegDecompression.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+using namespace yarp::sig;
+using namespace yarp::mjpeg;
+
+class MjpegStripsTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "MjpegStripsTest"; }
+
+    static void makeImage(ImageOf<PixelRgb>& img, size_t width, size_t height) {
+        img.resize(width, height);
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                PixelRgb& p = img(x, y);
+                p.r = (unsigned char)(x * 255 / width);
+                p.g = (unsigned char)(y * 255 / height);
+                p.b = (unsigned char)(((x / 16 + y / 16) % 2) ? 200 : 50);
+            }
+        }
+    }
+
+    static double meanDifference(const ImageOf<PixelRgb>& a, const FlexImage& b) {
+        if (b.getPixelCode() != VOCAB_PIXEL_RGB ||
+            a.width() != b.width() || a.height() != b.height()) {
+            return 1e9;
+        }
+        double total = 0;
+        for (size_t y = 0; y < a.height(); y++) {
+            const unsigned char *row = b.getRow(y);
+            for (size_t x = 0; x < a.width(); x++) {
+                const PixelRgb& p = a.pixel(x, y);
+                total += abs(p.r - row[x * 3]) + abs(p.g - row[x * 3 + 1]) + abs(p.b - row[x * 3 + 2]);
+            }
+        }
+        return total / (a.width() * a.height() * 3);
+    }
+
+    static bool decode(const Bytes& jpeg, FlexImage& out) {
+        MjpegDecompression decompression;
+        // copy the data, since the encoder reuses its buffer
+        ManagedBytes data(jpeg.length());
+        memcpy(data.get(), jpeg.get(), jpeg.length());
+        return decompression.decompress(data.bytes(), out);
+    }
+
+    // Compresses images with one thread and with several threads, that
+    // split the image in strips joined with restart markers, and checks
+    // that both decode to the original image.  The heights are not
+    // multiples of the MCU height, so that the last strip is a partial one.
+    void checkStrips(const std::string& subsampling) {
+        report(0, "checking strips with " + subsampling + " subsampling");
+        size_t heights[] = { 8, 37, 61, 100, 123, 479 };
+        for (size_t height : heights) {
+            ImageOf<PixelRgb> img;
+            makeImage(img, 150, height);
+
+            int threads[] = { 1, 4 };
+            FlexImage decoded[2];
+            for (int k = 0; k < 2; k++) {
+                MjpegCompression compression;
+                compression.setQuality(90);
+                compression.setSubsampling(subsampling);
+                compression.setThreads(threads[k]);
+                Bytes jpeg;
+                // twice, since the contexts and threads are reused
+                bool ok = compression.compress(img, "", jpeg) &&
+                          compression.compress(img, "", jpeg) &&
+                          decode(jpeg, decoded[k]);
+                std::string what = "height " + std::to_string(height) +
+                                   " threads " + std::to_string(threads[k]);
+                checkTrue(ok, what + " decoded");
+                checkTrue(meanDifference(img, decoded[k]) < 6, what + " matches the image");
+            }
+            // restart markers do not change the decoded pixels
+            bool same = decoded[0].width() == decoded[1].width() &&
+                        decoded[0].height() == decoded[1].height();
+            for (size_t y = 0; same && y < decoded[0].height(); y++) {
+                same = memcmp(decoded[0].getRow(y), decoded[1].getRow(y), decoded[0].width() * 3) == 0;
+            }
+            checkTrue(same, "height " + std::to_string(height) + " same image with strips");
+        }
+    }
+
+    virtual void runTests() override {
+        checkStrips("420");
+        checkStrips("444");
+    }
+};
+
+static MjpegStripsTest theMjpegStripsTest;
+
+UnitTest& getPluginTest() {
+    return theMjpegStripsTest;
+}
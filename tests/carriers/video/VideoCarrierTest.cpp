@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/os/all.h>
+#include <yarp/sig/all.h>
+#include <yarp/os/impl/FakeTwoWayStream.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <VideoDecoder.h>
+#include <VideoEncoder.h>
+#include <VideoFrameHeader.h>
+#include <VideoStream.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+using namespace yarp::sig;
+using namespace yarp::video;
+
+// Encodes a sequence of images and decodes it back, directly and through
+// the receiving side of the carrier, including a receiver that lost the
+// first packets and needs a keyframe.
+class VideoCarrierTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "VideoCarrierTest"; }
+
+    static void makeImage(ImageOf<PixelRgb>& img, int t) {
+        img.resize(96, 64);
+        for (size_t y = 0; y < img.height(); y++) {
+            for (size_t x = 0; x < img.width(); x++) {
+                PixelRgb& p = img(x, y);
+                p.r = (unsigned char)(x * 2 + t * 4);
+                p.g = (unsigned char)(y * 3);
+                p.b = (unsigned char)((x + y) / 2 + t);
+            }
+        }
+    }
+
+    static double meanDifference(const ImageOf<PixelRgb>& a, const ImageOf<PixelRgb>& b) {
+        if (a.width() != b.width() || a.height() != b.height()) {
+            return 1e9;
+        }
+        double total = 0;
+        for (size_t y = 0; y < a.height(); y++) {
+            for (size_t x = 0; x < a.width(); x++) {
+                const PixelRgb& p = a.pixel(x, y);
+                const PixelRgb& q = b.pixel(x, y);
+                total += abs(p.r - q.r) + abs(p.g - q.g) + abs(p.b - q.b);
+            }
+        }
+        return total / (a.width() * a.height() * 3);
+    }
+
+    static bool decodeImage(VideoDecoder& decoder, const ImageOf<PixelRgb>& ref, ImageOf<PixelRgb>& out) {
+        out.resize(ref.width(), ref.height());
+        return decoder.readPixels(out.getRawImage(), out.getRowSize(),
+                                  VOCAB_PIXEL_RGB, out.width(), out.height());
+    }
+
+    // a frame as the sending side of the carrier writes it
+    static std::string makeFrame(const Bytes& packet, int width, int height, int packetLen = -1) {
+        VideoFrameHeader header;
+        header.packetLen = (packetLen >= 0) ? packetLen : (int)packet.length();
+        header.width = width;
+        header.height = height;
+        header.pixelCode = VOCAB_PIXEL_RGB;
+        header.envelopeLen = 0;
+        std::string frame((char*)&header, sizeof(header));
+        frame.append(packet.get(), packet.length());
+        return frame;
+    }
+
+    static bool readImage(VideoStream& stream, ImageOf<PixelRgb>& out) {
+        ImageNetworkHeader header;
+        Bytes hbuf((char*)&header, sizeof(header));
+        if (stream.read(hbuf) != (yarp::conf::ssize_t)sizeof(header)) {
+            return false;
+        }
+        out.resize(header.width, header.height);
+        Bytes pbuf((char*)out.getRawImage(), out.getRawImageSize());
+        return stream.read(pbuf) == (yarp::conf::ssize_t)out.getRawImageSize();
+    }
+
+    void checkLoopback(const std::string& codec) {
+        report(0, "checking the " + codec + " codec");
+        VideoEncoder encoder;
+        VideoDecoder decoder;
+        checkTrue(encoder.setCodec(codec) && decoder.setCodec(codec), codec + " codec set");
+        encoder.setPreset("ultrafast");
+
+        bool decoded = true;
+        double worst = 0;
+        ImageOf<PixelRgb> img, out;
+        for (int t = 0; t < 10; t++) {
+            makeImage(img, t);
+            Bytes packet;
+            if (!encoder.encode(img, packet) || !decoder.decode(packet) ||
+                !decodeImage(decoder, img, out)) {
+                decoded = false;
+                break;
+            }
+            worst = std::max(worst, meanDifference(img, out));
+        }
+        checkTrue(decoded, codec + " every image decoded");
+        report(0, "largest mean difference " + std::to_string(worst));
+        checkTrue(worst < 8, codec + " images decoded faithfully");
+    }
+
+    void checkLostPackets() {
+        report(0, "checking a receiver that lost the first packets");
+        VideoEncoder encoder;
+        encoder.setPreset("ultrafast");
+        encoder.setGop(250);
+
+        // the receiver joins after the first keyframe was lost
+        FakeTwoWayStream *fake = new FakeTwoWayStream();
+        VideoStream stream(fake, "h264");
+
+        ImageOf<PixelRgb> img, out;
+        Bytes packet;
+        for (int t = 0; t < 3; t++) {
+            makeImage(img, t);
+            encoder.encode(img, packet);
+        }
+        fake->addInputText(makeFrame(packet, (int)img.width(), (int)img.height()));
+        size_t length = 0;
+        checkTrue(stream.readFrame(length), "frame after a lost packet read");
+        checkTrue(stream.takeKeyframeRequest(), "keyframe requested after a lost packet");
+        checkTrue(readImage(stream, out), "image still delivered after a lost packet");
+
+        // what the sender does when it gets the request
+        encoder.requestKeyframe();
+        makeImage(img, 3);
+        encoder.encode(img, packet);
+        fake->addInputText(makeFrame(packet, (int)img.width(), (int)img.height()));
+        checkTrue(stream.readFrame(length), "keyframe read");
+        checkFalse(stream.takeKeyframeRequest(), "no keyframe requested once decoded");
+        checkTrue(readImage(stream, out) && meanDifference(img, out) < 8, "image decoded from the keyframe");
+
+        makeImage(img, 4);
+        encoder.encode(img, packet);
+        fake->addInputText(makeFrame(packet, (int)img.width(), (int)img.height()));
+        checkTrue(stream.readFrame(length) && !stream.takeKeyframeRequest(), "next frame decoded");
+        checkTrue(readImage(stream, out) && meanDifference(img, out) < 8, "next image decoded");
+    }
+
+    void checkCorruptedHeaders() {
+        report(0, "checking corrupted headers");
+        char data[16] = { 0 };
+        Bytes packet(data, sizeof(data));
+        struct { int width, height, packetLen; const char *what; } cases[] = {
+            { 100000, 64, -1, "oversized width rejected" },
+            { 64, -2, -1, "negative height rejected" },
+            { 8, 8, 1 << 30, "oversized packet rejected" },
+        };
+        for (auto& c : cases) {
+            FakeTwoWayStream *fake = new FakeTwoWayStream();
+            VideoStream stream(fake, "h264");
+            fake->addInputText(makeFrame(packet, c.width, c.height, c.packetLen));
+            size_t length = 0;
+            checkFalse(stream.readFrame(length), c.what);
+        }
+    }
+
+    virtual void runTests() override {
+        checkLoopback("h264");
+        checkLostPackets();
+        checkCorruptedHeaders();
+    }
+};
+
+static VideoCarrierTest theVideoCarrierTest;
+
+UnitTest& getPluginTest() {
+    return theVideoCarrierTest;
+}
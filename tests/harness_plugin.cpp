@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/os/impl/UnitTest.h>
+
+#include <yarp/os/impl/Logger.h>
+#include <yarp/os/Network.h>
+
+#include <string>
+
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+/*
+ * The harness of the tests built with the sources of a plugin, that are
+ * not part of a library: each executable defines getPluginTest(), and it is
+ * run as the tests of the library harnesses ("verbose regression <test>").
+ */
+extern UnitTest& getPluginTest();
+
+
+int main(int argc, char *argv[]) {
+    Network yarp;
+
+    int verbosity = 0;
+    while (argc>1 && std::string(argv[1])==std::string("verbose")) {
+        verbosity++;
+        argc--;
+        argv++;
+    }
+    if (verbosity>0) {
+        Logger::get().setVerbosity(verbosity);
+    }
+    if (argc>1 && std::string(argv[1])==std::string("regression")) {
+        argc--;
+        argv++;
+    }
+
+    UnitTest::startTestSystem();
+    UnitTest::getRoot().add(getPluginTest());
+    int result;
+    if (argc>1) {
+        result = UnitTest::getRoot().run(argc-1,argv+1);
+    } else {
+        result = UnitTest::getRoot().run();
+    }
+    UnitTest::stopTestSystem();
+
+    return result;
+}
@@ -42,6 +42,32 @@ public:
         buf2[0] = 4;
         ct2 = NetType::getCrc(buf2,len);
         checkTrue(ct1==ct2,"two identical sequences again");
+
+        char check[] = "123456789";
+        checkEqual(NetType::getCrc(check,9),0xcbf43926UL,"standard check value");
+
+        // compare with a bitwise crc, for all the lengths and alignments
+        char data[64];
+        for (int i=0; i<64; i++) {
+            data[i] = (char)(i*37+11);
+        }
+        bool same = true;
+        for (int offset=0; offset<8; offset++) {
+            for (int n=0; n+offset<=64; n++) {
+                unsigned long c = 0xffffffffUL;
+                for (int i=0; i<n; i++) {
+                    c ^= (unsigned char)data[offset+i];
+                    for (int k=0; k<8; k++) {
+                        c = (c & 1) ? (0xedb88320UL ^ (c >> 1)) : (c >> 1);
+                    }
+                }
+                c ^= 0xffffffffUL;
+                if (NetType::getCrc(data+offset,n)!=c) {
+                    same = false;
+                }
+            }
+        }
+        checkTrue(same,"same crc as the bitwise implementation");
     }
 
     void checkInt() {
@@ -116,6 +116,40 @@ public:
     }
 
 
+    void checkConnectMany() {
+        report(0,"checking connection of several ports at once");
+        Port out1, out2, in1, in2;
+        bool ok = out1.open("/NetworkTest/many/out1") && out2.open("/NetworkTest/many/out2") &&
+                  in1.open("/NetworkTest/many/in1") && in2.open("/NetworkTest/many/in2");
+        checkTrue(ok,"ports opened ok");
+        if (!ok) {
+            return;
+        }
+        std::vector<NetworkBase::ConnectionRequest> requests;
+        requests.emplace_back(out1.getName(), in1.getName());
+        requests.emplace_back(out1.getName(), in2.getName());
+        requests.emplace_back(out2.getName(), in2.getName(), "udp");
+        requests.emplace_back(out2.getName(), "/NetworkTest/many/in3");
+        ContactStyle style;
+        style.quiet = true;
+        checkFalse(Network::connectMany(requests, style, 2),"a connection failed");
+        checkTrue(requests[0].ok && requests[1].ok && requests[2].ok,"good connections made");
+        checkFalse(requests[3].ok,"bad connection, not existing destination");
+        checkTrue(Network::isConnected(out1.getName(), in2.getName()),"connection found");
+        ContactStyle udp;
+        udp.carrier = "udp";
+        checkTrue(Network::isConnected(out2.getName(), in2.getName(), udp),"connection with carrier found");
+
+        requests.pop_back();
+        checkTrue(Network::disconnectMany(requests, style),"connections removed");
+        checkFalse(Network::isConnected(out1.getName(), in1.getName()),"connection removed");
+        checkFalse(Network::isConnected(out1.getName(), in2.getName()),"connection removed");
+        in2.close();
+        in1.close();
+        out2.close();
+        out1.close();
+    }
+
     void checkSync() {
         report(0,"checking port synchronization");
         Port p1;
@@ -263,6 +297,7 @@ public:
     virtual void runTests() override {
         Network::setLocalMode(true);
         checkConnect();
+        checkConnectMany();
         checkSync();
         checkComms();
         checkPropertySetGet();
@@ -11,6 +11,7 @@
 #include <yarp/os/PortReaderBuffer.h>
 #include <yarp/os/BufferedPort.h>
 #include <yarp/os/Network.h>
+#include <yarp/os/Stamp.h>
 #include <yarp/os/Time.h>
 
 #include <yarp/os/impl/UnitTest.h>
@@ -103,10 +104,47 @@ public:
             checkEqual(bot->toString().c_str(),"hello2","value ok");
         }
 
-        //p0.close();
-        //Network::disconnect("/p1","/p2","local");
-        //p1.close();
-        //p2.close();
+        Stamp stamp(3, 1.5);
+        p0.write(stamp);
+        bot = p2.read();
+        checkTrue(bot!=nullptr,"other type received");
+        if (bot!=nullptr) {
+            checkEqual(bot->toString().c_str(),"3 1.5","other type converted");
+        }
+
+        p0.close();
+        p1.close();
+        p2.close();
+    }
+
+    void checkLocalDelivery() {
+        report(0, "checking delivery within the process...");
+
+        BufferedPort<Bottle> p1, p2;
+        p1.open("/p1");
+        p2.open("/p2");
+        checkTrue(Network::connect("/p1","/p2","local"),"connected");
+        Network::sync("/p1");
+        Network::sync("/p2");
+
+        Bottle& data = p1.prepare();
+        data.fromString("hello (1 2 3)");
+        Stamp stamp(42, 3.0);
+        p1.setEnvelope(stamp);
+        p1.write(true);
+
+        Bottle *bot = p2.read();
+        checkTrue(bot!=nullptr,"message received");
+        if (bot!=nullptr) {
+            checkEqual(bot->toString().c_str(),"hello (1 2 3)","value ok");
+            checkTrue(bot!=&data,"message copied");
+        }
+        Stamp env;
+        p2.getEnvelope(env);
+        checkEqual(env.getCount(),42,"envelope received");
+
+        p1.close();
+        p2.close();
     }
 
     void checkCallback() {
@@ -180,9 +218,8 @@ public:
     virtual void runTests() override {
         Network::setLocalMode(true);
 
-        //checkLocal(); // still rather experimental
-        // in fact too experimental, omit from general builds
-
+        checkLocal();
+        checkLocalDelivery();
         checkAccept();
         checkCallback();
         checkCallbackNoOpen();
@@ -641,6 +641,88 @@ check $x $y\n\
         checkEqual(pCopy.toString(),p.toString(),"test if addGroup works fine with Property copy operator");
     }
 
+    virtual void checkGrowth() {
+        report(0,"checking growth of the table");
+        Property p(4);
+        for (int i=0; i<1000; i++) {
+            p.put("key" + std::to_string(i), i);
+        }
+        bool found = true;
+        for (int i=0; i<1000; i++) {
+            found = found && p.find("key" + std::to_string(i)).asInt32() == i;
+        }
+        checkTrue(found,"all the keys found after the table grew");
+        checkFalse(p.check("key1000"),"key never added not found");
+        Bottle b(p.toString());
+        checkEqual(b.size(),(size_t)1000,"one entry per key");
+    }
+
+    virtual void checkReuse() {
+        report(0,"checking keys removed and added again");
+        Property p;
+        for (int i=0; i<6; i++) {
+            p.put("key" + std::to_string(i), i);
+        }
+        bool ok = true;
+        for (int round=0; round<10000; round++) {
+            std::string key = "key" + std::to_string(round % 6);
+            p.unput(key);
+            ok = ok && !p.check(key);
+            p.put(key, round);
+            ok = ok && p.find(key).asInt32() == round;
+        }
+        checkTrue(ok,"keys found and removed while put and unput repeatedly");
+        bool last = true;
+        for (int i=0; i<6; i++) {
+            last = last && p.find("key" + std::to_string(i)).asInt32() == 9999 - (9999 - i) % 6;
+        }
+        checkTrue(last,"last values kept");
+        checkEqual(Bottle(p.toString()).size(),(size_t)6,"no stale entries left");
+
+        // keys removed in the middle of a run of collisions
+        Property q(2);
+        for (int i=0; i<50; i++) {
+            q.put("k" + std::to_string(i), i);
+        }
+        for (int i=0; i<50; i+=2) {
+            q.unput("k" + std::to_string(i));
+        }
+        for (int i=0; i<50; i+=4) {
+            q.put("k" + std::to_string(i), -i);
+        }
+        bool all = true;
+        for (int i=0; i<50; i++) {
+            std::string key = "k" + std::to_string(i);
+            if (i % 4 == 0) {
+                all = all && q.find(key).asInt32() == -i;
+            } else if (i % 2 == 0) {
+                all = all && !q.check(key);
+            } else {
+                all = all && q.find(key).asInt32() == i;
+            }
+        }
+        checkTrue(all,"keys after removed ones still found");
+    }
+
+    virtual void checkStableReferences() {
+        report(0,"checking references kept while adding keys");
+        Property p;
+        p.put("x",42);
+        p.addGroup("group").put("y",7);
+        Value& x = p.find("x");
+        Bottle& group = p.findGroup("group");
+        for (int i=0; i<1000; i++) {
+            p.put("key" + std::to_string(i), i);
+            if (i % 3 == 0) {
+                p.unput("key" + std::to_string(i));
+            }
+        }
+        checkTrue(&p.find("x") == &x,"same value after adding keys");
+        checkEqual(x.asInt32(),42,"value unchanged after adding keys");
+        checkTrue(&p.findGroup("group") == &group,"same group after adding keys");
+        checkEqual(group.find("y").asInt32(),7,"group unchanged after adding keys");
+    }
+
     virtual void runTests() override {
         checkPutGet();
         checkExternal();
@@ -665,6 +747,9 @@ check $x $y\n\
         checkDirectory();
         checkLongLongHex();
         checkAddGroup();
+        checkGrowth();
+        checkReuse();
+        checkStableReferences();
     }
 };
 
@@ -13,6 +13,7 @@
 #include <yarp/os/Time.h>
 #include <string>
 #include <yarp/os/LogStream.h>
+#include <atomic>
 #include <cmath>
 
 using namespace yarp::os;
@@ -119,6 +120,104 @@ public:
         checkFalse(t.isRunning() || t2.isRunning(), "timers automatically stopped");
     }
 
+    void idTest()
+    {
+        // ids used to be assigned from the number of timers, so a timer
+        // created after removing another one could replace a running one
+        int a{ 0 }, b{ 0 }, c{ 0 };
+        Timer* ta = new Timer(TimerSettings(0.05), [&a](const YarpTimerEvent&) {a++; return true; }, false);
+        Timer* tb = new Timer(TimerSettings(0.05), [&b](const YarpTimerEvent&) {b++; return true; }, false);
+        delete ta;
+        Timer* tc = new Timer(TimerSettings(0.05), [&c](const YarpTimerEvent&) {c++; return true; }, false);
+        tb->start();
+        tc->start();
+        yarp::os::Time::delay(0.5);
+        tb->stop();
+        tc->stop();
+        checkTrue(b > 0 && c > 0, "timers created after a removal are all running");
+        delete tb;
+        delete tc;
+    }
+
+    bool waitFor(const std::function<bool()>& condition, double timeout)
+    {
+        double start = yarp::os::Time::now();
+        while (!condition() && yarp::os::Time::now() - start < timeout) {
+            yarp::os::Time::delay(0.01);
+        }
+        return condition();
+    }
+
+    void callbackControlTest(size_t workers)
+    {
+        Timer::setWorkerCount(workers);
+        string mode = workers ? " (workers)" : " (timer thread)";
+
+        // stop and restart the timer from its callback
+        std::atomic<int> calls{ 0 };
+        Timer* t = nullptr;
+        t = new Timer(TimerSettings(0.02), [&calls, &t](const YarpTimerEvent&) {
+            int n = ++calls;
+            if (n == 2) {
+                t->stop();
+                t->start();
+            }
+            if (n == 4) {
+                t->stop();
+            }
+            return true;
+        }, false);
+        t->start();
+        checkTrue(waitFor([&calls] { return calls >= 4; }, 5.0), ("timer restarted by its callback" + mode).c_str());
+        yarp::os::Time::delay(0.2);
+        checkEqual(calls.load(), 4, ("timer stopped by its callback" + mode).c_str());
+        checkFalse(t->isRunning(), ("timer not running" + mode).c_str());
+        delete t;
+
+        // destroy the timer from its callback
+        std::atomic<int> selfCalls{ 0 };
+        std::atomic<bool> destroyed{ false };
+        Timer* s = nullptr;
+        s = new Timer(TimerSettings(0.02), [&selfCalls, &destroyed, &s](const YarpTimerEvent&) {
+            if (++selfCalls == 3) {
+                delete s;
+                destroyed = true;
+            }
+            return true;
+        }, false);
+        s->start();
+        checkTrue(waitFor([&destroyed] { return destroyed.load(); }, 5.0), ("timer destroyed by its callback" + mode).c_str());
+        yarp::os::Time::delay(0.2);
+        checkEqual(selfCalls.load(), 3, ("destroyed timer not called again" + mode).c_str());
+
+        // the thread running the timers is stopped when the last timer is
+        // destroyed outside of it, so that the next test uses its workers
+        delete new Timer(TimerSettings(1.0), [](const YarpTimerEvent&) { return true; }, false);
+        Timer::setWorkerCount(0);
+    }
+
+    void settingsTest(size_t workers)
+    {
+        Timer::setWorkerCount(workers);
+        string mode = workers ? " (workers)" : " (timer thread)";
+
+        // change the period of a running timer
+        std::atomic<int> calls{ 0 };
+        Timer* t = new Timer(TimerSettings(0.05), [&calls](const YarpTimerEvent&) { calls++; return true; }, false);
+        t->start();
+        checkTrue(waitFor([&calls] { return calls >= 2; }, 5.0), ("timer running before the change" + mode).c_str());
+        t->setSettings(TimerSettings(0.02));
+        checkTrue(t->getSettings() == TimerSettings(0.02), ("settings changed" + mode).c_str());
+        int before = calls;
+        checkTrue(waitFor([&calls, before] { return calls >= before + 5; }, 5.0), ("timer still firing after the change" + mode).c_str());
+        checkTrue(t->isRunning(), ("timer running after the change" + mode).c_str());
+        t->stop();
+        delete t;
+
+        // the timer that runs the timers is stopped with the last one
+        Timer::setWorkerCount(0);
+    }
+
     virtual void runTests() override
     {
         //fails with valgrind for valgrind slowing down the system
@@ -130,6 +229,11 @@ public:
         apiTest(false);
         monoMultiThreadTest(true);
         monoMultiThreadTest(false);
+        idTest();
+        callbackControlTest(0);
+        callbackControlTest(2);
+        settingsTest(0);
+        settingsTest(2);
     }
 };
 
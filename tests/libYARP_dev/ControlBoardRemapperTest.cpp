@@ -6,6 +6,7 @@
  * BSD-3-Clause license. See the accompanying LICENSE file for details.
  */
 
+#include <algorithm>
 #include <vector>
 
 #include <yarp/os/impl/UnitTest.h>
@@ -164,6 +165,22 @@ public:
         {
             checkEqual(setPosition[i],readedEncoders[i],"Setted position and readed encoders match");
         }
+
+        // The timed encoders are read with one call for each subcontrolboard,
+        // also for the subcontrolboards that are only partially remapped
+        IEncodersTimed * encsTimed = nullptr;
+        ok = ddRemapper.view(encsTimed);
+        checkTrue(ok, "encoders timed interface correctly opened");
+
+        std::vector<double> readedTimestamps(nrOfRemappedAxes,-40);
+        std::fill(readedEncoders.begin(), readedEncoders.end(), -30);
+        ok = encsTimed->getEncodersTimed(readedEncoders.data(), readedTimestamps.data());
+        checkTrue(ok, "getEncodersTimed correctly called");
+
+        for(size_t i=0; i < nrOfRemappedAxes; i++)
+        {
+            checkEqual(setPosition[i],readedEncoders[i],"Setted position and readed timed encoders match");
+        }
     }
 
     void testControlBoardRemapper() {
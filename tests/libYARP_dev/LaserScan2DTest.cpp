@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+/**
+ *
+ * Tests for LaserScan2D
+ *
+ */
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Portable.h>
+#include <yarp/sig/Vector.h>
+#include <yarp/dev/IRangefinder2D.h>
+#include <yarp/dev/LaserScan2D.h>
+
+#include "TestList.h"
+
+using namespace yarp::dev;
+using namespace yarp::sig;
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+class LaserScan2DTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "LaserScan2DTest"; }
+
+    void checkWriteAsBottle()
+    {
+        report(0, "checking that a scan can be read as a Bottle");
+        LaserScan2D scan;
+        scan.status = IRangefinder2D::DEVICE_OK_IN_USE;
+        for (int i = 0; i < 100; i++) {
+            scan.ranges.push_back(i * 0.25f);
+        }
+        Bottle b;
+        Portable::copyPortable(scan, b);
+        checkEqual(b.size(), (size_t)2, "two elements, no intensities");
+        Bottle* ranges = b.get(0).asList();
+        checkTrue(ranges != nullptr, "ranges are a list");
+        if (ranges == nullptr) {
+            return;
+        }
+        checkEqual(ranges->size(), (size_t)100, "ranges size");
+        checkEqualish(ranges->get(99).asFloat64(), 24.75, "ranges value");
+        checkEqual(b.get(1).asInt32(), (int)IRangefinder2D::DEVICE_OK_IN_USE, "status");
+
+        scan.intensities.assign(100, 0.5f);
+        Portable::copyPortable(scan, b);
+        checkEqual(b.size(), (size_t)3, "three elements, with intensities");
+        checkEqualish(b.get(2).asList()->get(10).asFloat64(), 0.5, "intensities value");
+    }
+
+    void checkReadFromBottle()
+    {
+        report(0, "checking that the old Bottle format is accepted");
+        Vector v(50);
+        for (size_t i = 0; i < v.size(); i++) {
+            v[i] = i * 0.5;
+        }
+        Bottle b;
+        Bottle& bl = b.addList();
+        bl.read(v);
+        b.addInt32(IRangefinder2D::DEVICE_TIMEOUT);
+
+        LaserScan2D scan;
+        scan.intensities.assign(3, 1.0f);
+        checkTrue(Portable::copyPortable(b, scan), "read float64 list");
+        checkEqual(scan.ranges.size(), (size_t)50, "ranges size");
+        checkEqualish(scan.ranges[49], 24.5, "ranges value");
+        checkEqual(scan.status, (int)IRangefinder2D::DEVICE_TIMEOUT, "status");
+        checkEqual(scan.intensities.size(), (size_t)0, "no intensities");
+
+        b.fromString("(1 2.5 3.0) 1");
+        checkTrue(Portable::copyPortable(b, scan), "read mixed list");
+        checkEqual(scan.ranges.size(), (size_t)3, "mixed ranges size");
+        checkEqualish(scan.ranges[0], 1.0, "mixed ranges int value");
+        checkEqualish(scan.ranges[1], 2.5, "mixed ranges float value");
+
+        b.fromString("(1.0 2.0) \"ok\"");
+        checkFalse(Portable::copyPortable(b, scan), "bad status rejected");
+    }
+
+    void checkRoundTrip()
+    {
+        report(0, "checking scan round trip");
+        LaserScan2D scan;
+        scan.status = IRangefinder2D::DEVICE_OK_STANBY;
+        scan.ranges.assign(2000, 3.5f);
+        scan.intensities.assign(2000, 100.0f);
+        LaserScan2D copy;
+        checkTrue(Portable::copyPortable(scan, copy), "copy");
+        checkEqual(copy.ranges.size(), (size_t)2000, "ranges size");
+        checkEqual(copy.intensities.size(), (size_t)2000, "intensities size");
+        checkEqualish(copy.ranges[1999], 3.5, "ranges value");
+        checkEqualish(copy.intensities[1999], 100.0, "intensities value");
+        checkEqual(copy.status, (int)IRangefinder2D::DEVICE_OK_STANBY, "status");
+    }
+
+    virtual void runTests() override
+    {
+        checkWriteAsBottle();
+        checkReadFromBottle();
+        checkRoundTrip();
+    }
+};
+
+static LaserScan2DTest theLaserScan2DTest;
+
+UnitTest& getLaserScan2DTest() {
+    return theLaserScan2DTest;
+}
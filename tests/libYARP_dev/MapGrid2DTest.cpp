@@ -15,11 +15,13 @@
 #include <yarp/os/NetType.h>
 #include <yarp/os/impl/BufferedConnectionWriter.h>
 #include <yarp/dev/MapGrid2D.h>
+#include <yarp/dev/MapGrid2DDelta.h>
 #include <yarp/os/Network.h>
 #include <yarp/dev/PolyDriver.h>
 #include <yarp/dev/IMap2D.h>
 #include <yarp/os/Port.h>
 #include <yarp/os/Bottle.h>
+#include <yarp/os/Property.h>
 #include <yarp/os/Time.h>
 
 #include "TestList.h"
@@ -102,6 +104,68 @@ public:
         return true;
     }
 
+    bool testDelta()
+    {
+        report(0,"checking tiled transfer of maps...");
+
+        MapGrid2D source;
+        source.setMapName("delta_map");
+        source.setResolution(0.05);
+        source.setSize_in_cells(200, 150);
+        for (int x = 10; x < 190; x++)
+        {
+            source.setMapFlag(MapGrid2D::XYCell(x, 20), MapGrid2D::MAP_CELL_WALL);
+            source.setOccupancyData(MapGrid2D::XYCell(x, 20), 100);
+        }
+
+        //the first delta contains the whole map
+        MapGrid2DDelta delta;
+        source.getDelta(0, 0, delta);
+        size_t tiles = ((200 + MapGrid2D::TILE_SIZE - 1) / MapGrid2D::TILE_SIZE) * ((150 + MapGrid2D::TILE_SIZE - 1) / MapGrid2D::TILE_SIZE);
+        checkEqual(delta.tiles.size(), tiles, "the first delta contains all the tiles");
+        checkTrue(delta.tiles[0].data[0] == MapGrid2DDelta::TILE_RLE, "uniform tiles are compressed");
+
+        //through the wire, as the server does
+        Bottle bot;
+        checkTrue(Property::copyPortable(delta, bot), "delta written to a bottle");
+        MapGrid2DDelta received;
+        checkTrue(Property::copyPortable(bot, received), "delta read from a bottle");
+
+        MapGrid2D copy;
+        checkTrue(copy.applyDelta(received), "whole map applied");
+        checkTrue(copy.isIdenticalTo(source), "whole map transferred correctly");
+
+        //a single modified cell produces a single tile
+        std::int64_t version = copy.getVersion();
+        source.setMapFlag(MapGrid2D::XYCell(150, 100), MapGrid2D::MAP_CELL_KEEP_OUT);
+        source.getDelta(copy.getEpoch(), version, delta);
+        checkEqual(delta.tiles.size(), (size_t)1, "only the modified tile is sent");
+        checkTrue(copy.applyDelta(delta), "delta applied");
+        checkTrue(copy.isIdenticalTo(source), "map synchronized by the delta");
+        checkFalse(copy.applyDelta(delta), "a delta is not applied twice");
+
+        //nothing changed
+        source.getDelta(copy.getEpoch(), copy.getVersion(), delta);
+        checkEqual(delta.tiles.size(), (size_t)0, "no tiles sent for an unchanged map");
+
+        //merging a modified copy only marks the tiles that differ
+        MapGrid2D edited = source;
+        edited.setOccupancyData(MapGrid2D::XYCell(5, 140), 50);
+        MapGrid2D stored;
+        stored.applyDelta(received);
+        version = stored.getVersion();
+        stored.mergeFrom(edited);
+        stored.getDelta(stored.getEpoch(), version, delta);
+        checkEqual(delta.tiles.size(), (size_t)2, "merging marks only the tiles that differ");
+        checkTrue(stored.isIdenticalTo(edited), "merged map identical to its source");
+
+        //a delta from an unrelated map contains the whole map
+        MapGrid2D other;
+        source.getDelta(other.getEpoch(), other.getVersion(), delta);
+        checkEqual(delta.tiles.size(), tiles, "unrelated maps receive the whole map");
+        return true;
+    }
+
     bool testClientServer()
     {
         report(0,"checking standard compliance of description...");
@@ -146,6 +210,12 @@ public:
         imap->get_map("test_map1",test_get_map);
         checkTrue(test_store_map1.isIdenticalTo(test_get_map), "IMap2D store/get operation successfull");
         
+        //modifications of a map already retrieved
+        test_store_map1.setMapFlag(MapGrid2D::XYCell(1, 1), MapGrid2D::MAP_CELL_WALL);
+        imap->store_map(test_store_map1);
+        imap->get_map("test_map1",test_get_map);
+        checkTrue(test_store_map1.isIdenticalTo(test_get_map), "IMap2D get of a modified map successfull");
+
         imap->get_map_names(names);
         bool b1 = (names.size()==2);
         bool b2 = false;
@@ -177,6 +247,7 @@ public:
     {
         Network::setLocalMode(true);
         testDataType();
+        testDelta();
         testClientServer();
         Network::setLocalMode(false);
     }
@@ -33,8 +33,8 @@ public:
 
     }
 
-    void testServerClientOnSingleIMU() {
-        report(0,"\ntest the multiple analog sensors device on a single IMU");
+    void testServerClientOnSingleIMU(const std::string& streamingFormat) {
+        report(0,"\ntest the multiple analog sensors device on a single IMU, streaming format " + streamingFormat);
 
         // We first allocate a single fakeImu
         PolyDriver imuSensor;
@@ -59,6 +59,7 @@ public:
         std::string serverPrefix = "/test/mas/server";
         pWrapper.put("name", serverPrefix);
         pWrapper.put("period", 10);
+        pWrapper.put("streaming_format", streamingFormat);
         result = wrapper.open(pWrapper);
         checkTrue(result, "multipleanalogsensorsserver open reported successful");
 
@@ -120,7 +121,8 @@ public:
 
     virtual void runTests() override {
         Network::setLocalMode(true);
-        testServerClientOnSingleIMU();
+        testServerClientOnSingleIMU("thrift");
+        testServerClientOnSingleIMU("flat");
         Network::setLocalMode(false);
     }
 };
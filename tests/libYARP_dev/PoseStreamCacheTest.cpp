@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+/**
+ *
+ * Tests for the cache of the poses streamed by a localization server
+ *
+ */
+
+#include <yarp/dev/impl/PoseStreamCache.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Network.h>
+#include <yarp/os/Port.h>
+#include <yarp/os/Stamp.h>
+#include <yarp/os/Time.h>
+
+#include <cmath>
+
+#include "TestList.h"
+
+using namespace yarp::dev;
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+class PoseStreamCacheTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "PoseStreamCacheTest"; }
+
+    void sendPose(Port& port, double time, const std::string& map, double x, double y, double theta)
+    {
+        Bottle b;
+        b.addString(map);
+        b.addFloat64(x);
+        b.addFloat64(y);
+        b.addFloat64(theta);
+        Stamp stamp(0, time);
+        port.setEnvelope(stamp);
+        port.write(b);
+    }
+
+    void waitPose(yarp::dev::impl::PoseStreamCache& cache, const std::string& map, double x)
+    {
+        Map2DLocation loc;
+        for (int i = 0; i < 200; i++)
+        {
+            if (cache.getLatest(loc) && loc.map_id == map && loc.x == x) return;
+            Time::delay(0.01);
+        }
+    }
+
+    void testCache()
+    {
+        report(0, "checking the pose stream cache...");
+
+        yarp::dev::impl::PoseStreamCache cache;
+        Port out;
+        bool ok = cache.open("/poseCacheTest/stream:i") && out.open("/poseCacheTest/stream:o");
+        checkTrue(ok, "ports opened");
+        cache.setTimeout(10.0);
+        cache.useCallback();
+        checkTrue(Network::connect(out.getName(), cache.getName()), "ports connected");
+        Network::sync(cache.getName());
+
+        Map2DLocation loc;
+        checkFalse(cache.getLatest(loc), "no pose before the stream starts");
+
+        double now = Time::now();
+        sendPose(out, now - 1.0, "map", 0.0, 0.0, 350.0);
+        sendPose(out, now - 0.5, "map", 1.0, 2.0, 10.0);
+        waitPose(cache, "map", 1.0);
+
+        checkTrue(cache.getLatest(loc), "latest pose available");
+        checkEqualish(loc.x, 1.0, "latest x");
+        checkEqualish(loc.y, 2.0, "latest y");
+
+        checkTrue(cache.getAt(now - 0.75, loc), "pose between two samples");
+        checkEqualish(loc.x, 0.5, "interpolated x");
+        checkEqualish(loc.y, 1.0, "interpolated y");
+        checkEqualish(std::cos(loc.theta * M_PI / 180.0), 1.0, "interpolated theta turns the shortest way");
+
+        checkFalse(cache.getAt(now - 2.0, loc), "no pose before the history");
+
+        sendPose(out, now - 0.25, "other_map", 5.0, 5.0, 0.0);
+        waitPose(cache, "other_map", 5.0);
+        checkFalse(cache.getAt(now - 0.4, loc), "no interpolation across maps");
+
+        cache.setTimeout(0.0);
+        Time::delay(0.05);
+        checkFalse(cache.getLatest(loc), "stale pose not given");
+
+        cache.interrupt();
+        cache.close();
+        out.close();
+    }
+
+    virtual void runTests() override
+    {
+        Network::setLocalMode(true);
+        testCache();
+        Network::setLocalMode(false);
+    }
+};
+
+static PoseStreamCacheTest thePoseStreamCacheTest;
+
+UnitTest& getPoseStreamCacheTest() {
+    return thePoseStreamCacheTest;
+}
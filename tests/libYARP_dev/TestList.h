@@ -24,6 +24,7 @@ namespace yarp {
 // method
 extern yarp::os::impl::UnitTest& getPolyDriverTest();
 extern yarp::os::impl::UnitTest& getRobotDescriptionTest();
+extern yarp::os::impl::UnitTest& getLaserScan2DTest();
 
 #ifdef YARP_CONTROLBOARDREMAPPER_TESTS
 extern yarp::os::impl::UnitTest& getControlBoardRemapperTest();
@@ -40,6 +41,7 @@ extern yarp::os::impl::UnitTest& getTestFrameGrabberTest();
 #ifdef WITH_YARPMATH
 extern yarp::os::impl::UnitTest& getFrameTransformClientTest();
 extern yarp::os::impl::UnitTest& getMapGrid2DTest();
+extern yarp::os::impl::UnitTest& getPoseStreamCacheTest();
 #endif
 
 #ifdef YARP_MULTIPLEANALOGSENSORSINTERFACES_TESTS
@@ -52,6 +54,7 @@ public:
         UnitTest& root = UnitTest::getRoot();
         root.add(getPolyDriverTest());
         root.add(getRobotDescriptionTest());
+        root.add(getLaserScan2DTest());
 #ifdef YARP_CONTROLBOARDREMAPPER_TESTS
         root.add(getControlBoardRemapperTest());
 #endif
@@ -64,6 +67,7 @@ public:
 #ifdef WITH_YARPMATH
         root.add(getFrameTransformClientTest());
         root.add(getMapGrid2DTest());
+        root.add(getPoseStreamCacheTest());
 #endif
 #ifdef YARP_MULTIPLEANALOGSENSORSINTERFACES_TESTS
         root.add(getMultipleAnalogSensorsInterfacesTest());
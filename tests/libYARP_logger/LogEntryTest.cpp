@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/logger/YarpLogger.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <string>
+#include <vector>
+
+using namespace yarp::os::impl;
+using namespace yarp::yarpLogger;
+
+class LogEntryTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "LogEntryTest"; }
+
+    static MessageEntry makeMessage(int i) {
+        MessageEntry msg;
+        msg.level = LOGLEVEL_INFO;
+        msg.text = std::to_string(i);
+        return msg;
+    }
+
+    // the messages stored, from the oldest, as "first..last", using
+    // both the sequence numbers and the copy of the list
+    std::string stored(const LogEntry& entry) {
+        std::string bySequence;
+        for (long long i = entry.first_sequence(); i < entry.end_sequence(); i++) {
+            bySequence += entry.get_message(i).text + " ";
+        }
+        std::string byList;
+        for (const auto& msg : entry.get_entry_list()) {
+            byList += msg.text + " ";
+        }
+        checkEqual(bySequence, byList, "same messages by sequence and in the list");
+        return byList;
+    }
+
+    void checkWrapAround() {
+        report(0, "checking the ring of messages...");
+        LogEntry entry(3);
+        for (int i = 0; i < 3; i++) {
+            checkTrue(entry.append_logEntry(makeMessage(i)), "message stored");
+        }
+        checkEqual(stored(entry), "0 1 2 ", "messages stored in order");
+
+        for (int i = 3; i < 8; i++) {
+            checkTrue(entry.append_logEntry(makeMessage(i)), "message stored when full");
+        }
+        checkEqual(stored(entry), "5 6 7 ", "oldest messages overwritten");
+        checkEqual((int)entry.first_sequence(), 5, "sequence of the oldest message");
+        checkEqual((int)entry.end_sequence(), 8, "sequence of the next message");
+        checkEqual((int)entry.logInfo.logsize, 3, "log size bounded");
+    }
+
+    void checkMaxSize() {
+        report(0, "checking the maximum size...");
+        LogEntry entry(3);
+        for (int i = 0; i < 5; i++) {
+            entry.append_logEntry(makeMessage(i));
+        }
+
+        // a new maximum size drops the messages, keeping the sequence
+        entry.setLogEntryMaxSize(2);
+        checkEqual(entry.getLogEntryMaxSize(), 2, "maximum size set");
+        checkEqual(stored(entry), "", "messages dropped with a new maximum size");
+        checkEqual((int)entry.first_sequence(), 5, "sequence kept");
+        for (int i = 5; i < 8; i++) {
+            entry.append_logEntry(makeMessage(i));
+        }
+        checkEqual(stored(entry), "6 7 ", "new maximum size used");
+
+        entry.setLogEntryMaxSize(0);
+        checkFalse(entry.append_logEntry(makeMessage(8)), "nothing stored with no room");
+        checkEqual(stored(entry), "", "log empty with no room");
+    }
+
+    void checkDisableAndClear() {
+        report(0, "checking the disabled limit and clear...");
+        LogEntry entry(3);
+        for (int i = 0; i < 4; i++) {
+            entry.append_logEntry(makeMessage(i));
+        }
+        checkEqual(stored(entry), "1 2 3 ", "ring full");
+
+        // without the limit the log grows from where the ring was
+        entry.setLogEntryMaxSizeEnabled(false);
+        checkFalse(entry.getLogEntryMaxSizeEnabled(), "limit disabled");
+        for (int i = 4; i < 7; i++) {
+            entry.append_logEntry(makeMessage(i));
+        }
+        checkEqual(stored(entry), "1 2 3 4 5 6 ", "log grows without the limit");
+        checkEqual((int)entry.logInfo.logsize, 6, "log size without the limit");
+
+        // enabling the limit again drops the oldest messages
+        entry.setLogEntryMaxSizeEnabled(true);
+        entry.append_logEntry(makeMessage(7));
+        checkEqual(stored(entry), "5 6 7 ", "oldest dropped when the limit is enabled");
+        checkEqual((int)entry.first_sequence(), 5, "sequence after the limit is enabled");
+        entry.append_logEntry(makeMessage(8));
+        checkEqual(stored(entry), "6 7 8 ", "ring used again after the limit is enabled");
+
+        // the sequence continues after a clear, so cursors stay valid
+        entry.last_read_message = 7;
+        entry.clear_logEntries();
+        checkEqual(stored(entry), "", "log cleared");
+        checkEqual((int)entry.logInfo.logsize, 0, "log size cleared");
+        checkEqual((int)entry.last_read_message, -1, "last read message reset");
+        checkEqual((int)entry.first_sequence(), 9, "sequence continues after a clear");
+        entry.append_logEntry(makeMessage(9));
+        checkEqual(stored(entry), "9 ", "message stored after a clear");
+        checkEqual((int)entry.first_sequence(), 9, "sequence of the message after a clear");
+    }
+
+    virtual void runTests() override {
+        checkWrapAround();
+        checkMaxSize();
+        checkDisableAndClear();
+    }
+};
+
+static LogEntryTest theLogEntryTest;
+
+UnitTest& getLogEntryTest() {
+    return theLogEntryTest;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/manager/launchgraph.h>
+#include <yarp/manager/localbroker.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace yarp::os::impl;
+using namespace yarp::manager;
+
+class LaunchGraphTest : public UnitTest {
+    std::vector<Module*> modules;
+    ExecutablePContainer runnables;
+    CnnContainer connections;
+
+public:
+    virtual std::string getName() const override { return "LaunchGraphTest"; }
+
+    // a module opening the given ports, and waiting for the given resources
+    size_t addModule(const char* name,
+                     const std::vector<const char*>& outputs,
+                     const std::vector<const char*>& inputs,
+                     const std::vector<const char*>& resources = {}) {
+        Module* module = new Module(name);
+        for (const char* port : outputs) {
+            OutputData output(port);
+            output.setPort(port);
+            module->addOutput(output);
+        }
+        for (const char* port : inputs) {
+            InputData input(port);
+            input.setPort(port);
+            module->addInput(input);
+        }
+        Executable* exe = new Executable(new LocalBroker(), nullptr, module, false);
+        exe->setCommand(name);
+        for (const char* port : resources) {
+            ResYarpPort res(port);
+            res.setPort(port);
+            exe->addResource(res);
+        }
+        modules.push_back(module);
+        runnables.push_back(exe);
+        return runnables.size() - 1;
+    }
+
+    void addConnection(const char* from, const char* to, bool priority) {
+        Connection cnn(from, to);
+        cnn.setPriority(priority);
+        connections.push_back(cnn);
+    }
+
+    void clear() {
+        for (Executable* exe : runnables) {
+            delete exe;
+        }
+        for (Module* module : modules) {
+            delete module;
+        }
+        runnables.clear();
+        modules.clear();
+        connections.clear();
+    }
+
+    bool hasParent(LaunchGraph& graph, size_t id, size_t parent, const std::string& port) {
+        LaunchGraph::Node& node = graph[id];
+        for (size_t i = 0; i < node.parents.size(); i++) {
+            if (node.parents[i] == parent && node.ports[i] == port) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void checkBuild() {
+        report(0, "checking the dependencies of the modules");
+        size_t a = addModule("a", {"/a/out"}, {});
+        size_t b = addModule("b", {"/b/out"}, {"/b/in"});
+        size_t c = addModule("c", {"/c/out"}, {}, {"/a/out", "/b/out", "/c/out", "/unknown"});
+        addConnection("/a/out", "/b/in", true);
+        addConnection("/c/out", "/b/in", false);
+
+        LaunchGraph graph;
+        graph.build(runnables, connections, ErrorLogger::Instance());
+        checkEqual(graph.size(), runnables.size(), "one node for each module");
+        checkEqual(graph[a].parents.size(), (size_t)0, "a module waiting for nothing");
+        checkEqual(graph[b].parents.size(), (size_t)1, "one parent for a connection with priority");
+        checkTrue(hasParent(graph, b, a, "/a/out"), "receiver waits for the sender");
+        checkEqual(graph[c].parents.size(), (size_t)2, "ports of the module itself and unknown ports ignored");
+        checkTrue(hasParent(graph, c, a, "/a/out") && hasParent(graph, c, b, "/b/out"),
+                  "module waits for the modules opening its resources");
+        clear();
+    }
+
+    void checkCycles() {
+        report(0, "checking the modules waiting for each other");
+        size_t d = addModule("d", {"/d/out"}, {"/d/in"});
+        size_t e = addModule("e", {"/e/out"}, {"/e/in"});
+        size_t f = addModule("f", {}, {"/f/in"});
+        addConnection("/d/out", "/e/in", true);
+        addConnection("/e/out", "/d/in", true);
+        addConnection("/e/out", "/f/in", true);
+
+        ErrorLogger* logger = ErrorLogger::Instance();
+        logger->clear();
+        LaunchGraph graph;
+        graph.build(runnables, connections, logger);
+        checkEqual(graph[d].parents.size() + graph[e].parents.size(), (size_t)1,
+                   "one dependency of the cycle dropped");
+        checkEqual(logger->warningCount(), 1, "cycle reported");
+        checkTrue(hasParent(graph, f, e, "/e/out"), "dependency outside of the cycle kept");
+
+        // the modules can be started in the order of the graph
+        size_t started = 0;
+        for (size_t round = 0; round < graph.size(); round++) {
+            for (size_t i = 0; i < graph.size(); i++) {
+                if (!graph[i].done && graph.launchable(i, 0.0, 10.0, [](const std::string&) { return true; })) {
+                    graph[i].done = true;
+                    started++;
+                }
+            }
+        }
+        checkEqual(started, graph.size(), "all the modules started");
+        logger->clear();
+        clear();
+    }
+
+    void checkLaunchable() {
+        report(0, "checking when a module can be started");
+        size_t a = addModule("a", {"/a/out"}, {});
+        size_t b = addModule("b", {"/b/out"}, {});
+        size_t c = addModule("c", {}, {}, {"/a/out", "/b/out"});
+
+        LaunchGraph graph;
+        graph.build(runnables, connections, ErrorLogger::Instance());
+
+        std::set<std::string> opened;
+        std::set<std::string> probed;
+        auto exists = [&](const std::string& port) {
+            probed.insert(port);
+            return opened.count(port) > 0;
+        };
+
+        checkTrue(graph.launchable(a, 0.0, 10.0, exists), "module without parents started");
+        checkFalse(graph.launchable(c, 0.0, 10.0, exists), "module not started before its parents");
+
+        graph[a].done = graph[a].failed = true;
+        graph[a].doneTime = 1.0;
+        checkFalse(graph.launchable(c, 1.0, 10.0, exists), "module not started after a failed parent only");
+
+        graph[b].done = true;
+        graph[b].doneTime = 2.0;
+        checkFalse(graph.launchable(c, 2.0, 10.0, exists), "module not started before the ports are opened");
+        checkEqual(probed.count("/a/out"), (size_t)0, "port of a failed parent not probed");
+        opened.insert("/b/out");
+        checkTrue(graph.launchable(c, 2.0, 10.0, exists), "module started when the ports are opened");
+
+        opened.clear();
+        checkTrue(graph.launchable(c, 12.5, 10.0, exists), "module started after the timeout");
+
+        graph[b].failed = true;
+        checkTrue(graph.launchable(c, 2.0, 10.0, exists), "module started when all its parents failed");
+        clear();
+    }
+
+    virtual void runTests() override {
+        checkBuild();
+        checkCycles();
+        checkLaunchable();
+    }
+};
+
+static LaunchGraphTest theLaunchGraphTest;
+
+UnitTest& getLaunchGraphTest() {
+    return theLaunchGraphTest;
+}
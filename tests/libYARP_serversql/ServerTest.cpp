@@ -9,14 +9,80 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <yarp/os/all.h>
+#include <yarp/os/DummyConnector.h>
+#include <yarp/os/NameStore.h>
 #include <yarp/os/impl/NameClient.h>
 #include <yarp/os/impl/UnitTest.h>
 
 using namespace yarp::os;
 using namespace yarp::os::impl;
 
+/**
+ * A name store that forwards everything to another one, counting the
+ * queries of each name, and that hides a name from the listings.
+ */
+class CountingNameStore : public NameStore {
+public:
+    NameStore *store;
+    std::string hidden;
+    std::map<std::string, int> queries;
+    int listings;
+
+    CountingNameStore(NameStore *store, const std::string& hidden) :
+        store(store),
+        hidden(hidden),
+        listings(0)
+    {
+    }
+
+    virtual Contact query(const std::string& name) override {
+        queries[name]++;
+        return store->query(name);
+    }
+
+    virtual bool announce(const std::string& name, int activity) override {
+        return store->announce(name, activity);
+    }
+
+    virtual bool process(PortWriter& in,
+                         PortReader& out,
+                         const Contact& source) override {
+        DummyConnector cmdConnector;
+        in.write(cmdConnector.getWriter());
+        Bottle cmd;
+        cmd.read(cmdConnector.getReader());
+        // the name clients ask "NAME_SERVER query <name>"
+        size_t first = (cmd.get(0).asString() == "NAME_SERVER") ? 1 : 0;
+        if (cmd.get(first).asString() == "query") {
+            queries[cmd.get(first + 1).asString()]++;
+        }
+        Bottle reply;
+        if (!store->process(cmd, reply, source)) {
+            return false;
+        }
+        if (cmd.get(0).asString() == "bot" && cmd.get(1).asString() == "list") {
+            listings++;
+            Bottle filtered;
+            filtered.add(reply.get(0));
+            for (size_t i = 1; i < reply.size(); i++) {
+                Bottle *entry = reply.get(i).asList();
+                if (entry == nullptr || entry->find("name").asString() != hidden) {
+                    filtered.add(reply.get(i));
+                }
+            }
+            reply = filtered;
+        }
+        DummyConnector replyConnector;
+        reply.write(replyConnector.getWriter());
+        return out.read(replyConnector.getReader());
+    }
+};
+
 /**
  *
  * Name server regression tests.
@@ -107,6 +173,49 @@ public:
         checkTrue(result.find(target)!=std::string::npos,"answer found");
     }
 
+    void checkConnectMany() {
+        report(0,"checking the names cached when connecting several ports...");
+        Port out1, out2, in1, in2;
+        bool ok = out1.open("/check/many/out1") && out2.open("/check/many/out2") &&
+                  in1.open("/check/many/in1") && in2.open("/check/many/in2");
+        checkTrue(ok,"ports opened");
+        if (!ok) {
+            return;
+        }
+
+        // in2 is not listed by the name server, so it must be queried
+        NameStore *store = NetworkBase::getQueryBypass();
+        CountingNameStore counter(store, in2.getName());
+        NetworkBase::queryBypass(&counter);
+
+        std::vector<NetworkBase::ConnectionRequest> requests;
+        requests.emplace_back(out1.getName(), in1.getName());
+        requests.emplace_back(out2.getName(), in1.getName());
+        requests.emplace_back(out2.getName(), in2.getName());
+        ContactStyle style;
+        style.quiet = true;
+        checkTrue(Network::connectMany(requests, style, 2),"connections made");
+        checkTrue(requests[0].ok && requests[1].ok && requests[2].ok,"every connection made");
+        checkEqual(counter.listings,1,"names listed once");
+        checkEqual(counter.queries[out1.getName()],0,"listed source found in the cache");
+        checkEqual(counter.queries[out2.getName()],0,"other listed source found in the cache");
+        // the source ports look up their destination themselves, once for
+        // each connection, and the cache cannot help them
+        checkEqual(counter.queries[in1.getName()],2,"listed destination found in the cache");
+        checkEqual(counter.queries[in2.getName()],2,"destination not listed queried");
+
+        NetworkBase::queryBypass(store);
+        checkTrue(Network::isConnected(out1.getName(), in1.getName()),"connection found");
+        checkTrue(Network::isConnected(out2.getName(), in2.getName()),"connection to the port not listed found");
+        checkTrue(Network::disconnectMany(requests, style),"connections removed");
+        checkFalse(Network::isConnected(out2.getName(), in2.getName()),"connection removed");
+
+        in2.close();
+        in1.close();
+        out2.close();
+        out1.close();
+    }
+
     virtual void runTests() override {
         NetworkBase::setLocalMode(true);
 
@@ -116,6 +225,7 @@ public:
         checkPortRegister();
         checkList();
         checkSetGet();
+        checkConnectMany();
 
         NetworkBase::setLocalMode(false);
 
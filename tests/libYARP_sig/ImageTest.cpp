@@ -17,6 +17,7 @@
 #include <yarp/os/impl/BufferedConnectionWriter.h>
 #include <yarp/sig/Image.h>
 #include <yarp/sig/ImageDraw.h>
+#include <yarp/sig/ImageFile.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/PortReaderBuffer.h>
 #include <yarp/os/Port.h>
@@ -26,6 +27,8 @@
 #include <yarp/os/impl/Logger.h>
 #include <yarp/os/PeriodicThread.h>
 
+#include <cstdio>
+
 #include "TestList.h"
 
 using namespace yarp::os::impl;
@@ -396,6 +399,65 @@ static const size_t EXT_HEIGHT = 64;
         checkEqual(img.width(),(size_t) 4,"dimension check");
     }
 
+    void testScaleFilters() {
+        report(0,"checking scaling filters...");
+        ImageOf<PixelMono> ramp;
+        ramp.resize(64,64);
+        for (size_t x=0; x<ramp.width(); x++) {
+            for (size_t y=0; y<ramp.height(); y++) {
+                ramp(x,y) = (unsigned char)(x*4);
+            }
+        }
+        ImageOf<PixelMono> half;
+        half.copy(ramp,32,32,Image::SCALE_BILINEAR);
+        checkEqual(half.width(),(size_t) 32,"dimension check");
+        checkEqual(half(5,3),42,"bilinear interpolates between samples");
+        half.copy(ramp,32,32,Image::SCALE_AREA);
+        checkEqual(half(5,3),42,"area averages the samples covered");
+
+        ImageOf<PixelMono> stripes;
+        stripes.resize(60,20);
+        for (size_t x=0; x<stripes.width(); x++) {
+            for (size_t y=0; y<stripes.height(); y++) {
+                stripes(x,y) = (x%2==0)?0:200;
+            }
+        }
+        ImageOf<PixelMono> small;
+        small.copy(stripes,15,5,Image::SCALE_AREA);
+        checkEqual(small(0,0),100,"area removes aliasing");
+        checkEqual(small(14,4),100,"area removes aliasing");
+
+        ImageOf<PixelFloat> line;
+        line.resize(2,1);
+        line(0,0) = 0;
+        line(1,0) = 1;
+        ImageOf<PixelFloat> wide;
+        wide.copy(line,4,1,Image::SCALE_BILINEAR);
+        checkEqualish(wide(0,0),0,"bilinear enlarging, border");
+        checkEqualish(wide(1,0),0.25,"bilinear enlarging");
+        checkEqualish(wide(2,0),0.75,"bilinear enlarging");
+        checkEqualish(wide(3,0),1,"bilinear enlarging, border");
+
+        ImageOf<PixelRgb> grey;
+        grey.resize(1024,768);
+        PixelRgb p(90,90,90);
+        for (size_t x=0; x<grey.width(); x++) {
+            for (size_t y=0; y<grey.height(); y++) {
+                grey(x,y) = p;
+            }
+        }
+        ImageOf<PixelMono> mono;
+        mono.copy(grey,500,300,Image::SCALE_BILINEAR);
+        checkEqual(mono.width(),(size_t) 500,"dimension check");
+        checkEqual(mono(0,0),90,"conversion while scaling");
+        checkEqual(mono(499,299),90,"conversion while scaling");
+
+        grey.copy(grey,320,240,Image::SCALE_AREA);
+        checkEqual(grey.width(),(size_t) 320,"scaling in place");
+        checkEqual(grey.height(),(size_t) 240,"scaling in place");
+        checkEqual(grey(319,239).g,90,"scaling in place");
+    }
+
     // test row pointer access (getRow())
     // this function only tests if getRow(r)[c] is consistent with the operator ()
     void testRowPointer()
@@ -614,6 +676,89 @@ static const size_t EXT_HEIGHT = 64;
     }
 
 
+    void testFile() {
+        report(0,"testing image file read/write...");
+        // odd sizes, so that the images in memory are padded
+        const size_t w = 7;
+        const size_t h = 5;
+
+        ImageOf<PixelRgb> rgb;
+        rgb.resize(w, h);
+        ImageOf<PixelMono> mono;
+        mono.resize(w, h);
+        ImageOf<PixelFloat> flt;
+        flt.resize(w, h);
+        for (size_t y = 0; y < h; y++) {
+            for (size_t x = 0; x < w; x++) {
+                rgb.pixel(x, y) = PixelRgb((unsigned char)(x * 10), (unsigned char)(y * 10), (unsigned char)(x + y));
+                mono.pixel(x, y) = (unsigned char)(x * y);
+                flt.pixel(x, y) = 0.5f * x - 0.25f * y;
+            }
+        }
+
+        checkTrue(file::write(rgb, "ImageTest_rgb.ppm"), "writing ppm");
+        checkTrue(file::write(mono, "ImageTest_mono.pgm"), "writing pgm");
+        checkTrue(file::write(flt, "ImageTest_float.float"), "writing float");
+
+        ImageOf<PixelRgb> rgb2;
+        ImageOf<PixelBgr> bgr2;
+        ImageOf<PixelRgba> rgba2;
+        ImageOf<PixelMono> mono2;
+        ImageOf<PixelRgb> monoAsRgb;
+        ImageOf<PixelFloat> flt2;
+        checkTrue(file::read(rgb2, "ImageTest_rgb.ppm"), "reading ppm as rgb");
+        checkTrue(file::read(bgr2, "ImageTest_rgb.ppm"), "reading ppm as bgr");
+        checkTrue(file::read(rgba2, "ImageTest_rgb.ppm"), "reading ppm as rgba");
+        checkTrue(file::read(mono2, "ImageTest_mono.pgm"), "reading pgm as mono");
+        checkTrue(file::read(monoAsRgb, "ImageTest_mono.pgm"), "reading pgm as rgb");
+        checkTrue(file::read(flt2, "ImageTest_float.float"), "reading float");
+        checkFalse(file::read(mono2, "ImageTest_rgb.ppm"), "reading ppm as mono fails");
+        checkFalse(file::read(rgb2, "ImageTest_missing.ppm"), "reading a missing file fails");
+
+        checkEqual(rgb2.width(), w, "width check");
+        checkEqual(rgb2.height(), h, "height check");
+        bool ok = true;
+        for (size_t y = 0; y < h; y++) {
+            for (size_t x = 0; x < w; x++) {
+                const PixelRgb& px = rgb.pixel(x, y);
+                ok &= rgb2.pixel(x, y).r == px.r && rgb2.pixel(x, y).g == px.g && rgb2.pixel(x, y).b == px.b;
+                ok &= bgr2.pixel(x, y).r == px.r && bgr2.pixel(x, y).g == px.g && bgr2.pixel(x, y).b == px.b;
+                ok &= rgba2.pixel(x, y).r == px.r && rgba2.pixel(x, y).g == px.g && rgba2.pixel(x, y).b == px.b && rgba2.pixel(x, y).a == 255;
+                ok &= mono2.pixel(x, y) == mono.pixel(x, y);
+                ok &= monoAsRgb.pixel(x, y).r == mono.pixel(x, y) && monoAsRgb.pixel(x, y).b == mono.pixel(x, y);
+                ok &= flt2.pixel(x, y) == flt.pixel(x, y);
+            }
+        }
+        checkTrue(ok, "pixels check");
+
+        std::remove("ImageTest_rgb.ppm");
+        std::remove("ImageTest_mono.pgm");
+        std::remove("ImageTest_float.float");
+
+        // headers whose sizes overflow when multiplied
+        struct { const char* header; const char* what; } headers[] = {
+            { "P6\n6148914691236517206 1\n255\n", "width times channels overflowing rejected" },
+            { "P5\n4294967296 4294967296\n255\n", "width times height overflowing rejected" },
+            { "P6\n99999999999999999999999 1\n255\n", "width overflowing rejected" },
+        };
+        for (auto& bad : headers) {
+            FILE* fp = fopen("ImageTest_bad.ppm", "wb");
+            fputs(bad.header, fp);
+            fputs("0123456789", fp);
+            fclose(fp);
+            checkFalse(file::read(rgb2, "ImageTest_bad.ppm"), bad.what);
+        }
+        std::remove("ImageTest_bad.ppm");
+
+        size_t dims[2] = { ((size_t)1 << (sizeof(size_t) * 8 - 2)) + 1, 4 };
+        FILE* fp = fopen("ImageTest_bad.float", "wb");
+        fwrite(dims, sizeof(dims), 1, fp);
+        fwrite(dims, sizeof(dims), 1, fp);
+        fclose(fp);
+        checkFalse(file::read(flt2, "ImageTest_bad.float"), "crafted float size rejected");
+        std::remove("ImageTest_bad.float");
+    }
+
     virtual void runTests() override {
         readWrite();
         testCreate();
@@ -628,6 +773,7 @@ static const size_t EXT_HEIGHT = 64;
         testStandard();
         testDraw();
         testScale();
+        testScaleFilters();
         testRowPointer();
         testConstMethods();
         testBlank();
@@ -635,6 +781,7 @@ static const size_t EXT_HEIGHT = 64;
         testRgbInt();
         testOrigin();
         testExternalRepeat();
+        testFile();
     }
 };
 
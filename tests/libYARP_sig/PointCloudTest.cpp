@@ -19,8 +19,11 @@
 #include <yarp/os/Network.h>
 #include <yarp/os/NetType.h>
 #include <yarp/sig/PointCloud.h>
+#include <yarp/sig/PointCloudUtils.h>
 #include <yarp/os/PortReaderBuffer.h>
 
+#include <cmath>
+
 #include "TestList.h"
 
 using namespace yarp::sig;
@@ -921,6 +924,71 @@ public:
 
     }
 
+    void depthToPCTest()
+    {
+        report(0, "Checking depth to point cloud conversion");
+        size_t width  = 64;
+        size_t height = 48;
+        ImageOf<PixelFloat> depth;
+        depth.resize(width, height);
+        ImageOf<PixelRgb> color;
+        color.resize(width, height);
+        for (size_t v = 0; v < height; v++) {
+            for (size_t u = 0; u < width; u++) {
+                depth.pixel(u, v) = 1.0f + 0.01f * u + 0.02f * v;
+                color.pixel(u, v) = PixelRgb(static_cast<unsigned char>(u),
+                                             static_cast<unsigned char>(v),
+                                             7);
+            }
+        }
+
+        yarp::os::Property prop;
+        prop.put("focalLengthX", 50.0);
+        prop.put("focalLengthY", 40.0);
+        prop.put("principalPointX", 32.0);
+        prop.put("principalPointY", 24.0);
+        IntrinsicParams intrinsic(prop);
+
+        PointCloud<DataXYZ> pc = utils::depthToPC(depth, intrinsic);
+        checkEqual(pc.width(), width, "Checking width");
+        checkEqual(pc.height(), height, "Checking height");
+        bool ok = true;
+        for (size_t v = 0; v < height; v++) {
+            for (size_t u = 0; u < width; u++) {
+                float z = depth.pixel(u, v);
+                ok &= std::fabs(pc(u, v).x - z * (u - 32.0f) / 50.0f) < acceptedDiff;
+                ok &= std::fabs(pc(u, v).y - z * (v - 24.0f) / 40.0f) < acceptedDiff;
+                ok &= pc(u, v).z == z;
+            }
+        }
+        checkTrue(ok, "Checking data consistency");
+
+        report(0, "Checking depth to point cloud conversion with roi, decimation and threads");
+        PointCloud<DataXYZRGBA> pcRgb;
+        utils::PCL_ROI roi(10, 50, 5, 45);
+        checkTrue(utils::depthRgbToPC(depth, color, intrinsic, pcRgb, roi, 3, 2, 4), "Checking conversion");
+        checkEqual(pcRgb.width(), (size_t)14, "Checking width");
+        checkEqual(pcRgb.height(), (size_t)20, "Checking height");
+        ok = true;
+        for (size_t r = 0; r < pcRgb.height(); r++) {
+            for (size_t c = 0; c < pcRgb.width(); c++) {
+                size_t u = 10 + c * 3;
+                size_t v = 5 + r * 2;
+                float z = depth.pixel(u, v);
+                ok &= std::fabs(pcRgb(c, r).x - z * (u - 32.0f) / 50.0f) < acceptedDiff;
+                ok &= std::fabs(pcRgb(c, r).y - z * (v - 24.0f) / 40.0f) < acceptedDiff;
+                ok &= pcRgb(c, r).z == z;
+                ok &= pcRgb(c, r).r == u;
+                ok &= pcRgb(c, r).g == v;
+                ok &= pcRgb(c, r).b == 7;
+            }
+        }
+        checkTrue(ok, "Checking data consistency");
+
+        checkFalse(utils::depthRgbToPC(depth, color, intrinsic, pcRgb, utils::PCL_ROI(0, 65, 0, 0)), "Checking roi out of bounds fails");
+        checkFalse(utils::depthToPC(depth, IntrinsicParams(), pc), "Checking invalid intrinsics fail");
+    }
+
     virtual void runTests() override
     {
         readWriteMatchTest();
@@ -931,6 +999,7 @@ public:
         concatenationTest();
         toFromBottle();
         readWritetoFromBottle();
+        depthToPCTest();
     }
 };
 
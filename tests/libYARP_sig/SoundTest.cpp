@@ -10,6 +10,10 @@
 #include <yarp/sig/Sound.h>
 #include <yarp/os/Network.h>
 #include <yarp/os/BufferedPort.h>
+#include <yarp/os/NetUint16.h>
+
+#include <thread>
+#include <vector>
 
 #include "TestList.h"
 
@@ -85,6 +89,103 @@ public:
         checkTrue(ok,"operator '+=' test performed ");
     }
 
+    void checkChunks() {
+        report(0,"check chunked sounds...");
+        const size_t channels = 3;
+        const size_t block = 10;
+        std::vector<std::int16_t> data(block*channels);
+
+        // accumulate a sound in small blocks
+        Sound snd;
+        snd.resize(0, channels);
+        for (size_t b=0; b<20; b++) {
+            for (size_t i=0; i<block; i++) {
+                for (size_t ch=0; ch<channels; ch++) {
+                    data[i*channels+ch] = (std::int16_t)((b*block+i)*channels+ch);
+                }
+            }
+            snd.appendInterleaved(data.data(), block);
+        }
+        checkEqual((size_t) 20*block,snd.getSamples(),"sample count");
+        bool ok = true;
+        for (size_t i=0; i<snd.getSamples(); i++) {
+            for (size_t ch=0; ch<channels; ch++) {
+                ok &= (snd.get(i,ch) == (int)(i*channels+ch));
+            }
+        }
+        checkTrue(ok,"appended samples");
+
+        // sub-sounds and appended sounds share the samples until modified
+        Sound sub = snd.subSound(15, 45);
+        checkEqual((size_t) 30,sub.getSamples(),"sub-sound sample count");
+        checkEqual((int)(15*channels+1),sub.get(0,1),"sub-sound samples");
+        sub.set(7,0,1);
+        checkEqual(7,sub.get(0,1),"sub-sound modified");
+        checkEqual((int)(15*channels+1),snd.get(15,1),"original not modified");
+
+        Sound sum = sub;
+        sum += snd.subSound(100, 110);
+        checkEqual((size_t) 40,sum.getSamples(),"appended sample count");
+        checkEqual((int)(100*channels+2),sum.get(30,2),"appended samples");
+
+        // merged chunks
+        unsigned char* raw = sum.getRawData();
+        NetUint16* raw16 = reinterpret_cast<NetUint16*>(raw);
+        checkEqual(sum.getRawDataSize(),(size_t) 40*channels*2,"raw data size");
+        checkEqual(7,(int)raw16[1*40+0],"raw data");
+        checkEqual((int)(100*channels+2),(int)raw16[2*40+30],"raw data of the appended sound");
+
+        std::vector<std::int16_t> out(5*channels);
+        sum.getInterleaved(out.data(), 28, 5);
+        checkEqual((int)out[0*channels+1],sum.get(28,1),"interleaved samples");
+        checkEqual((int)out[4*channels+2],sum.get(32,2),"interleaved samples across chunks");
+
+        Sound copy;
+        copy.setInterleaved(out.data(), 5, channels);
+        checkEqual((size_t) 5,copy.getSamples(),"interleaved sample count");
+        checkEqual(sum.get(31,0),copy.get(3,0),"interleaved round trip");
+    }
+
+    void checkConcurrentReaders() {
+        report(0,"check concurrent readers of a chunked sound...");
+        const size_t channels = 2;
+        std::vector<std::int16_t> data(10*channels);
+        Sound snd;
+        snd.resize(0, channels);
+        for (size_t b=0; b<50; b++) {
+            for (size_t i=0; i<data.size(); i++) {
+                data[i] = (std::int16_t)(b*data.size()+i);
+            }
+            snd.appendInterleaved(data.data(), 10);
+        }
+
+        // some threads merge the chunks while the others read them
+        const Sound& shared = snd;
+        bool ok[4] = { true, true, true, true };
+        std::vector<std::thread> threads;
+        for (int t=0; t<4; t++) {
+            threads.emplace_back([&shared, &ok, t, channels]() {
+                std::vector<std::int16_t> out(shared.getSamples()*channels);
+                for (int k=0; k<50; k++) {
+                    if (t%2 == 0) {
+                        const unsigned char* raw = shared.getRawData();
+                        ok[t] &= (raw != nullptr);
+                    } else {
+                        shared.getInterleaved(out.data(), 0, shared.getSamples());
+                        for (size_t i=0; i<out.size(); i++) {
+                            ok[t] &= (out[i] == (std::int16_t)i);
+                        }
+                        ok[t] &= (shared.get(123,1) == 123*2+1);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        checkTrue(ok[0] && ok[1] && ok[2] && ok[3],"const sound read from several threads");
+    }
+
     void checkTransmit() {
         report(0,"checking sound transmission...");
 
@@ -131,6 +232,8 @@ public:
         Network::setLocalMode(true);
         checkSetGet();
         checkSum();
+        checkChunks();
+        checkConcurrentReaders();
         checkTransmit();
         Network::setLocalMode(false);
     }
@@ -66,6 +66,15 @@ struct TestSomeMoreTypes {
   8: binary a_binary
 }
 
+struct TestNumericLists {
+  1: list<i8> i8_list,
+  2: list<i16> i16_list,
+  3: list<i32> i32_list,
+  4: list<i64> i64_list,
+  5: list<double> double_list,
+  6: list<string> string_list
+}
+
 /**
  * Documentation for service
  */
@@ -16,6 +16,7 @@
 #include <SurfaceMeshWithBoundingBox.h>
 #include <Wrapping.h>
 #include <TestSomeMoreTypes.h>
+#include <TestNumericLists.h>
 #include <sub/directory/ClockServer.h>
 #include <Settings.h>
 
@@ -945,6 +946,107 @@ bool test_primitives() {
     return true;
 }
 
+bool test_list_block() {
+    printf("\n*** test_list_block()\n");
+
+    // numbers written and read as a single block
+    {
+        std::vector<double> in = { 1.5, -2.25, 1e10, 0 };
+        std::vector<double> out(in.size());
+        DummyConnector con;
+        yarp::os::idl::WireWriter writer(con.getWriter());
+        if (!writer.writeListBlock(BOTTLE_TAG_FLOAT64, in.data(), (std::uint32_t)in.size())) {
+            fprintf(stderr,"writeListBlock failed\n");
+            return false;
+        }
+        yarp::os::idl::WireReader reader(con.getReader());
+        yarp::os::idl::WireState state;
+        std::uint32_t len = 0;
+        reader.readListBegin(state, len);
+        if (len != in.size() ||
+            !reader.readListBlock(BOTTLE_TAG_FLOAT64, out.data(), len) ||
+            out != in) {
+            fprintf(stderr,"readListBlock failed\n");
+            return false;
+        }
+        reader.readListEnd();
+    }
+
+    // a block of another type is left to be read element by element
+    {
+        std::vector<std::int32_t> in = { 1, 2, 3 };
+        std::vector<std::int64_t> out(in.size());
+        DummyConnector con;
+        yarp::os::idl::WireWriter writer(con.getWriter());
+        writer.writeListBlock(BOTTLE_TAG_INT32, in.data(), (std::uint32_t)in.size());
+        yarp::os::idl::WireReader reader(con.getReader());
+        yarp::os::idl::WireState state;
+        std::uint32_t len = 0;
+        reader.readListBegin(state, len);
+        if (reader.readListBlock(BOTTLE_TAG_INT64, out.data(), len)) {
+            fprintf(stderr,"readListBlock accepted the wrong type\n");
+            return false;
+        }
+        for (std::uint32_t i = 0; i < len; i++) {
+            if (!reader.readI64(out[i]) || out[i] != in[i]) {
+                fprintf(stderr,"element by element read failed\n");
+                return false;
+            }
+        }
+        reader.readListEnd();
+    }
+
+    // the generated code round trips every numeric list
+    TestNumericLists a, b;
+    a.i8_list = { -8, 0, 8 };
+    a.i16_list = { -16, 16, 1600 };
+    a.i32_list = { 1, -2, 3, 100000 };
+    a.i64_list = { -64, 64000000000LL };
+    a.double_list = { 0.5, -1.25 };
+    a.string_list = { "a", "b" };
+    Bottle tmp;
+    tmp.read(a);
+    tmp.write(b);
+    if (b.i8_list != a.i8_list || b.i16_list != a.i16_list ||
+        b.i32_list != a.i32_list || b.i64_list != a.i64_list ||
+        b.double_list != a.double_list || b.string_list != a.string_list) {
+        fprintf(stderr,"numeric lists round trip failed: %s\n", tmp.toString().c_str());
+        return false;
+    }
+
+    // the blocks are ordinary typed lists for other readers
+    Bottle *lst = tmp.get(2).asList();
+    if (lst == nullptr || lst->size() != a.i32_list.size() || lst->get(3).asInt32() != 100000) {
+        fprintf(stderr,"block not readable as a bottle: %s\n", tmp.toString().c_str());
+        return false;
+    }
+
+    // lists of other types, or written one element at a time, are read too
+    Bottle old("(1 2 3) (4 5) (6 7 8 9) (10) (1 2.5) (x)");
+    TestNumericLists c;
+    old.write(c);
+    if (c.i8_list.size() != 3 || c.i8_list[2] != 3 ||
+        c.i16_list.size() != 2 || c.i16_list[1] != 5 ||
+        c.i32_list.size() != 4 || c.i32_list[3] != 9 ||
+        c.i64_list.size() != 1 || c.i64_list[0] != 10 ||
+        c.double_list.size() != 2 || c.double_list[1] != 2.5 ||
+        c.string_list.size() != 1 || c.string_list[0] != "x") {
+        fprintf(stderr,"element by element lists not read: %s\n", old.toString().c_str());
+        return false;
+    }
+
+    // reading again reuses the lists
+    old.fromString("(1) () (5 6) (7) (0.5) ()");
+    old.write(c);
+    if (c.i8_list.size() != 1 || !c.i16_list.empty() || c.i32_list.size() != 2 ||
+        c.i32_list[1] != 6 || c.double_list[0] != 0.5 || !c.string_list.empty()) {
+        fprintf(stderr,"lists not updated when read again\n");
+        return false;
+    }
+
+    return true;
+}
+
 bool test_settings(UnitTest& test) {
     test.report(0,"test settings");
 
@@ -1059,6 +1161,7 @@ int main(int argc, char *argv[]) {
     if (!test_list_editor()) return 1;
     if (!test_help()) return 1;
     if (!test_primitives()) return 1;
+    if (!test_list_block()) return 1;
     UnitTest::startTestSystem();
     ThriftTest test;
     if (!test_settings(test)) return 1;
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2006-2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/impl/UnitTest.h>
+
+#include <samplebuffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace yarp::os;
+using namespace yarp::os::impl;
+
+// Checks the buffers of the yarpscope plugin: the samples read by each
+// graph, and the points drawn, that must keep the minimum and the maximum
+// of each group of points.
+class SampleBufferTest : public UnitTest {
+public:
+    virtual std::string getName() const override { return "SampleBufferTest"; }
+
+    static double signal(int i) {
+        // a slow wave with some spikes
+        double y = std::sin(i * 0.01);
+        if (i % 997 == 0) {
+            y += 5;
+        }
+        if (i % 1499 == 0) {
+            y -= 5;
+        }
+        return y;
+    }
+
+    void checkSampleBuffer() {
+        report(0, "checking the samples read by each graph");
+        SampleBuffer samples(8);
+        std::uint64_t cursor0 = 0;
+        std::uint64_t cursor2 = 0;
+        int column0 = samples.addColumn(0, cursor0);
+        int column2 = samples.addColumn(2, cursor2);
+
+        for (int i = 0; i < 5; i++) {
+            Bottle b;
+            b.addFloat64(i);
+            b.addFloat64(10 + i);
+            samples.append(b, i);
+        }
+        std::vector<double> values;
+        double lastTime = -1;
+        checkTrue(samples.read(column0, cursor0, values, lastTime) == 5 &&
+                  values[0] == 0 && values[4] == 4 && lastTime == 4,
+                  "samples of a column read");
+        checkEqual(samples.read(column0, cursor0, values, lastTime), (size_t)0, "samples read only once");
+        checkTrue(samples.read(column2, cursor2, values, lastTime) == 5 && std::isnan(values[0]),
+                  "missing values read as NaN");
+
+        // a slow reader loses the oldest samples
+        for (int i = 5; i < 20; i++) {
+            Bottle b;
+            b.addFloat64(i);
+            samples.append(b, i);
+        }
+        checkTrue(samples.read(column0, cursor0, values, lastTime) == 8 &&
+                  values[0] == 12 && values[7] == 19,
+                  "oldest samples lost by a slow reader");
+    }
+
+    // checks the points returned for the range of keys [from, to]
+    void checkDecimation(const LodBuffer& points, const std::map<double, double>& stored,
+                         double from, double to, int buckets, const std::string& what) {
+        std::vector<double> keys;
+        std::vector<double> values;
+        points.decimate(from, to, buckets, keys, values);
+
+        bool existing = true;
+        bool ordered = true;
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto it = stored.find(keys[i]);
+            existing = existing && it != stored.end() && it->second == values[i];
+            ordered = ordered && (i == 0 || keys[i - 1] < keys[i]);
+        }
+        checkTrue(existing, what + ": points among the ones stored");
+        checkTrue(ordered, what + ": points in order");
+        checkTrue(keys.size() <= 4 * static_cast<size_t>(buckets) + 4, what + ": about one group per bucket");
+
+        // the points in the range are never outside the values drawn, and
+        // the extremes of the range are drawn
+        double min = 1e300;
+        double max = -1e300;
+        for (auto it = stored.lower_bound(from); it != stored.end() && it->first <= to; ++it) {
+            min = std::min(min, it->second);
+            max = std::max(max, it->second);
+        }
+        checkTrue(std::find(values.begin(), values.end(), min) != values.end() &&
+                  std::find(values.begin(), values.end(), max) != values.end(),
+                  what + ": minimum and maximum drawn");
+
+        // every spike in the range is drawn
+        bool spikes = true;
+        for (auto it = stored.lower_bound(from); it != stored.end() && it->first <= to; ++it) {
+            if (std::fabs(it->second) > 3) {
+                spikes = spikes && std::find(keys.begin(), keys.end(), it->first) != keys.end();
+            }
+        }
+        checkTrue(spikes, what + ": spikes drawn");
+    }
+
+    void checkLodBuffer() {
+        report(0, "checking the points drawn");
+        LodBuffer points(10000);
+        std::map<double, double> stored;
+        checkEqual(points.size(), (size_t)0, "empty buffer");
+
+        for (int i = 0; i < 10; i++) {
+            points.append(i, signal(i));
+            stored[i] = signal(i);
+        }
+        std::vector<double> keys;
+        std::vector<double> values;
+        points.decimate(2, 5, 100, keys, values);
+        checkTrue(keys.size() == 5 && keys.front() == 1 && keys.back() == 5,
+                  "few points returned with the one before the range");
+
+        for (int i = 10; i < 12000; i++) {
+            points.append(i, signal(i));
+            stored[i] = signal(i);
+        }
+        checkEqual(points.size(), (size_t)12000, "points stored");
+        checkDecimation(points, stored, 0, 12000, 200, "whole range");
+        checkDecimation(points, stored, 1234.5, 7777, 50, "partial range");
+        checkDecimation(points, stored, 3000, 3100, 500, "range with fewer points than buckets");
+
+        // after the ring wraps around only the newest points are returned,
+        // the capacity is rounded up to a power of two
+        for (int i = 12000; i < 40000; i++) {
+            points.append(i, signal(i));
+            stored[i] = signal(i);
+        }
+        checkEqual(points.size(), (size_t)16384, "capacity rounded up");
+        std::map<double, double> newest(stored.lower_bound(40000 - static_cast<double>(points.size())), stored.end());
+        checkDecimation(points, newest, 0, 40000, 300, "wrapped around");
+        points.decimate(0, 40000, 300, keys, values);
+        checkTrue(!keys.empty() && keys.front() >= 40000 - static_cast<double>(points.size()),
+                  "wrapped around: oldest points dropped");
+
+        points.clear();
+        points.decimate(0, 40000, 300, keys, values);
+        checkTrue(points.size() == 0 && keys.empty(), "buffer cleared");
+    }
+
+    virtual void runTests() override {
+        checkSampleBuffer();
+        checkLodBuffer();
+    }
+};
+
+static SampleBufferTest theSampleBufferTest;
+
+UnitTest& getPluginTest() {
+    return theSampleBufferTest;
+}